@@ -0,0 +1,69 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include "../ComponentManager.hpp"
+
+OMP_CAPI(Collision_IsLoaded, bool())
+{
+	COMPONENT_CHECK_RET(collision, false);
+	return collision->isLoaded();
+}
+
+OMP_CAPI(Collision_RayCast, bool(float fromX, float fromY, float fromZ, float toX, float toY, float toZ, float* hitX, float* hitY, float* hitZ, float* normalX, float* normalY, float* normalZ, int* modelid))
+{
+	COMPONENT_CHECK_RET(collision, false);
+	CollisionHit hit;
+	if (!collision->rayCast({ fromX, fromY, fromZ }, { toX, toY, toZ }, hit))
+	{
+		return false;
+	}
+	*hitX = hit.position.x;
+	*hitY = hit.position.y;
+	*hitZ = hit.position.z;
+	*normalX = hit.normal.x;
+	*normalY = hit.normal.y;
+	*normalZ = hit.normal.z;
+	*modelid = hit.modelId;
+	return true;
+}
+
+OMP_CAPI(Collision_LineOfSight, bool(float fromX, float fromY, float fromZ, float toX, float toY, float toZ))
+{
+	COMPONENT_CHECK_RET(collision, true);
+	return collision->hasLineOfSight({ fromX, fromY, fromZ }, { toX, toY, toZ });
+}
+
+OMP_CAPI(Collision_FindZ, bool(float x, float y, float z, float* groundZ))
+{
+	COMPONENT_CHECK_RET(collision, false);
+	return collision->getGroundZ({ x, y, z }, *groundZ);
+}
+
+OMP_CAPI(Collision_RemoveBuilding, int(int modelid, float x, float y, float z, float radius))
+{
+	COMPONENT_CHECK_RET(collision, 0);
+	return collision->removeBuilding(modelid, { x, y, z }, radius);
+}
+
+OMP_CAPI(Collision_CreateObject, int(int modelid, float x, float y, float z, float rotationX, float rotationY, float rotationZ))
+{
+	COMPONENT_CHECK_RET(collision, INVALID_COLLISION_OBJECT_ID);
+	return collision->createObject(modelid, { x, y, z }, GTAQuat(Vector3(rotationX, rotationY, rotationZ)));
+}
+
+OMP_CAPI(Collision_SetObjectPos, bool(int objectid, float x, float y, float z, float rotationX, float rotationY, float rotationZ))
+{
+	COMPONENT_CHECK_RET(collision, false);
+	return collision->setObjectTransform(objectid, { x, y, z }, GTAQuat(Vector3(rotationX, rotationY, rotationZ)));
+}
+
+OMP_CAPI(Collision_DestroyObject, bool(int objectid))
+{
+	COMPONENT_CHECK_RET(collision, false);
+	return collision->destroyObject(objectid);
+}
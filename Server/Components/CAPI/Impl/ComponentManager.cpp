@@ -107,6 +107,10 @@ void ComponentManager::Init(ICore* c, IComponentList* clist)
 	checkpoints = GetComponent<ICheckpointsComponent>();
 	dialogs = GetComponent<IDialogsComponent>();
 	npcs = GetComponent<INPCComponent>();
+	collision = GetComponent<ICollisionComponent>();
+	hashing = GetComponent<IHashingComponent>();
+	unicode = GetComponent<IUnicodeComponent>();
+	databases = GetComponent<IDatabasesComponent>();
 }
 
 void ComponentManager::InitializeEvents()
@@ -22,6 +22,7 @@
 #include <Server/Components/Classes/classes.hpp>
 #include <Server/Components/Console/console.hpp>
 #include <Server/Components/CustomModels/custommodels.hpp>
+#include <Server/Components/Databases/databases.hpp>
 #include <Server/Components/Dialogs/dialogs.hpp>
 #include <Server/Components/Menus/menus.hpp>
 #include <Server/Components/TextDraws/textdraws.hpp>
@@ -30,6 +31,11 @@
 #include <Server/Components/TextLabels/textlabels.hpp>
 #include <Server/Components/GangZones/gangzones.hpp>
 #include <Server/Components/NPCs/npcs.hpp>
+#include <Server/Components/Unicode/unicode.hpp>
+#include <collision.hpp>
+#include <hashing.hpp>
+#include <player_codepage.hpp>
+#include <database_async.hpp>
 
 enum class EventReturnHandler
 {
@@ -57,6 +63,10 @@ public:
 	ICheckpointsComponent* checkpoints = nullptr;
 	IDialogsComponent* dialogs = nullptr;
 	INPCComponent* npcs = nullptr;
+	ICollisionComponent* collision = nullptr;
+	IHashingComponent* hashing = nullptr;
+	IUnicodeComponent* unicode = nullptr;
+	IDatabasesComponent* databases = nullptr;
 
 	/// Store open.mp components
 	void Init(ICore* c, IComponentList* clist);
@@ -7,6 +7,7 @@
  */
 
 #include "../ComponentManager.hpp"
+#include <packet_accounting.hpp>
 #include <sstream>
 #include <iomanip>
 
@@ -327,6 +328,87 @@ OMP_CAPI(Player_NetStatsPacketLossPercent, float(objectPtr player))
 	return packetLoss;
 }
 
+static IPacketAccountingExtension* GetPacketAccounting()
+{
+	for (INetwork* network : ComponentManager::Get()->core->getNetworks())
+	{
+		IPacketAccountingExtension* accounting = queryExtension<IPacketAccountingExtension>(network);
+		if (accounting)
+		{
+			return accounting;
+		}
+	}
+	return nullptr;
+}
+
+static bool CopyPacketStats(const PacketAccountingEntry* entry, uint64_t* count, uint64_t* bytes, uint64_t* handlerMicroseconds, uint32_t* handlerMaxMicroseconds)
+{
+	*count = entry ? entry->count : 0;
+	*bytes = entry ? entry->bytes : 0;
+	*handlerMicroseconds = entry ? entry->handlerMicroseconds : 0;
+	*handlerMaxMicroseconds = entry ? entry->handlerMaxMicroseconds : 0;
+	return entry != nullptr;
+}
+
+OMP_CAPI(Core_TogglePacketAccounting, bool(bool enable))
+{
+	IPacketAccountingExtension* accounting = GetPacketAccounting();
+	if (!accounting)
+	{
+		return false;
+	}
+	accounting->setAccountingEnabled(enable);
+	return true;
+}
+
+OMP_CAPI(Core_IsPacketAccountingEnabled, bool())
+{
+	IPacketAccountingExtension* accounting = GetPacketAccounting();
+	return accounting && accounting->isAccountingEnabled();
+}
+
+OMP_CAPI(Core_ResetPacketAccounting, bool())
+{
+	IPacketAccountingExtension* accounting = GetPacketAccounting();
+	if (!accounting)
+	{
+		return false;
+	}
+	accounting->resetAccounting();
+	return true;
+}
+
+OMP_CAPI(Core_GetPacketStats, bool(int kind, int direction, int id, uint64_t* count, uint64_t* bytes, uint64_t* handlerMicroseconds, uint32_t* handlerMaxMicroseconds))
+{
+	IPacketAccountingExtension* accounting = GetPacketAccounting();
+	if (!accounting || kind < 0 || kind >= PacketAccountingKind_End || direction < 0 || direction >= PacketAccountingDirection_End || id < 0 || id > 255)
+	{
+		return CopyPacketStats(nullptr, count, bytes, handlerMicroseconds, handlerMaxMicroseconds);
+	}
+	return CopyPacketStats(&accounting->getAccounting(PacketAccountingKind(kind), PacketAccountingDirection(direction), uint8_t(id)), count, bytes, handlerMicroseconds, handlerMaxMicroseconds);
+}
+
+OMP_CAPI(Core_GetPacketHandlerHistogram, uint32_t(int kind, int id, int bucket))
+{
+	IPacketAccountingExtension* accounting = GetPacketAccounting();
+	if (!accounting || kind < 0 || kind >= PacketAccountingKind_End || id < 0 || id > 255 || bucket < 0 || bucket >= int(PacketHandlerTimeBuckets))
+	{
+		return 0;
+	}
+	return accounting->getAccounting(PacketAccountingKind(kind), PacketAccountingDirection_In, uint8_t(id)).handlerHistogram[bucket];
+}
+
+OMP_CAPI(Player_NetStatsGetPacketStats, bool(objectPtr player, int kind, int direction, int id, uint64_t* count, uint64_t* bytes, uint64_t* handlerMicroseconds, uint32_t* handlerMaxMicroseconds))
+{
+	POOL_ENTITY_RET(players, IPlayer, player, player_, false);
+	IPacketAccountingExtension* accounting = GetPacketAccounting();
+	if (!accounting || kind < 0 || kind >= PacketAccountingKind_End || direction < 0 || direction >= PacketAccountingDirection_End || id < 0 || id > 255)
+	{
+		return CopyPacketStats(nullptr, count, bytes, handlerMicroseconds, handlerMaxMicroseconds);
+	}
+	return CopyPacketStats(accounting->getPlayerAccounting(*player_, PacketAccountingKind(kind), PacketAccountingDirection(direction), uint8_t(id)), count, bytes, handlerMicroseconds, handlerMaxMicroseconds);
+}
+
 OMP_CAPI(Core_SendRconCommand, bool(StringCharPtr command))
 {
 	IConsoleComponent* console = ComponentManager::Get()->console;
@@ -0,0 +1,140 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include "../ComponentManager.hpp"
+
+typedef void (*DatabaseQueryCallback)(voidPtr userData, objectPtr resultSet);
+
+struct CAPIDatabaseQueryHandler final : DatabaseQueryHandler
+{
+	voidPtr callback;
+	voidPtr userData;
+
+	CAPIDatabaseQueryHandler(voidPtr callback, voidPtr userData)
+		: callback(callback)
+		, userData(userData)
+	{
+	}
+
+	void onQueryExecuted(IDatabaseResultSet* resultSet) override
+	{
+		// The result set is the callback's to free with Database_FreeResultSet.
+		DatabaseQueryCallback(callback)(userData, resultSet);
+		delete this;
+	}
+};
+
+OMP_CAPI(Database_Open, objectPtr(StringCharPtr path, int flags, int* id))
+{
+	COMPONENT_CHECK_RET(databases, nullptr);
+	IDatabaseConnection* connection = databases->open(path, flags);
+	if (connection)
+	{
+		*id = connection->getID();
+		return connection;
+	}
+	return nullptr;
+}
+
+OMP_CAPI(Database_Close, bool(objectPtr db))
+{
+	POOL_ENTITY_RET(databases, IDatabaseConnection, db, db_, false);
+	return databases->close(*db_);
+}
+
+OMP_CAPI(Database_ExecuteQueryAsync, bool(objectPtr db, StringCharPtr query, voidPtr callback, voidPtr userData))
+{
+	POOL_ENTITY_RET(databases, IDatabaseConnection, db, db_, false);
+	IDatabaseAsyncExtension* async = queryExtension<IDatabaseAsyncExtension>(databases);
+	if (!async || !callback)
+	{
+		return false;
+	}
+	auto handler = new CAPIDatabaseQueryHandler(callback, userData);
+	if (async->executeQueryAsync(*db_, query, handler))
+	{
+		return true;
+	}
+	delete handler;
+	return false;
+}
+
+OMP_CAPI(Database_GetPendingQueryCount, int())
+{
+	COMPONENT_CHECK_RET(databases, 0);
+	IDatabaseAsyncExtension* async = queryExtension<IDatabaseAsyncExtension>(databases);
+	return async ? int(async->getPendingQueryCount()) : 0;
+}
+
+OMP_CAPI(Database_FreeResultSet, bool(objectPtr result))
+{
+	POOL_ENTITY_RET(databases, IDatabaseResultSet, result, result_, false);
+	return databases->freeResultSet(*result_);
+}
+
+OMP_CAPI(Database_GetRowCount, int(objectPtr result))
+{
+	POOL_ENTITY_RET(databases, IDatabaseResultSet, result, result_, 0);
+	return int(result_->getRowCount());
+}
+
+OMP_CAPI(Database_SelectNextRow, bool(objectPtr result))
+{
+	POOL_ENTITY_RET(databases, IDatabaseResultSet, result, result_, false);
+	return result_->selectNextRow();
+}
+
+OMP_CAPI(Database_GetFieldCount, int(objectPtr result))
+{
+	POOL_ENTITY_RET(databases, IDatabaseResultSet, result, result_, 0);
+	return int(result_->getFieldCount());
+}
+
+OMP_CAPI(Database_GetFieldName, bool(objectPtr result, int field, OutputStringViewPtr output))
+{
+	POOL_ENTITY_RET(databases, IDatabaseResultSet, result, result_, false);
+	if (field < 0 || size_t(field) >= result_->getFieldCount())
+	{
+		return false;
+	}
+	auto name = result_->getFieldName(size_t(field));
+	SET_CAPI_STRING_VIEW(output, name);
+	return true;
+}
+
+OMP_CAPI(Database_GetFieldString, bool(objectPtr result, int field, OutputStringViewPtr output))
+{
+	POOL_ENTITY_RET(databases, IDatabaseResultSet, result, result_, false);
+	if (field < 0 || size_t(field) >= result_->getFieldCount())
+	{
+		return false;
+	}
+	auto value = result_->getFieldString(size_t(field));
+	SET_CAPI_STRING_VIEW(output, value);
+	return true;
+}
+
+OMP_CAPI(Database_GetFieldInt, int(objectPtr result, int field))
+{
+	POOL_ENTITY_RET(databases, IDatabaseResultSet, result, result_, 0);
+	if (field < 0 || size_t(field) >= result_->getFieldCount())
+	{
+		return 0;
+	}
+	return int(result_->getFieldInt(size_t(field)));
+}
+
+OMP_CAPI(Database_GetFieldFloat, float(objectPtr result, int field))
+{
+	POOL_ENTITY_RET(databases, IDatabaseResultSet, result, result_, 0.0f);
+	if (field < 0 || size_t(field) >= result_->getFieldCount())
+	{
+		return 0.0f;
+	}
+	return float(result_->getFieldFloat(size_t(field)));
+}
@@ -0,0 +1,76 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include "../ComponentManager.hpp"
+
+typedef void (*PasswordHashedCallback)(voidPtr userData, StringCharPtr hash);
+typedef void (*PasswordCheckedCallback)(voidPtr userData, bool match);
+
+struct CAPIPasswordHandler final : PasswordHashHandler, PasswordCheckHandler
+{
+	voidPtr callback;
+	voidPtr userData;
+
+	CAPIPasswordHandler(voidPtr callback, voidPtr userData)
+		: callback(callback)
+		, userData(userData)
+	{
+	}
+
+	void onPasswordHashed(StringView hash) override
+	{
+		// Views from the component aren't terminated, the callback wants a C string.
+		Impl::String str(hash);
+		PasswordHashedCallback(callback)(userData, str.c_str());
+		delete this;
+	}
+
+	void onPasswordChecked(bool match) override
+	{
+		PasswordCheckedCallback(callback)(userData, match);
+		delete this;
+	}
+};
+
+OMP_CAPI(Password_Hash, bool(StringCharPtr password, int type, int cost, voidPtr callback, voidPtr userData))
+{
+	COMPONENT_CHECK_RET(hashing, false);
+	if (!callback)
+	{
+		return false;
+	}
+	auto handler = new CAPIPasswordHandler(callback, userData);
+	if (hashing->hashPassword(handler, PasswordHashType(type), password, cost))
+	{
+		return true;
+	}
+	delete handler;
+	return false;
+}
+
+OMP_CAPI(Password_Verify, bool(StringCharPtr password, StringCharPtr hash, voidPtr callback, voidPtr userData))
+{
+	COMPONENT_CHECK_RET(hashing, false);
+	if (!callback)
+	{
+		return false;
+	}
+	auto handler = new CAPIPasswordHandler(callback, userData);
+	if (hashing->checkPassword(handler, password, hash))
+	{
+		return true;
+	}
+	delete handler;
+	return false;
+}
+
+OMP_CAPI(Password_GetPendingCount, int())
+{
+	COMPONENT_CHECK_RET(hashing, 0);
+	return int(hashing->getPendingCount());
+}
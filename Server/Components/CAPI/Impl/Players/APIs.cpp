@@ -7,6 +7,8 @@
  */
 
 #include "../ComponentManager.hpp"
+#include <player_name_index.hpp>
+#include <player_rewind.hpp>
 
 OMP_CAPI(Player_FromID, objectPtr(int playerid))
 {
@@ -18,6 +20,39 @@ OMP_CAPI(Player_FromID, objectPtr(int playerid))
 	return nullptr;
 }
 
+OMP_CAPI(Player_FromName, objectPtr(StringCharPtr name))
+{
+	IPlayerPool* component = ComponentManager::Get()->players;
+	if (component)
+	{
+		if (auto index = queryExtension<IPlayerNameIndexExtension>(component))
+		{
+			return index->getPlayerByName(name);
+		}
+	}
+	return nullptr;
+}
+
+OMP_CAPI(Player_FindByNamePrefix, int(StringCharPtr prefix, objectPtr* players, int capacity))
+{
+	IPlayerPool* component = ComponentManager::Get()->players;
+	if (component && capacity >= 0)
+	{
+		if (auto index = queryExtension<IPlayerNameIndexExtension>(component))
+		{
+			IPlayer* found[PLAYER_POOL_SIZE];
+			const size_t size = std::min<size_t>(capacity, PLAYER_POOL_SIZE);
+			const size_t total = index->findPlayersByNamePrefix(prefix, found, size);
+			for (size_t i = 0, written = std::min(total, size); i != written; ++i)
+			{
+				players[i] = found[i];
+			}
+			return int(total);
+		}
+	}
+	return 0;
+}
+
 OMP_CAPI(Player_GetID, int(objectPtr player))
 {
 	POOL_ENTITY_RET(players, IPlayer, player, player_, INVALID_PLAYER_ID);
@@ -323,6 +358,32 @@ OMP_CAPI(Player_GetPing, int(objectPtr player))
 	return ping;
 }
 
+OMP_CAPI(Player_GetRewindPos, bool(objectPtr player, int milliseconds, float* x, float* y, float* z))
+{
+	POOL_ENTITY_RET(players, IPlayer, player, player_, false);
+	auto rewind = queryExtension<IPlayerRewindExtension>(ComponentManager::Get()->players);
+	Vector3 position;
+	if (rewind && rewind->getPlayerPositionAt(*player_, Time::now() - Milliseconds(milliseconds), position))
+	{
+		*x = position.x;
+		*y = position.y;
+		*z = position.z;
+		return true;
+	}
+	return false;
+}
+
+OMP_CAPI(Player_WasNearShotLine, bool(objectPtr player, float fromX, float fromY, float fromZ, float toX, float toY, float toZ, float radius, int milliseconds))
+{
+	POOL_ENTITY_RET(players, IPlayer, player, player_, true);
+	auto rewind = queryExtension<IPlayerRewindExtension>(ComponentManager::Get()->players);
+	if (rewind)
+	{
+		return rewind->wasPlayerNearLine(*player_, { fromX, fromY, fromZ }, { toX, toY, toZ }, radius, Time::now() - Milliseconds(milliseconds));
+	}
+	return true;
+}
+
 OMP_CAPI(Player_GetWeapon, int(objectPtr player))
 {
 	POOL_ENTITY_RET(players, IPlayer, player, player_, 0);
@@ -0,0 +1,53 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include "../ComponentManager.hpp"
+
+OMP_CAPI(Player_ConvertTextToUTF8, int(objectPtr player, StringCharPtr input, OutputStringBufferPtr output))
+{
+	POOL_ENTITY_RET(players, IPlayer, player, player_, 0);
+	COMPONENT_CHECK_RET(unicode, 0);
+	IPlayerCodepageExtension* codepages = queryExtension<IPlayerCodepageExtension>(unicode);
+	if (!codepages)
+	{
+		return 0;
+	}
+	OptimisedString converted = codepages->playerToUTF8(*player_, input);
+	StringView result = converted;
+	int len = result.length();
+	COPY_STRING_TO_CAPI_STRING_BUFFER(output, result.data(), len);
+	return len;
+}
+
+OMP_CAPI(Player_GetCodepage, int(objectPtr player, OutputStringViewPtr output))
+{
+	POOL_ENTITY_RET(players, IPlayer, player, player_, 0);
+	COMPONENT_CHECK_RET(unicode, 0);
+	IPlayerCodepageExtension* codepages = queryExtension<IPlayerCodepageExtension>(unicode);
+	if (!codepages)
+	{
+		return 0;
+	}
+	// Points at the player's data, valid until the codepage is changed or they disconnect.
+	StringView result = codepages->getPlayerCodepage(*player_);
+	SET_CAPI_STRING_VIEW(output, result);
+	return int(result.length());
+}
+
+OMP_CAPI(Player_SetCodepage, bool(objectPtr player, StringCharPtr codepage))
+{
+	POOL_ENTITY_RET(players, IPlayer, player, player_, false);
+	COMPONENT_CHECK_RET(unicode, false);
+	IPlayerCodepageExtension* codepages = queryExtension<IPlayerCodepageExtension>(unicode);
+	if (!codepages)
+	{
+		return false;
+	}
+	codepages->setPlayerCodepage(*player_, codepage);
+	return true;
+}
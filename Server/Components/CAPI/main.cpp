@@ -70,6 +70,9 @@ public:
 		COMPONENT_UNLOADED(mgr->vehicles)
 		COMPONENT_UNLOADED(mgr->models)
 		COMPONENT_UNLOADED(mgr->npcs)
+		COMPONENT_UNLOADED(mgr->collision)
+		COMPONENT_UNLOADED(mgr->hashing)
+		COMPONENT_UNLOADED(mgr->unicode)
 	}
 
 	void free() override
@@ -0,0 +1,258 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include <sdk.hpp>
+#include <Server/Components/Objects/objects.hpp>
+#include "collision_world.hpp"
+
+using namespace Impl;
+
+class CollisionComponent final : public ICollisionComponent, public CoreEventHandler, public PoolEventHandler<IObject>
+{
+private:
+	/// A global object mirrored in to the world, with the transform it was given there
+	struct TrackedObject
+	{
+		int collisionId;
+		Vector3 position;
+		GTAQuat rotation;
+	};
+
+	ICore* core = nullptr;
+	IObjectsComponent* objects = nullptr;
+	CollisionWorld world;
+	String filePath = "";
+	bool trackObjects = true;
+	FlatHashMap<int, TrackedObject> trackedObjects;
+
+	/// How far below a point getGroundZ looks
+	static constexpr float GroundSearchDepth = 2000.0f;
+
+public:
+	StringView componentName() const override
+	{
+		return "Collision";
+	}
+
+	SemanticVersion componentVersion() const override
+	{
+		return SemanticVersion(OMP_VERSION_MAJOR, OMP_VERSION_MINOR, OMP_VERSION_PATCH, BUILD_NUMBER);
+	}
+
+	void provideConfiguration(ILogger& logger, IEarlyConfig& config, bool defaults) override
+	{
+		if (defaults)
+		{
+			config.setString("collision.file", filePath);
+			config.setBool("collision.objects", trackObjects);
+		}
+		else
+		{
+			// Set default values if options are not set.
+			if (config.getType("collision.file") == ConfigOptionType_None)
+			{
+				config.setString("collision.file", filePath);
+			}
+			if (config.getType("collision.objects") == ConfigOptionType_None)
+			{
+				config.setBool("collision.objects", trackObjects);
+			}
+		}
+	}
+
+	void onLoad(ICore* c) override
+	{
+		core = c;
+		filePath = String(trim(core->getConfig().getString("collision.file")));
+		trackObjects = *core->getConfig().getBool("collision.objects");
+	}
+
+	void onInit(IComponentList* components) override
+	{
+		// No file configured means no collision, every query just misses.
+		if (filePath.empty())
+		{
+			return;
+		}
+
+		const TimePoint start = Time::now();
+		String error;
+		if (!world.load(filePath, error))
+		{
+			core->logLn(LogLevel::Error, "[Collision] Could not load %s: %s.", filePath.c_str(), error.c_str());
+			return;
+		}
+
+		core->logLn(LogLevel::Message, "[Collision] Loaded %zu models and %zu buildings from %s in %lldms.", world.getModelCount(), world.getBuildingCount(), filePath.c_str(),
+			static_cast<long long>(duration_cast<Milliseconds>(Time::now() - start).count()));
+
+		// Global objects block like the map does.  Player objects and RemoveBuildingForPlayer are per player,
+		// which a world shared by everyone can't show, so scripts add those themselves if they want them.
+		objects = trackObjects ? components->queryComponent<IObjectsComponent>() : nullptr;
+		if (objects)
+		{
+			objects->getPoolEventDispatcher().addEventHandler(this);
+			core->getEventDispatcher().addEventHandler(this);
+		}
+	}
+
+	void onFree(IComponent* component) override
+	{
+		if (component == objects)
+		{
+			objects->getPoolEventDispatcher().removeEventHandler(this);
+			core->getEventDispatcher().removeEventHandler(this);
+			objects = nullptr;
+			trackedObjects.clear();
+		}
+	}
+
+	void onPoolEntryCreated(IObject& object) override
+	{
+		// Models without collision are never going to block anything
+		if (!world.hasModel(object.getModel()))
+		{
+			return;
+		}
+
+		TrackedObject& tracked = trackedObjects[object.getID()];
+		tracked.collisionId = INVALID_COLLISION_OBJECT_ID;
+		syncObject(object, tracked);
+	}
+
+	void onPoolEntryDestroyed(IObject& object) override
+	{
+		auto it = trackedObjects.find(object.getID());
+		if (it != trackedObjects.end())
+		{
+			world.destroyObject(it->second.collisionId);
+			trackedObjects.erase(it);
+		}
+	}
+
+	/// Objects move, get moved and get attached without telling anyone, so look for changes every tick
+	void onTick(Microseconds elapsed, TimePoint now) override
+	{
+		for (auto it = trackedObjects.begin(); it != trackedObjects.end();)
+		{
+			// Resetting the objects component can drop objects without destroying them one by one
+			IObject* object = objects->get(it->first);
+			if (object == nullptr)
+			{
+				it = trackedObjects.erase(it);
+				continue;
+			}
+			syncObject(*object, it->second);
+			++it;
+		}
+	}
+
+	void syncObject(IObject& object, TrackedObject& tracked)
+	{
+		// An attached object's position is an offset from what it's attached to, leave it out while attached
+		if (object.getAttachmentData().type != ObjectAttachmentData::Type::None)
+		{
+			if (tracked.collisionId != INVALID_COLLISION_OBJECT_ID)
+			{
+				world.destroyObject(tracked.collisionId);
+				tracked.collisionId = INVALID_COLLISION_OBJECT_ID;
+			}
+			return;
+		}
+
+		const Vector3 position = object.getPosition();
+		const GTAQuat rotation = object.getRotation();
+		if (tracked.collisionId == INVALID_COLLISION_OBJECT_ID)
+		{
+			tracked.collisionId = world.createObject(object.getModel(), position, rotation.q);
+		}
+		else if (position != tracked.position || rotation.q != tracked.rotation.q)
+		{
+			world.setObjectTransform(tracked.collisionId, position, rotation.q);
+		}
+		tracked.position = position;
+		tracked.rotation = rotation;
+	}
+
+	bool isLoaded() const override
+	{
+		return world.isLoaded();
+	}
+
+	bool rayCast(Vector3 from, Vector3 to, CollisionHit& hit) const override
+	{
+		return world.rayCast(from, to, hit);
+	}
+
+	bool hasLineOfSight(Vector3 from, Vector3 to) const override
+	{
+		CollisionHit hit;
+		return !world.rayCast(from, to, hit, true);
+	}
+
+	bool getGroundZ(Vector3 position, float& z) const override
+	{
+		CollisionHit hit;
+		if (!world.rayCast(position, Vector3(position.x, position.y, position.z - GroundSearchDepth), hit))
+		{
+			return false;
+		}
+		z = hit.position.z;
+		return true;
+	}
+
+	int removeBuilding(int modelId, Vector3 position, float radius) override
+	{
+		return world.removeBuilding(modelId, position, radius);
+	}
+
+	int createObject(int modelId, Vector3 position, GTAQuat rotation) override
+	{
+		return world.createObject(modelId, position, rotation.q);
+	}
+
+	bool setObjectTransform(int objectId, Vector3 position, GTAQuat rotation) override
+	{
+		return world.setObjectTransform(objectId, position, rotation.q);
+	}
+
+	bool destroyObject(int objectId) override
+	{
+		return world.destroyObject(objectId);
+	}
+
+	void free() override
+	{
+		delete this;
+	}
+
+	void reset() override
+	{
+		// Removed buildings and script objects belong to the script that's going away.
+		world.reset();
+		// Objects that outlive the reset are put back on the next tick
+		for (auto& entry : trackedObjects)
+		{
+			entry.second.collisionId = INVALID_COLLISION_OBJECT_ID;
+		}
+	}
+
+	~CollisionComponent()
+	{
+		if (objects)
+		{
+			objects->getPoolEventDispatcher().removeEventHandler(this);
+			core->getEventDispatcher().removeEventHandler(this);
+		}
+	}
+};
+
+COMPONENT_ENTRY_POINT()
+{
+	return new CollisionComponent();
+}
@@ -0,0 +1,679 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include "collision_world.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+CollisionRay::CollisionRay(const Vector3& origin, const Vector3& direction, float length)
+	: origin(origin)
+	, direction(direction)
+	, length(length)
+{
+	for (int i = 0; i != 3; ++i)
+	{
+		// Keep the slab test free of 0 * inf for rays parallel to an axis
+		inverseDirection[i] = std::abs(direction[i]) > 1e-12f ? 1.0f / direction[i] : std::copysign(1e30f, direction[i]);
+	}
+}
+
+bool CollisionRay::intersects(const Vector3& min, const Vector3& max, float maxT) const
+{
+	const Vector3 t0 = (min - origin) * inverseDirection;
+	const Vector3 t1 = (max - origin) * inverseDirection;
+	const Vector3 tNear = glm::min(t0, t1);
+	const Vector3 tFar = glm::max(t0, t1);
+	const float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+	const float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxT));
+	return enter <= exit;
+}
+
+void CollisionBVH::build(const DynamicArray<CollisionBounds>& bounds)
+{
+	clear();
+
+	DynamicArray<Vector3> centres(bounds.size());
+	indices_.reserve(bounds.size());
+	for (uint32_t i = 0; i != bounds.size(); ++i)
+	{
+		if (bounds[i].min.x <= bounds[i].max.x)
+		{
+			centres[i] = bounds[i].centre();
+			indices_.push_back(i);
+		}
+	}
+
+	if (indices_.empty())
+	{
+		return;
+	}
+
+	nodes_.reserve(indices_.size() / MaxLeafSize * 2 + 1);
+	buildNode(bounds, centres, 0, uint32_t(indices_.size()), 0);
+}
+
+uint32_t CollisionBVH::buildNode(const DynamicArray<CollisionBounds>& bounds, const DynamicArray<Vector3>& centres, uint32_t begin, uint32_t end, int depth)
+{
+	const uint32_t index = uint32_t(nodes_.size());
+	nodes_.emplace_back();
+
+	CollisionBounds box, centreBox;
+	for (uint32_t i = begin; i != end; ++i)
+	{
+		box.extend(bounds[indices_[i]]);
+		centreBox.extend(centres[indices_[i]]);
+	}
+
+	const Vector3 extent = centreBox.max - centreBox.min;
+	const int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+	const uint32_t count = end - begin;
+
+	// The traversal stack is 64 deep, median splits never get close to that
+	if (count <= MaxLeafSize || depth >= 48 || extent[axis] <= 0.0f)
+	{
+		nodes_[index] = { box.min, begin, box.max, count };
+		return index;
+	}
+
+	const uint32_t middle = begin + count / 2;
+	std::nth_element(indices_.begin() + begin, indices_.begin() + middle, indices_.begin() + end, [&centres, axis](uint32_t a, uint32_t b)
+		{
+			return centres[a][axis] < centres[b][axis];
+		});
+
+	buildNode(bounds, centres, begin, middle, depth + 1);
+	const uint32_t second = buildNode(bounds, centres, middle, end, depth + 1);
+	nodes_[index] = { box.min, second, box.max, 0 };
+	return index;
+}
+
+namespace
+{
+struct FileReader
+{
+	const uint8_t* cursor;
+	const uint8_t* end;
+
+	size_t remaining() const
+	{
+		return size_t(end - cursor);
+	}
+
+	bool read(void* out, size_t bytes)
+	{
+		if (remaining() < bytes)
+		{
+			return false;
+		}
+		std::memcpy(out, cursor, bytes);
+		cursor += bytes;
+		return true;
+	}
+
+	template <typename T>
+	bool read(T& out)
+	{
+		return read(&out, sizeof(T));
+	}
+};
+}
+
+bool CollisionWorld::load(const String& path, String& error)
+{
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file)
+	{
+		error = "could not open the file";
+		return false;
+	}
+
+	const std::streamsize size = file.tellg();
+	file.seekg(0);
+	DynamicArray<uint8_t> data(size > 0 ? size_t(size) : 0);
+	if (data.empty() || !file.read(reinterpret_cast<char*>(data.data()), size))
+	{
+		error = "could not read the file";
+		return false;
+	}
+
+	return parse(data.data(), data.size(), error);
+}
+
+/// Validate a model's triangles and build its bounds and tree
+static bool buildModel(CollisionModel& model, String& error)
+{
+	for (const Vector3& vertex : model.vertices)
+	{
+		model.bounds.extend(vertex);
+	}
+
+	const size_t triangleCount = model.triangles.size() / 3;
+	DynamicArray<CollisionBounds> triangleBounds(triangleCount);
+	for (size_t t = 0; t != triangleCount; ++t)
+	{
+		for (int v = 0; v != 3; ++v)
+		{
+			const uint32_t vertex = model.triangles[t * 3 + v];
+			if (vertex >= model.vertices.size())
+			{
+				error = "model " + std::to_string(model.modelId) + " has a triangle outside its vertices";
+				return false;
+			}
+			triangleBounds[t].extend(model.vertices[vertex]);
+		}
+	}
+	model.bvh.build(triangleBounds);
+	return true;
+}
+
+static void addTriangle(CollisionModel& model, const Vector3& a, const Vector3& b, const Vector3& c)
+{
+	const uint32_t first = uint32_t(model.vertices.size());
+	model.vertices.push_back(a);
+	model.vertices.push_back(b);
+	model.vertices.push_back(c);
+	model.triangles.push_back(first);
+	model.triangles.push_back(first + 1);
+	model.triangles.push_back(first + 2);
+}
+
+static void addBox(CollisionModel& model, const Vector3& centre, const Vector3& halfSize)
+{
+	const uint32_t first = uint32_t(model.vertices.size());
+	for (int corner = 0; corner != 8; ++corner)
+	{
+		model.vertices.emplace_back(
+			centre.x + (corner & 1 ? halfSize.x : -halfSize.x),
+			centre.y + (corner & 2 ? halfSize.y : -halfSize.y),
+			centre.z + (corner & 4 ? halfSize.z : -halfSize.z));
+	}
+
+	// Two triangles per side, corners numbered by the bits above
+	static const uint32_t sides[12][3] = {
+		{ 0, 2, 1 }, { 1, 2, 3 }, { 4, 5, 6 }, { 5, 7, 6 },
+		{ 0, 1, 4 }, { 1, 5, 4 }, { 2, 6, 3 }, { 3, 6, 7 },
+		{ 0, 4, 2 }, { 2, 4, 6 }, { 1, 3, 5 }, { 3, 7, 5 },
+	};
+	for (const auto& side : sides)
+	{
+		model.triangles.push_back(first + side[0]);
+		model.triangles.push_back(first + side[1]);
+		model.triangles.push_back(first + side[2]);
+	}
+}
+
+/// An octahedron split once, 32 triangles is plenty for the small spheres collision files use
+static void addSphere(CollisionModel& model, const Vector3& centre, float radius)
+{
+	static const Vector3 points[6] = {
+		Vector3(1.0f, 0.0f, 0.0f), Vector3(-1.0f, 0.0f, 0.0f),
+		Vector3(0.0f, 1.0f, 0.0f), Vector3(0.0f, -1.0f, 0.0f),
+		Vector3(0.0f, 0.0f, 1.0f), Vector3(0.0f, 0.0f, -1.0f),
+	};
+	static const int faces[8][3] = {
+		{ 0, 2, 4 }, { 2, 1, 4 }, { 1, 3, 4 }, { 3, 0, 4 },
+		{ 2, 0, 5 }, { 1, 2, 5 }, { 3, 1, 5 }, { 0, 3, 5 },
+	};
+
+	for (const auto& face : faces)
+	{
+		const Vector3& a = points[face[0]];
+		const Vector3& b = points[face[1]];
+		const Vector3& c = points[face[2]];
+		const Vector3 ab = glm::normalize(a + b);
+		const Vector3 bc = glm::normalize(b + c);
+		const Vector3 ca = glm::normalize(c + a);
+		addTriangle(model, centre + a * radius, centre + ab * radius, centre + ca * radius);
+		addTriangle(model, centre + ab * radius, centre + b * radius, centre + bc * radius);
+		addTriangle(model, centre + ca * radius, centre + bc * radius, centre + c * radius);
+		addTriangle(model, centre + ab * radius, centre + bc * radius, centre + ca * radius);
+	}
+}
+
+static bool parseNative(FileReader& reader, DynamicArray<CollisionModel>& models, DynamicArray<CollisionPlacement>& placements, String& error)
+{
+	uint32_t version, modelCount, instanceCount;
+	if (!reader.read(version) || version != CollisionWorld::FileVersion)
+	{
+		error = "unsupported version, expected " + std::to_string(CollisionWorld::FileVersion);
+		return false;
+	}
+	if (!reader.read(modelCount) || !reader.read(instanceCount) || modelCount > reader.remaining() / 12)
+	{
+		error = "truncated header";
+		return false;
+	}
+
+	models.resize(modelCount);
+	for (uint32_t i = 0; i != modelCount; ++i)
+	{
+		CollisionModel& model = models[i];
+		uint32_t vertexCount, triangleCount;
+		if (!reader.read(model.modelId) || !reader.read(vertexCount) || !reader.read(triangleCount)
+			|| uint64_t(vertexCount) * sizeof(Vector3) + uint64_t(triangleCount) * 3 * sizeof(uint32_t) > reader.remaining())
+		{
+			error = "truncated model " + std::to_string(i);
+			return false;
+		}
+
+		model.vertices.resize(vertexCount);
+		model.triangles.resize(size_t(triangleCount) * 3);
+		reader.read(model.vertices.data(), model.vertices.size() * sizeof(Vector3));
+		reader.read(model.triangles.data(), model.triangles.size() * sizeof(uint32_t));
+	}
+
+	if (instanceCount > reader.remaining() / (sizeof(int32_t) + 7 * sizeof(float)))
+	{
+		error = "truncated building list";
+		return false;
+	}
+
+	placements.resize(instanceCount);
+	for (CollisionPlacement& placement : placements)
+	{
+		int32_t modelId;
+		float position[3], rotation[4];
+		reader.read(modelId);
+		reader.read(position);
+		reader.read(rotation);
+		placement = { modelId, Vector3(position[0], position[1], position[2]), glm::quat(rotation[0], rotation[1], rotation[2], rotation[3]) };
+	}
+	return true;
+}
+
+static bool parseColAndreas(FileReader& reader, DynamicArray<CollisionModel>& models, DynamicArray<CollisionPlacement>& placements, String& error)
+{
+	uint16_t version, modelCount;
+	uint32_t instanceCount;
+	if (!reader.read(version) || !reader.read(modelCount) || !reader.read(instanceCount))
+	{
+		error = "truncated header";
+		return false;
+	}
+
+	models.resize(modelCount);
+	for (uint32_t i = 0; i != modelCount; ++i)
+	{
+		CollisionModel& model = models[i];
+		uint16_t modelId, sphereCount, boxCount, faceCount;
+		if (!reader.read(modelId) || !reader.read(sphereCount) || !reader.read(boxCount) || !reader.read(faceCount)
+			|| (sphereCount * 4u + boxCount * 6u + faceCount * 9u) * sizeof(float) > reader.remaining())
+		{
+			error = "truncated model " + std::to_string(i);
+			return false;
+		}
+
+		model.modelId = modelId;
+		model.vertices.reserve(sphereCount * 96u + boxCount * 8u + faceCount * 3u);
+		model.triangles.reserve((sphereCount * 32u + boxCount * 12u + faceCount) * 3u);
+		for (uint16_t sphere = 0; sphere != sphereCount; ++sphere)
+		{
+			float values[4];
+			reader.read(values);
+			addSphere(model, Vector3(values[0], values[1], values[2]), values[3]);
+		}
+		for (uint16_t box = 0; box != boxCount; ++box)
+		{
+			float values[6];
+			reader.read(values);
+			addBox(model, Vector3(values[0], values[1], values[2]), Vector3(values[3], values[4], values[5]));
+		}
+		for (uint16_t face = 0; face != faceCount; ++face)
+		{
+			float values[9];
+			reader.read(values);
+			addTriangle(model, Vector3(values[0], values[1], values[2]), Vector3(values[3], values[4], values[5]), Vector3(values[6], values[7], values[8]));
+		}
+	}
+
+	if (instanceCount > reader.remaining() / (sizeof(uint16_t) + 7 * sizeof(float)))
+	{
+		error = "truncated building list";
+		return false;
+	}
+
+	placements.resize(instanceCount);
+	for (CollisionPlacement& placement : placements)
+	{
+		uint16_t modelId;
+		float position[3], rotation[4];
+		reader.read(modelId);
+		reader.read(position);
+		reader.read(rotation);
+		placement = { modelId, Vector3(position[0], position[1], position[2]), glm::quat(rotation[3], rotation[0], rotation[1], rotation[2]) };
+	}
+	return true;
+}
+
+bool CollisionWorld::parse(const uint8_t* data, size_t size, String& error)
+{
+	FileReader reader { data, data + size };
+
+	char magic[4];
+	DynamicArray<CollisionModel> models;
+	DynamicArray<CollisionPlacement> placements;
+	if (!reader.read(magic))
+	{
+		error = "not a collision file";
+		return false;
+	}
+	else if (std::memcmp(magic, "OMPC", 4) == 0)
+	{
+		if (!parseNative(reader, models, placements, error))
+		{
+			return false;
+		}
+	}
+	else if (std::memcmp(magic, "CADB", 4) == 0)
+	{
+		if (!parseColAndreas(reader, models, placements, error))
+		{
+			return false;
+		}
+	}
+	else
+	{
+		error = "not a collision file";
+		return false;
+	}
+
+	FlatHashMap<int, uint32_t> lookup;
+	for (uint32_t i = 0; i != models.size(); ++i)
+	{
+		if (!lookup.emplace(models[i].modelId, i).second)
+		{
+			error = "model " + std::to_string(models[i].modelId) + " is defined twice";
+			return false;
+		}
+		if (!buildModel(models[i], error))
+		{
+			return false;
+		}
+	}
+
+	std::unique_lock<std::shared_mutex> lock(mutex_);
+	models_ = std::move(models);
+	modelLookup_ = std::move(lookup);
+
+	DynamicArray<CollisionInstance> buildings;
+	buildings.reserve(placements.size());
+	for (CollisionPlacement& placement : placements)
+	{
+		auto model = modelLookup_.find(placement.modelId);
+		if (model == modelLookup_.end())
+		{
+			continue;
+		}
+
+		if (glm::dot(placement.rotation, placement.rotation) < 1e-6f)
+		{
+			placement.rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+		}
+
+		place(buildings.emplace_back(), model->second, placement.position, placement.rotation);
+	}
+
+	buildings_ = std::move(buildings);
+	buildInstanceBVH(buildingBVH_, buildings_);
+
+	objects_.clear();
+	freeObjectIds_.clear();
+	objectBVH_.clear();
+	objectsDirty_ = false;
+	return true;
+}
+
+void CollisionWorld::place(CollisionInstance& instance, uint32_t model, const Vector3& position, const glm::quat& rotation) const
+{
+	instance.model = model;
+	instance.position = position;
+	instance.rotation = glm::normalize(rotation);
+	instance.inverseRotation = glm::conjugate(instance.rotation);
+	instance.active = true;
+
+	// World bounds are the bounds of the rotated corners of the model's box
+	const CollisionBounds& local = models_[model].bounds;
+	instance.bounds = CollisionBounds();
+	for (int corner = 0; corner != 8; ++corner)
+	{
+		const Vector3 point(
+			corner & 1 ? local.max.x : local.min.x,
+			corner & 2 ? local.max.y : local.min.y,
+			corner & 4 ? local.max.z : local.min.z);
+		instance.bounds.extend(position + instance.rotation * point);
+	}
+}
+
+void CollisionWorld::buildInstanceBVH(CollisionBVH& bvh, const DynamicArray<CollisionInstance>& instances) const
+{
+	DynamicArray<CollisionBounds> bounds(instances.size());
+	for (size_t i = 0; i != instances.size(); ++i)
+	{
+		if (instances[i].active)
+		{
+			bounds[i] = instances[i].bounds;
+		}
+	}
+	bvh.build(bounds);
+}
+
+bool CollisionWorld::rayCast(const Vector3& from, const Vector3& to, CollisionHit& hit, bool anyHit) const
+{
+	const Vector3 delta = to - from;
+	const float length = glm::length(delta);
+	if (length <= 0.0f)
+	{
+		return false;
+	}
+
+	std::shared_lock<std::shared_mutex> lock(mutex_);
+	if (models_.empty())
+	{
+		return false;
+	}
+
+	if (objectsDirty_)
+	{
+		// Trade up to the exclusive lock for the rebuild, another query may have done it meanwhile
+		lock.unlock();
+		{
+			std::unique_lock<std::shared_mutex> rebuildLock(mutex_);
+			if (objectsDirty_)
+			{
+				buildInstanceBVH(objectBVH_, objects_);
+				objectsDirty_ = false;
+			}
+		}
+		lock.lock();
+	}
+
+	const CollisionRay ray(from, delta / length, length);
+	float maxT = length;
+	bool found = rayCastInstances(buildingBVH_, buildings_, ray, maxT, hit, anyHit);
+	if (!found || !anyHit)
+	{
+		found |= rayCastInstances(objectBVH_, objects_, ray, maxT, hit, anyHit);
+	}
+
+	if (found)
+	{
+		hit.distance = maxT;
+		hit.position = from + ray.direction * maxT;
+	}
+	return found;
+}
+
+bool CollisionWorld::rayCastInstances(const CollisionBVH& bvh, const DynamicArray<CollisionInstance>& instances, const CollisionRay& ray, float& maxT, CollisionHit& hit, bool anyHit) const
+{
+	bool found = false;
+	bvh.traverse(ray, maxT, [&](uint32_t index, float& limit)
+		{
+			const CollisionInstance& instance = instances[index];
+			if (!instance.active)
+			{
+				return false;
+			}
+
+			// Rotations keep lengths, so t means the same thing in model space
+			const CollisionModel& model = models_[instance.model];
+			const CollisionRay local(instance.inverseRotation * (ray.origin - instance.position), instance.inverseRotation * ray.direction, ray.length);
+			Vector3 normal;
+			if (!rayCastModel(model, local, limit, normal, anyHit))
+			{
+				return false;
+			}
+
+			found = true;
+			hit.modelId = model.modelId;
+			hit.normal = instance.rotation * normal;
+			return anyHit;
+		});
+	return found;
+}
+
+bool CollisionWorld::rayCastModel(const CollisionModel& model, const CollisionRay& ray, float& maxT, Vector3& normal, bool anyHit) const
+{
+	bool found = false;
+	model.bvh.traverse(ray, maxT, [&](uint32_t triangle, float& limit)
+		{
+			// Möller-Trumbore, both faces count
+			const uint32_t* indices = &model.triangles[triangle * 3];
+			const Vector3& a = model.vertices[indices[0]];
+			const Vector3 edge1 = model.vertices[indices[1]] - a;
+			const Vector3 edge2 = model.vertices[indices[2]] - a;
+
+			const Vector3 p = glm::cross(ray.direction, edge2);
+			const float det = glm::dot(edge1, p);
+			if (std::abs(det) < 1e-8f)
+			{
+				return false;
+			}
+
+			const float inverseDet = 1.0f / det;
+			const Vector3 s = ray.origin - a;
+			const float u = glm::dot(s, p) * inverseDet;
+			if (u < 0.0f || u > 1.0f)
+			{
+				return false;
+			}
+
+			const Vector3 q = glm::cross(s, edge1);
+			const float v = glm::dot(ray.direction, q) * inverseDet;
+			if (v < 0.0f || u + v > 1.0f)
+			{
+				return false;
+			}
+
+			const float t = glm::dot(edge2, q) * inverseDet;
+			if (t < 0.0f || t > limit)
+			{
+				return false;
+			}
+
+			limit = t;
+			normal = glm::normalize(glm::cross(edge1, edge2));
+			if (glm::dot(normal, ray.direction) > 0.0f)
+			{
+				normal = -normal;
+			}
+			found = true;
+			return anyHit;
+		});
+	return found;
+}
+
+int CollisionWorld::removeBuilding(int modelId, const Vector3& position, float radius)
+{
+	std::unique_lock<std::shared_mutex> lock(mutex_);
+	int removed = 0;
+	const float radiusSq = radius * radius;
+	for (CollisionInstance& building : buildings_)
+	{
+		if (!building.active || (modelId != -1 && models_[building.model].modelId != modelId))
+		{
+			continue;
+		}
+
+		const Vector3 diff = building.position - position;
+		if (glm::dot(diff, diff) <= radiusSq)
+		{
+			// The tree keeps the box, the traversal just skips it
+			building.active = false;
+			++removed;
+		}
+	}
+	return removed;
+}
+
+int CollisionWorld::createObject(int modelId, const Vector3& position, const glm::quat& rotation)
+{
+	std::unique_lock<std::shared_mutex> lock(mutex_);
+	auto model = modelLookup_.find(modelId);
+	if (model == modelLookup_.end())
+	{
+		return INVALID_COLLISION_OBJECT_ID;
+	}
+
+	int objectId;
+	if (freeObjectIds_.empty())
+	{
+		objectId = int(objects_.size());
+		objects_.emplace_back();
+	}
+	else
+	{
+		objectId = freeObjectIds_.back();
+		freeObjectIds_.pop_back();
+	}
+
+	place(objects_[objectId], model->second, position, rotation);
+	objectsDirty_ = true;
+	return objectId;
+}
+
+bool CollisionWorld::setObjectTransform(int objectId, const Vector3& position, const glm::quat& rotation)
+{
+	std::unique_lock<std::shared_mutex> lock(mutex_);
+	if (objectId < 0 || objectId >= int(objects_.size()) || !objects_[objectId].active)
+	{
+		return false;
+	}
+
+	place(objects_[objectId], objects_[objectId].model, position, rotation);
+	objectsDirty_ = true;
+	return true;
+}
+
+bool CollisionWorld::destroyObject(int objectId)
+{
+	std::unique_lock<std::shared_mutex> lock(mutex_);
+	if (objectId < 0 || objectId >= int(objects_.size()) || !objects_[objectId].active)
+	{
+		return false;
+	}
+
+	objects_[objectId].active = false;
+	freeObjectIds_.push_back(objectId);
+	objectsDirty_ = true;
+	return true;
+}
+
+void CollisionWorld::reset()
+{
+	std::unique_lock<std::shared_mutex> lock(mutex_);
+	for (CollisionInstance& building : buildings_)
+	{
+		building.active = true;
+	}
+
+	objects_.clear();
+	freeObjectIds_.clear();
+	objectBVH_.clear();
+	objectsDirty_ = false;
+}
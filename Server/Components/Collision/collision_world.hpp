@@ -0,0 +1,243 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <collision.hpp>
+#include <shared_mutex>
+
+using namespace Impl;
+
+/// Axis aligned bounding box
+struct CollisionBounds
+{
+	Vector3 min = Vector3(std::numeric_limits<float>::max());
+	Vector3 max = Vector3(std::numeric_limits<float>::lowest());
+
+	void extend(const Vector3& point)
+	{
+		min = glm::min(min, point);
+		max = glm::max(max, point);
+	}
+
+	void extend(const CollisionBounds& other)
+	{
+		min = glm::min(min, other.min);
+		max = glm::max(max, other.max);
+	}
+
+	Vector3 centre() const
+	{
+		return (min + max) * 0.5f;
+	}
+};
+
+/// A segment with its direction normalised, `length` is the largest t that's still on it
+struct CollisionRay
+{
+	Vector3 origin;
+	Vector3 direction;
+	Vector3 inverseDirection;
+	float length;
+
+	CollisionRay(const Vector3& origin, const Vector3& direction, float length);
+
+	/// Slab test, returns false if the box isn't touched before maxT
+	bool intersects(const Vector3& min, const Vector3& max, float maxT) const;
+};
+
+/// Flattened bounding volume hierarchy over a set of boxes.  Inner nodes keep their first child
+/// right after themselves and the second one at `offset`, leaves point at a run of `indices`.
+class CollisionBVH
+{
+public:
+	struct Node
+	{
+		Vector3 min;
+		uint32_t offset;
+		Vector3 max;
+		uint32_t count; ///< 0 for inner nodes
+	};
+
+	/// Boxes that are empty (min above max) are left out of the tree
+	void build(const DynamicArray<CollisionBounds>& bounds);
+
+	void clear()
+	{
+		nodes_.clear();
+		indices_.clear();
+	}
+
+	bool empty() const
+	{
+		return nodes_.empty();
+	}
+
+	/// Call visit(index, maxT) for every leaf box the ray reaches.  visit may shorten maxT once it
+	/// finds a hit, and returns true to stop the search altogether.
+	template <typename Visitor>
+	void traverse(const CollisionRay& ray, float& maxT, Visitor&& visit) const
+	{
+		if (nodes_.empty())
+		{
+			return;
+		}
+
+		uint32_t stack[64];
+		int top = 0;
+		stack[top++] = 0;
+
+		while (top > 0)
+		{
+			const Node& node = nodes_[stack[--top]];
+			if (!ray.intersects(node.min, node.max, maxT))
+			{
+				continue;
+			}
+
+			if (node.count)
+			{
+				for (uint32_t i = node.offset, end = node.offset + node.count; i != end; ++i)
+				{
+					if (visit(indices_[i], maxT))
+					{
+						return;
+					}
+				}
+			}
+			else
+			{
+				const uint32_t first = uint32_t(&node - nodes_.data()) + 1;
+				stack[top++] = node.offset;
+				stack[top++] = first;
+			}
+		}
+	}
+
+private:
+	static constexpr uint32_t MaxLeafSize = 4;
+
+	uint32_t buildNode(const DynamicArray<CollisionBounds>& bounds, const DynamicArray<Vector3>& centres, uint32_t begin, uint32_t end, int depth);
+
+	DynamicArray<Node> nodes_;
+	DynamicArray<uint32_t> indices_;
+};
+
+/// The triangles of one model in model space
+struct CollisionModel
+{
+	int modelId;
+	DynamicArray<Vector3> vertices;
+	DynamicArray<uint32_t> triangles; ///< Three vertex indices per triangle
+	CollisionBounds bounds;
+	CollisionBVH bvh;
+};
+
+/// A placed copy of a model
+struct CollisionInstance
+{
+	uint32_t model; ///< Index into the model list
+	Vector3 position;
+	glm::quat rotation;
+	glm::quat inverseRotation;
+	CollisionBounds bounds; ///< In world space
+	bool active;
+};
+
+/// A building as the file places it
+struct CollisionPlacement
+{
+	int modelId;
+	Vector3 position;
+	glm::quat rotation;
+};
+
+/// Everything the collision component knows about the world.
+///
+/// Two little endian file formats are read.  The native one:
+///   char magic[4] = "OMPC", uint32 version, uint32 model count, uint32 instance count
+///   per model:    int32 model ID, uint32 vertex count, uint32 triangle count,
+///                 float[3] per vertex, uint32[3] per triangle
+///   per instance: int32 model ID, float[3] position, float[4] rotation as w, x, y, z
+///
+/// And the ColAndreas database, so an existing ColAndreas.cadb can be used as it is:
+///   char magic[4] = "CADB", uint16 version, uint16 model count, uint32 instance count
+///   per model:    uint16 model ID, uint16 sphere count, uint16 box count, uint16 face count,
+///                 float[3] centre + float radius per sphere, float[3] centre + float[3] half size per box,
+///                 float[3] * 3 per face
+///   per instance: uint16 model ID, float[3] position, float[4] rotation as x, y, z, w
+/// Its spheres and boxes are turned in to triangles while loading.
+///
+/// Queries may come from any thread.  They share a lock that changes to the world take exclusively.
+class CollisionWorld
+{
+public:
+	static constexpr uint32_t FileVersion = 1;
+
+	/// Replace the world with the contents of a file, returns false and leaves it untouched if the file is malformed
+	bool load(const String& path, String& error);
+
+	bool isLoaded() const
+	{
+		std::shared_lock<std::shared_mutex> lock(mutex_);
+		return !models_.empty();
+	}
+
+	size_t getModelCount() const
+	{
+		std::shared_lock<std::shared_mutex> lock(mutex_);
+		return models_.size();
+	}
+
+	size_t getBuildingCount() const
+	{
+		std::shared_lock<std::shared_mutex> lock(mutex_);
+		return buildings_.size();
+	}
+
+	/// Whether a model has collision, objects of other models can't be added
+	bool hasModel(int modelId) const
+	{
+		std::shared_lock<std::shared_mutex> lock(mutex_);
+		return modelLookup_.find(modelId) != modelLookup_.end();
+	}
+
+	/// Closest hit, or any hit when anyHit is set
+	bool rayCast(const Vector3& from, const Vector3& to, CollisionHit& hit, bool anyHit = false) const;
+
+	int removeBuilding(int modelId, const Vector3& position, float radius);
+
+	int createObject(int modelId, const Vector3& position, const glm::quat& rotation);
+	bool setObjectTransform(int objectId, const Vector3& position, const glm::quat& rotation);
+	bool destroyObject(int objectId);
+
+	/// Put back removed buildings and drop every object
+	void reset();
+
+private:
+	bool parse(const uint8_t* data, size_t size, String& error);
+	void place(CollisionInstance& instance, uint32_t model, const Vector3& position, const glm::quat& rotation) const;
+	void buildInstanceBVH(CollisionBVH& bvh, const DynamicArray<CollisionInstance>& instances) const;
+	bool rayCastInstances(const CollisionBVH& bvh, const DynamicArray<CollisionInstance>& instances, const CollisionRay& ray, float& maxT, CollisionHit& hit, bool anyHit) const;
+	bool rayCastModel(const CollisionModel& model, const CollisionRay& ray, float& maxT, Vector3& normal, bool anyHit) const;
+
+	mutable std::shared_mutex mutex_;
+
+	DynamicArray<CollisionModel> models_;
+	FlatHashMap<int, uint32_t> modelLookup_;
+
+	DynamicArray<CollisionInstance> buildings_;
+	CollisionBVH buildingBVH_;
+
+	// Objects come and go, so their tree is only rebuilt on the first query after a change.  That query
+	// takes the lock exclusively for the rebuild, so other threads are never reading the tree meanwhile.
+	DynamicArray<CollisionInstance> objects_;
+	DynamicArray<int> freeObjectIds_;
+	mutable CollisionBVH objectBVH_;
+	mutable bool objectsDirty_ = false;
+};
@@ -7,6 +7,11 @@
  */
 
 #include "cmd_handler.hpp"
+#include <Server/Components/GangZones/gangzones.hpp>
+#include <Server/Components/Objects/objects.hpp>
+#include <event_profile.hpp>
+#include <memory_usage.hpp>
+#include <packet_accounting.hpp>
 
 FlatHashMap<String, CommandHandlerFuncType> ConsoleCmdHandler::Commands;
 
@@ -253,3 +258,173 @@ ADD_CONSOLE_CMD(worldtime, [](const String& params, const ConsoleCommandSenderDa
 		}
 		core->setWorldTime(Hours(time));
 	});
+
+ADD_CONSOLE_CMD(memusage, [](const String& params, const ConsoleCommandSenderData& sender, ConsoleComponent& console, ICore* core)
+	{
+		IComponentList* components = console.getComponents();
+		if (!components)
+		{
+			return;
+		}
+
+		const auto report = [&](IComponent* component)
+		{
+			IMemoryUsageExtension* usage = component ? queryExtension<IMemoryUsageExtension>(component) : nullptr;
+			if (usage)
+			{
+				const size_t kilobytes = (usage->getMemoryUsage() + 1023) / 1024;
+				console.sendMessage(sender, String(component->componentName()) + ": " + std::to_string(usage->getEntityCount()) + " entities, " + std::to_string(kilobytes) + " KB");
+			}
+		};
+
+		console.sendMessage(sender, "Entity memory usage:");
+		report(components->queryComponent<IObjectsComponent>());
+		report(components->queryComponent<IGangZonesComponent>());
+	});
+
+ADD_CONSOLE_CMD(packetstats, [](const String& params, const ConsoleCommandSenderData& sender, ConsoleComponent& console, ICore* core)
+	{
+		IPacketAccountingExtension* accounting = nullptr;
+		for (INetwork* network : core->getNetworks())
+		{
+			accounting = queryExtension<IPacketAccountingExtension>(network);
+			if (accounting)
+			{
+				break;
+			}
+		}
+
+		if (!accounting)
+		{
+			console.sendMessage(sender, "No network supports packet accounting.");
+			return;
+		}
+
+		if (params == "on" || params == "off")
+		{
+			accounting->setAccountingEnabled(params == "on");
+			console.sendMessage(sender, String("Packet accounting ") + (params == "on" ? "enabled." : "disabled."));
+			return;
+		}
+		if (params == "reset")
+		{
+			accounting->resetAccounting();
+			console.sendMessage(sender, "Packet accounting reset.");
+			return;
+		}
+
+		IPlayer* player = nullptr;
+		if (!params.empty())
+		{
+			int playerid;
+			if (sscanf(params.data(), "%d", &playerid) != 1 || !(player = core->getPlayers().get(playerid)))
+			{
+				console.sendMessage(sender, "Usage: packetstats [on|off|reset|playerid]");
+				return;
+			}
+		}
+
+		if (!accounting->isAccountingEnabled())
+		{
+			console.sendMessage(sender, "Packet accounting is disabled, enable it with \"packetstats on\".");
+		}
+
+		// The ten IDs with the most bytes in each direction, packets and RPCs ranked together.
+		static constexpr size_t Top = 10;
+		static const char* const kindNames[PacketAccountingKind_End] = { "packet", "RPC" };
+		for (int direction = 0; direction != PacketAccountingDirection_End; ++direction)
+		{
+			DynamicArray<Pair<const PacketAccountingEntry*, int>> entries;
+			for (int kind = 0; kind != PacketAccountingKind_End; ++kind)
+			{
+				for (int id = 0; id != 256; ++id)
+				{
+					const PacketAccountingEntry* entry = player
+						? accounting->getPlayerAccounting(*player, PacketAccountingKind(kind), PacketAccountingDirection(direction), uint8_t(id))
+						: &accounting->getAccounting(PacketAccountingKind(kind), PacketAccountingDirection(direction), uint8_t(id));
+					if (entry && entry->count)
+					{
+						entries.emplace_back(entry, kind * 256 + id);
+					}
+				}
+			}
+
+			const size_t shown = std::min(Top, entries.size());
+			std::partial_sort(entries.begin(), entries.begin() + shown, entries.end(),
+				[](const auto& a, const auto& b)
+				{
+					return a.first->bytes > b.first->bytes;
+				});
+
+			console.sendMessage(sender, direction == PacketAccountingDirection_Out ? "Sent:" : "Received:");
+			for (size_t i = 0; i != shown; ++i)
+			{
+				const PacketAccountingEntry* entry = entries[i].first;
+				String line = String("  ") + kindNames[entries[i].second / 256] + " " + std::to_string(entries[i].second % 256) + ": " + std::to_string(entry->count) + " messages, " + std::to_string((entry->bytes + 1023) / 1024) + " KB";
+				if (direction == PacketAccountingDirection_In)
+				{
+					line += ", handlers " + std::to_string(entry->handlerMicroseconds / entry->count) + " us avg, " + std::to_string(entry->handlerMaxMicroseconds) + " us max";
+				}
+				console.sendMessage(sender, line);
+			}
+		}
+	});
+
+ADD_CONSOLE_CMD(eventstats, [](const String& params, const ConsoleCommandSenderData& sender, ConsoleComponent& console, ICore* core)
+	{
+		IEventProfilerExtension* profiler = queryExtension<IEventProfilerExtension>(core);
+		if (!profiler)
+		{
+			console.sendMessage(sender, "Event profiling isn't supported.");
+			return;
+		}
+
+		if (params == "on" || params == "off")
+		{
+			profiler->setEventProfiling(params == "on");
+			console.sendMessage(sender, String("Event profiling ") + (params == "on" ? "enabled." : "disabled."));
+			return;
+		}
+		if (params == "reset")
+		{
+			profiler->resetEventProfile();
+			console.sendMessage(sender, "Event profiling reset.");
+			return;
+		}
+		if (!params.empty())
+		{
+			console.sendMessage(sender, "Usage: eventstats [on|off|reset]");
+			return;
+		}
+
+		if (!profiler->isEventProfiling())
+		{
+			console.sendMessage(sender, "Event profiling is disabled, enable it with \"eventstats on\".");
+		}
+
+		// The twenty handlers that have taken the most time in total.
+		static constexpr size_t Top = 20;
+		Span<const EventHandlerProfile> profile = profiler->getEventProfile();
+		DynamicArray<const EventHandlerProfile*> entries;
+		for (const EventHandlerProfile& entry : profile)
+		{
+			if (entry.calls)
+			{
+				entries.push_back(&entry);
+			}
+		}
+
+		const size_t shown = std::min(Top, entries.size());
+		std::partial_sort(entries.begin(), entries.begin() + shown, entries.end(),
+			[](const EventHandlerProfile* a, const EventHandlerProfile* b)
+			{
+				return a->nanoseconds > b->nanoseconds;
+			});
+
+		console.sendMessage(sender, "Event handlers:");
+		for (size_t i = 0; i != shown; ++i)
+		{
+			const EventHandlerProfile& entry = *entries[i];
+			console.sendMessage(sender, "  " + String(entry.event) + " " + String(entry.handler) + " (priority " + std::to_string(entry.priority) + "): " + std::to_string(entry.calls) + " calls, " + std::to_string(entry.nanoseconds / 1000) + " us total, " + std::to_string(entry.nanoseconds / entry.calls) + " ns avg, " + std::to_string(entry.maxNanoseconds / 1000) + " us max");
+		}
+	});
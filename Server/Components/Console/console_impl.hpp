@@ -60,6 +60,7 @@ private:
 	};
 
 	ICore* core = nullptr;
+	IComponentList* components = nullptr;
 	DefaultEventDispatcher<ConsoleEventHandler> eventDispatcher;
 	std::mutex cmdMutex;
 	std::atomic_bool newCmd = false;
@@ -218,6 +219,16 @@ public:
 		cinThread.detach();
 	}
 
+	void onInit(IComponentList* components) override
+	{
+		this->components = components;
+	}
+
+	IComponentList* getComponents() const
+	{
+		return components;
+	}
+
 	void onReady() override
 	{
 		// Server without a config file has rcon.password empty so we disable rcon manually too.
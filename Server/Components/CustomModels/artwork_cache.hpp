@@ -0,0 +1,226 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <sdk.hpp>
+#include <ghc/filesystem.hpp>
+#include "crc32.hpp"
+#include <atomic>
+#include <memory>
+#include <thread>
+
+using namespace Impl;
+
+/// What we know about a model file, checksummed once and optionally kept in memory to be served from there
+struct ArtworkFile
+{
+	uint32_t checksum = 0;
+	size_t size = 0;
+	ghc::filesystem::file_time_type modified;
+	std::shared_ptr<const String> contents; ///< Only set when serving from memory
+};
+
+/// Model files by name, loaded in parallel and handed to the web server threads as immutable snapshots
+class ArtworkCache
+{
+public:
+	using Contents = std::shared_ptr<const String>;
+	using Snapshot = FlatHashMap<String, Contents>;
+
+	ArtworkCache(StringView modelsPath, bool keepContents)
+		: path_(modelsPath)
+		, keepContents_(keepContents)
+	{
+	}
+
+	bool keepsContents() const
+	{
+		return keepContents_;
+	}
+
+	/// Checksum a batch of files up front, spread over all cores, so adding their models later is only a lookup
+	void prepare(const DynamicArray<String>& names)
+	{
+		FlatHashSet<String> seen;
+		DynamicArray<String> stale;
+		for (const String& name : names)
+		{
+			if (seen.insert(name).second && !isFresh(name))
+			{
+				stale.push_back(name);
+			}
+		}
+		if (stale.empty())
+		{
+			return;
+		}
+
+		DynamicArray<ArtworkFile> loaded(stale.size());
+		const size_t threadCount = std::min<size_t>(std::thread::hardware_concurrency(), stale.size());
+		if (threadCount > 1)
+		{
+			std::atomic_size_t next(0);
+			DynamicArray<std::thread> loaders;
+			loaders.reserve(threadCount);
+			for (size_t i = 0; i != threadCount; ++i)
+			{
+				loaders.emplace_back([this, &stale, &loaded, &next]()
+					{
+						for (size_t idx = next++; idx < stale.size(); idx = next++)
+						{
+							loaded[idx] = load(stale[idx]);
+						}
+					});
+			}
+			for (std::thread& loader : loaders)
+			{
+				loader.join();
+			}
+		}
+		else
+		{
+			for (size_t i = 0; i != stale.size(); ++i)
+			{
+				loaded[i] = load(stale[i]);
+			}
+		}
+
+		for (size_t i = 0; i != stale.size(); ++i)
+		{
+			store(stale[i], std::move(loaded[i]));
+		}
+		publish();
+	}
+
+	/// Get a file's checksum, only reading it if it isn't known or has changed on disk since, size is 0 if it's missing
+	ArtworkFile get(StringView name)
+	{
+		const String key(name);
+		if (!isFresh(key))
+		{
+			store(key, load(key));
+			publish();
+		}
+
+		auto itr = files_.find(key);
+		return itr == files_.end() ? ArtworkFile() : itr->second;
+	}
+
+	/// Look up the contents of a file to serve, safe to call from any thread
+	Contents find(const String& name) const
+	{
+		const std::shared_ptr<const Snapshot> snapshot = std::atomic_load(&snapshot_);
+		if (snapshot)
+		{
+			auto itr = snapshot->find(name);
+			if (itr != snapshot->end())
+			{
+				return itr->second;
+			}
+		}
+		return nullptr;
+	}
+
+private:
+	String fullPath(const String& name) const
+	{
+		return path_ + "/" + name;
+	}
+
+	bool isFresh(const String& name) const
+	{
+		auto itr = files_.find(name);
+		if (itr == files_.end())
+		{
+			return false;
+		}
+
+		std::error_code ec;
+		const ghc::filesystem::path file(fullPath(name));
+		const auto modified = ghc::filesystem::last_write_time(file, ec);
+		if (ec || modified != itr->second.modified)
+		{
+			return false;
+		}
+		const auto size = ghc::filesystem::file_size(file, ec);
+		return !ec && size == itr->second.size;
+	}
+
+	/// Runs on the loader threads, so touches nothing but the file
+	ArtworkFile load(const String& name) const
+	{
+		ArtworkFile file;
+		const String path = fullPath(name);
+
+		std::error_code ec;
+		file.modified = ghc::filesystem::last_write_time(ghc::filesystem::path(path), ec);
+
+		if (!keepContents_)
+		{
+			file.size = GetFileCRC32Checksum(path.c_str(), file.checksum);
+			return file;
+		}
+
+		FILE* f = fopen(path.c_str(), "rb");
+		if (!f)
+		{
+			return file;
+		}
+
+		String contents;
+		fseek(f, 0, SEEK_END);
+		const long length = ftell(f);
+		fseek(f, 0, SEEK_SET);
+		if (length > 0)
+		{
+			contents.resize(size_t(length));
+			contents.resize(fread(&contents[0], 1, contents.size(), f));
+		}
+		fclose(f);
+
+		file.size = contents.size();
+		file.checksum = CRC32(0, reinterpret_cast<const uint8_t*>(contents.data()), contents.size());
+		file.contents = std::make_shared<const String>(std::move(contents));
+		return file;
+	}
+
+	void store(const String& name, ArtworkFile&& file)
+	{
+		if (file.size)
+		{
+			files_[name] = std::move(file);
+		}
+		else
+		{
+			files_.erase(name);
+		}
+	}
+
+	/// Hand the web server a new snapshot, requests still sending the old contents keep them alive until they finish
+	void publish()
+	{
+		if (!keepContents_)
+		{
+			return;
+		}
+
+		auto snapshot = std::make_shared<Snapshot>();
+		snapshot->reserve(files_.size());
+		for (const auto& [name, file] : files_)
+		{
+			snapshot->emplace(name, file.contents);
+		}
+		std::atomic_store(&snapshot_, std::shared_ptr<const Snapshot>(std::move(snapshot)));
+	}
+
+	String path_;
+	bool keepContents_;
+	FlatHashMap<String, ArtworkFile> files_;
+	std::shared_ptr<const Snapshot> snapshot_;
+};
@@ -8,13 +8,13 @@
 
 #include <Impl/pool_impl.hpp>
 #include <Server/Components/CustomModels/custommodels.hpp>
+#include <join_budget.hpp>
 #include <sdk.hpp>
 #include <netcode.hpp>
 #include <httplib.h>
 #include <ghc/filesystem.hpp>
-#include "crc32.hpp"
+#include "artwork_cache.hpp"
 #include <regex>
-#include <shared_mutex>
 #include "utils.hpp"
 
 static auto rAddCharModel = std::regex(R"(AddCharModel\s*\(\s*(\d+)\s*,\s*(\d+)\s*,\s*\"(.+)\"\s*,\s*\"(.+)\"\s*\)\s*;*)");
@@ -30,9 +30,10 @@ struct ModelFile
 	uint32_t checksum;
 	size_t size;
 
-	ModelFile(StringView modelsPath, StringView fileName)
+	ModelFile(StringView fileName, const ArtworkFile& file)
 		: name(fileName)
-		, size(GetFileCRC32Checksum(String(modelsPath) + "/" + String(fileName), checksum))
+		, checksum(file.checksum)
+		, size(file.size)
 	{
 	}
 };
@@ -93,12 +94,28 @@ private:
 
 	String url = "";
 
+	/// Connections per address, only touched on the main thread
 	FlatHashMap<uint32_t, uint16_t> allowedIPs_;
-	std::shared_mutex mutex_;
+	/// What the request threads check against, replaced whenever an address is added or removed
+	std::shared_ptr<const FlatHashSet<uint32_t>> allowedSnapshot_;
+
+	const ArtworkCache* cache_;
+
+	void publishAllowedIPs()
+	{
+		auto snapshot = std::make_shared<FlatHashSet<uint32_t>>();
+		snapshot->reserve(allowedIPs_.size());
+		for (const auto& entry : allowedIPs_)
+		{
+			snapshot->insert(entry.first);
+		}
+		std::atomic_store(&allowedSnapshot_, std::shared_ptr<const FlatHashSet<uint32_t>>(std::move(snapshot)));
+	}
 
 public:
-	WebServer(ICore* core, StringView modelsPath, StringView bind, uint16_t port, StringView publicAddr, uint16_t threadsCount)
+	WebServer(ICore* core, StringView modelsPath, const ArtworkCache* cache, StringView bind, uint16_t port, StringView publicAddr, uint16_t threadsCount)
 		: port_(port)
+		, cache_(cache)
 	{
 
 		if (!bind.empty())
@@ -139,8 +156,8 @@ public:
 				if (req.sockaddr.ss_family == AF_INET)
 				{
 					auto ip = reinterpret_cast<const struct sockaddr_in*>(&req.sockaddr)->sin_addr.s_addr;
-					std::shared_lock<std::shared_mutex> lock(mutex_);
-					if (allowedIPs_.find(ip) == allowedIPs_.end())
+					const auto allowed = std::atomic_load(&allowedSnapshot_);
+					if (!allowed || allowed->find(ip) == allowed->end())
 					{
 						res.status = 401;
 						return httplib::Server::HandlerResponse::Handled;
@@ -154,7 +171,35 @@ public:
 				return httplib::Server::HandlerResponse::Unhandled;
 			});
 
-		if (svr.set_mount_point("/", modelsPath.data()))
+		bool mounted = true;
+		if (cache_)
+		{
+			// Served straight out of the cache, httplib deals with range requests itself when given the length up front.
+			svr.Get(R"(/.+)", [this](const httplib::Request& req, httplib::Response& res)
+				{
+					ArtworkCache::Contents contents = cache_->find(req.path.substr(1));
+					if (!contents)
+					{
+						res.status = 404;
+						return;
+					}
+
+					res.set_content_provider(
+						contents->size(),
+						"application/octet-stream",
+						[contents](size_t offset, size_t length, httplib::DataSink& sink)
+						{
+							sink.write(contents->data() + offset, length);
+							return true;
+						});
+				});
+		}
+		else
+		{
+			mounted = svr.set_mount_point("/", modelsPath.data());
+		}
+
+		if (mounted)
 		{
 			thread = std::thread(&WebServer::run, this);
 			thread.detach();
@@ -197,12 +242,10 @@ public:
 	void allowIPAddress(uint32_t ipAddress)
 	{
 		auto itr = allowedIPs_.find(ipAddress);
-
-		std::unique_lock lock(mutex_);
-
 		if (itr == allowedIPs_.end())
 		{
 			allowedIPs_.insert({ ipAddress, 1 });
+			publishAllowedIPs();
 		}
 		else
 		{
@@ -218,8 +261,6 @@ public:
 			return;
 		}
 
-		std::unique_lock lock(mutex_);
-
 		if (itr->second > 1)
 		{
 			--itr->second;
@@ -227,6 +268,7 @@ public:
 		else
 		{
 			allowedIPs_.erase(itr);
+			publishAllowedIPs();
 		}
 	}
 };
@@ -237,6 +279,9 @@ private:
 	IPlayer& player;
 	uint32_t skin_ = 0;
 	std::pair<ModelDownloadType, uint32_t> requestedFile_;
+	/// The model requests sent so far, and how many models there were when they started going out
+	uint32_t modelRequestsSent_ = 0;
+	uint32_t modelRequestsCount_ = 0;
 
 public:
 	PlayerCustomModelsData(IPlayer& player)
@@ -260,6 +305,27 @@ public:
 		requestedFile_ = { type, checksum };
 	}
 
+	IPlayer& getPlayer()
+	{
+		return player;
+	}
+
+	uint32_t getModelRequestsSent() const
+	{
+		return modelRequestsSent_;
+	}
+
+	uint32_t getModelRequestsCount() const
+	{
+		return modelRequestsCount_;
+	}
+
+	void setModelRequests(uint32_t sent, uint32_t count)
+	{
+		modelRequestsSent_ = sent;
+		modelRequestsCount_ = count;
+	}
+
 	virtual bool sendDownloadUrl(StringView url) const override
 	{
 		if (requestedFile_.first == ModelDownloadType::NONE)
@@ -275,6 +341,8 @@ public:
 	{
 		skin_ = 0;
 		requestedFile_ = { ModelDownloadType::NONE, 0 };
+		modelRequestsSent_ = 0;
+		modelRequestsCount_ = 0;
 	}
 
 	void freeExtension() override
@@ -283,13 +351,17 @@ public:
 	}
 };
 
-class CustomModelsComponent final : public ICustomModelsComponent, public PlayerConnectEventHandler
+class CustomModelsComponent final : public ICustomModelsComponent, public PlayerConnectEventHandler, public CoreEventHandler
 {
 private:
 	ICore* core = nullptr;
 	IPlayerPool* players = nullptr;
+	IPlayerJoinBudgetExtension* joinBudget = nullptr;
+	/// Players still being sent model requests, a join budget at a time
+	FlatPtrHashSet<PlayerCustomModelsData> joiningPlayers;
 
 	WebServer* webServer = nullptr;
+	ArtworkCache* artwork = nullptr;
 
 	std::vector<ModelInfo*> storage;
 	FlatHashMap<uint32_t, uint16_t> baseModels;
@@ -303,6 +375,7 @@ private:
 	bool usingCdn = false;
 	uint16_t httpThreads = 50; // default max_players is 50
 	bool showCRCLogs = false;
+	bool memoryCache = false;
 
 	DefaultEventDispatcher<PlayerModelsEventHandler> eventDispatcher;
 
@@ -402,11 +475,17 @@ public:
 		NetCode::RPC::RequestDFF::removeEventHandler(*core, &requestDownloadLinkHandler);
 		NetCode::RPC::FinishDownload::removeEventHandler(*core, &finishDownloadHandler);
 		players->getPlayerConnectDispatcher().removeEventHandler(this);
+		core->getEventDispatcher().removeEventHandler(this);
 
 		if (webServer)
 		{
 			delete webServer;
 		}
+
+		if (artwork)
+		{
+			delete artwork;
+		}
 	}
 
 	void provideConfiguration(ILogger& logger, IEarlyConfig& config, bool defaults) override
@@ -420,6 +499,7 @@ public:
 			config.setInt("artwork.port", modelsPort);
 			config.setString("artwork.web_server_bind", webServerBindAddress);
 			config.setBool("artwork.show_crc_logs", showCRCLogs);
+			config.setBool("artwork.memory_cache", memoryCache);
 		}
 		else
 		{
@@ -457,6 +537,12 @@ public:
 			{
 				config.setBool("artwork.show_crc_logs", showCRCLogs);
 			}
+			// Keep every model file in memory and serve it from there, trading memory for not hitting the disk
+			// on every download when the whole server reconnects at once.
+			if (config.getType("artwork.memory_cache") == ConfigOptionType_None)
+			{
+				config.setBool("artwork.memory_cache", memoryCache);
+			}
 		}
 	}
 
@@ -465,6 +551,8 @@ public:
 		this->core = core;
 		players = &core->getPlayers();
 		players->getPlayerConnectDispatcher().addEventHandler(this);
+		core->getEventDispatcher().addEventHandler(this);
+		joinBudget = queryExtension<IPlayerJoinBudgetExtension>(players);
 
 		enabled = *core->getConfig().getBool("artwork.enable");
 		modelsPath = String(trim(core->getConfig().getString("artwork.models_path")));
@@ -472,6 +560,7 @@ public:
 		httpThreads = *core->getConfig().getInt("network.http_threads");
 		webServerBindAddress = String(core->getConfig().getString("artwork.web_server_bind"));
 		showCRCLogs = *core->getConfig().getBool("artwork.show_crc_logs");
+		memoryCache = *core->getConfig().getBool("artwork.memory_cache");
 
 		NetCode::RPC::RequestTXD::addEventHandler(*core, &requestDownloadLinkHandler);
 		NetCode::RPC::RequestDFF::addEventHandler(*core, &requestDownloadLinkHandler);
@@ -493,6 +582,7 @@ public:
 			return;
 		}
 
+		artwork = new ArtworkCache(modelsPath, memoryCache);
 		loadArtConfig();
 
 		if (!cdn.empty())
@@ -519,23 +609,51 @@ public:
 		if (artconfig.is_open())
 		{
 			core->logLn(LogLevel::Message, "[artwork:info] Loading artconfig.txt");
+			struct ArtConfigEntry
+			{
+				ModelType type;
+				int32_t id;
+				int32_t baseId;
+				String dff;
+				String txd;
+				int32_t virtualWorld = -1;
+				uint8_t timeOn = 0;
+				uint8_t timeOff = 0;
+			};
+
+			DynamicArray<ArtConfigEntry> entries;
 			std::string line;
 			std::smatch match;
 			while (std::getline(artconfig, line))
 			{
 				if (std::regex_match(line, match, rAddCharModel))
 				{
-					addCustomModel(ModelType::Skin, std::atoi(match[2].str().c_str()), std::atoi(match[1].str().c_str()), match[3].str(), match[4].str());
+					entries.push_back({ ModelType::Skin, std::atoi(match[2].str().c_str()), std::atoi(match[1].str().c_str()), match[3].str(), match[4].str() });
 				}
 				else if (std::regex_match(line, match, rAddSimpleModel))
 				{
-					addCustomModel(ModelType::Object, std::atoi(match[3].str().c_str()), std::atoi(match[2].str().c_str()), match[4].str(), match[5].str(), std::atoi(match[1].str().c_str()));
+					entries.push_back({ ModelType::Object, std::atoi(match[3].str().c_str()), std::atoi(match[2].str().c_str()), match[4].str(), match[5].str(), std::atoi(match[1].str().c_str()) });
 				}
 				else if (std::regex_match(line, match, rAddSimpleModelTimed))
 				{
-					addCustomModel(ModelType::Object, std::atoi(match[3].str().c_str()), std::atoi(match[2].str().c_str()), match[4].str(), match[5].str(), std::atoi(match[1].str().c_str()), std::atoi(match[6].str().c_str()), std::atoi(match[7].str().c_str()));
+					entries.push_back({ ModelType::Object, std::atoi(match[3].str().c_str()), std::atoi(match[2].str().c_str()), match[4].str(), match[5].str(), std::atoi(match[1].str().c_str()), uint8_t(std::atoi(match[6].str().c_str())), uint8_t(std::atoi(match[7].str().c_str())) });
 				}
 			}
+
+			// Read all the files at once rather than one by one as each model is added.
+			DynamicArray<String> files;
+			files.reserve(entries.size() * 2);
+			for (const ArtConfigEntry& entry : entries)
+			{
+				files.push_back(entry.dff);
+				files.push_back(entry.txd);
+			}
+			artwork->prepare(files);
+
+			for (const ArtConfigEntry& entry : entries)
+			{
+				addCustomModel(entry.type, entry.id, entry.baseId, entry.dff, entry.txd, entry.virtualWorld, entry.timeOn, entry.timeOff);
+			}
 		}
 	}
 
@@ -560,7 +678,7 @@ public:
 			}
 		}
 
-		webServer = new WebServer(core, modelsPath, bindAddress, *core->getConfig().getInt("artwork.port"), core->getConfig().getString("network.public_addr"), httpThreads);
+		webServer = new WebServer(core, modelsPath, artwork->keepsContents() ? artwork : nullptr, bindAddress, *core->getConfig().getInt("artwork.port"), core->getConfig().getString("network.public_addr"), httpThreads);
 
 		if (webServer->is_running())
 		{
@@ -615,8 +733,8 @@ public:
 			return false;
 		}
 
-		ModelFile dff(modelsPath, dffName);
-		ModelFile txd(modelsPath, txdName);
+		ModelFile dff(dffName, artwork->get(dffName));
+		ModelFile txd(txdName, artwork->get(txdName));
 
 		if (!dff.size)
 		{
@@ -700,13 +818,40 @@ public:
 		if (player.getClientVersion() != ClientVersion::ClientVersion_SAMP_03DL)
 			return;
 
-		const auto modelsCount = storage.size();
-		for (auto i = 0; i != modelsCount; ++i)
+		PlayerCustomModelsData* data = queryExtension<PlayerCustomModelsData>(player);
+		if (data == nullptr)
+		{
+			return;
+		}
+
+		// One request per model, a join budget at a time, the rest go out in onTick.
+		data->setModelRequests(0, uint32_t(storage.size()));
+		if (!sendModelRequests(*data))
+		{
+			joiningPlayers.insert(data);
+		}
+	}
+
+	/// Send as many of the player's model requests as their join budget allows, true once they've all gone
+	bool sendModelRequests(PlayerCustomModelsData& data)
+	{
+		IPlayer& player = data.getPlayer();
+		const uint32_t modelsCount = data.getModelRequestsCount();
+		uint32_t i = data.getModelRequestsSent();
+		// Models are only ever added, so everything counted when the requests started is still there.
+		const size_t budget = joinBudget ? joinBudget->takeJoinBudget(player, modelsCount - i) : modelsCount - i;
+		for (const uint32_t end = i + uint32_t(budget); i != end; ++i)
 		{
 			NetCode::RPC::ModelRequest modelInfo(i, modelsCount);
 			storage[i]->write(modelInfo);
 			PacketHelper::send(modelInfo, player);
 		}
+		data.setModelRequests(i, modelsCount);
+
+		if (i != modelsCount)
+		{
+			return false;
+		}
 
 		// If client reconnected (lost connection to the server) let's force it to download files if there are any.
 		NetCode::RPC::SetPlayerVirtualWorld setWorld;
@@ -714,6 +859,19 @@ public:
 		PacketHelper::send(setWorld, player);
 		setWorld.worldId--;
 		PacketHelper::send(setWorld, player);
+		return true;
+	}
+
+	void onTick(Microseconds elapsed, TimePoint now) override
+	{
+		for (auto it = joiningPlayers.begin(); it != joiningPlayers.end();)
+		{
+			PlayerCustomModelsData* data = *(it++);
+			if (sendModelRequests(*data))
+			{
+				joiningPlayers.erase(data);
+			}
+		}
 	}
 
 	IEventDispatcher<PlayerModelsEventHandler>& getEventDispatcher() override
@@ -735,6 +893,11 @@ public:
 
 	void onPlayerDisconnect(IPlayer& player, PeerDisconnectReason reason) override
 	{
+		if (PlayerCustomModelsData* data = queryExtension<PlayerCustomModelsData>(player))
+		{
+			joiningPlayers.erase(data);
+		}
+
 		if (player.getClientVersion() != ClientVersion::ClientVersion_SAMP_03DL || !webServer)
 		{
 			return;
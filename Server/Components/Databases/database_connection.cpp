@@ -28,6 +28,7 @@ bool DatabaseConnection::close()
 	bool ret(databaseConnectionHandle != nullptr);
 	if (ret)
 	{
+		stopWorker();
 		sqlite3_close(databaseConnectionHandle);
 		databaseConnectionHandle = nullptr;
 	}
@@ -39,6 +40,11 @@ bool DatabaseConnection::close()
 /// @returns Result set
 IDatabaseResultSet* DatabaseConnection::executeQuery(StringView query)
 {
+	if (worker)
+	{
+		// Run after the queries queued before this one, and keep the worker off the connection meanwhile.
+		worker->flush();
+	}
 	IDatabaseResultSet* ret(parentDatabasesComponent->createResultSet());
 	if (ret)
 	{
@@ -58,6 +64,23 @@ IDatabaseResultSet* DatabaseConnection::executeQuery(StringView query)
 	return ret;
 }
 
+/// Gets the worker for asynchronous queries, starting it if needed
+/// @returns Worker, or "nullptr" if this connection has been closed
+DatabaseWorker* DatabaseConnection::getWorker()
+{
+	if (!worker && databaseConnectionHandle)
+	{
+		worker = std::make_unique<DatabaseWorker>(parentDatabasesComponent->getAsync(), databaseConnectionHandle, parentDatabasesComponent->getAsyncBatchSize());
+	}
+	return worker.get();
+}
+
+/// Runs the queued asynchronous queries and stops the worker
+void DatabaseConnection::stopWorker()
+{
+	worker.reset();
+}
+
 /// Gets invoked when a query step has been performed
 /// @param userData User data
 /// @param fieldCount Field count
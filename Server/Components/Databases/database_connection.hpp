@@ -12,7 +12,9 @@
 #include <sqlite3.h>
 
 #include "database_result_set.hpp"
+#include "database_worker.hpp"
 #include <Impl/pool_impl.hpp>
+#include <memory>
 
 using namespace Impl;
 
@@ -27,6 +29,9 @@ private:
 	/// Database connection handle
 	sqlite3* databaseConnectionHandle;
 
+	/// Worker for asynchronous queries, started by the first one
+	std::unique_ptr<DatabaseWorker> worker;
+
 public:
 	DatabaseConnection(DatabasesComponent* parentDatabasesComponent, sqlite3* databaseConnectionHandle);
 
@@ -44,6 +49,13 @@ public:
 	/// @returns Result set
 	IDatabaseResultSet* executeQuery(StringView query) override;
 
+	/// Gets the worker for asynchronous queries, starting it if needed
+	/// @returns Worker, or "nullptr" if this connection has been closed
+	DatabaseWorker* getWorker();
+
+	/// Runs the queued asynchronous queries and stops the worker
+	void stopWorker();
+
 private:
 	/// Gets invoked when a query step has been performed
 	/// @param userData User data
@@ -0,0 +1,336 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include "database_worker.hpp"
+
+#include <cctype>
+#include <cstring>
+
+/// Statements that start, end or need to be outside a transaction
+static const char* const UnbatchableStatements[] = {
+	"attach",
+	"begin",
+	"commit",
+	"detach",
+	"end",
+	"pragma",
+	"release",
+	"rollback",
+	"savepoint",
+	"vacuum",
+};
+
+void DatabaseQueryJob::addRow(int fieldCount, char const* const* rowValues, char const* const* fieldNames)
+{
+	size_t nameIndex = names.size();
+	if (!rows.empty() && rows.back().fieldCount == fieldCount)
+	{
+		// Every row of a statement has the same names, only a query with several statements changes them.
+		const size_t last = rows.back().names;
+		bool same = true;
+		for (int i = 0; i != fieldCount && same; ++i)
+		{
+			same = names[last + i] == (fieldNames[i] ? fieldNames[i] : "");
+		}
+		if (same)
+		{
+			nameIndex = last;
+		}
+	}
+	if (nameIndex == names.size())
+	{
+		for (int i = 0; i != fieldCount; ++i)
+		{
+			names.emplace_back(fieldNames[i] ? fieldNames[i] : "");
+		}
+	}
+
+	rows.push_back({ fieldCount, nameIndex, values.size() });
+	for (int i = 0; i != fieldCount; ++i)
+	{
+		values.emplace_back(rowValues[i] ? rowValues[i] : "");
+	}
+}
+
+void DatabaseQueryJob::clear()
+{
+	succeeded = false;
+	error.clear();
+	rows.clear();
+	names.clear();
+	values.clear();
+}
+
+DatabaseWorker::DatabaseWorker(DatabaseQueryCompletion& completion, sqlite3* handle, int batchSize)
+	: completion_(completion)
+	, handle_(handle)
+	, batchSize_(batchSize > 1 ? size_t(batchSize) : 1)
+{
+	thread_ = std::thread(&DatabaseWorker::loop, this);
+}
+
+DatabaseWorker::~DatabaseWorker()
+{
+	stop();
+}
+
+void DatabaseWorker::post(DatabaseQueryJob&& job)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	jobs_.emplace_back(std::move(job));
+	busy_ = true;
+	workerCV_.notify_all();
+}
+
+void DatabaseWorker::flush()
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	idleCV_.wait(lock, [this]()
+		{
+			return !busy_;
+		});
+}
+
+void DatabaseWorker::stop()
+{
+	if (thread_.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stopping_ = true;
+			workerCV_.notify_all();
+		}
+		thread_.join();
+	}
+}
+
+bool DatabaseWorker::canBatch(DatabaseQueryJob& job)
+{
+	const String& query = job.query;
+	size_t start = 0;
+	while (start != query.size() && std::isspace(static_cast<unsigned char>(query[start])))
+	{
+		++start;
+	}
+	size_t end = start;
+	while (end != query.size() && std::isalpha(static_cast<unsigned char>(query[end])))
+	{
+		++end;
+	}
+	if (end == start)
+	{
+		// Starts with a comment or something else we can't read, run it alone to be safe.
+		return false;
+	}
+
+	String keyword(query, start, end - start);
+	for (char& c : keyword)
+	{
+		c = char(std::tolower(static_cast<unsigned char>(c)));
+	}
+	for (char const* statement : UnbatchableStatements)
+	{
+		if (keyword == statement)
+		{
+			return false;
+		}
+	}
+
+	// Called on the worker's thread, which has the connection to itself.
+	sqlite3_stmt* statement = nullptr;
+	char const* tail = nullptr;
+	if (sqlite3_prepare_v2(handle_, query.c_str(), int(query.size()), &statement, &tail) != SQLITE_OK || statement == nullptr)
+	{
+		// Perhaps it uses a table a query before it creates, it can't be checked until that's run.
+		sqlite3_finalize(statement);
+		return false;
+	}
+	char const* const queryEnd = query.c_str() + query.size();
+	while (tail != queryEnd && (std::isspace(static_cast<unsigned char>(*tail)) || *tail == ';'))
+	{
+		++tail;
+	}
+	if (tail != queryEnd)
+	{
+		sqlite3_finalize(statement);
+		return false;
+	}
+	job.statement = statement;
+	return true;
+}
+
+bool DatabaseWorker::exec(char const* sql)
+{
+	return sqlite3_exec(handle_, sql, nullptr, nullptr, nullptr) == SQLITE_OK;
+}
+
+void DatabaseWorker::execute(DatabaseQueryJob& job)
+{
+	if (job.statement)
+	{
+		step(job);
+		return;
+	}
+
+	char* error = nullptr;
+	const int result = sqlite3_exec(handle_, job.query.c_str(), [](void* userData, int fieldCount, char** values, char** fieldNames)
+		{
+			reinterpret_cast<DatabaseQueryJob*>(userData)->addRow(fieldCount, values, fieldNames);
+			return SQLITE_OK;
+		},
+		&job, &error);
+	job.succeeded = result == SQLITE_OK;
+	if (error)
+	{
+		job.error = error;
+		sqlite3_free(error);
+	}
+}
+
+void DatabaseWorker::step(DatabaseQueryJob& job)
+{
+	sqlite3_stmt* statement = job.statement;
+	const int fieldCount = sqlite3_column_count(statement);
+	DynamicArray<char const*> fieldNames(fieldCount);
+	DynamicArray<char const*> values(fieldCount);
+
+	int result;
+	while ((result = sqlite3_step(statement)) == SQLITE_ROW)
+	{
+		// Names are fetched again for each row, stepping may have prepared the statement again after a schema change.
+		for (int i = 0; i != fieldCount; ++i)
+		{
+			fieldNames[i] = sqlite3_column_name(statement, i);
+			values[i] = reinterpret_cast<char const*>(sqlite3_column_text(statement, i));
+		}
+		job.addRow(fieldCount, values.data(), fieldNames.data());
+	}
+	job.succeeded = result == SQLITE_DONE;
+	if (!job.succeeded)
+	{
+		job.error = sqlite3_errmsg(handle_);
+	}
+	// Ready to run again, should the batch it's in be lost.
+	sqlite3_reset(statement);
+}
+
+bool DatabaseWorker::runBatch(DynamicArray<DatabaseQueryJob>& jobs)
+{
+	if (!exec("BEGIN"))
+	{
+		return false;
+	}
+
+	for (DatabaseQueryJob& job : jobs)
+	{
+		// Each query keeps its own all or nothing behaviour inside the shared transaction.
+		if (!exec("SAVEPOINT omp_async_query"))
+		{
+			exec("ROLLBACK");
+			return false;
+		}
+		execute(job);
+		if (sqlite3_get_autocommit(handle_))
+		{
+			// Some errors roll back the whole transaction, taking the queries before this one with them.
+			return false;
+		}
+		if (!job.succeeded)
+		{
+			exec("ROLLBACK TO omp_async_query");
+		}
+		exec("RELEASE omp_async_query");
+	}
+
+	if (!exec("COMMIT"))
+	{
+		exec("ROLLBACK");
+		return false;
+	}
+	return true;
+}
+
+void DatabaseWorker::run(DynamicArray<DatabaseQueryJob>& jobs)
+{
+	// Only batch when nobody left a transaction open, otherwise the queries are already part of theirs.
+	if (jobs.size() > 1 && sqlite3_get_autocommit(handle_) && runBatch(jobs))
+	{
+		return;
+	}
+
+	// A lost batch was rolled back as a whole.  Every query in it is one statement that can't end the transaction
+	// itself, so none of them was committed early and each can be run again on its own.
+	for (DatabaseQueryJob& job : jobs)
+	{
+		job.clear();
+		execute(job);
+	}
+}
+
+void DatabaseWorker::loop()
+{
+	DynamicArray<DatabaseQueryJob> jobs;
+	std::unique_lock<std::mutex> lock(mutex_);
+	for (;;)
+	{
+		workerCV_.wait(lock, [this]()
+			{
+				return !jobs_.empty() || stopping_;
+			});
+		if (jobs_.empty())
+		{
+			break;
+		}
+
+		// Take the candidates for a batch, and check them without the lock so posting never waits on SQLite.
+		while (jobs.size() < batchSize_ && !jobs_.empty())
+		{
+			jobs.emplace_back(std::move(jobs_.front()));
+			jobs_.pop_front();
+		}
+		lock.unlock();
+
+		// Keep every query that can share a transaction with the first, up to the first that can't.
+		size_t count = 1;
+		if (canBatch(jobs.front()))
+		{
+			while (count != jobs.size() && canBatch(jobs[count]))
+			{
+				++count;
+			}
+		}
+		if (count != jobs.size())
+		{
+			lock.lock();
+			for (size_t i = jobs.size(); i-- != count;)
+			{
+				jobs_.emplace_front(std::move(jobs[i]));
+			}
+			lock.unlock();
+			jobs.resize(count);
+		}
+
+		run(jobs);
+		for (DatabaseQueryJob& job : jobs)
+		{
+			sqlite3_finalize(job.statement);
+			job.statement = nullptr;
+		}
+		completion_.complete(jobs);
+		jobs.clear();
+		lock.lock();
+
+		if (jobs_.empty())
+		{
+			busy_ = false;
+			idleCV_.notify_all();
+		}
+	}
+	busy_ = false;
+	idleCV_.notify_all();
+}
@@ -0,0 +1,97 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <database_async.hpp>
+#include <sqlite3.h>
+#include <types.hpp>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+using namespace Impl;
+
+/// A query queued on a connection's worker, with the rows it returned.  The rows are only turned in to a result set
+/// on the main thread, the result set pool isn't safe to touch from the worker.
+struct DatabaseQueryJob
+{
+	/// A row's field names are shared with the row before it when they're the same
+	struct Row
+	{
+		int fieldCount;
+		size_t names;
+		size_t values;
+	};
+
+	String query;
+	DatabaseQueryHandler* handler = nullptr;
+	/// Kept from checking whether it can be batched, run instead of the query text when set
+	sqlite3_stmt* statement = nullptr;
+	bool succeeded = false;
+	String error;
+	DynamicArray<Row> rows;
+	DynamicArray<String> names;
+	DynamicArray<String> values;
+
+	void addRow(int fieldCount, char const* const* values, char const* const* fieldNames);
+	void clear();
+};
+
+/// Takes the queries a worker has run, called on the worker's thread
+struct DatabaseQueryCompletion
+{
+	virtual void complete(DynamicArray<DatabaseQueryJob>& jobs) = 0;
+};
+
+/// Runs the queries queued on one connection in order, on its own thread.  Queries that are waiting together are
+/// run in one transaction, so a burst of small writes costs one commit instead of one each.
+class DatabaseWorker final : public NoCopy
+{
+public:
+	DatabaseWorker(DatabaseQueryCompletion& completion, sqlite3* handle, int batchSize);
+	~DatabaseWorker();
+
+	void post(DatabaseQueryJob&& job);
+
+	/// Wait for everything queued so far to have run, after which the connection is free to use on this thread
+	void flush();
+
+	/// Run everything still queued, then stop the thread
+	void stop();
+
+private:
+	/// Whether a query can go in a transaction with others.  It can't if it manages transactions itself, or if it has
+	/// more than one statement, as the ones after the first could end the transaction.  When it can, the statement
+	/// prepared to check it is kept on the job.
+	bool canBatch(DatabaseQueryJob& job);
+
+	bool exec(char const* sql);
+	void execute(DatabaseQueryJob& job);
+
+	/// Run a job's prepared statement, leaving it reset to run again
+	void step(DatabaseQueryJob& job);
+
+	/// Run jobs in one transaction, false if the transaction was lost and nothing they did was kept
+	bool runBatch(DynamicArray<DatabaseQueryJob>& jobs);
+	void run(DynamicArray<DatabaseQueryJob>& jobs);
+	void loop();
+
+	DatabaseQueryCompletion& completion_;
+	sqlite3* handle_;
+	size_t batchSize_;
+
+	std::thread thread_;
+	std::mutex mutex_;
+	std::condition_variable workerCV_;
+	std::condition_variable idleCV_;
+	std::deque<DatabaseQueryJob> jobs_;
+	bool busy_ = false;
+	bool stopping_ = false;
+};
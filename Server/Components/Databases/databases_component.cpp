@@ -8,10 +8,119 @@
 
 #include "databases_component.hpp"
 
+DatabaseAsync::DatabaseAsync(DatabasesComponent& parentDatabasesComponent)
+	: parentDatabasesComponent(parentDatabasesComponent)
+{
+}
+
+/// Queues a query on the connection's worker
+/// @param connection Database connection
+/// @param query Query to execute
+/// @param handler Handler to call with the result set
+/// @returns "true" if the query has been queued, otherwise "false"
+bool DatabaseAsync::executeQueryAsync(IDatabaseConnection& connection, StringView query, DatabaseQueryHandler* handler)
+{
+	if (!handler)
+	{
+		return false;
+	}
+	DatabaseWorker* worker(static_cast<DatabaseConnection&>(connection).getWorker());
+	if (!worker)
+	{
+		return false;
+	}
+	parentDatabasesComponent.logQuery("[log_sqlite_queries]: %.*s", PRINT_VIEW(query));
+	DatabaseQueryJob job;
+	job.query = String(query);
+	job.handler = handler;
+	++pending;
+	worker->post(std::move(job));
+	return true;
+}
+
+/// Gets the number of queries whose handlers haven't been called yet
+/// @returns Number of pending queries
+size_t DatabaseAsync::getPendingQueryCount() const
+{
+	return pending;
+}
+
+/// Hands over queries a worker has run, called from the worker
+/// @param jobs Queries that have been run
+void DatabaseAsync::complete(DynamicArray<DatabaseQueryJob>& jobs)
+{
+	std::scoped_lock<std::mutex> lock(completedMutex);
+	for (DatabaseQueryJob& job : jobs)
+	{
+		completed.emplace_back(std::move(job));
+	}
+}
+
+/// Calls the handlers of the queries run since the last time
+void DatabaseAsync::processCompleted()
+{
+	if (pending == 0)
+	{
+		return;
+	}
+	DynamicArray<DatabaseQueryJob> jobs;
+	{
+		std::scoped_lock<std::mutex> lock(completedMutex);
+		jobs.swap(completed);
+	}
+
+	// Handlers run without the lock, they're free to queue more queries.
+	DynamicArray<char*> names;
+	DynamicArray<char*> values;
+	for (DatabaseQueryJob& job : jobs)
+	{
+		--pending;
+		DatabaseResultSet* resultSet(nullptr);
+		if (!job.succeeded)
+		{
+			parentDatabasesComponent.log(LogLevel::Error, "[log_sqlite]: Error executing query: %s", job.error.c_str());
+		}
+		else if ((resultSet = static_cast<DatabaseResultSet*>(parentDatabasesComponent.createResultSet())))
+		{
+			for (const DatabaseQueryJob::Row& row : job.rows)
+			{
+				names.clear();
+				values.clear();
+				for (int field_index(0); field_index < row.fieldCount; field_index++)
+				{
+					names.push_back(job.names[row.names + field_index].data());
+					values.push_back(job.values[row.values + field_index].data());
+				}
+				resultSet->addRow(row.fieldCount, names.data(), values.data());
+			}
+		}
+		else
+		{
+			parentDatabasesComponent.log(LogLevel::Error, "[log_sqlite]: Could not create SQLite result set.");
+		}
+		job.handler->onQueryExecuted(resultSet);
+	}
+}
+
 DatabasesComponent::DatabasesComponent()
+	: async_(*this)
 {
 }
 
+DatabasesComponent::~DatabasesComponent()
+{
+	// Let the workers finish before anything they hand results to goes away, then give the handlers what they ran.
+	for (IDatabaseConnection* connection : databaseConnections)
+	{
+		static_cast<DatabaseConnection*>(connection)->stopWorker();
+	}
+	async_.processCompleted();
+	if (core_)
+	{
+		core_->getEventDispatcher().removeEventHandler(this);
+	}
+}
+
 /// Creates a  result set
 /// @returns Result set if successful, otherwise "nullptr"
 IDatabaseResultSet* DatabasesComponent::createResultSet()
@@ -28,6 +137,31 @@ void DatabasesComponent::onLoad(ICore* c)
 	core_ = c;
 	logSQLite_ = core_->getConfig().getBool("logging.log_sqlite");
 	logSQLiteQueries_ = core_->getConfig().getBool("logging.log_sqlite_queries");
+	asyncBatchSize_ = *core_->getConfig().getInt("database.async_batch_size");
+	core_->getEventDispatcher().addEventHandler(this);
+}
+
+/// Fills in the default values of the component's settings
+void DatabasesComponent::provideConfiguration(ILogger& logger, IEarlyConfig& config, bool defaults)
+{
+	if (defaults)
+	{
+		config.setInt("database.async_batch_size", asyncBatchSize_);
+	}
+	else
+	{
+		// Set default values if options are not set.
+		if (config.getType("database.async_batch_size") == ConfigOptionType_None)
+		{
+			config.setInt("database.async_batch_size", asyncBatchSize_);
+		}
+	}
+}
+
+/// Delivers the results of asynchronous queries
+void DatabasesComponent::onTick(Microseconds elapsed, TimePoint now)
+{
+	async_.processCompleted();
 }
 
 /// To optionally log things from connections.
@@ -10,10 +10,55 @@
 
 #include "database_connection.hpp"
 #include <Impl/pool_impl.hpp>
+#include <atomic>
 
 using namespace Impl;
 
-class DatabasesComponent final : public IDatabasesComponent, public NoCopy
+/// Queues queries on the connections' workers and hands their results back from the tick
+class DatabaseAsync final : public IDatabaseAsyncExtension, public DatabaseQueryCompletion, public NoCopy
+{
+private:
+	/// Parent databases component
+	DatabasesComponent& parentDatabasesComponent;
+
+	/// Queries run by the workers whose handlers haven't been called yet
+	std::mutex completedMutex;
+	DynamicArray<DatabaseQueryJob> completed;
+
+	std::atomic<size_t> pending { 0 };
+
+public:
+	DatabaseAsync(DatabasesComponent& parentDatabasesComponent);
+
+	/// Queues a query on the connection's worker
+	/// @param connection Database connection
+	/// @param query Query to execute
+	/// @param handler Handler to call with the result set
+	/// @returns "true" if the query has been queued, otherwise "false"
+	bool executeQueryAsync(IDatabaseConnection& connection, StringView query, DatabaseQueryHandler* handler) override;
+
+	/// Gets the number of queries whose handlers haven't been called yet
+	/// @returns Number of pending queries
+	size_t getPendingQueryCount() const override;
+
+	/// Hands over queries a worker has run, called from the worker
+	/// @param jobs Queries that have been run
+	void complete(DynamicArray<DatabaseQueryJob>& jobs) override;
+
+	/// Calls the handlers of the queries run since the last time
+	void processCompleted();
+
+	void freeExtension() override
+	{
+		// Owned by the databases component.
+	}
+
+	void reset() override
+	{
+	}
+};
+
+class DatabasesComponent final : public IDatabasesComponent, public CoreEventHandler, public NoCopy
 {
 private:
 	/// Database connections
@@ -27,7 +72,12 @@ private:
 	bool* logSQLite_;
 	bool* logSQLiteQueries_;
 
-	ICore* core_;
+	/// Most queries a worker runs in one transaction
+	int asyncBatchSize_ = 100;
+
+	DatabaseAsync async_;
+
+	ICore* core_ = nullptr;
 
 public:
 	/// Creates a result set
@@ -36,6 +86,31 @@ public:
 
 	DatabasesComponent();
 
+	~DatabasesComponent();
+
+	/// Gets the asynchronous query extension
+	/// @returns Asynchronous query extension
+	DatabaseAsync& getAsync()
+	{
+		return async_;
+	}
+
+	/// Gets the most queries a worker runs in one transaction
+	/// @returns Batch size
+	int getAsyncBatchSize() const
+	{
+		return asyncBatchSize_;
+	}
+
+	IExtension* getExtension(UID id) override
+	{
+		if (id == IDatabaseAsyncExtension::ExtensionIID)
+		{
+			return &async_;
+		}
+		return IDatabasesComponent::getExtension(id);
+	}
+
 	/// Gets the component name
 	/// @returns Component name
 	StringView componentName() const override
@@ -62,6 +137,12 @@ public:
 	/// Should NOT be used for interacting with other components as they might not have been initialised yet
 	void onLoad(ICore* c) override;
 
+	/// Fills in the default values of the component's settings
+	void provideConfiguration(ILogger& logger, IEarlyConfig& config, bool defaults) override;
+
+	/// Delivers the results of asynchronous queries
+	void onTick(Microseconds elapsed, TimePoint now) override;
+
 	/// Opens a new database connection
 	/// @param path Path to the database
 	/// @param outDatabaseConnectionID Database connection ID (out)
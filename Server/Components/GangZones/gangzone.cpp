@@ -8,6 +8,7 @@
 
 #include "gangzone.hpp"
 #include <legacy_id_mapper.hpp>
+#include <memory_usage.hpp>
 
 using namespace Impl;
 
@@ -103,7 +104,55 @@ private:
 	DefaultEventDispatcher<GangZoneEventHandler> eventDispatcher;
 	FiniteLegacyIDMapper<GANG_ZONE_POOL_SIZE> legacyIDs_;
 
+	struct MemoryUsageExtension final : public IMemoryUsageExtension
+	{
+		GangZonesComponent& self;
+
+		MemoryUsageExtension(GangZonesComponent& component)
+			: self(component)
+		{
+		}
+
+		size_t getEntityCount() const override
+		{
+			return self.storage._entries().size();
+		}
+
+		size_t getMemoryUsage() const override
+		{
+			size_t usage = 0;
+			for (IGangZone* zone : self.storage)
+			{
+				usage += static_cast<GangZone*>(zone)->memoryUsage();
+			}
+			return usage;
+		}
+
+		void freeExtension() override
+		{
+			// Owned by the component.
+		}
+
+		void reset() override
+		{
+		}
+	} memoryUsage;
+
 public:
+	GangZonesComponent()
+		: memoryUsage(*this)
+	{
+	}
+
+	IExtension* getExtension(UID id) override
+	{
+		if (id == IMemoryUsageExtension::ExtensionIID)
+		{
+			return &memoryUsage;
+		}
+		return IGangZonesComponent::getExtension(id);
+	}
+
 	StringView componentName() const override
 	{
 		return "GangZones";
@@ -9,6 +9,7 @@
 #include <Impl/pool_impl.hpp>
 #include <Server/Components/GangZones/gangzones.hpp>
 #include <netcode.hpp>
+#include <player_overlay.hpp>
 #include <sdk.hpp>
 
 using namespace Impl;
@@ -19,9 +20,10 @@ private:
 	GangZonePos pos;
 	Colour col;
 	UniqueIDArray<IPlayer, PLAYER_POOL_SIZE> shownFor_;
-	StaticBitset<PLAYER_POOL_SIZE> flashingFor_;
-	StaticArray<Colour, PLAYER_POOL_SIZE> flashColorForPlayer_;
-	StaticArray<Colour, PLAYER_POOL_SIZE> colorForPlayer_;
+	/// Only players it's flashing for have an entry
+	PlayerOverlay<Colour> flashColorForPlayer_ { Colour::None() };
+	/// Only players it's shown for have an entry
+	PlayerOverlay<Colour> colorForPlayer_ { Colour::None() };
 	StaticBitset<PLAYER_POOL_SIZE> playersInside_;
 	IPlayer* legacyPerPlayer_ = nullptr;
 
@@ -82,18 +84,20 @@ public:
 		}
 
 		playersInside_.reset(pid);
-		flashingFor_.reset(pid);
-		colorForPlayer_[pid] = Colour::None();
-		flashColorForPlayer_[pid] = Colour::None();
+		colorForPlayer_.erase(pid);
+		flashColorForPlayer_.erase(pid);
 	}
 
 	GangZone(GangZonePos pos)
 		: pos(pos)
 	{
 		playersInside_.reset();
-		flashingFor_.reset();
-		colorForPlayer_.fill(Colour::None());
-		flashColorForPlayer_.fill(Colour::None());
+	}
+
+	/// Bytes used by this zone and its per-player state
+	size_t memoryUsage() const
+	{
+		return sizeof(*this) + colorForPlayer_.heapUsage() + flashColorForPlayer_.heapUsage() + shownFor_.entries().size() * sizeof(IPlayer*);
 	}
 
 	bool isShownForPlayer(const IPlayer& player) const override
@@ -103,7 +107,7 @@ public:
 
 	bool isFlashingForPlayer(const IPlayer& player) const override
 	{
-		return flashingFor_.test(player.getID());
+		return flashColorForPlayer_.has(player.getID());
 	}
 
 	void showForPlayer(IPlayer& player, const Colour& colour) override
@@ -112,10 +116,8 @@ public:
 		const int playerId = player.getID();
 		shownFor_.add(playerId, player);
 
-		flashingFor_.reset(playerId);
-
-		colorForPlayer_[playerId] = colour;
-		flashColorForPlayer_[playerId] = Colour::None();
+		colorForPlayer_.set(playerId, colour);
+		flashColorForPlayer_.erase(playerId);
 
 		showForClient(player, colour);
 	}
@@ -140,8 +142,7 @@ public:
 				flashGangZoneRPC.Col = colour;
 				PacketHelper::send(flashGangZoneRPC, player);
 			}
-			flashColorForPlayer_[pid] = colour;
-			flashingFor_.set(pid);
+			flashColorForPlayer_.set(pid, colour);
 		}
 	}
 
@@ -158,19 +159,18 @@ public:
 				stopFlashGangZoneRPC.ID = id;
 				PacketHelper::send(stopFlashGangZoneRPC, player);
 			}
-			flashColorForPlayer_[pid] = Colour::None();
-			flashingFor_.reset(pid);
+			flashColorForPlayer_.erase(pid);
 		}
 	}
 
 	const Colour getFlashingColourForPlayer(IPlayer& player) const override
 	{
-		return flashColorForPlayer_[player.getID()];
+		return flashColorForPlayer_.get(player.getID());
 	}
 
 	const Colour getColourForPlayer(IPlayer& player) const override
 	{
-		return colorForPlayer_[player.getID()];
+		return colorForPlayer_.get(player.getID());
 	}
 
 	const FlatHashSet<IPlayer*>& getShownFor() override
@@ -0,0 +1,695 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include "argon2.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+namespace
+{
+constexpr uint32_t Version = 0x13;
+constexpr uint32_t TypeId = 2;
+constexpr size_t BlockWords = 128;
+constexpr uint32_t SyncPoints = 4;
+constexpr size_t MinSaltSize = 8;
+constexpr size_t MaxSaltSize = 64;
+constexpr size_t MinTagSize = 4;
+constexpr size_t MaxTagSize = 64;
+constexpr char Base64Code[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+inline uint64_t rotr64(uint64_t x, int n)
+{
+	return (x >> n) | (x << (64 - n));
+}
+
+inline uint64_t load64(const uint8_t* in)
+{
+	uint64_t out = 0;
+	for (int i = 7; i >= 0; --i)
+	{
+		out = (out << 8) | in[i];
+	}
+	return out;
+}
+
+inline void store32(uint8_t* out, uint32_t in)
+{
+	for (int i = 0; i != 4; ++i)
+	{
+		out[i] = uint8_t(in >> (8 * i));
+	}
+}
+
+inline void store64(uint8_t* out, uint64_t in)
+{
+	for (int i = 0; i != 8; ++i)
+	{
+		out[i] = uint8_t(in >> (8 * i));
+	}
+}
+
+/// Unkeyed BLAKE2b (RFC 7693) with a variable digest size, all Argon2 needs from it
+class Blake2b
+{
+public:
+	static constexpr size_t BlockSize = 128;
+	static constexpr size_t MaxOutSize = 64;
+
+	explicit Blake2b(size_t outSize)
+		: outSize_(outSize)
+	{
+		for (int i = 0; i != 8; ++i)
+		{
+			h_[i] = IV[i];
+		}
+		h_[0] ^= 0x01010000 ^ outSize;
+	}
+
+	void update(const void* data, size_t length)
+	{
+		const uint8_t* in = static_cast<const uint8_t*>(data);
+		while (length)
+		{
+			// Keep the last block around, it has to be compressed with the final flag.
+			if (bufferLength_ == BlockSize)
+			{
+				counter_ += BlockSize;
+				compress(buffer_, false);
+				bufferLength_ = 0;
+			}
+			const size_t chunk = std::min(length, BlockSize - bufferLength_);
+			std::memcpy(buffer_ + bufferLength_, in, chunk);
+			bufferLength_ += chunk;
+			in += chunk;
+			length -= chunk;
+		}
+	}
+
+	void update32(uint32_t value)
+	{
+		uint8_t bytes[4];
+		store32(bytes, value);
+		update(bytes, sizeof(bytes));
+	}
+
+	void final(uint8_t* out)
+	{
+		counter_ += bufferLength_;
+		std::memset(buffer_ + bufferLength_, 0, BlockSize - bufferLength_);
+		compress(buffer_, true);
+
+		uint8_t digest[MaxOutSize];
+		for (int i = 0; i != 8; ++i)
+		{
+			store64(digest + i * 8, h_[i]);
+		}
+		std::memcpy(out, digest, outSize_);
+	}
+
+private:
+	static constexpr uint64_t IV[8] = {
+		0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
+		0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179
+	};
+
+	static constexpr uint8_t Sigma[12][16] = {
+		{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+		{ 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 },
+		{ 11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4 },
+		{ 7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8 },
+		{ 9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13 },
+		{ 2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9 },
+		{ 12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11 },
+		{ 13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10 },
+		{ 6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5 },
+		{ 10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0 },
+		{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+		{ 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 }
+	};
+
+	void compress(const uint8_t* block, bool last)
+	{
+		uint64_t m[16], v[16];
+		for (int i = 0; i != 16; ++i)
+		{
+			m[i] = load64(block + i * 8);
+		}
+		for (int i = 0; i != 8; ++i)
+		{
+			v[i] = h_[i];
+			v[i + 8] = IV[i];
+		}
+		v[12] ^= counter_;
+		if (last)
+		{
+			v[14] = ~v[14];
+		}
+
+		const auto g = [&](int a, int b, int c, int d, uint64_t x, uint64_t y)
+		{
+			v[a] = v[a] + v[b] + x;
+			v[d] = rotr64(v[d] ^ v[a], 32);
+			v[c] = v[c] + v[d];
+			v[b] = rotr64(v[b] ^ v[c], 24);
+			v[a] = v[a] + v[b] + y;
+			v[d] = rotr64(v[d] ^ v[a], 16);
+			v[c] = v[c] + v[d];
+			v[b] = rotr64(v[b] ^ v[c], 63);
+		};
+
+		for (const uint8_t* s : Sigma)
+		{
+			g(0, 4, 8, 12, m[s[0]], m[s[1]]);
+			g(1, 5, 9, 13, m[s[2]], m[s[3]]);
+			g(2, 6, 10, 14, m[s[4]], m[s[5]]);
+			g(3, 7, 11, 15, m[s[6]], m[s[7]]);
+			g(0, 5, 10, 15, m[s[8]], m[s[9]]);
+			g(1, 6, 11, 12, m[s[10]], m[s[11]]);
+			g(2, 7, 8, 13, m[s[12]], m[s[13]]);
+			g(3, 4, 9, 14, m[s[14]], m[s[15]]);
+		}
+
+		for (int i = 0; i != 8; ++i)
+		{
+			h_[i] ^= v[i] ^ v[i + 8];
+		}
+	}
+
+	uint64_t h_[8];
+	uint64_t counter_ = 0; ///< Inputs are never anywhere near 2^64 bytes
+	uint8_t buffer_[BlockSize];
+	size_t bufferLength_ = 0;
+	size_t outSize_;
+};
+
+/// The variable length hash H' from the spec
+void hashLong(uint8_t* out, size_t outLength, const uint8_t* in, size_t inLength)
+{
+	if (outLength <= Blake2b::MaxOutSize)
+	{
+		Blake2b blake(outLength);
+		blake.update32(uint32_t(outLength));
+		blake.update(in, inLength);
+		blake.final(out);
+		return;
+	}
+
+	uint8_t v[Blake2b::MaxOutSize];
+	Blake2b first(Blake2b::MaxOutSize);
+	first.update32(uint32_t(outLength));
+	first.update(in, inLength);
+	first.final(v);
+
+	// Every intermediate digest contributes its first half.
+	std::memcpy(out, v, 32);
+	out += 32;
+	outLength -= 32;
+	while (outLength > Blake2b::MaxOutSize)
+	{
+		Blake2b next(Blake2b::MaxOutSize);
+		next.update(v, sizeof(v));
+		next.final(v);
+		std::memcpy(out, v, 32);
+		out += 32;
+		outLength -= 32;
+	}
+
+	Blake2b last(outLength);
+	last.update(v, sizeof(v));
+	last.final(out);
+}
+
+struct Block
+{
+	uint64_t v[BlockWords];
+};
+
+/// The BlaMka variant of the BLAKE2b round function, with the multiplications that make it memory hard
+inline void blamkaG(uint64_t& a, uint64_t& b, uint64_t& c, uint64_t& d)
+{
+	const auto fBlaMka = [](uint64_t x, uint64_t y)
+	{
+		return x + y + 2 * (x & 0xffffffff) * (y & 0xffffffff);
+	};
+
+	a = fBlaMka(a, b);
+	d = rotr64(d ^ a, 32);
+	c = fBlaMka(c, d);
+	b = rotr64(b ^ c, 24);
+	a = fBlaMka(a, b);
+	d = rotr64(d ^ a, 16);
+	c = fBlaMka(c, d);
+	b = rotr64(b ^ c, 63);
+}
+
+inline void blamkaRound(uint64_t& v0, uint64_t& v1, uint64_t& v2, uint64_t& v3, uint64_t& v4, uint64_t& v5, uint64_t& v6, uint64_t& v7,
+	uint64_t& v8, uint64_t& v9, uint64_t& v10, uint64_t& v11, uint64_t& v12, uint64_t& v13, uint64_t& v14, uint64_t& v15)
+{
+	blamkaG(v0, v4, v8, v12);
+	blamkaG(v1, v5, v9, v13);
+	blamkaG(v2, v6, v10, v14);
+	blamkaG(v3, v7, v11, v15);
+	blamkaG(v0, v5, v10, v15);
+	blamkaG(v1, v6, v11, v12);
+	blamkaG(v2, v7, v8, v13);
+	blamkaG(v3, v4, v9, v14);
+}
+
+/// The compression function G, XORed into the existing block on every pass after the first
+void fillBlock(const Block& prev, const Block& ref, Block& next, bool withXor)
+{
+	Block r, tmp;
+	for (size_t i = 0; i != BlockWords; ++i)
+	{
+		r.v[i] = prev.v[i] ^ ref.v[i];
+		tmp.v[i] = withXor ? r.v[i] ^ next.v[i] : r.v[i];
+	}
+
+	for (size_t i = 0; i != 8; ++i)
+	{
+		uint64_t* row = r.v + 16 * i;
+		blamkaRound(row[0], row[1], row[2], row[3], row[4], row[5], row[6], row[7],
+			row[8], row[9], row[10], row[11], row[12], row[13], row[14], row[15]);
+	}
+
+	for (size_t i = 0; i != 8; ++i)
+	{
+		uint64_t* col = r.v + 2 * i;
+		blamkaRound(col[0], col[1], col[16], col[17], col[32], col[33], col[48], col[49],
+			col[64], col[65], col[80], col[81], col[96], col[97], col[112], col[113]);
+	}
+
+	for (size_t i = 0; i != BlockWords; ++i)
+	{
+		next.v[i] = tmp.v[i] ^ r.v[i];
+	}
+}
+
+class Instance
+{
+public:
+	Instance(const Argon2::Params& params)
+		: passes_(params.timeCost)
+		, lanes_(params.parallelism)
+	{
+		// Round the memory down to a multiple of four blocks per lane, with at least eight blocks per lane.
+		uint32_t blocks = std::max(params.memoryCost, 2 * SyncPoints * lanes_);
+		segmentLength_ = blocks / (lanes_ * SyncPoints);
+		laneLength_ = segmentLength_ * SyncPoints;
+		blockCount_ = laneLength_ * lanes_;
+		memory_.reset(new Block[blockCount_]);
+	}
+
+	~Instance()
+	{
+		std::memset(memory_.get(), 0, sizeof(Block) * blockCount_);
+	}
+
+	void initialise(const uint8_t (&h0)[Blake2b::MaxOutSize + 8])
+	{
+		uint8_t seed[Blake2b::MaxOutSize + 8];
+		std::memcpy(seed, h0, sizeof(seed));
+		uint8_t bytes[sizeof(Block)];
+		for (uint32_t lane = 0; lane != lanes_; ++lane)
+		{
+			store32(seed + Blake2b::MaxOutSize + 4, lane);
+			for (uint32_t i = 0; i != 2; ++i)
+			{
+				store32(seed + Blake2b::MaxOutSize, i);
+				hashLong(bytes, sizeof(bytes), seed, sizeof(seed));
+				loadBlock(memory_[lane * laneLength_ + i], bytes);
+			}
+		}
+		std::memset(seed, 0, sizeof(seed));
+		std::memset(bytes, 0, sizeof(bytes));
+	}
+
+	void fill()
+	{
+		for (uint32_t pass = 0; pass != passes_; ++pass)
+		{
+			for (uint32_t slice = 0; slice != SyncPoints; ++slice)
+			{
+				// Lanes only reference each other's finished slices, so doing them in order gives the same result as threads would.
+				for (uint32_t lane = 0; lane != lanes_; ++lane)
+				{
+					fillSegment(pass, lane, slice);
+				}
+			}
+		}
+	}
+
+	void finalise(uint8_t* out, size_t outLength)
+	{
+		Block final = memory_[laneLength_ - 1];
+		for (uint32_t lane = 1; lane != lanes_; ++lane)
+		{
+			const Block& last = memory_[lane * laneLength_ + laneLength_ - 1];
+			for (size_t i = 0; i != BlockWords; ++i)
+			{
+				final.v[i] ^= last.v[i];
+			}
+		}
+
+		uint8_t bytes[sizeof(Block)];
+		for (size_t i = 0; i != BlockWords; ++i)
+		{
+			store64(bytes + i * 8, final.v[i]);
+		}
+		hashLong(out, outLength, bytes, sizeof(bytes));
+		std::memset(bytes, 0, sizeof(bytes));
+	}
+
+private:
+	static void loadBlock(Block& block, const uint8_t* bytes)
+	{
+		for (size_t i = 0; i != BlockWords; ++i)
+		{
+			block.v[i] = load64(bytes + i * 8);
+		}
+	}
+
+	uint32_t indexAlpha(uint32_t pass, uint32_t slice, uint32_t index, uint32_t pseudoRand, bool sameLane) const
+	{
+		uint32_t referenceAreaSize;
+		if (pass == 0)
+		{
+			if (slice == 0)
+			{
+				referenceAreaSize = index - 1;
+			}
+			else if (sameLane)
+			{
+				referenceAreaSize = slice * segmentLength_ + index - 1;
+			}
+			else
+			{
+				referenceAreaSize = slice * segmentLength_ + (index == 0 ? -1 : 0);
+			}
+		}
+		else
+		{
+			if (sameLane)
+			{
+				referenceAreaSize = laneLength_ - segmentLength_ + index - 1;
+			}
+			else
+			{
+				referenceAreaSize = laneLength_ - segmentLength_ + (index == 0 ? -1 : 0);
+			}
+		}
+
+		uint64_t relativePosition = pseudoRand;
+		relativePosition = (relativePosition * relativePosition) >> 32;
+		relativePosition = referenceAreaSize - 1 - ((referenceAreaSize * relativePosition) >> 32);
+
+		const uint32_t startPosition = (pass != 0 && slice != SyncPoints - 1) ? (slice + 1) * segmentLength_ : 0;
+		return uint32_t((startPosition + relativePosition) % laneLength_);
+	}
+
+	void fillSegment(uint32_t pass, uint32_t lane, uint32_t slice)
+	{
+		// Argon2id uses data independent addressing for the first half of the first pass.
+		const bool dataIndependent = pass == 0 && slice < SyncPoints / 2;
+
+		Block zero = {}, input = {}, addresses = {};
+		const auto nextAddresses = [&]()
+		{
+			++input.v[6];
+			fillBlock(zero, input, addresses, false);
+			fillBlock(zero, addresses, addresses, false);
+		};
+
+		if (dataIndependent)
+		{
+			input.v[0] = pass;
+			input.v[1] = lane;
+			input.v[2] = slice;
+			input.v[3] = blockCount_;
+			input.v[4] = passes_;
+			input.v[5] = TypeId;
+		}
+
+		uint32_t startingIndex = 0;
+		if (pass == 0 && slice == 0)
+		{
+			// The first two blocks of each lane come from the seed.
+			startingIndex = 2;
+			if (dataIndependent)
+			{
+				nextAddresses();
+			}
+		}
+
+		uint32_t currentOffset = lane * laneLength_ + slice * segmentLength_ + startingIndex;
+		uint32_t previousOffset = (currentOffset % laneLength_ == 0) ? currentOffset + laneLength_ - 1 : currentOffset - 1;
+
+		for (uint32_t i = startingIndex; i != segmentLength_; ++i, ++currentOffset, ++previousOffset)
+		{
+			if (currentOffset % laneLength_ == 1)
+			{
+				previousOffset = currentOffset - 1;
+			}
+
+			uint64_t pseudoRand;
+			if (dataIndependent)
+			{
+				if (i % BlockWords == 0)
+				{
+					nextAddresses();
+				}
+				pseudoRand = addresses.v[i % BlockWords];
+			}
+			else
+			{
+				pseudoRand = memory_[previousOffset].v[0];
+			}
+
+			uint32_t refLane = uint32_t((pseudoRand >> 32) % lanes_);
+			if (pass == 0 && slice == 0)
+			{
+				refLane = lane;
+			}
+
+			const uint32_t refIndex = indexAlpha(pass, slice, i, uint32_t(pseudoRand), refLane == lane);
+			fillBlock(memory_[previousOffset], memory_[refLane * laneLength_ + refIndex], memory_[currentOffset], pass != 0);
+		}
+	}
+
+	uint32_t passes_;
+	uint32_t lanes_;
+	uint32_t segmentLength_;
+	uint32_t laneLength_;
+	uint32_t blockCount_;
+	std::unique_ptr<Block[]> memory_;
+};
+
+bool validParams(const Argon2::Params& params)
+{
+	return params.timeCost >= 1 && params.timeCost <= Argon2::MaxTimeCost
+		&& params.parallelism >= 1 && params.parallelism <= Argon2::MaxParallelism
+		&& params.memoryCost >= 8 * params.parallelism && params.memoryCost <= Argon2::MaxMemoryCost;
+}
+
+void encodeBase64(String& out, const uint8_t* data, size_t length)
+{
+	// Standard alphabet without padding, as the PHC string format wants.
+	uint32_t accumulator = 0;
+	int bits = 0;
+	for (size_t i = 0; i != length; ++i)
+	{
+		accumulator = (accumulator << 8) | data[i];
+		bits += 8;
+		while (bits >= 6)
+		{
+			bits -= 6;
+			out += Base64Code[(accumulator >> bits) & 0x3f];
+		}
+	}
+	if (bits > 0)
+	{
+		out += Base64Code[(accumulator << (6 - bits)) & 0x3f];
+	}
+}
+
+bool decodeBase64(DynamicArray<uint8_t>& out, StringView encoded)
+{
+	uint32_t accumulator = 0;
+	int bits = 0;
+	for (char c : encoded)
+	{
+		const char* found = static_cast<const char*>(std::memchr(Base64Code, c, sizeof(Base64Code) - 1));
+		if (!found || c == '\0')
+		{
+			return false;
+		}
+		accumulator = (accumulator << 6) | uint32_t(found - Base64Code);
+		bits += 6;
+		if (bits >= 8)
+		{
+			bits -= 8;
+			out.push_back(uint8_t(accumulator >> bits));
+		}
+	}
+	// Leftover bits must be zero padding, and there can't be a lone sextet.
+	return bits < 6 && (accumulator & ((1u << bits) - 1)) == 0;
+}
+
+/// Consume "name=" followed by a decimal number from the front of the string
+bool parseParam(StringView& str, StringView name, uint32_t& value)
+{
+	if (str.substr(0, name.size()) != name || str.size() <= name.size() || str[name.size()] != '=')
+	{
+		return false;
+	}
+	str.remove_prefix(name.size() + 1);
+
+	uint64_t result = 0;
+	size_t digits = 0;
+	while (digits < str.size() && str[digits] >= '0' && str[digits] <= '9')
+	{
+		result = result * 10 + (str[digits] - '0');
+		if (result > UINT32_MAX)
+		{
+			return false;
+		}
+		++digits;
+	}
+	if (digits == 0)
+	{
+		return false;
+	}
+	str.remove_prefix(digits);
+	value = uint32_t(result);
+	return true;
+}
+
+bool consume(StringView& str, StringView prefix)
+{
+	if (str.substr(0, prefix.size()) != prefix)
+	{
+		return false;
+	}
+	str.remove_prefix(prefix.size());
+	return true;
+}
+}
+
+namespace Argon2
+{
+bool derive(StringView password, const uint8_t* salt, size_t saltLength, const Params& params, uint8_t* out, size_t outLength,
+	const uint8_t* secret, size_t secretLength, const uint8_t* ad, size_t adLength)
+{
+	if (!validParams(params) || outLength < MinTagSize || outLength > UINT32_MAX || saltLength < MinSaltSize)
+	{
+		return false;
+	}
+
+	uint8_t h0[Blake2b::MaxOutSize + 8];
+	Blake2b blake(Blake2b::MaxOutSize);
+	blake.update32(params.parallelism);
+	blake.update32(uint32_t(outLength));
+	blake.update32(params.memoryCost);
+	blake.update32(params.timeCost);
+	blake.update32(Version);
+	blake.update32(TypeId);
+	blake.update32(uint32_t(password.size()));
+	blake.update(password.data(), password.size());
+	blake.update32(uint32_t(saltLength));
+	blake.update(salt, saltLength);
+	blake.update32(uint32_t(secretLength));
+	blake.update(secret, secretLength);
+	blake.update32(uint32_t(adLength));
+	blake.update(ad, adLength);
+	blake.final(h0);
+
+	Instance instance(params);
+	instance.initialise(h0);
+	instance.fill();
+	instance.finalise(out, outLength);
+	std::memset(h0, 0, sizeof(h0));
+	return true;
+}
+
+String hash(StringView password, const uint8_t (&salt)[SaltSize], const Params& params)
+{
+	uint8_t tag[TagSize];
+	if (!derive(password, salt, SaltSize, params, tag, TagSize))
+	{
+		return String();
+	}
+
+	char prefix[64];
+	snprintf(prefix, sizeof(prefix), "$argon2id$v=%u$m=%u,t=%u,p=%u$", Version, params.memoryCost, params.timeCost, params.parallelism);
+	String out(prefix);
+	encodeBase64(out, salt, SaltSize);
+	out += '$';
+	encodeBase64(out, tag, TagSize);
+	return out;
+}
+
+bool verify(StringView password, StringView encoded, const Params& limits)
+{
+	// $argon2id$v=19$m=<m>,t=<t>,p=<p>$<salt>$<hash>
+	Params params;
+	uint32_t version;
+	if (!consume(encoded, "$argon2id$") || !parseParam(encoded, "v", version) || version != Version || !consume(encoded, "$")
+		|| !parseParam(encoded, "m", params.memoryCost) || !consume(encoded, ",")
+		|| !parseParam(encoded, "t", params.timeCost) || !consume(encoded, ",")
+		|| !parseParam(encoded, "p", params.parallelism) || !consume(encoded, "$"))
+	{
+		return false;
+	}
+	if (params.timeCost > limits.timeCost || params.memoryCost > limits.memoryCost || params.parallelism > limits.parallelism)
+	{
+		return false;
+	}
+
+	const size_t separator = encoded.find('$');
+	if (separator == StringView::npos)
+	{
+		return false;
+	}
+
+	DynamicArray<uint8_t> salt, expected;
+	if (!decodeBase64(salt, encoded.substr(0, separator)) || !decodeBase64(expected, encoded.substr(separator + 1)))
+	{
+		return false;
+	}
+	if (salt.size() < MinSaltSize || salt.size() > MaxSaltSize || expected.size() < MinTagSize || expected.size() > MaxTagSize)
+	{
+		return false;
+	}
+
+	uint8_t computed[MaxTagSize];
+	if (!derive(password, salt.data(), salt.size(), params, computed, expected.size()))
+	{
+		return false;
+	}
+
+	uint8_t diff = 0;
+	for (size_t i = 0; i != expected.size(); ++i)
+	{
+		diff |= computed[i] ^ expected[i];
+	}
+	return diff == 0;
+}
+
+void blake2b(uint8_t* out, size_t outLength, const void* data, size_t length)
+{
+	if (outLength == 0 || outLength > Blake2b::MaxOutSize)
+	{
+		return;
+	}
+	Blake2b blake(outLength);
+	blake.update(data, length);
+	blake.final(out);
+}
+}
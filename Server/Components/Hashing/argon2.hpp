@@ -0,0 +1,46 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <sdk.hpp>
+
+using namespace Impl;
+
+/// Argon2id version 1.3 (RFC 9106), producing the same PHC strings as libargon2
+namespace Argon2
+{
+constexpr size_t SaltSize = 16;
+constexpr size_t TagSize = 32;
+
+/// Upper bounds for any parameters, hashes being verified are held to the tighter limits passed to verify
+constexpr uint32_t MaxTimeCost = 64;
+constexpr uint32_t MaxMemoryCost = 1024 * 1024;
+constexpr uint32_t MaxParallelism = 64;
+
+struct Params
+{
+	uint32_t timeCost; ///< Passes over memory
+	uint32_t memoryCost; ///< In KiB
+	uint32_t parallelism; ///< Lanes, computed one after another
+};
+
+/// Raw key derivation, the secret and associated data are optional
+bool derive(StringView password, const uint8_t* salt, size_t saltLength, const Params& params, uint8_t* out, size_t outLength,
+	const uint8_t* secret = nullptr, size_t secretLength = 0, const uint8_t* ad = nullptr, size_t adLength = 0);
+
+/// Hash a password into a "$argon2id$" string, empty if the parameters are out of range
+String hash(StringView password, const uint8_t (&salt)[SaltSize], const Params& params);
+
+/// Check a password against a "$argon2id$" string, false if it doesn't match or the string is malformed.  Strings
+/// asking for more than the limits are refused before any memory is allocated for them.
+bool verify(StringView password, StringView encoded, const Params& limits);
+
+/// Unkeyed BLAKE2b (RFC 7693) digest of 1 to 64 bytes, the hash Argon2 is built on
+void blake2b(uint8_t* out, size_t outLength, const void* data, size_t length);
+}
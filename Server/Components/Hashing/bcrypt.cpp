@@ -0,0 +1,282 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include "bcrypt.hpp"
+#include "blowfish_tables.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+constexpr char Base64Code[] = "./ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+constexpr size_t HashSize = 23;
+constexpr size_t EncodedSaltSize = 22;
+constexpr size_t EncodedHashSize = 31;
+
+struct BlowfishState
+{
+	uint32_t P[18];
+	uint32_t S[4][256];
+
+	uint32_t F(uint32_t x) const
+	{
+		return ((S[0][x >> 24] + S[1][(x >> 16) & 0xff]) ^ S[2][(x >> 8) & 0xff]) + S[3][x & 0xff];
+	}
+
+	void encipher(uint32_t& left, uint32_t& right) const
+	{
+		uint32_t l = left, r = right;
+		for (int i = 0; i != 16; i += 2)
+		{
+			l ^= P[i];
+			r ^= F(l);
+			r ^= P[i + 1];
+			l ^= F(r);
+		}
+		left = r ^ P[17];
+		right = l ^ P[16];
+	}
+};
+
+/// Read the next big endian word from a byte string, wrapping around at the end
+uint32_t streamToWord(const uint8_t* data, size_t length, size_t& position)
+{
+	uint32_t word = 0;
+	for (int i = 0; i != 4; ++i)
+	{
+		if (position >= length)
+		{
+			position = 0;
+		}
+		word = (word << 8) | data[position++];
+	}
+	return word;
+}
+
+/// The key schedule, with the salt mixed in when there is one
+void expandState(BlowfishState& state, const uint8_t* salt, size_t saltLength, const uint8_t* key, size_t keyLength)
+{
+	size_t position = 0;
+	for (uint32_t& p : state.P)
+	{
+		p ^= streamToWord(key, keyLength, position);
+	}
+
+	uint32_t left = 0, right = 0;
+	position = 0;
+	const auto next = [&]()
+	{
+		if (salt)
+		{
+			left ^= streamToWord(salt, saltLength, position);
+			right ^= streamToWord(salt, saltLength, position);
+		}
+		state.encipher(left, right);
+	};
+
+	for (int i = 0; i != 18; i += 2)
+	{
+		next();
+		state.P[i] = left;
+		state.P[i + 1] = right;
+	}
+
+	for (auto& box : state.S)
+	{
+		for (int i = 0; i != 256; i += 2)
+		{
+			next();
+			box[i] = left;
+			box[i + 1] = right;
+		}
+	}
+}
+
+void encodeBase64(String& out, const uint8_t* data, size_t length)
+{
+	const uint8_t* end = data + length;
+	while (data < end)
+	{
+		uint32_t c1 = *data++;
+		out += Base64Code[c1 >> 2];
+		c1 = (c1 & 0x03) << 4;
+		if (data >= end)
+		{
+			out += Base64Code[c1];
+			break;
+		}
+
+		uint32_t c2 = *data++;
+		c1 |= c2 >> 4;
+		out += Base64Code[c1];
+		c1 = (c2 & 0x0f) << 2;
+		if (data >= end)
+		{
+			out += Base64Code[c1];
+			break;
+		}
+
+		c2 = *data++;
+		c1 |= c2 >> 6;
+		out += Base64Code[c1];
+		out += Base64Code[c2 & 0x3f];
+	}
+}
+
+int decodeBase64Char(char c)
+{
+	const char* found = static_cast<const char*>(std::memchr(Base64Code, c, sizeof(Base64Code) - 1));
+	return found ? int(found - Base64Code) : -1;
+}
+
+bool decodeBase64(uint8_t* out, size_t length, StringView encoded)
+{
+	size_t read = 0, written = 0;
+	const auto next = [&]()
+	{
+		return read < encoded.size() ? decodeBase64Char(encoded[read++]) : -1;
+	};
+
+	while (written < length)
+	{
+		const int c1 = next(), c2 = next();
+		if (c1 < 0 || c2 < 0)
+		{
+			return false;
+		}
+		out[written++] = uint8_t((c1 << 2) | ((c2 & 0x30) >> 4));
+		if (written >= length)
+		{
+			break;
+		}
+
+		const int c3 = next();
+		if (c3 < 0)
+		{
+			return false;
+		}
+		out[written++] = uint8_t(((c2 & 0x0f) << 4) | ((c3 & 0x3c) >> 2));
+		if (written >= length)
+		{
+			break;
+		}
+
+		const int c4 = next();
+		if (c4 < 0)
+		{
+			return false;
+		}
+		out[written++] = uint8_t(((c3 & 0x03) << 6) | c4);
+	}
+	return true;
+}
+
+String hashWithVersion(StringView password, const uint8_t (&salt)[Bcrypt::SaltSize], int cost, char minor)
+{
+	// The key includes the terminating NUL and stops at 72 bytes, as the original does.
+	uint8_t key[73] = {};
+	const size_t passwordLength = std::min<size_t>(password.size(), 72);
+	std::memcpy(key, password.data(), passwordLength);
+	const size_t keyLength = passwordLength + 1;
+
+	BlowfishState state;
+	std::memcpy(state.P, BlowfishInitP, sizeof(state.P));
+	std::memcpy(state.S, BlowfishInitS, sizeof(state.S));
+
+	expandState(state, salt, Bcrypt::SaltSize, key, keyLength);
+	for (uint64_t round = 0, rounds = uint64_t(1) << cost; round != rounds; ++round)
+	{
+		expandState(state, nullptr, 0, key, keyLength);
+		expandState(state, nullptr, 0, salt, Bcrypt::SaltSize);
+	}
+
+	static const uint8_t magic[] = "OrpheanBeholderScryDoubt";
+	uint32_t cdata[6];
+	size_t position = 0;
+	for (uint32_t& word : cdata)
+	{
+		word = streamToWord(magic, 24, position);
+	}
+	for (int i = 0; i != 64; ++i)
+	{
+		for (int block = 0; block != 6; block += 2)
+		{
+			state.encipher(cdata[block], cdata[block + 1]);
+		}
+	}
+
+	uint8_t ciphertext[24];
+	for (int i = 0; i != 6; ++i)
+	{
+		ciphertext[i * 4 + 0] = uint8_t(cdata[i] >> 24);
+		ciphertext[i * 4 + 1] = uint8_t(cdata[i] >> 16);
+		ciphertext[i * 4 + 2] = uint8_t(cdata[i] >> 8);
+		ciphertext[i * 4 + 3] = uint8_t(cdata[i]);
+	}
+
+	char prefix[8];
+	snprintf(prefix, sizeof(prefix), "$2%c$%02d$", minor, cost);
+	String out(prefix);
+	encodeBase64(out, salt, Bcrypt::SaltSize);
+	encodeBase64(out, ciphertext, HashSize);
+
+	std::memset(key, 0, sizeof(key));
+	std::memset(&state, 0, sizeof(state));
+	return out;
+}
+}
+
+namespace Bcrypt
+{
+String hash(StringView password, const uint8_t (&salt)[SaltSize], int cost)
+{
+	return hashWithVersion(password, salt, std::clamp(cost, MinCost, MaxCost), 'b');
+}
+
+bool verify(StringView password, StringView hash, int maxCost)
+{
+	// $2?$NN$ + salt + hash
+	if (hash.size() != 7 + EncodedSaltSize + EncodedHashSize || hash[0] != '$' || hash[1] != '2' || hash[3] != '$' || hash[6] != '$')
+	{
+		return false;
+	}
+
+	const char minor = hash[2];
+	if (minor != 'a' && minor != 'b' && minor != 'y')
+	{
+		return false;
+	}
+
+	if (hash[4] < '0' || hash[4] > '9' || hash[5] < '0' || hash[5] > '9')
+	{
+		return false;
+	}
+	const int cost = (hash[4] - '0') * 10 + (hash[5] - '0');
+	if (cost < MinCost || cost > std::min(maxCost, MaxCost))
+	{
+		return false;
+	}
+
+	uint8_t salt[SaltSize];
+	if (!decodeBase64(salt, SaltSize, hash.substr(7, EncodedSaltSize)))
+	{
+		return false;
+	}
+
+	// The versions only differ in how they treat passwords longer than 255 bytes, which we cut at 72 anyway.
+	const String computed = hashWithVersion(password, salt, cost, minor);
+
+	uint8_t diff = 0;
+	for (size_t i = 0; i != hash.size(); ++i)
+	{
+		diff |= uint8_t(computed[i] ^ hash[i]);
+	}
+	return diff == 0;
+}
+}
@@ -0,0 +1,28 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <sdk.hpp>
+
+using namespace Impl;
+
+/// OpenBSD bcrypt, compatible with the $2a$, $2b$ and $2y$ hashes other plugins and sites produce
+namespace Bcrypt
+{
+constexpr int MinCost = 4;
+constexpr int MaxCost = 31;
+constexpr size_t SaltSize = 16;
+
+/// Hash a password into a "$2b$" string, only the first 72 bytes of the password count
+String hash(StringView password, const uint8_t (&salt)[SaltSize], int cost);
+
+/// Check a password against a hash string, false if it doesn't match, the hash is malformed or its cost is above
+/// maxCost
+bool verify(StringView password, StringView hash, int maxCost);
+}
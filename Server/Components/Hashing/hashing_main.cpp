@@ -0,0 +1,348 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include <sdk.hpp>
+#include "argon2.hpp"
+#include "bcrypt.hpp"
+#include <hashing.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <openssl/rand.h>
+
+using namespace Impl;
+
+/// Stored hashes may ask for this many times the configured Argon2 costs before they're refused unchecked, which
+/// leaves room to raise the config without letting a crafted hash allocate gigabytes.
+constexpr uint32_t VerifyCostFactor = 4;
+
+/// The same headroom for bcrypt, whose cost is a power of two
+constexpr int VerifyCostIncrease = 2;
+
+class HashingComponent final : public IHashingComponent, public CoreEventHandler
+{
+private:
+	struct Job
+	{
+		PasswordHashHandler* hashHandler = nullptr;
+		PasswordCheckHandler* checkHandler = nullptr;
+		PasswordHashType type = PasswordHashType_Bcrypt;
+		int cost = 0;
+		String password;
+		String hash; ///< The hash to check against, then the result of hashing
+		bool match = false;
+	};
+
+	ICore* core = nullptr;
+	int threadCount = 0;
+	int bcryptCost = 12;
+	Argon2::Params argon2Params = { 2, 19456, 1 };
+	Argon2::Params argon2Limits = argon2Params;
+	int bcryptLimit = bcryptCost;
+
+	std::vector<std::thread> workers;
+	std::mutex queueMutex;
+	std::condition_variable queueSignal;
+	std::deque<Job> queue;
+	DynamicArray<Job> finished;
+	bool stopping = false;
+	std::atomic<size_t> pending { 0 };
+
+	static void wipe(String& str)
+	{
+		std::fill(str.begin(), str.end(), '\0');
+		str.clear();
+	}
+
+	void run(Job& job)
+	{
+		if (job.checkHandler)
+		{
+			const StringView hash = job.hash;
+			if (hash.substr(0, 10) == "$argon2id$")
+			{
+				job.match = Argon2::verify(job.password, hash, argon2Limits);
+			}
+			else
+			{
+				job.match = Bcrypt::verify(job.password, hash, bcryptLimit);
+			}
+			return;
+		}
+
+		static_assert(Argon2::SaltSize == Bcrypt::SaltSize, "Both algorithms take the same salt");
+		uint8_t salt[Bcrypt::SaltSize];
+		if (RAND_bytes(salt, sizeof(salt)) != 1)
+		{
+			return;
+		}
+
+		if (job.type == PasswordHashType_Argon2id)
+		{
+			Argon2::Params params = argon2Params;
+			params.timeCost = job.cost;
+			job.hash = Argon2::hash(job.password, salt, params);
+		}
+		else
+		{
+			job.hash = Bcrypt::hash(job.password, salt, job.cost);
+		}
+	}
+
+	void workerProc()
+	{
+		for (;;)
+		{
+			Job job;
+			{
+				std::unique_lock<std::mutex> lock(queueMutex);
+				queueSignal.wait(lock, [this]()
+					{
+						return stopping || !queue.empty();
+					});
+				if (stopping)
+				{
+					return;
+				}
+				job = std::move(queue.front());
+				queue.pop_front();
+			}
+
+			run(job);
+			wipe(job.password);
+
+			std::scoped_lock<std::mutex> lock(queueMutex);
+			finished.emplace_back(std::move(job));
+		}
+	}
+
+	bool enqueue(Job&& job)
+	{
+		if (workers.empty())
+		{
+			wipe(job.password);
+			return false;
+		}
+
+		++pending;
+		{
+			std::scoped_lock<std::mutex> lock(queueMutex);
+			queue.emplace_back(std::move(job));
+		}
+		queueSignal.notify_one();
+		return true;
+	}
+
+	void stopWorkers()
+	{
+		{
+			std::scoped_lock<std::mutex> lock(queueMutex);
+			stopping = true;
+		}
+		queueSignal.notify_all();
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+		workers.clear();
+
+		// Every handler is called once so it can free itself: what finished gets its result, what never ran fails.
+		DynamicArray<Job> results;
+		results.swap(finished);
+		for (Job& job : queue)
+		{
+			wipe(job.password);
+			job.hash.clear();
+			job.match = false;
+			results.emplace_back(std::move(job));
+		}
+		queue.clear();
+		deliver(results);
+	}
+
+	/// Call the handlers of jobs taken off the finished list, without the lock held so they're free to queue more
+	void deliver(DynamicArray<Job>& results)
+	{
+		for (Job& job : results)
+		{
+			--pending;
+			if (job.checkHandler)
+			{
+				job.checkHandler->onPasswordChecked(job.match);
+			}
+			else
+			{
+				job.hashHandler->onPasswordHashed(job.hash);
+			}
+		}
+	}
+
+public:
+	StringView componentName() const override
+	{
+		return "Hashing";
+	}
+
+	SemanticVersion componentVersion() const override
+	{
+		return SemanticVersion(OMP_VERSION_MAJOR, OMP_VERSION_MINOR, OMP_VERSION_PATCH, BUILD_NUMBER);
+	}
+
+	void provideConfiguration(ILogger& logger, IEarlyConfig& config, bool defaults) override
+	{
+		if (defaults)
+		{
+			config.setInt("hashing.threads", threadCount);
+			config.setInt("hashing.bcrypt_cost", bcryptCost);
+			config.setInt("hashing.argon2_time", argon2Params.timeCost);
+			config.setInt("hashing.argon2_memory", argon2Params.memoryCost);
+			config.setInt("hashing.argon2_parallelism", argon2Params.parallelism);
+		}
+		else
+		{
+			// Set default values if options are not set.
+			if (config.getType("hashing.threads") == ConfigOptionType_None)
+			{
+				config.setInt("hashing.threads", threadCount);
+			}
+			if (config.getType("hashing.bcrypt_cost") == ConfigOptionType_None)
+			{
+				config.setInt("hashing.bcrypt_cost", bcryptCost);
+			}
+			if (config.getType("hashing.argon2_time") == ConfigOptionType_None)
+			{
+				config.setInt("hashing.argon2_time", argon2Params.timeCost);
+			}
+			if (config.getType("hashing.argon2_memory") == ConfigOptionType_None)
+			{
+				config.setInt("hashing.argon2_memory", argon2Params.memoryCost);
+			}
+			if (config.getType("hashing.argon2_parallelism") == ConfigOptionType_None)
+			{
+				config.setInt("hashing.argon2_parallelism", argon2Params.parallelism);
+			}
+		}
+	}
+
+	void onLoad(ICore* c) override
+	{
+		core = c;
+		core->getEventDispatcher().addEventHandler(this);
+
+		IConfig& config = core->getConfig();
+		threadCount = *config.getInt("hashing.threads");
+		bcryptCost = std::clamp(*config.getInt("hashing.bcrypt_cost"), Bcrypt::MinCost, Bcrypt::MaxCost);
+		argon2Params.timeCost = std::clamp<int>(*config.getInt("hashing.argon2_time"), 1, Argon2::MaxTimeCost);
+		argon2Params.parallelism = std::clamp<int>(*config.getInt("hashing.argon2_parallelism"), 1, Argon2::MaxParallelism);
+		argon2Params.memoryCost = std::clamp<int>(*config.getInt("hashing.argon2_memory"), 8 * argon2Params.parallelism, Argon2::MaxMemoryCost);
+
+		bcryptLimit = std::min(bcryptCost + VerifyCostIncrease, Bcrypt::MaxCost);
+		argon2Limits.timeCost = std::min(argon2Params.timeCost * VerifyCostFactor, Argon2::MaxTimeCost);
+		argon2Limits.memoryCost = std::min(argon2Params.memoryCost * VerifyCostFactor, Argon2::MaxMemoryCost);
+		argon2Limits.parallelism = std::min(argon2Params.parallelism * VerifyCostFactor, Argon2::MaxParallelism);
+
+		if (threadCount <= 0)
+		{
+			// Leave a core for the main thread, hashing is meant to be slow and would starve it otherwise.
+			threadCount = std::max<int>(1, int(std::thread::hardware_concurrency()) - 1);
+		}
+	}
+
+	void onInit(IComponentList* components) override
+	{
+		workers.reserve(threadCount);
+		for (int i = 0; i != threadCount; ++i)
+		{
+			workers.emplace_back(&HashingComponent::workerProc, this);
+		}
+	}
+
+	~HashingComponent()
+	{
+		stopWorkers();
+		if (core)
+		{
+			core->getEventDispatcher().removeEventHandler(this);
+		}
+	}
+
+	bool hashPassword(PasswordHashHandler* handler, PasswordHashType type, StringView password, int cost) override
+	{
+		if (!handler || (type != PasswordHashType_Bcrypt && type != PasswordHashType_Argon2id))
+		{
+			return false;
+		}
+
+		Job job;
+		job.hashHandler = handler;
+		job.type = type;
+		job.password = String(password);
+		if (type == PasswordHashType_Argon2id)
+		{
+			// Hashes are held to the same limits as verification, or they couldn't be checked later.
+			job.cost = cost < 0 ? int(argon2Params.timeCost) : std::clamp<int>(cost, 1, argon2Limits.timeCost);
+		}
+		else
+		{
+			job.cost = cost < 0 ? bcryptCost : std::clamp(cost, Bcrypt::MinCost, bcryptLimit);
+		}
+		return enqueue(std::move(job));
+	}
+
+	bool checkPassword(PasswordCheckHandler* handler, StringView password, StringView hash) override
+	{
+		if (!handler)
+		{
+			return false;
+		}
+
+		Job job;
+		job.checkHandler = handler;
+		job.password = String(password);
+		job.hash = String(hash);
+		return enqueue(std::move(job));
+	}
+
+	size_t getPendingCount() const override
+	{
+		return pending;
+	}
+
+	void onTick(Microseconds elapsed, TimePoint now) override
+	{
+		if (pending == 0)
+		{
+			return;
+		}
+
+		DynamicArray<Job> results;
+		{
+			std::scoped_lock<std::mutex> lock(queueMutex);
+			results.swap(finished);
+		}
+
+		deliver(results);
+	}
+
+	void free() override
+	{
+		delete this;
+	}
+
+	void reset() override
+	{
+	}
+};
+
+COMPONENT_ENTRY_POINT()
+{
+	return new HashingComponent();
+}
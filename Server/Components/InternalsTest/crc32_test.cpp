@@ -0,0 +1,62 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include "internals_test.hpp"
+#include "../CustomModels/crc32.hpp"
+
+/// The plain bit at a time CRC the tables are built from
+static uint32_t bitwiseCRC32(uint32_t checksum, const uint8_t* buffer, size_t length)
+{
+	checksum = ~checksum;
+	while (length--)
+	{
+		checksum ^= *buffer++;
+		for (int bit = 0; bit != 8; ++bit)
+		{
+			checksum = (checksum >> 1) ^ (0xEDB88320u & (0u - (checksum & 1u)));
+		}
+	}
+	return ~checksum;
+}
+
+bool testCRC32(ICore& core)
+{
+	bool ok = true;
+
+	// The standard check value
+	const uint8_t check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+	INTERNALS_CHECK(core, CRC32(0, check, sizeof(check)) == 0xCBF43926u);
+	INTERNALS_CHECK(core, CRC32(0, check, 0) == 0);
+
+	uint8_t data[1031];
+	uint32_t seed = 0x12345678;
+	for (uint8_t& byte : data)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		byte = uint8_t(seed >> 24);
+	}
+
+	// Every length and alignment around the 8 byte steps, so the tail loop is covered too
+	for (size_t offset = 0; offset != 8; ++offset)
+	{
+		for (size_t length = 0; length != 40; ++length)
+		{
+			INTERNALS_CHECK(core, CRC32(0, data + offset, length) == bitwiseCRC32(0, data + offset, length));
+		}
+	}
+	INTERNALS_CHECK(core, CRC32(0, data, sizeof(data)) == bitwiseCRC32(0, data, sizeof(data)));
+
+	// Checksums carry on across chunks, as they do reading a file
+	const uint32_t whole = CRC32(0, data, sizeof(data));
+	for (size_t split : { size_t(1), size_t(7), size_t(8), size_t(513), sizeof(data) - 1 })
+	{
+		INTERNALS_CHECK(core, CRC32(CRC32(0, data, split), data + split, sizeof(data) - split) == whole);
+	}
+
+	return ok;
+}
@@ -0,0 +1,165 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include "internals_test.hpp"
+#include "../Databases/database_worker.hpp"
+
+namespace
+{
+/// Keeps what the worker ran, in the order it handed it over
+struct CollectedQueries final : public DatabaseQueryCompletion
+{
+	std::mutex mutex;
+	DynamicArray<DatabaseQueryJob> jobs;
+
+	void complete(DynamicArray<DatabaseQueryJob>& completed) override
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (DatabaseQueryJob& job : completed)
+		{
+			jobs.emplace_back(std::move(job));
+		}
+	}
+};
+
+/// `SELECT omp_test_gate()` holds the worker up until the gate is opened, so everything queued meanwhile is
+/// waiting together and goes in one batch
+struct Gate
+{
+	std::mutex mutex;
+	std::condition_variable cv;
+	bool open = false;
+
+	static void wait(sqlite3_context* context, int, sqlite3_value**)
+	{
+		Gate& gate = *static_cast<Gate*>(sqlite3_user_data(context));
+		std::unique_lock<std::mutex> lock(gate.mutex);
+		gate.cv.wait(lock, [&gate]()
+			{
+				return gate.open;
+			});
+		sqlite3_result_null(context);
+	}
+
+	void close()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		open = false;
+	}
+
+	void release()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		open = true;
+		cv.notify_all();
+	}
+};
+
+void post(DatabaseWorker& worker, char const* query)
+{
+	DatabaseQueryJob job;
+	job.query = query;
+	worker.post(std::move(job));
+}
+
+/// Every value in a table's `v` column, in order
+String values(sqlite3* handle, char const* table)
+{
+	String out;
+	const String query = String("SELECT v FROM ") + table + " ORDER BY v";
+	sqlite3_exec(handle, query.c_str(), [](void* userData, int, char** values, char**)
+		{
+			String& out = *static_cast<String*>(userData);
+			out += out.empty() ? "" : ",";
+			out += values[0] ? values[0] : "null";
+			return SQLITE_OK;
+		},
+		&out, nullptr);
+	return out;
+}
+}
+
+bool testDatabaseWorker(ICore& core)
+{
+	bool ok = true;
+
+	sqlite3* handle = nullptr;
+	INTERNALS_CHECK(core, sqlite3_open_v2(":memory:", &handle, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr) == SQLITE_OK);
+	if (!ok)
+	{
+		sqlite3_close_v2(handle);
+		return false;
+	}
+
+	Gate gate;
+	sqlite3_create_function_v2(handle, "omp_test_gate", 0, SQLITE_UTF8, &gate, &Gate::wait, nullptr, nullptr, nullptr);
+	sqlite3_exec(handle,
+		"PRAGMA foreign_keys = ON;"
+		"CREATE TABLE parent (v INTEGER PRIMARY KEY);"
+		"CREATE TABLE child (v INTEGER REFERENCES parent (v) DEFERRABLE INITIALLY DEFERRED);"
+		"CREATE TABLE t (v INTEGER PRIMARY KEY);"
+		"CREATE TABLE log (v INTEGER);",
+		nullptr, nullptr, nullptr);
+
+	CollectedQueries collected;
+	DatabaseWorker worker(collected, handle, 100);
+
+	// A failing query in a batch only loses its own changes
+	post(worker, "SELECT omp_test_gate()");
+	post(worker, "INSERT INTO t VALUES (1)");
+	post(worker, "INSERT INTO t VALUES (2), (1)");
+	post(worker, "INSERT INTO t VALUES (3)");
+	gate.release();
+	worker.flush();
+	INTERNALS_CHECK(core, values(handle, "t") == "1,3");
+	INTERNALS_CHECK(core, collected.jobs.size() == 4);
+	INTERNALS_CHECK(core, collected.jobs.size() == 4 && collected.jobs[1].succeeded && !collected.jobs[2].succeeded && collected.jobs[3].succeeded);
+
+	// The deferred foreign key fails the batch's commit, which is then run again one query at a time
+	collected.jobs.clear();
+	gate.close();
+	post(worker, "SELECT omp_test_gate()");
+	post(worker, "INSERT INTO t VALUES (4)");
+	post(worker, "INSERT INTO child VALUES (99)");
+	post(worker, "INSERT INTO t VALUES (5)");
+	gate.release();
+	worker.flush();
+	INTERNALS_CHECK(core, values(handle, "t") == "1,3,4,5");
+	INTERNALS_CHECK(core, values(handle, "child") == "");
+	INTERNALS_CHECK(core, collected.jobs.size() == 4 && collected.jobs[1].succeeded && !collected.jobs[2].succeeded && collected.jobs[3].succeeded);
+
+	// Queries with several statements run alone, exactly once, even when one of them commits
+	collected.jobs.clear();
+	gate.close();
+	post(worker, "SELECT omp_test_gate()");
+	post(worker, "INSERT INTO log VALUES (20)");
+	post(worker, "INSERT INTO log VALUES (21); COMMIT");
+	post(worker, "INSERT INTO log VALUES (22)");
+	post(worker, "INSERT INTO log VALUES (23); INSERT INTO log VALUES (24);");
+	post(worker, "INSERT INTO log VALUES (25);");
+	gate.release();
+	worker.flush();
+	INTERNALS_CHECK(core, values(handle, "log") == "20,21,22,23,24,25");
+	INTERNALS_CHECK(core, collected.jobs.size() == 6 && collected.jobs[1].succeeded && !collected.jobs[2].succeeded && collected.jobs[4].succeeded && collected.jobs[5].succeeded);
+
+	// Rows come back with their names, shared between rows of one statement
+	collected.jobs.clear();
+	post(worker, "SELECT v, v * 2 AS twice FROM t WHERE v < 4 ORDER BY v");
+	worker.flush();
+	INTERNALS_CHECK(core, collected.jobs.size() == 1 && collected.jobs[0].succeeded && collected.jobs[0].rows.size() == 2);
+	if (collected.jobs.size() == 1 && collected.jobs[0].rows.size() == 2)
+	{
+		const DatabaseQueryJob& job = collected.jobs[0];
+		INTERNALS_CHECK(core, job.names.size() == 2 && job.names[1] == "twice" && job.rows[0].names == job.rows[1].names);
+		INTERNALS_CHECK(core, job.values[job.rows[1].values] == "3" && job.values[job.rows[1].values + 1] == "6");
+	}
+
+	worker.stop();
+	sqlite3_close_v2(handle);
+	return ok;
+}
@@ -0,0 +1,144 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include "internals_test.hpp"
+#include "../../Source/event_dispatcher.hpp"
+
+namespace
+{
+struct TestEventHandler
+{
+	virtual void onTest(int depth) = 0;
+};
+
+using TestDispatcher = SortedEventDispatcher<TestEventHandler>;
+
+/// Writes its id to the shared log when called, then does whatever the test gave it to do
+struct RecordingHandler final : public TestEventHandler
+{
+	char id;
+	String& log;
+	void (*action)(RecordingHandler& self, int depth) = nullptr;
+	TestDispatcher* dispatcher = nullptr;
+	TestEventHandler* other = nullptr;
+
+	RecordingHandler(char id, String& log)
+		: id(id)
+		, log(log)
+	{
+	}
+
+	void onTest(int depth) override
+	{
+		log += id;
+		if (action)
+		{
+			action(*this, depth);
+		}
+	}
+};
+}
+
+bool testEventDispatcher(ICore& core)
+{
+	bool ok = true;
+
+	String log;
+	RecordingHandler a('a', log), b('b', log), c('c', log), d('d', log);
+	TestDispatcher dispatcher;
+
+	// Sorted by priority, ties in the order they were added
+	INTERNALS_CHECK(core, dispatcher.addEventHandler(&b, EventPriority_Default));
+	INTERNALS_CHECK(core, dispatcher.addEventHandler(&c, EventPriority_Default));
+	INTERNALS_CHECK(core, dispatcher.addEventHandler(&a, EventPriority_FairlyHigh));
+	INTERNALS_CHECK(core, !dispatcher.addEventHandler(&a, EventPriority_Lowest));
+	dispatcher.dispatch(&TestEventHandler::onTest, 0);
+	INTERNALS_CHECK(core, log == "abc");
+	INTERNALS_CHECK(core, dispatcher.count() == 3);
+
+	// A handler removing one further on and adding another mid dispatch: the removed one is skipped at once, the
+	// added one only takes part from the next event
+	a.dispatcher = &dispatcher;
+	a.action = [](RecordingHandler& self, int)
+	{
+		self.dispatcher->removeEventHandler(self.other);
+		self.dispatcher->addEventHandler(self.other, EventPriority_Lowest);
+	};
+	a.other = &b;
+	log.clear();
+	dispatcher.dispatch(&TestEventHandler::onTest, 0);
+	INTERNALS_CHECK(core, log == "ac");
+	event_order_t priority;
+	INTERNALS_CHECK(core, dispatcher.hasEventHandler(&b, priority) && priority == EventPriority_Lowest);
+	INTERNALS_CHECK(core, dispatcher.count() == 3);
+	a.action = nullptr;
+	log.clear();
+	dispatcher.dispatch(&TestEventHandler::onTest, 0);
+	INTERNALS_CHECK(core, log == "acb");
+
+	// Nested dispatches see the same handlers, and nothing moves until the outermost one returns
+	d.dispatcher = &dispatcher;
+	d.action = [](RecordingHandler& self, int depth)
+	{
+		if (depth == 0)
+		{
+			self.dispatcher->dispatch(&TestEventHandler::onTest, 1);
+		}
+		else
+		{
+			// Removing itself and the first handler, which has already been called on the outer dispatch
+			self.dispatcher->removeEventHandler(&self);
+			self.dispatcher->removeEventHandler(self.other);
+		}
+	};
+	d.other = &a;
+	INTERNALS_CHECK(core, dispatcher.addEventHandler(&d, EventPriority_Default));
+	log.clear();
+	dispatcher.dispatch(&TestEventHandler::onTest, 0);
+	INTERNALS_CHECK(core, log == "acd" "acdb" "b");
+	INTERNALS_CHECK(core, !dispatcher.hasEventHandler(&d, priority) && !dispatcher.hasEventHandler(&a, priority));
+	INTERNALS_CHECK(core, dispatcher.count() == 2);
+	log.clear();
+	dispatcher.dispatch(&TestEventHandler::onTest, 0);
+	INTERNALS_CHECK(core, log == "cb");
+
+	// Adding then removing within one dispatch leaves nothing behind
+	c.dispatcher = &dispatcher;
+	c.other = &a;
+	c.action = [](RecordingHandler& self, int)
+	{
+		self.dispatcher->addEventHandler(self.other, EventPriority_Highest);
+		self.dispatcher->removeEventHandler(self.other);
+	};
+	log.clear();
+	dispatcher.dispatch(&TestEventHandler::onTest, 0);
+	c.action = nullptr;
+	INTERNALS_CHECK(core, log == "cb");
+	INTERNALS_CHECK(core, dispatcher.count() == 2 && !dispatcher.hasEventHandler(&a, priority));
+
+	// stopAtFalse stops at the first handler to return false, anyTrue still calls every one
+	log.clear();
+	INTERNALS_CHECK(core, !dispatcher.stopAtFalse([](TestEventHandler* handler)
+		{
+			handler->onTest(0);
+			return false;
+		}));
+	INTERNALS_CHECK(core, log == "c");
+	log.clear();
+	INTERNALS_CHECK(core, dispatcher.anyTrue([](TestEventHandler* handler)
+		{
+			handler->onTest(0);
+			return true;
+		}));
+	INTERNALS_CHECK(core, log == "cb");
+
+	INTERNALS_CHECK(core, dispatcher.removeEventHandler(&b) && dispatcher.removeEventHandler(&c));
+	INTERNALS_CHECK(core, dispatcher.count() == 0);
+
+	return ok;
+}
@@ -0,0 +1,101 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include "internals_test.hpp"
+#include "../Hashing/argon2.hpp"
+#include "../Hashing/bcrypt.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+
+static String toHex(const uint8_t* data, size_t length)
+{
+	String out;
+	char digits[3];
+	for (size_t i = 0; i != length; ++i)
+	{
+		snprintf(digits, sizeof(digits), "%02x", data[i]);
+		out += digits;
+	}
+	return out;
+}
+
+bool testHashing(ICore& core)
+{
+	bool ok = true;
+
+	// RFC 7693 appendix A, plus the empty message and a multi-block one with a short digest
+	{
+		uint8_t digest[64];
+		Argon2::blake2b(digest, 64, "abc", 3);
+		INTERNALS_CHECK(core, toHex(digest, 64) == "ba80a53f981c4d0d6a2797b69f12f6e94c212f14685ac4b74b12bb6fdbffa2d17d87c5392aab792dc252d5de4533cc9518d38aa8dbf1925ab92386edd4009923");
+		Argon2::blake2b(digest, 64, "", 0);
+		INTERNALS_CHECK(core, toHex(digest, 64) == "786a02f742015903c6c6fd852552d272912f4740e15847618a86e217f71f5419d25e1031afee585313896444934eb04b903a685b1448b755d56f701afe9be2ce");
+		Argon2::blake2b(digest, 32, "abc", 3);
+		INTERNALS_CHECK(core, toHex(digest, 32) == "bddd813c634239723171ef3fee98579b94964e3bb1cb3e427262c8c068d52319");
+
+		uint8_t message[512];
+		for (size_t i = 0; i != sizeof(message); ++i)
+		{
+			message[i] = uint8_t(i);
+		}
+		Argon2::blake2b(digest, 64, message, sizeof(message));
+		INTERNALS_CHECK(core, toHex(digest, 64) == "c59ab1095ca4579525338b6b74689ff234bc3fe9765fe26dfb04ddceaee0ab84dfd8967594cb261fcd88687f4454d80f718116c1b3c32f9f7e169357468cbe67");
+	}
+
+	// RFC 9106 section 5.3, Argon2id with a secret and associated data
+	{
+		const String password(32, '\x01');
+		uint8_t salt[16], secret[8], ad[12], tag[32];
+		std::fill(std::begin(salt), std::end(salt), 0x02);
+		std::fill(std::begin(secret), std::end(secret), 0x03);
+		std::fill(std::begin(ad), std::end(ad), 0x04);
+		const Argon2::Params params = { 3, 32, 4 };
+		INTERNALS_CHECK(core, Argon2::derive(password, salt, sizeof(salt), params, tag, sizeof(tag), secret, sizeof(secret), ad, sizeof(ad)));
+		INTERNALS_CHECK(core, toHex(tag, sizeof(tag)) == "0d640df58d78766c08c037a34a8b53c9d01ef0452d75b65eb52520e96b01e659");
+	}
+
+	// PHC strings round trip, and costs above the limits are refused
+	{
+		const uint8_t salt[Argon2::SaltSize] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+		const Argon2::Params params = { 1, 64, 1 };
+		const String encoded = Argon2::hash("password", salt, params);
+		INTERNALS_CHECK(core, encoded.substr(0, 31) == "$argon2id$v=19$m=64,t=1,p=1$AQI");
+		INTERNALS_CHECK(core, Argon2::verify("password", encoded, params));
+		INTERNALS_CHECK(core, !Argon2::verify("passwore", encoded, params));
+
+		const Argon2::Params tight = { 1, 32, 1 };
+		INTERNALS_CHECK(core, !Argon2::verify("password", encoded, tight));
+		INTERNALS_CHECK(core, !Argon2::verify("password", "$argon2id$v=19$m=4194304,t=1,p=1$AQIDBAUGBwgJCgsMDQ4PEA$AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA", params));
+		INTERNALS_CHECK(core, !Argon2::verify("password", "$argon2id$v=19$m=64,t=1,p=1$AQIDBAUGBwgJCgsMDQ4PEA", params));
+	}
+
+	// OpenBSD bcrypt vectors
+	{
+		static const char* const Vectors[][2] = {
+			{ "", "$2a$06$DCq7YPn5Rq63x1Lad4cll.TV4S6ytwfsfvkgY8jIucDrjc8deX1s." },
+			{ "a", "$2a$06$m0CrhHm10qJ3lXRY.5zDGO3rS2KdeeWLuGmsfGlMfOxih58VYVfxe" },
+			{ "abc", "$2a$06$If6bvum7DFjUnE9p2uDeDu0YHzrHM6tf.iqN8.yx.jNN1ILEf7h0i" },
+			{ "abcdefghijklmnopqrstuvwxyz", "$2a$06$.rCVZVOThsIa97pEDOxvGuRRgzG64bvtJ0938xuqzv18d3ZpQhstC" },
+			{ "~!@#$%^&*()      ~!@#$%^&*()PNBFRD", "$2a$06$fPIsBO8qRqkjj273rfaOI.HtSV9jLDpTbZn782DC6/t7qT67P6FfO" },
+		};
+		for (const auto& vector : Vectors)
+		{
+			INTERNALS_CHECK(core, Bcrypt::verify(vector[0], vector[1], 6));
+			INTERNALS_CHECK(core, !Bcrypt::verify("wrong", vector[1], 6));
+			INTERNALS_CHECK(core, !Bcrypt::verify(vector[0], vector[1], 5));
+		}
+
+		const uint8_t salt[Bcrypt::SaltSize] = {};
+		const String hash = Bcrypt::hash("password", salt, 4);
+		INTERNALS_CHECK(core, hash.substr(0, 7) == "$2b$04$");
+		INTERNALS_CHECK(core, Bcrypt::verify("password", hash, 4));
+	}
+
+	return ok;
+}
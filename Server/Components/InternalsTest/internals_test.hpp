@@ -0,0 +1,32 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <sdk.hpp>
+
+/// Checks a condition, printing it with an [ERROR] prefix when it doesn't hold
+#define INTERNALS_CHECK(core, condition)                                                         \
+	do                                                                                           \
+	{                                                                                            \
+		if (!(condition))                                                                        \
+		{                                                                                        \
+			(core).printLn("[ERROR] %s:%d: \"%s\" doesn't hold.", __FILE__, __LINE__, #condition); \
+			ok = false;                                                                          \
+		}                                                                                        \
+	} while (false)
+
+/// Each test prints what failed and returns false if anything did
+bool testSPSCQueue(ICore& core);
+bool testHashing(ICore& core);
+bool testNameIndex(ICore& core);
+bool testPositionHistory(ICore& core);
+bool testCRC32(ICore& core);
+bool testEventDispatcher(ICore& core);
+bool testDatabaseWorker(ICore& core);
+bool testThreadRelay(ICore& core);
@@ -0,0 +1,78 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include "internals_test.hpp"
+
+/// Runs checks on pieces of other components that can't be reached through their interfaces
+struct InternalsTestComponent final : public IComponent, public NoCopy
+{
+	/// Core
+	ICore* core = nullptr;
+
+	/// Gets the component UID
+	/// @returns Component UID
+	UID getUID() override
+	{
+		return 0x6a0f3d81c5e2b947;
+	}
+
+	/// Gets the component name
+	/// @returns Component name
+	StringView componentName() const override
+	{
+		return "Internals test";
+	}
+
+	/// Gets the component type
+	/// @returns Component type
+	ComponentType componentType() const override
+	{
+		return ComponentType::Other;
+	}
+
+	/// Called for every component after components have been loaded
+	/// @param c Core
+	void onLoad(ICore* c) override
+	{
+		core = c;
+	}
+
+	/// Called when all components have been initialised
+	/// @param components Components list to query
+	void onInit(IComponentList* components) override
+	{
+		run("SPSC queue", &testSPSCQueue);
+		run("Hashing", &testHashing);
+		run("Name index", &testNameIndex);
+		run("Position history", &testPositionHistory);
+		run("CRC32", &testCRC32);
+		run("Event dispatcher", &testEventDispatcher);
+		run("Database worker", &testDatabaseWorker);
+		run("Thread relay", &testThreadRelay);
+	}
+
+	/// Runs one test and reports how it went
+	/// @param name Test name
+	/// @param test Test function
+	void run(const char* name, bool (*test)(ICore&))
+	{
+		if (test(*core))
+		{
+			core->printLn("%s test passed.", name);
+		}
+		else
+		{
+			core->printLn("[ERROR] %s test failed.", name);
+		}
+	}
+} internalsTestComponent;
+
+COMPONENT_ENTRY_POINT()
+{
+	return &internalsTestComponent;
+}
@@ -0,0 +1,70 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include "internals_test.hpp"
+#include "../../Source/name_index.hpp"
+
+namespace
+{
+struct Named
+{
+	StringView name;
+};
+}
+
+bool testNameIndex(ICore& core)
+{
+	bool ok = true;
+
+	Named alice { "Alice" }, albert { "albert" }, bob { "Bob" }, al { "AL" };
+	NameIndex<Named> index;
+	Named* found[4];
+
+	INTERNALS_CHECK(core, index.get("alice") == nullptr);
+	INTERNALS_CHECK(core, index.findByPrefix("", found, 4) == 0);
+
+	index.add(alice.name, alice);
+	index.add(albert.name, albert);
+	index.add(bob.name, bob);
+	index.add(al.name, al);
+
+	// Exact lookups ignore case
+	INTERNALS_CHECK(core, index.get("ALICE") == &alice);
+	INTERNALS_CHECK(core, index.get("al") == &al);
+	INTERNALS_CHECK(core, index.get("ali") == nullptr);
+
+	// Prefixes come out in name order and count every match, written or not
+	INTERNALS_CHECK(core, index.findByPrefix("aL", found, 4) == 3);
+	INTERNALS_CHECK(core, found[0] == &al && found[1] == &albert && found[2] == &alice);
+	INTERNALS_CHECK(core, index.findByPrefix("al", found, 1) == 3 && found[0] == &al);
+	INTERNALS_CHECK(core, index.findByPrefix("al", nullptr, 0) == 3);
+	INTERNALS_CHECK(core, index.findByPrefix("", found, 4) == 4);
+	INTERNALS_CHECK(core, index.findByPrefix("c", found, 4) == 0);
+
+	// Removing only takes the entry it's given, and prunes branches left unused
+	index.remove("alice", bob);
+	INTERNALS_CHECK(core, index.get("alice") == &alice);
+	index.remove(alice.name, alice);
+	INTERNALS_CHECK(core, index.get("alice") == nullptr);
+	INTERNALS_CHECK(core, index.findByPrefix("ali", found, 4) == 0);
+	INTERNALS_CHECK(core, index.findByPrefix("al", found, 4) == 2);
+
+	// A renamed entry is found by its new name only, and freed nodes are reused
+	index.remove(bob.name, bob);
+	bob.name = "Bobby";
+	index.add(bob.name, bob);
+	INTERNALS_CHECK(core, index.get("bob") == nullptr && index.get("bobby") == &bob);
+	INTERNALS_CHECK(core, index.findByPrefix("b", found, 4) == 1 && found[0] == &bob);
+
+	index.remove(al.name, al);
+	index.remove(albert.name, albert);
+	index.remove(bob.name, bob);
+	INTERNALS_CHECK(core, index.findByPrefix("", found, 4) == 0);
+
+	return ok;
+}
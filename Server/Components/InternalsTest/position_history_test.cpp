@@ -0,0 +1,59 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include "internals_test.hpp"
+#include "../../Source/position_history.hpp"
+
+static bool near(Vector3 a, Vector3 b)
+{
+	return glm::distance(a, b) < 0.001f;
+}
+
+bool testPositionHistory(ICore& core)
+{
+	bool ok = true;
+
+	PositionHistory history;
+	const TimePoint start = TimePoint::clock::now();
+	Vector3 position;
+
+	INTERNALS_CHECK(core, history.empty());
+	INTERNALS_CHECK(core, !history.getPositionAt(start, position));
+
+	// Moving along x at one unit every 100ms, standing still as far as velocity goes
+	for (int i = 0; i != 10; ++i)
+	{
+		history.push(start + Milliseconds(i * 100), Vector3(float(i), 0.0f, 0.0f), Vector3(0.0f));
+	}
+	INTERNALS_CHECK(core, !history.empty());
+
+	// On a sample, between two, and before the oldest
+	INTERNALS_CHECK(core, history.getPositionAt(start + Milliseconds(300), position) && near(position, Vector3(3.0f, 0.0f, 0.0f)));
+	INTERNALS_CHECK(core, history.getPositionAt(start + Milliseconds(450), position) && near(position, Vector3(4.5f, 0.0f, 0.0f)));
+	INTERNALS_CHECK(core, history.getPositionAt(start, position) && near(position, Vector3(0.0f)));
+	INTERNALS_CHECK(core, !history.getPositionAt(start - Milliseconds(1), position));
+
+	// Past the newest sample it extrapolates with the velocity, which is per 1/50 of a second, up to a limit
+	history.push(start + Milliseconds(1000), Vector3(10.0f, 0.0f, 0.0f), Vector3(0.0f, 0.1f, 0.0f));
+	INTERNALS_CHECK(core, history.getPositionAt(start + Milliseconds(1100), position) && near(position, Vector3(10.0f, 0.5f, 0.0f)));
+	INTERNALS_CHECK(core, history.getPositionAt(start + Milliseconds(5000), position) && near(position, Vector3(10.0f, 1.25f, 0.0f)));
+
+	// Old samples fall off once it's full
+	for (size_t i = 0; i != PositionHistory::Capacity; ++i)
+	{
+		history.push(start + Milliseconds(2000 + i * 10), Vector3(100.0f), Vector3(0.0f));
+	}
+	INTERNALS_CHECK(core, !history.getPositionAt(start + Milliseconds(1500), position));
+	INTERNALS_CHECK(core, history.getPositionAt(start + Milliseconds(2005), position) && near(position, Vector3(100.0f)));
+
+	history.clear();
+	INTERNALS_CHECK(core, history.empty());
+	INTERNALS_CHECK(core, !history.getPositionAt(start + Milliseconds(2005), position));
+
+	return ok;
+}
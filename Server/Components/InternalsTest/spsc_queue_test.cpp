@@ -0,0 +1,76 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include "internals_test.hpp"
+#include "../LegacyNetwork/spsc_queue.hpp"
+#include <thread>
+
+bool testSPSCQueue(ICore& core)
+{
+	bool ok = true;
+
+	// One slot is kept free, so a queue of 8 holds 7
+	SPSCQueue<int, 8> queue;
+	int item = 0;
+	INTERNALS_CHECK(core, !queue.pop(item));
+	for (int i = 0; i != 7; ++i)
+	{
+		INTERNALS_CHECK(core, queue.push(i));
+	}
+	INTERNALS_CHECK(core, !queue.push(7));
+	for (int i = 0; i != 7; ++i)
+	{
+		INTERNALS_CHECK(core, queue.pop(item) && item == i);
+	}
+	INTERNALS_CHECK(core, !queue.pop(item));
+
+	// Wrap around the end a few times
+	for (int i = 0; i != 20; ++i)
+	{
+		INTERNALS_CHECK(core, queue.push(i) && queue.push(i + 100));
+		INTERNALS_CHECK(core, queue.pop(item) && item == i);
+		INTERNALS_CHECK(core, queue.pop(item) && item == i + 100);
+	}
+
+	// Across two threads everything arrives once and in order
+	constexpr int Count = 200000;
+	SPSCQueue<int, 64> shared;
+	std::thread producer([&shared]()
+		{
+			for (int i = 0; i != Count;)
+			{
+				if (shared.push(i))
+				{
+					++i;
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+			}
+		});
+	int expected = 0;
+	bool ordered = true;
+	while (expected != Count)
+	{
+		if (shared.pop(item))
+		{
+			ordered = ordered && item == expected;
+			++expected;
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+	producer.join();
+	INTERNALS_CHECK(core, ordered);
+	INTERNALS_CHECK(core, !shared.pop(item));
+
+	return ok;
+}
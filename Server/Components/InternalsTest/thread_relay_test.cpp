@@ -0,0 +1,96 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include "internals_test.hpp"
+#include "../Pawn/Manager/ThreadRelay.hpp"
+
+#include <thread>
+
+namespace
+{
+/// Stands in for a public call, which asks for `natives` main thread natives one after another
+struct EventJob
+{
+	int natives = 0;
+};
+
+/// Stands in for a native call, the main thread adds one to it
+struct NativeRequest
+{
+	int value = 0;
+};
+
+using Relay = ThreadRelay<EventJob, NativeRequest>;
+}
+
+bool testThreadRelay(ICore& core)
+{
+	bool ok = true;
+
+	constexpr int Events = 200;
+	constexpr int NativesPerEvent = 5;
+	// Generous for a loaded machine, the point is that a tick isn't limited to one native per script
+	constexpr Microseconds Budget = Milliseconds(100);
+
+	Relay relay(Events);
+	int served = 0;
+	const auto serve = [&served](NativeRequest& request)
+	{
+		++request.value;
+		++served;
+	};
+
+	// Nothing queued: returns straight away, whatever the deadline
+	const TimePoint before = Time::now();
+	relay.serve(TimePoint::max(), serve);
+	INTERNALS_CHECK(core, served == 0 && Time::now() - before < Budget);
+
+	// The queue is full once `Events` are waiting
+	for (int i = 0; i != Events; ++i)
+	{
+		INTERNALS_CHECK(core, relay.post(EventJob { NativesPerEvent }));
+	}
+	INTERNALS_CHECK(core, !relay.post(EventJob { NativesPerEvent }));
+
+	int finished = 0;
+	int wrong = 0;
+	std::thread worker([&relay, &finished, &wrong]()
+		{
+			EventJob job;
+			while (relay.next(job))
+			{
+				for (int i = 0; i != job.natives; ++i)
+				{
+					NativeRequest request;
+					relay.ask(request);
+					wrong += request.value != 1;
+				}
+				++finished;
+			}
+		});
+
+	int ticks = 0;
+	while (served != Events * NativesPerEvent && ticks != Events * NativesPerEvent)
+	{
+		relay.serve(Time::now() + Budget, serve);
+		++ticks;
+	}
+	INTERNALS_CHECK(core, served == Events * NativesPerEvent);
+	// Serving one native per tick would take a tick per native
+	INTERNALS_CHECK(core, ticks <= Events / 10);
+
+	// Stopping lets the worker finish, serving it as long as that takes
+	relay.post(EventJob { NativesPerEvent });
+	relay.stop();
+	relay.serve(TimePoint::max(), serve);
+	worker.join();
+	INTERNALS_CHECK(core, finished == Events + 1 && wrong == 0);
+	INTERNALS_CHECK(core, served == (Events + 1) * NativesPerEvent);
+
+	return ok;
+}
@@ -14,9 +14,55 @@
 #include <raknet/PacketEnumerations.h>
 #include <raknet/RakPeer.h>
 #include <ttmath/ttmath.h>
+#include <algorithm>
+#include <bitset>
 
 #define RPCHOOK(id) rakNetServer.RegisterAsRemoteProcedureCall(id, &RakNetLegacyNetwork::RPCHook<id>, this)
 
+static thread_local bool isReceiveThread = false;
+
+/// Cheap checks done on the receive thread, rejecting sync packets the Players handlers would reject anyway
+struct SyncPacketRule
+{
+	uint8_t id;
+	unsigned minBytes; // Smallest valid packet, including the packet ID
+	int weaponOffset; // Byte holding the weapon ID in its low six bits, -1 if there isn't one
+	bool superseded; // Only the newest packet of this kind in a tick is worth applying
+};
+
+static const SyncPacketRule SyncPacketRules[] = {
+	{ NetCode::Packet::PlayerFootSync::PacketID, 69, 37, true },
+	{ NetCode::Packet::PlayerVehicleSync::PacketID, 64, 55, true },
+	{ NetCode::Packet::PlayerPassengerSync::PacketID, 25, 4, true },
+	{ NetCode::Packet::PlayerAimSync::PacketID, 32, -1, true },
+	{ NetCode::Packet::PlayerSpectatorSync::PacketID, 19, -1, true },
+	{ NetCode::Packet::PlayerStatsSync::PacketID, 9, -1, true },
+	{ NetCode::Packet::PlayerUnoccupiedSync::PacketID, 68, -1, false },
+	{ NetCode::Packet::PlayerTrailerSync::PacketID, 55, -1, false },
+	{ NetCode::Packet::PlayerBulletSync::PacketID, 41, -1, false },
+};
+
+static const SyncPacketRule* findSyncPacketRule(uint8_t id)
+{
+	for (const SyncPacketRule& rule : SyncPacketRules)
+	{
+		if (rule.id == id)
+		{
+			return &rule;
+		}
+	}
+	return nullptr;
+}
+
+static bool isSyncPacketValid(const SyncPacketRule& rule, const RakNet::Packet& pkt)
+{
+	if (pkt.bitSize < rule.minBytes * 8)
+	{
+		return false;
+	}
+	return rule.weaponOffset < 0 || WeaponSlotData(pkt.data[rule.weaponOffset] & 0x3F).slot() != INVALID_WEAPON_SLOT;
+}
+
 RakNetLegacyNetwork::RakNetLegacyNetwork()
 	: Network(256, 256)
 	, core(nullptr)
@@ -297,6 +343,7 @@ RakNetLegacyNetwork::~RakNetLegacyNetwork()
 		npcComponent->getPoolEventDispatcher().removeEventHandler(this);
 	}
 
+	stopReceiveThread();
 	rakNetServer.Disconnect(300);
 	RakNet::RakNetworkFactory::DestroyRakServerInterface(&rakNetServer);
 }
@@ -365,6 +412,7 @@ IPlayer* RakNetLegacyNetwork::OnPeerConnect(RakNet::RPCParameters* rpcParams, bo
 			// Entry denied, send reason and disconnect
 			RakNet::BitStream bss;
 			bss.Write(uint8_t(newConnectionResult.first));
+			RakNetLock lock(rakNetMutex);
 			rakNetServer.RPC(130, &bss, RakNet::HIGH_PRIORITY, RakNet::UNRELIABLE, 0, rid, false, false, RakNet::UNASSIGNED_NETWORK_ID, nullptr);
 		}
 		return nullptr;
@@ -372,13 +420,28 @@ IPlayer* RakNetLegacyNetwork::OnPeerConnect(RakNet::RPCParameters* rpcParams, bo
 
 	playerFromRakIndex[rpcParams->senderIndex] = newConnectionResult.second;
 
+	if (capture.isOpen())
+	{
+		const ClientVersion clientVersion = version == LegacyClientVersion_037 ? ClientVersion::ClientVersion_SAMP_037 : ClientVersion::ClientVersion_SAMP_03DL;
+		capture.writeConnect(newConnectionResult.second->getID(), isNPC, clientVersion, name, versionName);
+	}
+
 	return newConnectionResult.second;
 }
 
 void RakNetLegacyNetwork::OnPlayerConnect(RakNet::RPCParameters* rpcParams, void* extra)
 {
 	RakNetLegacyNetwork* network = reinterpret_cast<RakNetLegacyNetwork*>(extra);
-	RakNet::RakPeer::RemoteSystemStruct* remoteSystem = network->rakNetServer.GetRemoteSystemFromPlayerID(rpcParams->sender);
+	if (network->deferRPC(rpcParams, &RakNetLegacyNetwork::OnPlayerConnect))
+	{
+		return;
+	}
+
+	RakNet::RakPeer::RemoteSystemStruct* remoteSystem;
+	{
+		RakNetLock lock(network->rakNetMutex);
+		remoteSystem = network->rakNetServer.GetRemoteSystemFromPlayerID(rpcParams->sender);
+	}
 
 	if (!remoteSystem || remoteSystem->connectMode != RakNet::RakPeer::RemoteSystemStruct::ConnectMode::CONNECTED)
 	{
@@ -387,6 +450,7 @@ void RakNetLegacyNetwork::OnPlayerConnect(RakNet::RPCParameters* rpcParams, void
 
 	if (remoteSystem->sampData.authType != SAMPRakNet::AuthType_Player)
 	{
+		RakNetLock lock(network->rakNetMutex);
 		network->rakNetServer.Kick(rpcParams->sender);
 		return;
 	}
@@ -395,6 +459,7 @@ void RakNetLegacyNetwork::OnPlayerConnect(RakNet::RPCParameters* rpcParams, void
 	NetCode::RPC::PlayerConnect playerConnectRPC;
 	if (!playerConnectRPC.read(bs))
 	{
+		RakNetLock lock(network->rakNetMutex);
 		network->rakNetServer.Kick(rpcParams->sender);
 		return;
 	}
@@ -428,6 +493,7 @@ void RakNetLegacyNetwork::OnPlayerConnect(RakNet::RPCParameters* rpcParams, void
 		PeerAddress::ToString(address, addressString);
 
 		network->core->logLn(LogLevel::Warning, "Invalid client connecting from %.*s", int(addressString.length()), addressString.data());
+		RakNetLock lock(network->rakNetMutex);
 		network->rakNetServer.Kick(rpcParams->sender);
 		network->rakNetServer.AddToBanList(addressString.data(), 15'000u);
 		return;
@@ -442,6 +508,7 @@ void RakNetLegacyNetwork::OnPlayerConnect(RakNet::RPCParameters* rpcParams, void
 	IPlayer* newPeer = network->OnPeerConnect(rpcParams, false, serial, playerConnectRPC.VersionNumber, playerConnectRPC.VersionString, playerConnectRPC.ChallengeResponse, playerConnectRPC.Name, isUsingOmp, playerConnectRPC.IsUsingOfficialClient);
 	if (!newPeer)
 	{
+		RakNetLock lock(network->rakNetMutex);
 		network->rakNetServer.Kick(rpcParams->sender);
 		return;
 	}
@@ -475,7 +542,16 @@ void RakNetLegacyNetwork::OnPlayerConnect(RakNet::RPCParameters* rpcParams, void
 void RakNetLegacyNetwork::OnNPCConnect(RakNet::RPCParameters* rpcParams, void* extra)
 {
 	RakNetLegacyNetwork* network = reinterpret_cast<RakNetLegacyNetwork*>(extra);
-	RakNet::RakPeer::RemoteSystemStruct* remoteSystem = network->rakNetServer.GetRemoteSystemFromPlayerID(rpcParams->sender);
+	if (network->deferRPC(rpcParams, &RakNetLegacyNetwork::OnNPCConnect))
+	{
+		return;
+	}
+
+	RakNet::RakPeer::RemoteSystemStruct* remoteSystem;
+	{
+		RakNetLock lock(network->rakNetMutex);
+		remoteSystem = network->rakNetServer.GetRemoteSystemFromPlayerID(rpcParams->sender);
+	}
 
 	if (!remoteSystem || remoteSystem->connectMode != RakNet::RakPeer::RemoteSystemStruct::ConnectMode::CONNECTED)
 	{
@@ -519,6 +595,17 @@ void RakNetLegacyNetwork::OnNPCConnect(RakNet::RPCParameters* rpcParams, void* e
 	}
 }
 
+void RakNetLegacyNetwork::accountBroadcast(PacketAccountingKind kind, uint8_t id, size_t size, const IPlayer* exceptPeer)
+{
+	for (IPlayer* player : core->getPlayers().entries())
+	{
+		if (player != exceptPeer && player->getNetworkData().network == this)
+		{
+			accounting.add(*player, kind, PacketAccountingDirection_Out, id, size);
+		}
+	}
+}
+
 void RakNetLegacyNetwork::OnRakNetDisconnect(RakNet::PlayerIndex rid, PeerDisconnectReason reason)
 {
 	IPlayer* player = playerFromRakIndex[rid];
@@ -528,6 +615,11 @@ void RakNetLegacyNetwork::OnRakNetDisconnect(RakNet::PlayerIndex rid, PeerDiscon
 		return;
 	}
 
+	if (capture.isOpen())
+	{
+		capture.writeDisconnect(player->getID(), uint8_t(reason));
+	}
+
 	playerFromRakIndex[rid] = nullptr;
 	playerRemoteSystem[player->getID()] = nullptr;
 	networkEventDispatcher.dispatch(&NetworkEventHandler::onPeerDisconnect, *player, reason);
@@ -537,6 +629,11 @@ template <size_t ID>
 void RakNetLegacyNetwork::RPCHook(RakNet::RPCParameters* rpcParams, void* extra)
 {
 	RakNetLegacyNetwork* network = reinterpret_cast<RakNetLegacyNetwork*>(extra);
+	if (network->deferRPC(rpcParams, &RakNetLegacyNetwork::RPCHook<ID>))
+	{
+		return;
+	}
+
 	const RakNet::PlayerIndex senderId = rpcParams->senderIndex;
 
 	if (senderId >= network->playerFromRakIndex.size())
@@ -553,23 +650,43 @@ void RakNetLegacyNetwork::RPCHook(RakNet::RPCParameters* rpcParams, void* extra)
 
 	NetworkBitStream bs = GetBitStream(*rpcParams);
 
-	if (!network->inEventDispatcher.stopAtFalse(
-			[&player, &bs](NetworkInEventHandler* handler)
-			{
-				bs.resetReadPointer();
-				return handler->onReceiveRPC(*player, ID, bs);
-			}))
+	if (network->capture.isOpen())
 	{
-		return;
+		network->capture.writeRPC(player->getID(), uint8_t(ID), rpcParams->input, rpcParams->numberOfBitsOfData);
 	}
 
-	if (!network->rpcInEventDispatcher.stopAtFalse(
+	const bool accounting = network->accounting.enabled();
+	TimePoint start;
+	if (accounting)
+	{
+		network->accounting.add(*player, PacketAccountingKind_RPC, PacketAccountingDirection_In, uint8_t(ID), bitsToBytes(rpcParams->numberOfBitsOfData));
+		start = Time::now();
+	}
+
+	bool handled = network->inEventDispatcher.stopAtFalse(
+		[&player, &bs](NetworkInEventHandler* handler)
+		{
+			bs.resetReadPointer();
+			return handler->onReceiveRPC(*player, ID, bs);
+		});
+
+	if (handled)
+	{
+		handled = network->rpcInEventDispatcher.stopAtFalse(
 			ID,
 			[&player, &bs](SingleNetworkInEventHandler* handler)
 			{
 				bs.resetReadPointer();
 				return handler->onReceive(*player, bs);
-			}))
+			});
+	}
+
+	if (accounting)
+	{
+		network->accounting.addHandlerTime(*player, PacketAccountingKind_RPC, uint8_t(ID), duration_cast<Microseconds>(Time::now() - start));
+	}
+
+	if (!handled)
 	{
 		return;
 	}
@@ -595,8 +712,13 @@ void RakNetLegacyNetwork::synchronizeBans()
 
 		const PeerNetworkData::NetworkID& nid = netData.networkID;
 		const RakNet::PlayerID rid { unsigned(nid.address.v4), nid.port };
-		rakNetServer.GetPlayerIPFromID(rid, addr, &port);
-		if (rakNetServer.IsBanned(addr))
+		bool banned;
+		{
+			RakNetLock lock(rakNetMutex);
+			rakNetServer.GetPlayerIPFromID(rid, addr, &port);
+			banned = rakNetServer.IsBanned(addr);
+		}
+		if (banned)
 		{
 			player->kick();
 		}
@@ -608,13 +730,17 @@ void RakNetLegacyNetwork::ban(const BanEntry& entry, Milliseconds expire)
 	// Only support ipv4
 	if (entry.address != StringView("127.0.0.1"))
 	{
-		rakNetServer.AddToBanList(entry.address.data(), expire.count());
+		{
+			RakNetLock lock(rakNetMutex);
+			rakNetServer.AddToBanList(entry.address.data(), expire.count());
+		}
 		synchronizeBans();
 	}
 }
 
 void RakNetLegacyNetwork::unban(const BanEntry& entry)
 {
+	RakNetLock lock(rakNetMutex);
 	rakNetServer.RemoveFromBanList(entry.address.data());
 }
 
@@ -643,6 +769,8 @@ NetworkStats RakNetLegacyNetwork::getStatistics(IPlayer* player)
 		}
 	}
 
+	// The statistics point in to RakNet, keep it locked until we're done reading them
+	RakNetLock lock(rakNetMutex);
 	RakNet::RakNetStatisticsStruct* raknetStats = rakNetServer.GetStatistics(playerID);
 
 	// Return empty statistics structure if raknet failed to provide statistics
@@ -795,6 +923,7 @@ void RakNetLegacyNetwork::update()
 
 	StringView password = config.getString("password");
 	query.setPassworded(!password.empty());
+	RakNetLock lock(rakNetMutex);
 	rakNetServer.SetPassword(password.empty() ? 0 : password.data());
 
 	query.buildConfigDependentBuffers();
@@ -822,6 +951,7 @@ void RakNetLegacyNetwork::init(ICore* c)
 	core->getEventDispatcher().addEventHandler(this);
 	core->getPlayers().getPlayerChangeDispatcher().addEventHandler(this);
 	core->getPlayers().getPlayerConnectDispatcher().addEventHandler(this, EventPriority_Lowest);
+	accounting.init(core->getConfig());
 }
 
 void RakNetLegacyNetwork::start()
@@ -915,73 +1045,363 @@ void RakNetLegacyNetwork::start()
 	{
 		rakNetServer.ReserveSlots(npcComponent->count());
 	}
+
+	StringView captureFile = config.getString("network.capture_file");
+	if (!captureFile.empty())
+	{
+		bool* maskInput = config.getBool("network.capture_mask_input");
+		capture.setMaskInput(!maskInput || *maskInput);
+		if (capture.open(captureFile, Time::now()))
+		{
+			core->logLn(LogLevel::Warning, "Capturing all received network traffic to %.*s", PRINT_VIEW(captureFile));
+			if (maskInput && !*maskInput)
+			{
+				core->logLn(LogLevel::Warning, "Network capture input masking is off, passwords players type will be in the capture");
+			}
+		}
+		else
+		{
+			core->logLn(LogLevel::Error, "Unable to open network capture file %.*s", PRINT_VIEW(captureFile));
+		}
+	}
+
+	bool* useReceiveThread = config.getBool("network.use_receive_thread");
+	if (useReceiveThread && *useReceiveThread)
+	{
+		receiveInterval = Milliseconds(std::max(sleep, 1));
+		startReceiveThread();
+	}
 }
 
 void RakNetLegacyNetwork::onTick(Microseconds elapsed, TimePoint now)
 {
-	for (RakNet::Packet* pkt = rakNetServer.Receive(); pkt; pkt = rakNetServer.Receive())
+	if (capture.isOpen())
 	{
-		if (pkt->playerIndex >= playerFromRakIndex.size())
+		capture.beginTick(now);
+	}
+
+	if (receivePeers)
+	{
+		processReceiveQueues();
+		reportReceiveOverflow(now);
+	}
+	else
+	{
+		for (RakNet::Packet* pkt = rakNetServer.Receive(); pkt; pkt = rakNetServer.Receive())
 		{
-			rakNetServer.DeallocatePacket(pkt);
-			continue;
+			processPacket(pkt);
 		}
+	}
 
-		IPlayer* player = playerFromRakIndex[pkt->playerIndex];
+	if (now - lastCookieSeed > cookieSeedTime)
+	{
+		SAMPRakNet::SeedCookie();
+		lastCookieSeed = now;
+	}
+}
 
-		// We shouldn't be needing this, it's only here IF somehow this is happening again
-		// So users can report it to us
-		if (player && player->getID() == -1)
-		{
-			rakNetServer.Kick(pkt->playerId);
-			playerFromRakIndex[pkt->playerIndex] = nullptr;
-			core->logLn(LogLevel::Warning, "RakNet player %d with open.mp player pool id -1  was found and deleted. Packet ID: %d", pkt->playerIndex, pkt->data[0]);
-			core->logLn(LogLevel::Warning, "Please contact us by creating an issue in our repository at https://github.com/openmultiplayer/open.mp");
-			rakNetServer.DeallocatePacket(pkt);
-			continue;
-		}
+void RakNetLegacyNetwork::processPacket(RakNet::Packet* pkt)
+{
+	if (pkt->playerIndex >= playerFromRakIndex.size())
+	{
+		RakNetLock lock(rakNetMutex);
+		rakNetServer.DeallocatePacket(pkt);
+		return;
+	}
+
+	IPlayer* player = playerFromRakIndex[pkt->playerIndex];
 
-		if (player)
+	// We shouldn't be needing this, it's only here IF somehow this is happening again
+	// So users can report it to us
+	if (player && player->getID() == -1)
+	{
+		RakNetLock lock(rakNetMutex);
+		rakNetServer.Kick(pkt->playerId);
+		playerFromRakIndex[pkt->playerIndex] = nullptr;
+		core->logLn(LogLevel::Warning, "RakNet player %d with open.mp player pool id -1  was found and deleted. Packet ID: %d", pkt->playerIndex, pkt->data[0]);
+		core->logLn(LogLevel::Warning, "Please contact us by creating an issue in our repository at https://github.com/openmultiplayer/open.mp");
+		rakNetServer.DeallocatePacket(pkt);
+		return;
+	}
+
+	if (player)
+	{
+		const unsigned int bits = pkt->bitSize;
+		NetworkBitStream bs(pkt->data, bitsToBytes(bits), false);
+		bs.SetWriteOffset(bits);
+		uint8_t type;
+		if (bs.readUINT8(type))
 		{
-			const unsigned int bits = pkt->bitSize;
-			NetworkBitStream bs(pkt->data, bitsToBytes(bits), false);
-			bs.SetWriteOffset(bits);
-			uint8_t type;
-			if (bs.readUINT8(type))
+			if (capture.isOpen())
 			{
-				// Call event handlers for packet receive
-				const bool res = inEventDispatcher.stopAtFalse([&player, type, &bs](NetworkInEventHandler* handler)
+				capture.writePacket(player->getID(), type, pkt->data, bits);
+			}
+
+			const bool accountingEnabled = accounting.enabled();
+			TimePoint start;
+			if (accountingEnabled)
+			{
+				accounting.add(*player, PacketAccountingKind_Packet, PacketAccountingDirection_In, type, bitsToBytes(bits));
+				start = Time::now();
+			}
+
+			// Call event handlers for packet receive
+			const bool res = inEventDispatcher.stopAtFalse([&player, type, &bs](NetworkInEventHandler* handler)
+				{
+					bs.SetReadOffset(8); // Ignore packet ID
+					return handler->onReceivePacket(*player, type, bs);
+				});
+
+			if (res)
+			{
+				packetInEventDispatcher.stopAtFalse(type, [&player, &bs](SingleNetworkInEventHandler* handler)
 					{
 						bs.SetReadOffset(8); // Ignore packet ID
-						return handler->onReceivePacket(*player, type, bs);
+						return handler->onReceive(*player, bs);
 					});
+			}
 
-				if (res)
-				{
-					packetInEventDispatcher.stopAtFalse(type, [&player, &bs](SingleNetworkInEventHandler* handler)
-						{
-							bs.SetReadOffset(8); // Ignore packet ID
-							return handler->onReceive(*player, bs);
-						});
-				}
+			if (accountingEnabled)
+			{
+				accounting.addHandlerTime(*player, PacketAccountingKind_Packet, type, duration_cast<Microseconds>(Time::now() - start));
+			}
 
-				if (type == RakNet::ID_DISCONNECTION_NOTIFICATION)
-				{
-					OnRakNetDisconnect(pkt->playerIndex, PeerDisconnectReason_Quit);
-				}
-				else if (type == RakNet::ID_CONNECTION_LOST)
+			if (type == RakNet::ID_DISCONNECTION_NOTIFICATION)
+			{
+				OnRakNetDisconnect(pkt->playerIndex, PeerDisconnectReason_Quit);
+			}
+			else if (type == RakNet::ID_CONNECTION_LOST)
+			{
+				OnRakNetDisconnect(pkt->playerIndex, PeerDisconnectReason_Timeout);
+			}
+		}
+	}
+
+	RakNetLock lock(rakNetMutex);
+	rakNetServer.DeallocatePacket(pkt);
+}
+
+void RakNetLegacyNetwork::startReceiveThread()
+{
+	receivePeers = std::make_unique<StaticArray<ReceivePeer, PLAYER_POOL_SIZE>>();
+	receivedMessages.reserve(ReceiveQueue::capacity());
+	lastReceiveOverflowReport = Time::now();
+	receiveThreadRunning = true;
+	receiveThread = std::thread(&RakNetLegacyNetwork::receiveThreadProc, this);
+}
+
+void RakNetLegacyNetwork::stopReceiveThread()
+{
+	if (!receiveThread.joinable())
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(receiveWaitMutex);
+		receiveThreadRunning = false;
+	}
+	receiveWakeup.notify_all();
+	receiveThread.join();
+
+	ReceivedMessage message;
+	for (ReceivePeer& peer : *receivePeers)
+	{
+		while (peer.queue.pop(message))
+		{
+			releaseReceivedMessage(message);
+		}
+		for (const ReceivedMessage& spilled : peer.spill)
+		{
+			releaseReceivedMessage(spilled);
+		}
+	}
+	receivePeers.reset();
+}
+
+void RakNetLegacyNetwork::receiveThreadProc()
+{
+	isReceiveThread = true;
+
+	std::unique_lock<std::mutex> waitLock(receiveWaitMutex);
+	while (receiveThreadRunning.load(std::memory_order_relaxed))
+	{
+		waitLock.unlock();
+		for (;;)
+		{
+			RakNet::Packet* pkt;
+			{
+				// RPCs are handled inside Receive and come back to us through deferRPC
+				RakNetLock lock(rakNetMutex);
+				pkt = rakNetServer.Receive();
+			}
+			if (pkt == nullptr)
+			{
+				break;
+			}
+
+			if (pkt->playerIndex >= PLAYER_POOL_SIZE || pkt->bitSize < 8)
+			{
+				releaseReceivedMessage({ pkt, nullptr });
+				continue;
+			}
+
+			const SyncPacketRule* rule = findSyncPacketRule(pkt->data[0]);
+			if (rule && !isSyncPacketValid(*rule, *pkt))
+			{
+				releaseReceivedMessage({ pkt, nullptr });
+				continue;
+			}
+
+			queueReceivedMessage(pkt->playerIndex, { pkt, nullptr }, rule != nullptr);
+		}
+		waitLock.lock();
+
+		// RakNet's interface gives us nothing to block on, but its update thread only hands packets over once per
+		// interval, so wait for the next one instead of polling.  Stopping wakes us straight away.
+		receiveWakeup.wait_for(waitLock, receiveInterval, [this]()
+			{
+				return !receiveThreadRunning.load(std::memory_order_relaxed);
+			});
+	}
+}
+
+bool RakNetLegacyNetwork::deferRPC(RakNet::RPCParameters* rpcParams, void (*handler)(RakNet::RPCParameters*, void*))
+{
+	if (!isReceiveThread)
+	{
+		return false;
+	}
+
+	if (rpcParams->senderIndex >= PLAYER_POOL_SIZE)
+	{
+		return true;
+	}
+
+	DeferredRPC* rpc = new DeferredRPC { handler, *rpcParams, {} };
+	rpc->data.assign(rpcParams->input, rpcParams->input + bitsToBytes(rpcParams->numberOfBitsOfData));
+	rpc->params.input = rpc->data.data();
+	queueReceivedMessage(rpcParams->senderIndex, { nullptr, rpc }, false);
+	return true;
+}
+
+void RakNetLegacyNetwork::queueReceivedMessage(RakNet::PlayerIndex index, const ReceivedMessage& message, bool droppable)
+{
+	ReceivePeer& peer = (*receivePeers)[index];
+	if (!peer.spilled.load(std::memory_order_acquire) && peer.queue.push(message))
+	{
+		return;
+	}
+
+	// Sync packets will be sent again shortly
+	if (droppable)
+	{
+		droppedSyncPackets.fetch_add(1, std::memory_order_relaxed);
+		releaseReceivedMessage(message);
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(receiveSpillMutex);
+	peer.spill.push_back(message);
+	peer.spilled.store(true, std::memory_order_release);
+	spilledMessages.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RakNetLegacyNetwork::processReceiveQueues()
+{
+	for (ReceivePeer& peer : *receivePeers)
+	{
+		// Bounded so a peer flooding the receive thread can't keep us here forever
+		receivedMessages.clear();
+		ReceivedMessage message;
+		while (receivedMessages.size() != ReceiveQueue::capacity() && peer.queue.pop(message))
+		{
+			receivedMessages.push_back(message);
+		}
+
+		// The spill list holds what came after the queue, and nothing new goes in the queue while it's in use
+		if (receivedMessages.size() != ReceiveQueue::capacity() && peer.spilled.load(std::memory_order_acquire))
+		{
+			std::lock_guard<std::mutex> lock(receiveSpillMutex);
+			while (peer.queue.pop(message))
+			{
+				receivedMessages.push_back(message);
+			}
+			receivedMessages.insert(receivedMessages.end(), peer.spill.begin(), peer.spill.end());
+			peer.spill.clear();
+			peer.spilled.store(false, std::memory_order_release);
+		}
+
+		if (receivedMessages.empty())
+		{
+			continue;
+		}
+
+		// Walk backwards so the newest sync packet of each kind is kept and older ones are dropped unseen
+		std::bitset<256> seen;
+		for (auto it = receivedMessages.rbegin(); it != receivedMessages.rend(); ++it)
+		{
+			if (it->packet)
+			{
+				const uint8_t type = it->packet->data[0];
+				const SyncPacketRule* rule = findSyncPacketRule(type);
+				if (rule && rule->superseded)
 				{
-					OnRakNetDisconnect(pkt->playerIndex, PeerDisconnectReason_Timeout);
+					if (seen.test(type))
+					{
+						releaseReceivedMessage(*it);
+						it->packet = nullptr;
+					}
+					seen.set(type);
 				}
 			}
 		}
 
-		rakNetServer.DeallocatePacket(pkt);
+		for (const ReceivedMessage& received : receivedMessages)
+		{
+			if (received.packet || received.rpc)
+			{
+				dispatchReceivedMessage(received);
+			}
+		}
 	}
+}
 
-	if (now - lastCookieSeed > cookieSeedTime)
+void RakNetLegacyNetwork::reportReceiveOverflow(TimePoint now)
+{
+	if (now - lastReceiveOverflowReport < Seconds(60))
 	{
-		SAMPRakNet::SeedCookie();
-		lastCookieSeed = now;
+		return;
+	}
+	lastReceiveOverflowReport = now;
+
+	const size_t dropped = droppedSyncPackets.exchange(0, std::memory_order_relaxed);
+	const size_t spilled = spilledMessages.exchange(0, std::memory_order_relaxed);
+	if (dropped || spilled)
+	{
+		core->logLn(LogLevel::Warning, "The main thread fell behind the network receive thread, %zu sync packets were dropped and %zu other messages held back in the last minute", dropped, spilled);
+	}
+}
+
+void RakNetLegacyNetwork::dispatchReceivedMessage(const ReceivedMessage& message)
+{
+	if (message.packet)
+	{
+		processPacket(message.packet);
+	}
+	else
+	{
+		message.rpc->handler(&message.rpc->params, this);
+		delete message.rpc;
+	}
+}
+
+void RakNetLegacyNetwork::releaseReceivedMessage(const ReceivedMessage& message)
+{
+	if (message.packet)
+	{
+		RakNetLock lock(rakNetMutex);
+		rakNetServer.DeallocatePacket(message.packet);
 	}
+	delete message.rpc;
 }
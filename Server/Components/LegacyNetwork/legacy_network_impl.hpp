@@ -9,18 +9,25 @@
 #pragma once
 
 #include "Query/query.hpp"
+#include "packet_accounting_impl.hpp"
+#include "spsc_queue.hpp"
 #include <Impl/network_impl.hpp>
 #include <bitstream.hpp>
 #include <core.hpp>
 #include <glm/glm.hpp>
 #include <map>
+#include <memory>
 #include <network.hpp>
+#include <traffic_capture.hpp>
 #include <raknet/BitStream.h>
 #include <raknet/GetTime.h>
 #include <raknet/RakNetworkFactory.h>
 #include <raknet/RakServerInterface.h>
 #include <raknet/StringCompressor.h>
 #include <Server/Components/NPCs/npcs.hpp>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 using namespace Impl;
 
@@ -46,6 +53,71 @@ private:
 	Milliseconds cookieSeedTime;
 	TimePoint lastCookieSeed;
 	INPCComponent* npcComponent = nullptr;
+	PacketAccounting accounting;
+	/// Everything received, written to network.capture_file when it's set
+	TrafficCaptureWriter capture;
+
+	/// An RPC that arrived on the receive thread, replayed on the main thread with its own copy of the data
+	struct DeferredRPC
+	{
+		void (*handler)(RakNet::RPCParameters*, void*);
+		RakNet::RPCParameters params;
+		DynamicArray<unsigned char> data;
+	};
+
+	/// One entry in a peer's receive queue, exactly one of the two is set
+	struct ReceivedMessage
+	{
+		RakNet::Packet* packet;
+		DeferredRPC* rpc;
+	};
+
+	using ReceiveQueue = SPSCQueue<ReceivedMessage, 64>;
+
+	/// What the receive thread has for one peer.  When the queue is full sync packets are dropped and anything else
+	/// spills to a locked list, so the receive thread never waits on the main thread.  Once a peer has spilled,
+	/// everything after it goes to the spill list too until the main thread has emptied both, to keep the order.
+	struct ReceivePeer
+	{
+		ReceiveQueue queue;
+		std::atomic_bool spilled = false;
+		DynamicArray<ReceivedMessage> spill;
+	};
+
+	/// RakNet's server interface isn't safe to call from two threads at once, so while the receive thread runs
+	/// every call in to it holds this.  Recursive, because RPC handlers called from inside Receive send and kick.
+	std::recursive_mutex rakNetMutex;
+	using RakNetLock = std::lock_guard<std::recursive_mutex>;
+
+	// Optional receive thread, see network.use_receive_thread.  Only the peers and counters are shared with it.
+	std::thread receiveThread;
+	std::atomic_bool receiveThreadRunning = false;
+	std::mutex receiveWaitMutex;
+	std::condition_variable receiveWakeup;
+	/// How often RakNet's own update thread hands us new packets, there's no point looking sooner
+	Milliseconds receiveInterval;
+	std::unique_ptr<StaticArray<ReceivePeer, PLAYER_POOL_SIZE>> receivePeers;
+	std::mutex receiveSpillMutex;
+	std::atomic<size_t> droppedSyncPackets = 0;
+	std::atomic<size_t> spilledMessages = 0;
+	TimePoint lastReceiveOverflowReport;
+	DynamicArray<ReceivedMessage> receivedMessages;
+
+	void startReceiveThread();
+	void stopReceiveThread();
+	void receiveThreadProc();
+	void queueReceivedMessage(RakNet::PlayerIndex index, const ReceivedMessage& message, bool droppable);
+	void processReceiveQueues();
+	void reportReceiveOverflow(TimePoint now);
+	void processPacket(RakNet::Packet* pkt);
+	void dispatchReceivedMessage(const ReceivedMessage& message);
+	void releaseReceivedMessage(const ReceivedMessage& message);
+
+	/// Called first thing in every RPC callback, queues the call and returns true when on the receive thread
+	bool deferRPC(RakNet::RPCParameters* rpcParams, void (*handler)(RakNet::RPCParameters*, void*));
+
+	/// Count a broadcast for every player on this network it reaches
+	void accountBroadcast(PacketAccountingKind kind, uint8_t id, size_t size, const IPlayer* exceptPeer);
 
 public:
 	inline void setNPCComponent(INPCComponent* comp)
@@ -82,6 +154,10 @@ public:
 		{
 			return static_cast<INetworkQueryExtension*>(this);
 		}
+		if (id == IPacketAccountingExtension::ExtensionIID)
+		{
+			return &accounting;
+		}
 		return nullptr;
 	}
 
@@ -101,6 +177,7 @@ public:
 		const PeerNetworkData::NetworkID& nid = netData.networkID;
 		const RakNet::PlayerID rid { unsigned(nid.address.v4), nid.port };
 
+		RakNetLock lock(rakNetMutex);
 		const int playerIndex = rakNetServer.GetIndexFromPlayerID(rid);
 		if (playerIndex >= 0 && playerIndex < PLAYER_POOL_SIZE)
 		{
@@ -141,6 +218,11 @@ public:
 			}
 		}
 
+		if (accounting.enabled() && data.size() >= 8)
+		{
+			accountBroadcast(PacketAccountingKind_Packet, data.data()[0], bitsToBytes(data.size()), exceptPeer);
+		}
+
 		const RakNet::PacketReliability reliability = (channel == OrderingChannel_Unordered) ? RakNet::RELIABLE : RakNet::RELIABLE_ORDERED;
 		if (exceptPeer)
 		{
@@ -150,10 +232,12 @@ public:
 				const PeerNetworkData::NetworkID& nid = netData.networkID;
 				const RakNet::PlayerID rid { unsigned(nid.address.v4), nid.port };
 
+				RakNetLock lock(rakNetMutex);
 				return rakNetServer.Send((const char*)bs.GetData(), bs.GetNumberOfBitsUsed(), RakNet::HIGH_PRIORITY, reliability, channel, rid, true);
 			}
 		}
 
+		RakNetLock lock(rakNetMutex);
 		return rakNetServer.Send((const char*)bs.GetData(), bs.GetNumberOfBitsUsed(), RakNet::HIGH_PRIORITY, reliability, channel, RakNet::UNASSIGNED_PLAYER_ID, true);
 	}
 
@@ -197,6 +281,11 @@ public:
 		const PeerNetworkData::NetworkID& nid = netData.networkID;
 		const RakNet::PlayerID rid { unsigned(nid.address.v4), nid.port };
 		const RakNet::PacketReliability reliability = (channel == OrderingChannel_Reliable) ? RakNet::RELIABLE : ((channel == OrderingChannel_Unordered) ? RakNet::UNRELIABLE : RakNet::UNRELIABLE_SEQUENCED);
+		if (accounting.enabled() && data.size() >= 8)
+		{
+			accounting.add(peer, PacketAccountingKind_Packet, PacketAccountingDirection_Out, data.data()[0], bitsToBytes(data.size()));
+		}
+		RakNetLock lock(rakNetMutex);
 		return rakNetServer.Send((const char*)bs.GetData(), bs.GetNumberOfBitsUsed(), RakNet::HIGH_PRIORITY, reliability, channel, rid, false);
 	}
 
@@ -232,6 +321,11 @@ public:
 			}
 		}
 
+		if (accounting.enabled())
+		{
+			accountBroadcast(PacketAccountingKind_RPC, uint8_t(id), bitsToBytes(data.size()), exceptPeer);
+		}
+
 		const RakNet::PacketReliability reliability = (channel == OrderingChannel_Unordered) ? RakNet::RELIABLE : RakNet::RELIABLE_ORDERED;
 		if (exceptPeer)
 		{
@@ -241,10 +335,12 @@ public:
 				const PeerNetworkData::NetworkID& nid = netData.networkID;
 				const RakNet::PlayerID rid { unsigned(nid.address.v4), nid.port };
 
+				RakNetLock lock(rakNetMutex);
 				return rakNetServer.RPC(id, (const char*)bs.GetData(), bs.GetNumberOfBitsUsed(), RakNet::HIGH_PRIORITY, reliability, channel, rid, true, false, RakNet::UNASSIGNED_NETWORK_ID, nullptr);
 			}
 		}
 
+		RakNetLock lock(rakNetMutex);
 		return rakNetServer.RPC(id, (const char*)bs.GetData(), bs.GetNumberOfBitsUsed(), RakNet::HIGH_PRIORITY, reliability, channel, RakNet::UNASSIGNED_PLAYER_ID, true, false, RakNet::UNASSIGNED_NETWORK_ID, nullptr);
 	}
 
@@ -289,6 +385,11 @@ public:
 		const PeerNetworkData::NetworkID& nid = netData.networkID;
 		const RakNet::PlayerID rid { unsigned(nid.address.v4), nid.port };
 		const RakNet::PacketReliability reliability = (channel == OrderingChannel_Unordered) ? RakNet::RELIABLE : RakNet::RELIABLE_ORDERED;
+		if (accounting.enabled())
+		{
+			accounting.add(peer, PacketAccountingKind_RPC, PacketAccountingDirection_Out, uint8_t(id), bitsToBytes(data.size()));
+		}
+		RakNetLock lock(rakNetMutex);
 		return rakNetServer.RPC(id, (const char*)bs.GetData(), bs.GetNumberOfBitsUsed(), RakNet::HIGH_PRIORITY, reliability, channel, rid, false, false, RakNet::UNASSIGNED_NETWORK_ID, nullptr);
 	}
 
@@ -324,12 +425,14 @@ public:
 	void onPlayerDisconnect(IPlayer& player, PeerDisconnectReason reason) override
 	{
 		query.buildPlayerDependentBuffers(&player);
+		accounting.removePlayer(player);
 	}
 
 	void onPoolEntryCreated(INPC& npc) override
 	{
 		if (npcComponent)
 		{
+			RakNetLock lock(rakNetMutex);
 			rakNetServer.ReserveSlots(npcComponent->count());
 		}
 	}
@@ -338,6 +441,7 @@ public:
 	{
 		if (npcComponent)
 		{
+			RakNetLock lock(rakNetMutex);
 			rakNetServer.ReserveSlots(npcComponent->count());
 		}
 	}
@@ -0,0 +1,141 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <packet_accounting.hpp>
+#include <memory>
+
+using namespace Impl;
+
+/// The legacy network's packet accounting tables.  Totals are flat arrays indexed by ID, players get a small
+/// hash map of only the IDs they actually used, so leaving it on costs a few adds and one lookup per message.
+class PacketAccounting final : public IPacketAccountingExtension
+{
+public:
+	PacketAccounting()
+		: totals_(std::make_unique<Totals>())
+	{
+	}
+
+	void init(IConfig& config)
+	{
+		enabled_ = config.getBool("network.packet_accounting");
+	}
+
+	bool enabled() const
+	{
+		return enabled_ && *enabled_;
+	}
+
+	/// Count a message sent to or received from one player, broadcasts are counted once for each player they reach
+	void add(const IPlayer& player, PacketAccountingKind kind, PacketAccountingDirection direction, uint8_t id, size_t size)
+	{
+		(*totals_)[table(kind, direction)][id].add(size);
+		getPlayerEntry(player, kind, direction, id).add(size);
+	}
+
+	/// Count the time the receive handlers took over a message already counted with add()
+	void addHandlerTime(const IPlayer& player, PacketAccountingKind kind, uint8_t id, Microseconds time)
+	{
+		const uint64_t microseconds = uint64_t(std::max<Microseconds::rep>(time.count(), 0));
+		(*totals_)[table(kind, PacketAccountingDirection_In)][id].addHandlerTime(microseconds);
+		getPlayerEntry(player, kind, PacketAccountingDirection_In, id).addHandlerTime(microseconds);
+	}
+
+	void removePlayer(const IPlayer& player)
+	{
+		const int pid = player.getID();
+		if (pid >= 0 && pid < PLAYER_POOL_SIZE)
+		{
+			players_[pid].clear();
+		}
+	}
+
+	bool isAccountingEnabled() const override
+	{
+		return enabled();
+	}
+
+	void setAccountingEnabled(bool enabled) override
+	{
+		if (enabled_)
+		{
+			*enabled_ = enabled;
+		}
+	}
+
+	void resetAccounting() override
+	{
+		for (auto& table : *totals_)
+		{
+			table.fill(PacketAccountingEntry());
+		}
+		for (auto& player : players_)
+		{
+			player.clear();
+		}
+	}
+
+	const PacketAccountingEntry& getAccounting(PacketAccountingKind kind, PacketAccountingDirection direction, uint8_t id) const override
+	{
+		return (*totals_)[table(kind, direction)][id];
+	}
+
+	const PacketAccountingEntry* getPlayerAccounting(const IPlayer& player, PacketAccountingKind kind, PacketAccountingDirection direction, uint8_t id) const override
+	{
+		const int pid = player.getID();
+		if (pid < 0 || pid >= PLAYER_POOL_SIZE)
+		{
+			return nullptr;
+		}
+
+		const auto& entries = players_[pid];
+		auto itr = entries.find(key(kind, direction, id));
+		return itr == entries.end() ? nullptr : &itr->second;
+	}
+
+	void freeExtension() override
+	{
+		// Owned by the network.
+	}
+
+	void reset() override
+	{
+	}
+
+private:
+	static constexpr size_t TableCount = PacketAccountingKind_End * PacketAccountingDirection_End;
+
+	using Totals = StaticArray<StaticArray<PacketAccountingEntry, 256>, TableCount>;
+
+	static size_t table(PacketAccountingKind kind, PacketAccountingDirection direction)
+	{
+		return size_t(kind) * PacketAccountingDirection_End + size_t(direction);
+	}
+
+	static uint16_t key(PacketAccountingKind kind, PacketAccountingDirection direction, uint8_t id)
+	{
+		return uint16_t((table(kind, direction) << 8) | id);
+	}
+
+	PacketAccountingEntry& getPlayerEntry(const IPlayer& player, PacketAccountingKind kind, PacketAccountingDirection direction, uint8_t id)
+	{
+		static PacketAccountingEntry discard;
+		const int pid = player.getID();
+		if (pid < 0 || pid >= PLAYER_POOL_SIZE)
+		{
+			return discard;
+		}
+		return players_[pid][key(kind, direction, id)];
+	}
+
+	bool* enabled_ = nullptr;
+	std::unique_ptr<Totals> totals_; ///< 64 KB, kept off the network object
+	StaticArray<FlatHashMap<uint16_t, PacketAccountingEntry>, PLAYER_POOL_SIZE> players_;
+};
@@ -0,0 +1,61 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2022, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/// Bounded lock-free queue for exactly one producer thread and one consumer thread.
+/// One slot is always left empty to tell a full queue from an empty one.
+template <typename T, size_t Capacity>
+class SPSCQueue
+{
+	static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+	static constexpr size_t Mask = Capacity - 1;
+
+public:
+	static constexpr size_t capacity()
+	{
+		return Capacity;
+	}
+
+	/// Producer only, returns false if the queue is full
+	bool push(const T& item)
+	{
+		const size_t tail = tail_.load(std::memory_order_relaxed);
+		const size_t next = (tail + 1) & Mask;
+		if (next == head_.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+		items_[tail] = item;
+		tail_.store(next, std::memory_order_release);
+		return true;
+	}
+
+	/// Consumer only, returns false if the queue is empty
+	bool pop(T& item)
+	{
+		const size_t head = head_.load(std::memory_order_relaxed);
+		if (head == tail_.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+		item = items_[head];
+		head_.store((head + 1) & Mask, std::memory_order_release);
+		return true;
+	}
+
+private:
+	// Keep the two indices on separate cache lines so the threads don't fight over one
+	alignas(64) std::atomic<size_t> head_ { 0 };
+	alignas(64) std::atomic<size_t> tail_ { 0 };
+	std::array<T, Capacity> items_;
+};
@@ -0,0 +1,496 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include <sdk.hpp>
+#include <netcode.hpp>
+#include <Server/Components/Console/console.hpp>
+#include <Server/Components/Objects/objects.hpp>
+#include <Server/Components/Vehicles/vehicles.hpp>
+#include <simulated_network.hpp>
+#include <random>
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__)
+#include <Windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+using namespace Impl;
+
+/// Exported by the server when it's built with OMP_COUNT_ALLOCATIONS.
+typedef uint64_t (*AllocationCounter_t)();
+
+static AllocationCounter_t findAllocationCounter()
+{
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__)
+	return reinterpret_cast<AllocationCounter_t>(GetProcAddress(GetModuleHandle(nullptr), "OMPGetAllocationCount"));
+#else
+	return reinterpret_cast<AllocationCounter_t>(dlsym(RTLD_DEFAULT, "OMPGetAllocationCount"));
+#endif
+}
+
+/// One scripted client.  Walks (or drives) in a circle so every sync packet carries new data.
+struct SimulatedClient
+{
+	IPlayer* player = nullptr;
+	IVehicle* vehicle = nullptr;
+	Vector3 centre;
+	float radius = 0.0f;
+	float angle = 0.0f;
+	float angularSpeed = 0.0f;
+	TimePoint nextSync;
+};
+
+class LoadTestComponent final : public INetworkComponent, public CoreEventHandler
+{
+private:
+	/// Runs after everything else in the tick so the whole tick can be timed.
+	struct TickEndHandler : public CoreEventHandler
+	{
+		LoadTestComponent& self;
+
+		TickEndHandler(LoadTestComponent& self)
+			: self(self)
+		{
+		}
+
+		void onTick(Microseconds elapsed, TimePoint now) override
+		{
+			self.onTickEnd();
+		}
+	};
+
+	ICore* core = nullptr;
+	IConsoleComponent* console = nullptr;
+	IObjectsComponent* objects = nullptr;
+	IVehiclesComponent* vehicles = nullptr;
+	SimulatedNetwork network;
+	TickEndHandler tickEndHandler;
+	AllocationCounter_t allocationCounter = nullptr;
+
+	int playerCount = 100;
+	int vehicleCount = 0;
+	int objectCount = 0;
+	int driverPercent = 25;
+	int syncRate = 40;
+	int warmup = 5;
+	int duration = 60;
+	int seed = 1;
+	bool exitWhenDone = true;
+
+	DynamicArray<SimulatedClient> clients;
+	DynamicArray<Microseconds> tickTimes;
+	TimePoint tickStart;
+	TimePoint measureStart;
+	TimePoint measureEnd;
+	uint64_t bytesAtStart = 0;
+	uint64_t packetsAtStart = 0;
+	uint64_t allocationsAtStart = 0;
+	bool running = false;
+	bool measuring = false;
+
+	void createWorld()
+	{
+		std::mt19937 gen(seed);
+		std::uniform_real_distribution<float> coord(-2500.0f, 2500.0f);
+		std::uniform_real_distribution<float> heading(0.0f, 360.0f);
+
+		if (objects)
+		{
+			for (int i = 0; i != objectCount; ++i)
+			{
+				objects->create(1337, Vector3(coord(gen), coord(gen), 5.0f), Vector3(0.0f, 0.0f, heading(gen)), 300.0f);
+			}
+		}
+
+		DynamicArray<IVehicle*> spawned;
+		if (vehicles)
+		{
+			spawned.reserve(vehicleCount);
+			for (int i = 0; i != vehicleCount; ++i)
+			{
+				IVehicle* vehicle = vehicles->create(false, 400 + i % 212, Vector3(coord(gen), coord(gen), 5.0f), heading(gen));
+				if (vehicle)
+				{
+					spawned.push_back(vehicle);
+				}
+			}
+		}
+
+		const size_t drivers = std::min(spawned.size(), size_t(playerCount * driverPercent / 100));
+		std::uniform_real_distribution<float> radius(5.0f, 150.0f);
+		std::uniform_real_distribution<float> speed(0.01f, 0.05f);
+		std::uniform_int_distribution<int> offset(0, syncRate);
+		const TimePoint now = Time::now();
+
+		clients.reserve(playerCount);
+		for (int i = 0; i != playerCount; ++i)
+		{
+			IPlayer* player = connect(i);
+			if (player == nullptr)
+			{
+				core->logLn(LogLevel::Error, "[loadtest] Could only connect %d of %d players, check max_players.", i, playerCount);
+				break;
+			}
+
+			SimulatedClient& client = clients.emplace_back();
+			client.player = player;
+			client.centre = Vector3(coord(gen), coord(gen), 5.0f);
+			client.radius = radius(gen);
+			client.angle = glm::radians(heading(gen));
+			client.angularSpeed = speed(gen);
+			// Spread the first updates so every client doesn't sync on the same tick
+			client.nextSync = now + Milliseconds(offset(gen));
+
+			if (clients.size() <= drivers)
+			{
+				client.vehicle = spawned[clients.size() - 1];
+				client.centre = client.vehicle->getPosition();
+				client.vehicle->putPlayer(*player, 0);
+			}
+		}
+
+		core->printLn("[loadtest] Simulating %zu players (%zu drivers), %zu vehicles and %d objects.", clients.size(), drivers, spawned.size(), objects ? objectCount : 0);
+	}
+
+	IPlayer* connect(int index)
+	{
+		PeerNetworkData data;
+		data.network = &network;
+		data.networkID.address.v4 = 16777343; // 127.0.0.1
+		data.networkID.address.ipv6 = false;
+		data.networkID.port = uint16_t(10000 + index);
+
+		const String name = "LoadTest_" + std::to_string(index);
+		PeerRequestParams request;
+		request.bot = false;
+		request.name = name;
+
+		Pair<NewConnectionResult, IPlayer*> result = core->getPlayers().requestPlayer(data, request);
+		if (result.first != NewConnectionResult_Success)
+		{
+			return nullptr;
+		}
+
+		IPlayer& player = *result.second;
+		network.addPeer(player);
+		network.networkEventDispatcher.dispatch(&NetworkEventHandler::onPeerConnect, player);
+
+		// Go through class selection and spawn the same way a client does
+		NetworkBitStream requestClassBS;
+		NetworkBitStream emptyBS;
+		requestClassBS.writeUINT16(0);
+		network.receiveRPC(player, NetCode::RPC::PlayerRequestClass::PacketID, requestClassBS);
+		network.receiveRPC(player, NetCode::RPC::PlayerRequestSpawn::PacketID, emptyBS);
+		network.receiveRPC(player, NetCode::RPC::PlayerSpawn::PacketID, emptyBS);
+		return &player;
+	}
+
+	void sendFootSync(SimulatedClient& client, const Vector3& position, const Vector3& velocity)
+	{
+		const GTAQuat rotation(Vector3(0.0f, 0.0f, glm::degrees(client.angle) + 90.0f));
+
+		NetworkBitStream bs;
+		bs.writeUINT8(NetCode::Packet::PlayerFootSync::PacketID);
+		bs.writeUINT16(0); // LeftRight
+		bs.writeUINT16(uint16_t(-128)); // UpDown, walking forwards
+		bs.writeUINT16(0); // Keys
+		bs.writeVEC3(position);
+		bs.writeVEC4(Vector4(rotation.q.w, rotation.q.x, rotation.q.y, rotation.q.z));
+		bs.writeUINT8(100); // Health
+		bs.writeUINT8(0); // Armour
+		bs.writeUINT8(0); // Weapon and additional key
+		bs.writeUINT8(0); // Special action
+		bs.writeVEC3(velocity);
+		bs.writeVEC3(Vector3(0.0f)); // Surfing offset
+		bs.writeUINT16(0); // Surfing ID
+		bs.writeUINT16(1231); // Walking animation
+		bs.writeUINT16(0); // Animation flags
+		network.receivePacket(*client.player, NetCode::Packet::PlayerFootSync::PacketID, bs);
+	}
+
+	void sendDriverSync(SimulatedClient& client, const Vector3& position, const Vector3& velocity)
+	{
+		const GTAQuat rotation(Vector3(0.0f, 0.0f, glm::degrees(client.angle) + 90.0f));
+
+		NetworkBitStream bs;
+		bs.writeUINT8(NetCode::Packet::PlayerVehicleSync::PacketID);
+		bs.writeUINT16(client.vehicle->getID());
+		bs.writeUINT16(0); // LeftRight
+		bs.writeUINT16(0); // UpDown
+		bs.writeUINT16(Key::SPRINT); // Accelerate
+		bs.writeVEC4(Vector4(rotation.q.w, rotation.q.x, rotation.q.y, rotation.q.z));
+		bs.writeVEC3(position);
+		bs.writeVEC3(velocity);
+		bs.writeFLOAT(1000.0f); // Vehicle health
+		bs.writeUINT8(100); // Health
+		bs.writeUINT8(0); // Armour
+		bs.writeUINT8(0); // Weapon and additional key
+		bs.writeUINT8(0); // Siren
+		bs.writeUINT8(0); // Landing gear
+		bs.writeUINT16(0); // Trailer
+		bs.writeUINT32(0); // Hydra thrust angle or train speed
+		network.receivePacket(*client.player, NetCode::Packet::PlayerVehicleSync::PacketID, bs);
+	}
+
+	void simulate(TimePoint now)
+	{
+		for (SimulatedClient& client : clients)
+		{
+			if (now < client.nextSync)
+			{
+				continue;
+			}
+			client.nextSync += Milliseconds(syncRate);
+
+			client.angle += client.angularSpeed;
+			const Vector3 direction(std::cos(client.angle), std::sin(client.angle), 0.0f);
+			const Vector3 position = client.centre + direction * client.radius;
+			const Vector3 velocity = Vector3(-direction.y, direction.x, 0.0f) * client.angularSpeed * client.radius / 10.0f;
+
+			if (client.vehicle)
+			{
+				sendDriverSync(client, position, velocity);
+			}
+			else
+			{
+				sendFootSync(client, position, velocity);
+			}
+		}
+	}
+
+	uint64_t allocations() const
+	{
+		return allocationCounter ? allocationCounter() : 0;
+	}
+
+	void report()
+	{
+		const float seconds = duration_cast<Milliseconds>(measureEnd - measureStart).count() / 1000.0f;
+		if (tickTimes.empty() || seconds <= 0.0f)
+		{
+			core->printLn("[loadtest] No ticks were measured.");
+			return;
+		}
+
+		DynamicArray<Microseconds> sorted = tickTimes;
+		std::sort(sorted.begin(), sorted.end());
+		const auto percentile = [&sorted](float p)
+		{
+			return sorted[std::min(sorted.size() - 1, size_t(p * sorted.size()))].count() / 1000.0f;
+		};
+
+		core->printLn("[loadtest] %zu players over %.1fs (%zu ticks, %.1f ticks/s)", clients.size(), seconds, tickTimes.size(), tickTimes.size() / seconds);
+		core->printLn("[loadtest] Tick time: p50 %.3fms, p90 %.3fms, p99 %.3fms, max %.3fms", percentile(0.5f), percentile(0.9f), percentile(0.99f), sorted.back().count() / 1000.0f);
+		core->printLn("[loadtest] Outgoing: %.1f KB/s, %.0f messages/s", (network.getBytesSent() - bytesAtStart) / 1024.0f / seconds, (network.getPacketsSent() - packetsAtStart) / seconds);
+		if (allocationCounter)
+		{
+			// Only the server executable's own allocations are seen, see OMPGetAllocationCount.
+			core->printLn("[loadtest] Allocations: %.1f per tick, made by the core only, not by Pawn, LegacyNetwork or any other component", float(allocations() - allocationsAtStart) / tickTimes.size());
+		}
+		else
+		{
+			core->printLn("[loadtest] Allocations: not counted, build the server with OMP_COUNT_ALLOCATIONS");
+		}
+	}
+
+public:
+	LoadTestComponent()
+		: tickEndHandler(*this)
+	{
+	}
+
+	StringView componentName() const override
+	{
+		return "LoadTest";
+	}
+
+	SemanticVersion componentVersion() const override
+	{
+		return SemanticVersion(OMP_VERSION_MAJOR, OMP_VERSION_MINOR, OMP_VERSION_PATCH, BUILD_NUMBER);
+	}
+
+	UID getUID() override
+	{
+		return 0x6c1a5e7f93b04d28;
+	}
+
+	void provideConfiguration(ILogger& logger, IEarlyConfig& config, bool defaults) override
+	{
+		if (defaults)
+		{
+			config.setInt("loadtest.players", playerCount);
+			config.setInt("loadtest.vehicles", vehicleCount);
+			config.setInt("loadtest.objects", objectCount);
+			config.setInt("loadtest.driver_percent", driverPercent);
+			config.setInt("loadtest.sync_rate", syncRate);
+			config.setInt("loadtest.warmup", warmup);
+			config.setInt("loadtest.duration", duration);
+			config.setInt("loadtest.seed", seed);
+			config.setBool("loadtest.exit_when_done", exitWhenDone);
+		}
+		else
+		{
+			// Set default values if options are not set.
+			if (config.getType("loadtest.players") == ConfigOptionType_None)
+			{
+				config.setInt("loadtest.players", playerCount);
+			}
+			if (config.getType("loadtest.vehicles") == ConfigOptionType_None)
+			{
+				config.setInt("loadtest.vehicles", vehicleCount);
+			}
+			if (config.getType("loadtest.objects") == ConfigOptionType_None)
+			{
+				config.setInt("loadtest.objects", objectCount);
+			}
+			if (config.getType("loadtest.driver_percent") == ConfigOptionType_None)
+			{
+				config.setInt("loadtest.driver_percent", driverPercent);
+			}
+			if (config.getType("loadtest.sync_rate") == ConfigOptionType_None)
+			{
+				config.setInt("loadtest.sync_rate", syncRate);
+			}
+			if (config.getType("loadtest.warmup") == ConfigOptionType_None)
+			{
+				config.setInt("loadtest.warmup", warmup);
+			}
+			if (config.getType("loadtest.duration") == ConfigOptionType_None)
+			{
+				config.setInt("loadtest.duration", duration);
+			}
+			if (config.getType("loadtest.seed") == ConfigOptionType_None)
+			{
+				config.setInt("loadtest.seed", seed);
+			}
+			if (config.getType("loadtest.exit_when_done") == ConfigOptionType_None)
+			{
+				config.setBool("loadtest.exit_when_done", exitWhenDone);
+			}
+		}
+	}
+
+	void onLoad(ICore* c) override
+	{
+		core = c;
+		allocationCounter = findAllocationCounter();
+	}
+
+	void onInit(IComponentList* components) override
+	{
+		console = components->queryComponent<IConsoleComponent>();
+		objects = components->queryComponent<IObjectsComponent>();
+		vehicles = components->queryComponent<IVehiclesComponent>();
+
+		IConfig& config = core->getConfig();
+		playerCount = *config.getInt("loadtest.players");
+		vehicleCount = *config.getInt("loadtest.vehicles");
+		objectCount = *config.getInt("loadtest.objects");
+		driverPercent = std::clamp(*config.getInt("loadtest.driver_percent"), 0, 100);
+		syncRate = std::max(*config.getInt("loadtest.sync_rate"), 1);
+		warmup = std::max(*config.getInt("loadtest.warmup"), 0);
+		duration = std::max(*config.getInt("loadtest.duration"), 1);
+		seed = *config.getInt("loadtest.seed");
+		exitWhenDone = *config.getBool("loadtest.exit_when_done");
+
+		core->getEventDispatcher().addEventHandler(this, EventPriority_Highest);
+		core->getEventDispatcher().addEventHandler(&tickEndHandler, EventPriority_Lowest);
+	}
+
+	void onReady() override
+	{
+		createWorld();
+
+		const TimePoint now = Time::now();
+		measureStart = now + Seconds(warmup);
+		measureEnd = measureStart + Seconds(duration);
+		tickTimes.reserve(size_t(duration) * 1000);
+		running = true;
+	}
+
+	void onFree(IComponent* component) override
+	{
+		if (component == console)
+		{
+			console = nullptr;
+		}
+		else if (component == objects)
+		{
+			objects = nullptr;
+		}
+		else if (component == vehicles)
+		{
+			vehicles = nullptr;
+		}
+	}
+
+	void onTick(Microseconds elapsed, TimePoint now) override
+	{
+		tickStart = Time::now();
+		if (!running)
+		{
+			return;
+		}
+
+		if (!measuring && now >= measureStart)
+		{
+			measuring = true;
+			bytesAtStart = network.getBytesSent();
+			packetsAtStart = network.getPacketsSent();
+			allocationsAtStart = allocations();
+		}
+
+		simulate(now);
+	}
+
+	void onTickEnd()
+	{
+		if (!measuring)
+		{
+			return;
+		}
+
+		const TimePoint now = Time::now();
+		tickTimes.push_back(duration_cast<Microseconds>(now - tickStart));
+
+		if (now >= measureEnd)
+		{
+			measureEnd = now;
+			measuring = false;
+			running = false;
+			report();
+
+			if (exitWhenDone && console)
+			{
+				console->send("exit");
+			}
+		}
+	}
+
+	INetwork* getNetwork() override
+	{
+		return &network;
+	}
+
+	void free() override
+	{
+		core->getEventDispatcher().removeEventHandler(this);
+		core->getEventDispatcher().removeEventHandler(&tickEndHandler);
+		delete this;
+	}
+
+	void reset() override
+	{
+	}
+};
+
+COMPONENT_ENTRY_POINT()
+{
+	return new LoadTestComponent();
+}
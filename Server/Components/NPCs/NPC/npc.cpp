@@ -972,6 +972,12 @@ void NPC::shoot(int hitId, PlayerBulletHitType hitType, uint8_t weapon, const Ve
 			break;
 		}
 		case EntityCheckType::Map:
+		{
+			// Picked up as a map hit below
+			bulletData.hitType = PlayerBulletHitType_None;
+			bulletData.hitPos = hitMapPos;
+			break;
+		}
 		default:
 		{
 			bulletData.hitType = PlayerBulletHitType_None;
@@ -999,7 +1005,7 @@ void NPC::shoot(int hitId, PlayerBulletHitType hitType, uint8_t weapon, const Ve
 				}
 			}
 		}
-		else if (bulletData.hitID == ACTOR_POOL_SIZE + 1)
+		else if (bulletData.hitID == NPC_MAP_HIT_ID)
 		{
 			// Hit map
 			bulletData.offset = hitMapPos; // When map is hit use the object collision position
@@ -2159,7 +2165,7 @@ void NPC::sendFootSync()
 
 	bool needsImmediateUpdate = footSync_.LeftRight != leftAndRight || footSync_.UpDown != upAndDown || footSync_.Keys != keys || footSync_.Position != position_ || footSync_.Rotation.q != rotation_.q || footSync_.HealthArmour.x != health_ || footSync_.HealthArmour.y != armour_ || footSync_.Weapon != weapon_ || footSync_.Velocity != velocity_ || footSync_.AnimationID != animationId_ || footSync_.AnimationFlags != animationFlags_ || footSync_.SpecialAction != specialAction_;
 
-	auto generateFootSyncBitStream = [&](NetworkBitStream& bs)
+	auto sendFootSyncPacket = [&]()
 	{
 		footSync_.LeftRight = leftAndRight;
 		footSync_.UpDown = upAndDown;
@@ -2177,6 +2183,17 @@ void NPC::sendFootSync()
 		footSync_.SurfingData.type = surfingData_.type;
 		footSync_.SurfingData.offset = surfingData_.offset;
 
+		if (NetCode::ISyncInjector* injector = npcComponent_->getSyncInjector(footSync_.PacketID))
+		{
+			// The handler adjusts the packet it's given, keep ours as the last state we sent
+			NetCode::Packet::PlayerFootSync footSync = footSync_;
+			// Health and armour go as the byte a packet would carry them in
+			footSync.HealthArmour = { float(uint8_t(footSync.HealthArmour.x)), float(uint8_t(footSync.HealthArmour.y)) };
+			injector->injectFootSync(*player_, footSync);
+			return;
+		}
+
+		NetworkBitStream bs;
 		bs.writeUINT8(footSync_.PacketID);
 		bs.writeUINT16(footSync_.LeftRight);
 		bs.writeUINT16(footSync_.UpDown);
@@ -2192,13 +2209,12 @@ void NPC::sendFootSync()
 		bs.writeUINT16(footSync_.SurfingData.ID);
 		bs.writeUINT16(footSync_.AnimationID);
 		bs.writeUINT16(footSync_.AnimationFlags);
+		npcComponent_->emulatePacketIn(*player_, footSync_.PacketID, bs);
 	};
 
 	if (needsImmediateUpdate)
 	{
-		NetworkBitStream bs;
-		generateFootSyncBitStream(bs);
-		npcComponent_->emulatePacketIn(*player_, footSync_.PacketID, bs);
+		sendFootSyncPacket();
 	}
 	else
 	{
@@ -2208,9 +2224,7 @@ void NPC::sendFootSync()
 		}
 		else
 		{
-			NetworkBitStream bs;
-			generateFootSyncBitStream(bs);
-			npcComponent_->emulatePacketIn(*player_, footSync_.PacketID, bs);
+			sendFootSyncPacket();
 			footSyncSkipUpdate_ = 0;
 		}
 	}
@@ -2231,7 +2245,7 @@ void NPC::sendDriverSync()
 	// Check if immediate update is needed (basic comparison for now)
 	bool needsImmediateUpdate = driverSync_.LeftRight != leftAndRight || driverSync_.UpDown != upAndDown || driverSync_.Keys != keys || driverSync_.Position != position_ || driverSync_.Rotation.q != rotation_.q || driverSync_.PlayerHealthArmour.x != health_ || driverSync_.PlayerHealthArmour.y != armour_ || driverSync_.VehicleID != vehicleID || driverSync_.Velocity != velocity_ || driverSync_.Health != vehicleHealth_;
 
-	auto generateDriverSyncBitStream = [&](NetworkBitStream& bs)
+	auto sendDriverSyncPacket = [&]()
 	{
 		driverSync_.VehicleID = vehicleID;
 		driverSync_.LeftRight = leftAndRight;
@@ -2265,6 +2279,16 @@ void NPC::sendDriverSync()
 		driverSync_.HasTrailer = false;
 		driverSync_.AdditionalKeyWeapon = weapon_;
 
+		if (NetCode::ISyncInjector* injector = npcComponent_->getSyncInjector(driverSync_.PacketID))
+		{
+			NetCode::Packet::PlayerVehicleSync driverSync = driverSync_;
+			// Health and armour go as the byte a packet would carry them in
+			driverSync.PlayerHealthArmour = { float(uint8_t(driverSync.PlayerHealthArmour.x)), float(uint8_t(driverSync.PlayerHealthArmour.y)) };
+			injector->injectDriverSync(*player_, driverSync);
+			return;
+		}
+
+		NetworkBitStream bs;
 		bs.writeUINT8(driverSync_.PacketID);
 		bs.writeUINT16(driverSync_.VehicleID);
 		bs.writeUINT16(driverSync_.LeftRight);
@@ -2281,13 +2305,12 @@ void NPC::sendDriverSync()
 		bs.writeUINT8(driverSync_.LandingGear);
 		bs.writeUINT16(driverSync_.TrailerID);
 		bs.writeUINT32(driverSync_.HydraThrustAngle);
+		npcComponent_->emulatePacketIn(*player_, driverSync_.PacketID, bs);
 	};
 
 	if (needsImmediateUpdate)
 	{
-		NetworkBitStream bs;
-		generateDriverSyncBitStream(bs);
-		npcComponent_->emulatePacketIn(*player_, driverSync_.PacketID, bs);
+		sendDriverSyncPacket();
 	}
 	else
 	{
@@ -2297,9 +2320,7 @@ void NPC::sendDriverSync()
 		}
 		else
 		{
-			NetworkBitStream bs;
-			generateDriverSyncBitStream(bs);
-			npcComponent_->emulatePacketIn(*player_, driverSync_.PacketID, bs);
+			sendDriverSyncPacket();
 			driverSyncSkipUpdate_ = 0;
 		}
 	}
@@ -2320,7 +2341,7 @@ void NPC::sendPassengerSync()
 	// Check if immediate update is needed (basic comparison for now)
 	bool needsImmediateUpdate = passengerSync_.LeftRight != leftAndRight || passengerSync_.UpDown != upAndDown || passengerSync_.Keys != keys || passengerSync_.Position != position_ || passengerSync_.HealthArmour.x != health_ || passengerSync_.HealthArmour.y != armour_ || passengerSync_.VehicleID != vehicleID || passengerSync_.SeatID != vehicleSeat_ || passengerSync_.WeaponID != weapon_;
 
-	auto generatePassengerSyncBitStream = [&](NetworkBitStream& bs)
+	auto sendPassengerSyncPacket = [&]()
 	{
 		passengerSync_.VehicleID = vehicleID;
 		passengerSync_.LeftRight = leftAndRight;
@@ -2332,6 +2353,16 @@ void NPC::sendPassengerSync()
 		passengerSync_.SeatID = vehicleSeat_;
 		passengerSync_.WeaponID = weapon_;
 
+		if (NetCode::ISyncInjector* injector = npcComponent_->getSyncInjector(passengerSync_.PacketID))
+		{
+			NetCode::Packet::PlayerPassengerSync passengerSync = passengerSync_;
+			// Health and armour go as the byte a packet would carry them in
+			passengerSync.HealthArmour = { float(uint8_t(passengerSync.HealthArmour.x)), float(uint8_t(passengerSync.HealthArmour.y)) };
+			injector->injectPassengerSync(*player_, passengerSync);
+			return;
+		}
+
+		NetworkBitStream bs;
 		bs.writeUINT8(passengerSync_.PacketID);
 		bs.writeUINT16(passengerSync_.VehicleID);
 		bs.writeUINT16(passengerSync_.DriveBySeatAdditionalKeyWeapon);
@@ -2341,13 +2372,12 @@ void NPC::sendPassengerSync()
 		bs.writeUINT16(passengerSync_.UpDown);
 		bs.writeUINT16(passengerSync_.Keys);
 		bs.writeVEC3(passengerSync_.Position);
+		npcComponent_->emulatePacketIn(*player_, passengerSync_.PacketID, bs);
 	};
 
 	if (needsImmediateUpdate)
 	{
-		NetworkBitStream bs;
-		generatePassengerSyncBitStream(bs);
-		npcComponent_->emulatePacketIn(*player_, passengerSync_.PacketID, bs);
+		sendPassengerSyncPacket();
 	}
 	else
 	{
@@ -2357,9 +2387,7 @@ void NPC::sendPassengerSync()
 		}
 		else
 		{
-			NetworkBitStream bs;
-			generatePassengerSyncBitStream(bs);
-			npcComponent_->emulatePacketIn(*player_, passengerSync_.PacketID, bs);
+			sendPassengerSyncPacket();
 			passengerSyncSkipUpdate_ = 0;
 		}
 	}
@@ -2375,8 +2403,16 @@ void NPC::sendAimSync()
 
 	bool needsImmediateUpdate = prevAimSync_.CamMode != aimSync_.CamMode || prevAimSync_.CamFrontVector != aimSync_.CamFrontVector || prevAimSync_.CamPos != aimSync_.CamPos || prevAimSync_.AimZ != aimSync_.AimZ || prevAimSync_.ZoomWepState != aimSync_.ZoomWepState || prevAimSync_.AspectRatio != aimSync_.AspectRatio;
 
-	auto generateAimSyncBitStream = [&](NetworkBitStream& bs)
+	auto sendAimSyncPacket = [&]()
 	{
+		if (NetCode::ISyncInjector* injector = npcComponent_->getSyncInjector(aimSync_.PacketID))
+		{
+			NetCode::Packet::PlayerAimSync aimSync = aimSync_;
+			injector->injectAimSync(*player_, aimSync);
+			return;
+		}
+
+		NetworkBitStream bs;
 		bs.writeUINT8(aimSync_.PacketID);
 		bs.writeUINT8(aimSync_.CamMode);
 		bs.writeVEC3(aimSync_.CamFrontVector);
@@ -2384,13 +2420,12 @@ void NPC::sendAimSync()
 		bs.writeFLOAT(aimSync_.AimZ);
 		bs.writeUINT8(aimSync_.ZoomWepState);
 		bs.writeUINT8(aimSync_.AspectRatio);
+		npcComponent_->emulatePacketIn(*player_, aimSync_.PacketID, bs);
 	};
 
 	if (needsImmediateUpdate)
 	{
-		NetworkBitStream bs;
-		generateAimSyncBitStream(bs);
-		npcComponent_->emulatePacketIn(*player_, aimSync_.PacketID, bs);
+		sendAimSyncPacket();
 		prevAimSync_ = aimSync_;
 	}
 	else
@@ -2401,9 +2436,7 @@ void NPC::sendAimSync()
 		}
 		else
 		{
-			NetworkBitStream bs;
-			generateAimSyncBitStream(bs);
-			npcComponent_->emulatePacketIn(*player_, aimSync_.PacketID, bs);
+			sendAimSyncPacket();
 			aimSyncSkipUpdate_ = 0;
 		}
 	}
@@ -2590,6 +2623,16 @@ void NPC::advance(TimePoint now)
 			auto direction = toTarget / distanceToTarget;
 			auto travelled = direction * velocityLength * deltaTimeMS;
 			position_ = position + travelled;
+
+			// Follow the terrain on foot when the world collision is known, probing from about head height
+			// so steps up are found, and leaving drops further than a small ledge alone
+			ICollisionComponent* collision = npcComponent_->getCollision();
+			float groundZ = 0.0f;
+			if (moveType_ != NPCMoveType_Drive && collision && collision->getGroundZ(Vector3(position_.x, position_.y, position_.z + NPC_GROUND_OFFSET), groundZ)
+				&& position_.z - NPC_GROUND_OFFSET - groundZ < NPC_MAX_GROUND_DROP)
+			{
+				position_.z = groundZ + NPC_GROUND_OFFSET;
+			}
 		}
 	}
 
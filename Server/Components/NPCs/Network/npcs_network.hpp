@@ -10,16 +10,19 @@
 #include <sdk.hpp>
 #include <Server/Components/NPCs/npcs.hpp>
 #include <Impl/network_impl.hpp>
+#include <netcode.hpp>
+#include <sync_injection.hpp>
 #include "../NPC/npc.hpp"
 
 using namespace Impl;
 
-class NPCNetwork : public Impl::Network
+class NPCNetwork : public Impl::Network, public NetCode::ISyncInjectionExtension
 {
 private:
 	ICore* core;
 	INPCComponent* npcComponent;
 	DynamicArray<int> markedToBeKicked;
+	NetCode::ISyncInjector* syncInjector = nullptr;
 
 public:
 	void init(ICore* c, INPCComponent* comp)
@@ -33,6 +36,34 @@ public:
 		return markedToBeKicked;
 	}
 
+	IExtension* getExtension(UID id) override
+	{
+		if (id == NetCode::ISyncInjectionExtension::ExtensionIID)
+		{
+			return static_cast<NetCode::ISyncInjectionExtension*>(this);
+		}
+		return nullptr;
+	}
+
+	void setSyncInjector(NetCode::ISyncInjector* injector) override
+	{
+		syncInjector = injector;
+	}
+
+	void reset() override
+	{
+	}
+
+	/// The player pool's injector, only while nothing else listens to this packet and needs the bitstream
+	NetCode::ISyncInjector* getSyncInjector(int packetId)
+	{
+		if (inEventDispatcher.count() || packetInEventDispatcher.count(packetId) > 1)
+		{
+			return nullptr;
+		}
+		return syncInjector;
+	}
+
 	ENetworkType getNetworkType() const override
 	{
 		return ENetworkType(3);
@@ -9,64 +9,16 @@
 #pragma once
 
 #include <sdk.hpp>
-#include <fstream>
+#include "node_data.hpp"
 
 class NPC;
-using namespace Impl;
-
-#pragma pack(push, 1)
-
-struct NodeHeader
-{
-	uint32_t nodesNumber;
-	uint32_t vehicleNodesNumber;
-	uint32_t pedNodesNumber;
-	uint32_t naviNodesNumber;
-	uint32_t linksNumber;
-};
-
-struct PathNode
-{
-	uint32_t memAddress;
-	uint32_t unknown1;
-	int16_t positionX;
-	int16_t positionY;
-	int16_t positionZ;
-	uint16_t unknown2;
-	uint16_t linkId;
-	uint16_t areaId;
-	uint16_t nodeId;
-	uint8_t pathWidth;
-	uint8_t nodeType;
-	uint32_t flags;
-};
-
-struct NaviNode
-{
-	int16_t positionX;
-	int16_t positionY;
-	uint16_t areaId;
-	uint16_t nodeId;
-	uint8_t directionX;
-	uint8_t directionY;
-	uint32_t flags;
-};
-
-struct LinkNode
-{
-	uint16_t areaId;
-	uint16_t nodeId;
-};
-
-#pragma pack(pop)
 
 class NPCNode
 {
 public:
-	NPCNode(int nodeId);
+	NPCNode(int nodeId, std::shared_ptr<const NPCNodeData> data);
 	~NPCNode();
 
-	bool initialize(ICore* core);
 	uint16_t process(NPC* npc, uint16_t pointId, uint16_t lastPoint, uint16_t& currentLinkId);
 	uint16_t processNodeChange(NPC* npc, uint16_t targetPointId);
 
@@ -90,13 +42,11 @@ public:
 	uint16_t getLastLinkTargetPointId() const;
 
 private:
-	int nodeId_;
-	bool initialized_;
+	const PathNode* currentPoint() const;
+	const LinkNode* currentLink() const;
 
-	NodeHeader nodeHeader_;
-	DynamicArray<PathNode> pathNodes_;
-	DynamicArray<NaviNode> naviNodes_;
-	DynamicArray<LinkNode> linkNodes_;
+	int nodeId_;
+	std::shared_ptr<const NPCNodeData> data_;
 
 	uint16_t currentPointId_;
 	uint16_t currentLinkId_;
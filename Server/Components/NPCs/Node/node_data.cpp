@@ -0,0 +1,281 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include "node_data.hpp"
+#include <ghc/filesystem.hpp>
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__)
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__)
+	if (data_)
+	{
+		UnmapViewOfFile(data_);
+	}
+	if (mapping_)
+	{
+		CloseHandle(mapping_);
+	}
+	if (file_ && file_ != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(file_);
+	}
+#else
+	if (data_)
+	{
+		munmap(const_cast<uint8_t*>(data_), size_);
+	}
+#endif
+}
+
+bool MappedFile::open(const String& path)
+{
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__)
+	file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file_ == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file_, &fileSize) || fileSize.QuadPart == 0)
+	{
+		return false;
+	}
+
+	mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping_ == nullptr)
+	{
+		return false;
+	}
+
+	data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+	size_ = data_ ? size_t(fileSize.QuadPart) : 0;
+#else
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd == -1)
+	{
+		return false;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) == -1 || st.st_size == 0)
+	{
+		::close(fd);
+		return false;
+	}
+
+	void* mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping keeps its own reference to the file.
+	::close(fd);
+	if (mapped == MAP_FAILED)
+	{
+		return false;
+	}
+
+	data_ = static_cast<const uint8_t*>(mapped);
+	size_ = st.st_size;
+#endif
+	return data_ != nullptr;
+}
+
+String NPCNodeData::getFilePath(int nodeId)
+{
+	return "scriptfiles/NPCs/nodes/NODES" + std::to_string(nodeId) + ".DAT";
+}
+
+std::shared_ptr<const NPCNodeData> NPCNodeData::load(ICore* core, int nodeId, bool logMissing)
+{
+	const String filePath = getFilePath(nodeId);
+	if (!ghc::filesystem::exists(filePath))
+	{
+		if (logMissing)
+		{
+			core->logLn(LogLevel::Error, "[NPCs] Node file %s does not exist.", filePath.c_str());
+			core->logLn(LogLevel::Message, "[NPCs] Download the package from https://assets.open.mp/npc_nodes/NODES.zip and extract the contents in `scriptfiles/NPCs/nodes`");
+		}
+		return nullptr;
+	}
+
+	std::shared_ptr<NPCNodeData> data = std::make_shared<NPCNodeData>();
+	if (!data->file_.open(filePath))
+	{
+		core->logLn(LogLevel::Error, "[NPCs] Could not open node file %s.", filePath.c_str());
+		return nullptr;
+	}
+
+	if (!data->index())
+	{
+		core->logLn(LogLevel::Error, "[NPCs] Node file %s is malformed.", filePath.c_str());
+		return nullptr;
+	}
+
+	return data;
+}
+
+bool NPCNodeData::index()
+{
+	const uint8_t* cursor = file_.data();
+	const uint8_t* end = cursor + file_.size();
+
+	if (size_t(end - cursor) < sizeof(NodeHeader))
+	{
+		return false;
+	}
+	header_ = reinterpret_cast<const NodeHeader*>(cursor);
+	cursor += sizeof(NodeHeader);
+
+	// Every section must fit in the file before we point anything into it
+	pathNodeCount_ = size_t(header_->vehicleNodesNumber) + header_->pedNodesNumber;
+	const size_t pathBytes = pathNodeCount_ * sizeof(PathNode);
+	const size_t naviBytes = size_t(header_->naviNodesNumber) * sizeof(NaviNode);
+	linkCount_ = header_->linksNumber;
+	const size_t linkBytes = linkCount_ * sizeof(LinkNode);
+	if (pathNodeCount_ > UINT16_MAX || linkCount_ > UINT16_MAX || size_t(end - cursor) < pathBytes + naviBytes + linkBytes)
+	{
+		return false;
+	}
+
+	pathNodes_ = reinterpret_cast<const PathNode*>(cursor);
+	cursor += pathBytes + naviBytes;
+	links_ = reinterpret_cast<const LinkNode*>(cursor);
+
+	// Link table: clamp every point's links to the ones actually in the file
+	linkRanges_.resize(pathNodeCount_);
+	for (size_t i = 0; i != pathNodeCount_; ++i)
+	{
+		const PathNode& node = pathNodes_[i];
+		const uint16_t count = static_cast<uint16_t>(node.flags & 0xF);
+		if (node.linkId >= linkCount_)
+		{
+			linkRanges_[i] = { node.linkId, 0 };
+		}
+		else
+		{
+			linkRanges_[i] = { node.linkId, static_cast<uint16_t>(std::min<size_t>(count, linkCount_ - node.linkId)) };
+		}
+	}
+
+	if (pathNodeCount_ == 0)
+	{
+		return true;
+	}
+
+	// Spatial grid over the bounding box of the path nodes
+	Vector2 min(std::numeric_limits<float>::max()), max(std::numeric_limits<float>::lowest());
+	for (size_t i = 0; i != pathNodeCount_; ++i)
+	{
+		const Vector3 pos = getPointPosition(pathNodes_[i]);
+		min = glm::min(min, Vector2(pos));
+		max = glm::max(max, Vector2(pos));
+	}
+
+	gridMin_ = min;
+	gridWidth_ = int((max.x - min.x) / CellSize) + 1;
+	gridHeight_ = int((max.y - min.y) / CellSize) + 1;
+
+	const auto cellOf = [this](const PathNode& node)
+	{
+		const Vector3 pos = getPointPosition(node);
+		return cellIndex(
+			std::clamp(int((pos.x - gridMin_.x) / CellSize), 0, gridWidth_ - 1),
+			std::clamp(int((pos.y - gridMin_.y) / CellSize), 0, gridHeight_ - 1));
+	};
+
+	// Counting sort of the points by cell
+	cellOffsets_.assign(size_t(gridWidth_) * gridHeight_ + 1, 0);
+	for (size_t i = 0; i != pathNodeCount_; ++i)
+	{
+		++cellOffsets_[cellOf(pathNodes_[i]) + 1];
+	}
+	for (size_t i = 1; i != cellOffsets_.size(); ++i)
+	{
+		cellOffsets_[i] += cellOffsets_[i - 1];
+	}
+
+	DynamicArray<uint32_t> fill(cellOffsets_.begin(), cellOffsets_.end() - 1);
+	cellPoints_.resize(pathNodeCount_);
+	for (size_t i = 0; i != pathNodeCount_; ++i)
+	{
+		cellPoints_[fill[cellOf(pathNodes_[i])]++] = static_cast<uint16_t>(i);
+	}
+
+	return true;
+}
+
+bool NPCNodeData::findNearestPoint(const Vector3& position, uint16_t& pointId, float& distance) const
+{
+	if (pathNodeCount_ == 0)
+	{
+		return false;
+	}
+
+	const int cx = std::clamp(int((position.x - gridMin_.x) / CellSize), 0, gridWidth_ - 1);
+	const int cy = std::clamp(int((position.y - gridMin_.y) / CellSize), 0, gridHeight_ - 1);
+	const int maxRing = std::max(gridWidth_, gridHeight_);
+
+	float bestSq = std::numeric_limits<float>::max();
+	bool found = false;
+
+	// Search rings of cells outwards, stopping once no unvisited cell can hold anything closer.
+	for (int ring = 0; ring <= maxRing; ++ring)
+	{
+		if (found)
+		{
+			const float reach = (ring - 1) * CellSize;
+			if (reach > 0.0f && reach * reach > bestSq)
+			{
+				break;
+			}
+		}
+
+		for (int y = cy - ring; y <= cy + ring; ++y)
+		{
+			if (y < 0 || y >= gridHeight_)
+			{
+				continue;
+			}
+			const bool edgeRow = y == cy - ring || y == cy + ring;
+			for (int x = cx - ring; x <= cx + ring; x += (edgeRow ? 1 : ring * 2))
+			{
+				if (x >= 0 && x < gridWidth_)
+				{
+					const int cell = cellIndex(x, y);
+					for (uint32_t i = cellOffsets_[cell]; i != cellOffsets_[cell + 1]; ++i)
+					{
+						const Vector3 diff = getPointPosition(pathNodes_[cellPoints_[i]]) - position;
+						const float distSq = glm::dot(diff, diff);
+						if (distSq < bestSq)
+						{
+							bestSq = distSq;
+							pointId = cellPoints_[i];
+							found = true;
+						}
+					}
+				}
+
+				if (ring == 0)
+				{
+					break;
+				}
+			}
+		}
+	}
+
+	distance = std::sqrt(bestSq);
+	return found;
+}
@@ -0,0 +1,174 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <sdk.hpp>
+#include <memory>
+
+using namespace Impl;
+
+#pragma pack(push, 1)
+
+struct NodeHeader
+{
+	uint32_t nodesNumber;
+	uint32_t vehicleNodesNumber;
+	uint32_t pedNodesNumber;
+	uint32_t naviNodesNumber;
+	uint32_t linksNumber;
+};
+
+struct PathNode
+{
+	uint32_t memAddress;
+	uint32_t unknown1;
+	int16_t positionX;
+	int16_t positionY;
+	int16_t positionZ;
+	uint16_t unknown2;
+	uint16_t linkId;
+	uint16_t areaId;
+	uint16_t nodeId;
+	uint8_t pathWidth;
+	uint8_t nodeType;
+	uint32_t flags;
+};
+
+struct NaviNode
+{
+	int16_t positionX;
+	int16_t positionY;
+	uint16_t areaId;
+	uint16_t nodeId;
+	uint8_t directionX;
+	uint8_t directionY;
+	uint32_t flags;
+};
+
+struct LinkNode
+{
+	uint16_t areaId;
+	uint16_t nodeId;
+};
+
+#pragma pack(pop)
+
+/// The links of one path node, already validated against the link table
+struct NodeLinkRange
+{
+	uint16_t first;
+	uint16_t count;
+};
+
+/// A read-only view of a memory mapped file
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	~MappedFile();
+
+	bool open(const String& path);
+
+	const uint8_t* data() const
+	{
+		return data_;
+	}
+
+	size_t size() const
+	{
+		return size_;
+	}
+
+private:
+	const uint8_t* data_ = nullptr;
+	size_t size_ = 0;
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__)
+	void* file_ = nullptr;
+	void* mapping_ = nullptr;
+#endif
+};
+
+/// The contents of one NODESx.DAT file.  Loaded once, shared between every user of the node and
+/// never modified, with the link table and a spatial index computed up front.
+class NPCNodeData
+{
+public:
+	/// Map the node file, returns nullptr and logs why if it's missing or malformed.
+	static std::shared_ptr<const NPCNodeData> load(ICore* core, int nodeId, bool logMissing = true);
+
+	static String getFilePath(int nodeId);
+
+	static Vector3 getPointPosition(const PathNode& node)
+	{
+		return Vector3(
+			static_cast<float>(node.positionX) / 8.0f,
+			static_cast<float>(node.positionY) / 8.0f,
+			static_cast<float>(node.positionZ) / 8.0f + 1.2f);
+	}
+
+	const NodeHeader& getHeader() const
+	{
+		return *header_;
+	}
+
+	size_t getPathNodeCount() const
+	{
+		return pathNodeCount_;
+	}
+
+	const PathNode* getPathNode(uint16_t pointId) const
+	{
+		return pointId < pathNodeCount_ ? &pathNodes_[pointId] : nullptr;
+	}
+
+	size_t getLinkCount() const
+	{
+		return linkCount_;
+	}
+
+	const LinkNode* getLink(uint16_t linkId) const
+	{
+		return linkId < linkCount_ ? &links_[linkId] : nullptr;
+	}
+
+	NodeLinkRange getLinkRange(uint16_t pointId) const
+	{
+		return pointId < linkRanges_.size() ? linkRanges_[pointId] : NodeLinkRange { 0, 0 };
+	}
+
+	/// Find the path node closest to a position, returns false if the file has no path nodes.
+	bool findNearestPoint(const Vector3& position, uint16_t& pointId, float& distance) const;
+
+private:
+	static constexpr float CellSize = 50.0f;
+
+	bool index();
+	int cellIndex(int x, int y) const
+	{
+		return y * gridWidth_ + x;
+	}
+
+	MappedFile file_;
+	const NodeHeader* header_ = nullptr;
+	const PathNode* pathNodes_ = nullptr;
+	size_t pathNodeCount_ = 0;
+	const LinkNode* links_ = nullptr;
+	size_t linkCount_ = 0;
+
+	DynamicArray<NodeLinkRange> linkRanges_;
+
+	// Uniform grid over the node's bounding box, stored as offsets into one array of point IDs.
+	Vector2 gridMin_ = Vector2(0.0f, 0.0f);
+	int gridWidth_ = 0;
+	int gridHeight_ = 0;
+	DynamicArray<uint32_t> cellOffsets_;
+	DynamicArray<uint16_t> cellPoints_;
+};
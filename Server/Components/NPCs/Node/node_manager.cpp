@@ -48,13 +48,13 @@ bool NPCNodeManager::openNode(ICore* core, int nodeId)
 		return false;
 	}
 
-	nodes_[nodeId] = std::make_unique<NPCNode>(nodeId);
-
-	if (!nodes_[nodeId]->initialize(core))
+	std::shared_ptr<const NPCNodeData> data = getData(core, nodeId, true);
+	if (!data)
 	{
-		nodes_[nodeId].reset();
 		return false;
 	}
+
+	nodes_[nodeId] = std::make_unique<NPCNode>(nodeId, std::move(data));
 	opened_[nodeId] = true;
 	return true;
 }
@@ -83,4 +83,48 @@ void NPCNodeManager::closeAllNodes()
 			closeNode(i);
 		}
 	}
-}
\ No newline at end of file
+}
+
+void NPCNodeManager::preloadNodes(ICore* core)
+{
+	int loaded = 0;
+	for (int i = 0; i < MAX_NODES; ++i)
+	{
+		if (getData(core, i, false))
+		{
+			++loaded;
+		}
+	}
+
+	if (loaded)
+	{
+		core->logLn(LogLevel::Message, "[NPCs] Loaded %d node files.", loaded);
+	}
+}
+
+bool NPCNodeManager::findNearestPoint(const Vector3& position, int& nodeId, uint16_t& pointId, float& distance) const
+{
+	bool found = false;
+	for (int i = 0; i < MAX_NODES; ++i)
+	{
+		uint16_t point;
+		float dist;
+		if (data_[i] && data_[i]->findNearestPoint(position, point, dist) && (!found || dist < distance))
+		{
+			nodeId = i;
+			pointId = point;
+			distance = dist;
+			found = true;
+		}
+	}
+	return found;
+}
+
+std::shared_ptr<const NPCNodeData> NPCNodeManager::getData(ICore* core, int nodeId, bool logMissing)
+{
+	if (!data_[nodeId])
+	{
+		data_[nodeId] = NPCNodeData::load(core, nodeId, logMissing);
+	}
+	return data_[nodeId];
+}
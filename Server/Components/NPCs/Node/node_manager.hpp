@@ -27,7 +27,17 @@ public:
 	void closeNode(int nodeId);
 	void closeAllNodes();
 
+	/// Map and index every node file that is present so opening a node later never touches the disk.
+	void preloadNodes(ICore* core);
+
+	/// Find the closest path point over all loaded node files.
+	bool findNearestPoint(const Vector3& position, int& nodeId, uint16_t& pointId, float& distance) const;
+
 private:
+	std::shared_ptr<const NPCNodeData> getData(ICore* core, int nodeId, bool logMissing);
+
 	StaticArray<bool, MAX_NODES> opened_;
 	StaticArray<std::unique_ptr<NPCNode>, MAX_NODES> nodes_;
+	// File contents outlive closeNode, they are immutable and cheap to keep mapped.
+	StaticArray<std::shared_ptr<const NPCNodeData>, MAX_NODES> data_;
 };
\ No newline at end of file
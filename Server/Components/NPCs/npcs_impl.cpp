@@ -26,6 +26,7 @@ void NPCComponent::onInit(IComponentList* components)
 		vehicles = components->queryComponent<IVehiclesComponent>();
 		objects = components->queryComponent<IObjectsComponent>();
 		actors = components->queryComponent<IActorsComponent>();
+		collision = components->queryComponent<ICollisionComponent>();
 
 		if (vehicles != nullptr)
 		{
@@ -33,6 +34,8 @@ void NPCComponent::onInit(IComponentList* components)
 			vehicles->getEventDispatcher().addEventHandler(this);
 		}
 	}
+
+	nodeManager_.preloadNodes(core);
 }
 
 void NPCComponent::free()
@@ -73,6 +76,11 @@ void NPCComponent::onFree(IComponent* component)
 	{
 		actors = nullptr;
 	}
+
+	if (component == collision)
+	{
+		collision = nullptr;
+	}
 }
 
 INetwork* NPCComponent::getNetwork()
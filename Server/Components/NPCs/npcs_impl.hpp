@@ -18,6 +18,8 @@
 #include "./Path/path_pool.hpp"
 #include "./Playback/record_manager.hpp"
 #include "./Node/node_manager.hpp"
+#include <npcs_nodes.hpp>
+#include <collision.hpp>
 
 using namespace Impl;
 
@@ -40,6 +42,15 @@ public:
 
 	void onReady() override { }
 
+	IExtension* getExtension(UID id) override
+	{
+		if (id == INPCNodeLookupExtension::ExtensionIID)
+		{
+			return &nodeLookup_;
+		}
+		return INPCComponent::getExtension(id);
+	}
+
 	void free() override;
 
 	void onFree(IComponent* component) override;
@@ -157,6 +168,12 @@ public:
 
 	void emulatePacketIn(IPlayer& player, int type, NetworkBitStream& bs);
 
+	/// Returns the player pool's sync injector if a sync packet can skip emulatePacketIn, or nullptr
+	NetCode::ISyncInjector* getSyncInjector(int type)
+	{
+		return npcNetwork.getSyncInjector(type);
+	}
+
 	ICore* getCore()
 	{
 		return core;
@@ -177,6 +194,11 @@ public:
 		return actors;
 	}
 
+	ICollisionComponent* getCollision()
+	{
+		return collision;
+	}
+
 	DefaultEventDispatcher<NPCEventHandler>& getEventDispatcher_internal()
 	{
 		return eventDispatcher;
@@ -319,6 +341,7 @@ private:
 	IVehiclesComponent* vehicles = nullptr;
 	IObjectsComponent* objects = nullptr;
 	IActorsComponent* actors = nullptr;
+	ICollisionComponent* collision = nullptr;
 
 	// Path manager
 	NPCPathPool pathManager_;
@@ -328,4 +351,37 @@ private:
 
 	// Node manager
 	NPCNodeManager nodeManager_;
+
+	// Node lookups for other components and scripts
+	struct NodeLookup final : public INPCNodeLookupExtension
+	{
+		NPCNodeManager& nodes;
+
+		NodeLookup(NPCNodeManager& nodes)
+			: nodes(nodes)
+		{
+		}
+
+		bool findNearestNodePoint(Vector3 position, int& nodeId, int& pointId, float& distance) const override
+		{
+			uint16_t point;
+			if (!nodes.findNearestPoint(position, nodeId, point, distance))
+			{
+				return false;
+			}
+			pointId = point;
+			return true;
+		}
+
+		void freeExtension() override
+		{
+			// Owned by the NPC component.
+		}
+
+		void reset() override
+		{
+		}
+	};
+
+	NodeLookup nodeLookup_ { nodeManager_ };
 };
@@ -17,6 +17,10 @@
 #define MAX_HIT_RADIUS_VEHICLE 1.0f
 #define MAX_DISTANCE_TO_ENTER_VEHICLE 30.0f
 #define MIN_VEHICLE_GO_TO_DISTANCE 1.0f
+#define NPC_GROUND_OFFSET 1.0f
+#define NPC_MAX_GROUND_DROP 3.0f
+// Bullet hit ID for a shot stopped by world collision, past the last actor ID
+#define NPC_MAP_HIT_ID (ACTOR_POOL_SIZE + 1)
 
 static const float WeaponDamages[MAX_WEAPON_ID] = {
 	5.0f, // fists (0)
@@ -562,6 +566,19 @@ inline int getClosestEntityInBetween(NPCComponent* npcs, const Vector3& hitOrigi
 		}
 	}
 
+	if (int(betweenCheckFlags) & int(EntityCheckType::Map))
+	{
+		// Checked last, a wall only counts if it's in front of everything else we found
+		CollisionHit hit;
+		if (npcs->getCollision() && npcs->getCollision()->rayCast(hitOrigin, hitTarget, hit) && hit.distance <= range && (closestEntityId == INVALID_PLAYER_ID || hit.distance < closestEntityDistance))
+		{
+			entityType = EntityCheckType::Map;
+			closestEntityDistance = hit.distance;
+			closestEntityId = NPC_MAP_HIT_ID;
+			hitMap = hit.position;
+		}
+	}
+
 	return closestEntityId;
 }
 
@@ -27,7 +27,10 @@ void Object::restream()
 {
 	for (IPlayer* player : objects_.getPlayers().entries())
 	{
-		createObjectForClient(*player);
+		if (!objects_.isGlobalObjectPending(*player, poolID))
+		{
+			createObjectForClient(*player);
+		}
 	}
 }
 
@@ -75,23 +78,31 @@ bool Object::advance(Microseconds elapsed, TimePoint now)
 {
 	if (getDelayedProcessing())
 	{
-		for (IPlayer* player : objects_.getPlayers().entries())
+		// Only the players still waiting are in here, so there's no need to walk the whole player pool.
+		for (size_t i = 0; i < delayedProcessing_.size();)
 		{
-			const int pid = player->getID();
-			if (delayedProcessing_.test(pid) && now >= delayedProcessingTime_[pid])
+			const int pid = delayedProcessing_[i].first;
+			if (now < delayedProcessing_[i].second)
 			{
-				delayedProcessing_.reset(pid);
-				if (delayedProcessing_.any())
-				{
-					enableDelayedProcessing();
-				}
-				else
-				{
-					disableDelayedProcessing();
-				}
+				++i;
+				continue;
+			}
 
-				eraseFromProcessed(false /* force */);
+			delayedProcessing_.eraseAt(i);
+			if (!delayedProcessing_.empty())
+			{
+				enableDelayedProcessing();
+			}
+			else
+			{
+				disableDelayedProcessing();
+			}
+
+			eraseFromProcessed(false /* force */);
 
+			IPlayer* player = objects_.getPlayers().get(pid);
+			if (player)
+			{
 				if (isMoving())
 				{
 					PacketHelper::send(makeMovePacket(), *player);
@@ -12,6 +12,7 @@
 #include <Server/Components/Objects/objects.hpp>
 #include <Server/Components/Vehicles/vehicles.hpp>
 #include <netcode.hpp>
+#include <player_overlay.hpp>
 
 class ObjectComponent;
 class PlayerObjectData;
@@ -321,8 +322,8 @@ protected:
 class Object final : public BaseObject<IObject>
 {
 private:
-	StaticBitset<PLAYER_POOL_SIZE> delayedProcessing_;
-	StaticArray<TimePoint, PLAYER_POOL_SIZE> delayedProcessingTime_;
+	/// When each player the object was just created for should get its movement and attachment
+	PlayerOverlay<TimePoint> delayedProcessing_;
 	ObjectComponent& objects_;
 
 	void restream();
@@ -340,17 +341,22 @@ public:
 		if (isMoving() || getAttachmentData().type == ObjectAttachmentData::Type::Player)
 		{
 			const int pid = player.getID();
-			delayedProcessing_.set(pid);
-			delayedProcessingTime_[pid] = Time::now() + Seconds(1);
+			delayedProcessing_.set(pid, Time::now() + Seconds(1));
 			enableDelayedProcessing();
 			addToProcessed();
 		}
 	}
 
+	/// Bytes used by this object and its per-player state
+	size_t memoryUsage() const
+	{
+		return sizeof(*this) + delayedProcessing_.heapUsage();
+	}
+
 	void destroyForPlayer(IPlayer& player)
 	{
 		const int pid = player.getID();
-		delayedProcessing_.reset(pid);
+		delayedProcessing_.erase(pid);
 
 		destroyObjectForClient(player);
 	}
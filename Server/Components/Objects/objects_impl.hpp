@@ -11,13 +11,18 @@
 #include "object.hpp"
 #include <Server/Components/Vehicles/vehicles.hpp>
 #include <Server/Components/CustomModels/custommodels.hpp>
+#include <join_budget.hpp>
+#include <memory_usage.hpp>
 #include <netcode.hpp>
 
+class PlayerObjectData;
+
 class ObjectComponent final : public IObjectsComponent, public CoreEventHandler, public PlayerConnectEventHandler, public PlayerStreamEventHandler, public PlayerSpawnEventHandler, public PoolEventHandler<IPlayer>, public PlayerModelsEventHandler
 {
 private:
 	ICore* core = nullptr;
 	IPlayerPool* players = nullptr;
+	IPlayerJoinBudgetExtension* joinBudget = nullptr;
 	MarkedDynamicPoolStorage<Object, IObject, 1, OBJECT_POOL_SIZE> storage;
 	DefaultEventDispatcher<ObjectEventHandler> eventDispatcher;
 	StaticArray<int, OBJECT_POOL_SIZE> isPlayerObject;
@@ -25,6 +30,8 @@ private:
 	FlatPtrHashSet<PlayerObject> processedPlayerObjects;
 	FlatPtrHashSet<Object> processedObjects;
 	FlatPtrHashSet<Object> attachedToPlayer;
+	/// Players still being sent the global objects there were when they joined, a join budget at a time
+	FlatPtrHashSet<PlayerObjectData> joiningPlayers;
 	bool defCameraCollision = true;
 
 	ICustomModelsComponent* models = nullptr;
@@ -189,6 +196,40 @@ private:
 		}
 	} playerEditAttachedObjectEventHandler;
 
+	struct MemoryUsageExtension final : public IMemoryUsageExtension
+	{
+		ObjectComponent& self;
+
+		MemoryUsageExtension(ObjectComponent& component)
+			: self(component)
+		{
+		}
+
+		size_t getEntityCount() const override
+		{
+			return self.storage._entries().size();
+		}
+
+		size_t getMemoryUsage() const override
+		{
+			size_t usage = 0;
+			for (IObject* object : self.storage)
+			{
+				usage += static_cast<Object*>(object)->memoryUsage();
+			}
+			return usage;
+		}
+
+		void freeExtension() override
+		{
+			// Owned by the component.
+		}
+
+		void reset() override
+		{
+		}
+	} memoryUsage;
+
 public:
 	inline void incrementPlayerCounter(int objid)
 	{
@@ -231,14 +272,25 @@ public:
 		: playerSelectObjectEventHandler(*this)
 		, playerEditObjectEventHandler(*this)
 		, playerEditAttachedObjectEventHandler(*this)
+		, memoryUsage(*this)
 	{
 		isPlayerObject.fill(0);
 	}
 
+	IExtension* getExtension(UID id) override
+	{
+		if (id == IMemoryUsageExtension::ExtensionIID)
+		{
+			return &memoryUsage;
+		}
+		return IObjectsComponent::getExtension(id);
+	}
+
 	void onLoad(ICore* core) override
 	{
 		this->core = core;
 		this->players = &core->getPlayers();
+		joinBudget = queryExtension<IPlayerJoinBudgetExtension>(players);
 		core->getEventDispatcher().addEventHandler(this);
 		players->getPlayerSpawnDispatcher().addEventHandler(this, EventPriority::EventPriority_FairlyHigh + 1 /* want this to be called before Pawn */);
 		players->getPlayerStreamDispatcher().addEventHandler(this, EventPriority::EventPriority_FairlyLow - 1 /* want this to be called after Pawn but before Core */);
@@ -354,7 +406,10 @@ public:
 		Object* obj = storage.get(objid);
 		for (IPlayer* player : players->entries())
 		{
-			obj->createForPlayer(*player);
+			if (!isGlobalObjectPending(*player, objid))
+			{
+				obj->createForPlayer(*player);
+			}
 		}
 
 		return obj;
@@ -423,9 +478,18 @@ public:
 
 	void onPlayerStreamIn(IPlayer& player, IPlayer& forPlayer) override;
 
+	bool onPlayerRequestSpawn(IPlayer& player) override
+	{
+		// The world they spawn in has to be there first.
+		flushGlobalObjects(player);
+		return true;
+	}
+
 	// Pre-spawn so you can safely attach onPlayerSpawn
 	void onPlayerSpawn(IPlayer& player) override
 	{
+		flushGlobalObjects(player);
+
 		const int pid = player.getID();
 		for (IObject* object : storage)
 		{
@@ -460,6 +524,7 @@ public:
 		isPlayerObject.fill(0);
 		defCameraCollision = true;
 		attachedToPlayer.clear();
+		stopJoiningPlayers();
 	}
 
 	bool is037CompatModeEnabled() const { return compatModeEnabled; }
@@ -470,6 +535,21 @@ public:
 
 	void onPlayerStreamOut(IPlayer& player, IPlayer& forPlayer) override;
 	inline FlatPtrHashSet<Object>& getAttachedToPlayers() { return attachedToPlayer; }
+
+	/// Start creating the global objects for a player, as many as their join budget allows each tick
+	void streamGlobalObjects(IPlayer& player);
+
+	/// Create as many of the player's outstanding global objects as the budget allows, or all of them when flushing
+	void sendGlobalObjects(PlayerObjectData& data, bool flush);
+
+	/// Create every global object the player is still waiting for
+	void flushGlobalObjects(IPlayer& player);
+
+	/// Whether the player is still to be sent this global object in turn, so it mustn't be sent to them meanwhile
+	bool isGlobalObjectPending(IPlayer& player, int id);
+
+	/// Forget about everyone still waiting for global objects
+	void stopJoiningPlayers();
 };
 
 class PlayerObjectData final : public IPlayerObjectData
@@ -484,6 +564,8 @@ private:
 	bool inObjectSelection_;
 	bool inObjectEdit_;
 	bool streamedGlobalObjects_;
+	/// Global objects from this ID up are still to be created for the player, OBJECT_POOL_SIZE once they all are
+	int nextGlobalObject_;
 
 public:
 	// TODO: const.
@@ -502,6 +584,7 @@ public:
 		: component_(component)
 		, player_(player)
 		, streamedGlobalObjects_(false)
+		, nextGlobalObject_(OBJECT_POOL_SIZE)
 	{
 	}
 
@@ -644,6 +727,7 @@ public:
 		inObjectEdit_ = false;
 		inObjectSelection_ = false;
 		streamedGlobalObjects_ = false;
+		nextGlobalObject_ = OBJECT_POOL_SIZE;
 		slotsOccupied_.reset();
 		storage.clear();
 		attachedToPlayer_.clear();
@@ -766,6 +850,16 @@ public:
 		streamedGlobalObjects_ = value;
 	}
 
+	int getNextGlobalObject() const
+	{
+		return nextGlobalObject_;
+	}
+
+	void setNextGlobalObject(int id)
+	{
+		nextGlobalObject_ = id;
+	}
+
 	ObjectComponent& getComponent()
 	{
 		return component_;
@@ -29,6 +29,16 @@ void ObjectComponent::onTick(Microseconds elapsed, TimePoint now)
 			eventDispatcher.dispatch(&ObjectEventHandler::onPlayerObjectMoved, obj->getObjects().getPlayer(), *obj);
 		}
 	}
+
+	for (auto it = joiningPlayers.begin(); it != joiningPlayers.end();)
+	{
+		PlayerObjectData* data = *(it++);
+		sendGlobalObjects(*data, false);
+		if (data->getNextGlobalObject() == OBJECT_POOL_SIZE)
+		{
+			joiningPlayers.erase(data);
+		}
+	}
 }
 
 void ObjectComponent::onPlayerConnect(IPlayer& player)
@@ -39,16 +49,7 @@ void ObjectComponent::onPlayerConnect(IPlayer& player)
 	if (artwork && player.getClientVersion() == ClientVersion::ClientVersion_SAMP_03DL)
 		return;
 
-	auto playerData = reinterpret_cast<PlayerObjectData*>(queryExtension<IPlayerObjectData>(player));
-	if (playerData)
-	{
-		playerData->setStreamedGlobalObjects(true);
-		for (IObject* o : storage)
-		{
-			Object* obj = static_cast<Object*>(o);
-			obj->createForPlayer(player);
-		}
-	}
+	streamGlobalObjects(player);
 }
 
 void ObjectComponent::onPlayerFinishedDownloading(IPlayer& player)
@@ -65,12 +66,70 @@ void ObjectComponent::onPlayerFinishedDownloading(IPlayer& player)
 		return;
 	}
 
-	player_data->setStreamedGlobalObjects(true);
-	for (IObject* o : storage)
+	streamGlobalObjects(player);
+}
+
+void ObjectComponent::streamGlobalObjects(IPlayer& player)
+{
+	PlayerObjectData* data = queryExtension<PlayerObjectData>(player);
+	if (data == nullptr)
+	{
+		return;
+	}
+
+	// Thousands of mapped objects would otherwise all go out in one tick, the rest are created in onTick.
+	data->setStreamedGlobalObjects(true);
+	data->setNextGlobalObject(storage.Lower);
+	sendGlobalObjects(*data, false);
+	if (data->getNextGlobalObject() != OBJECT_POOL_SIZE)
+	{
+		joiningPlayers.insert(data);
+	}
+}
+
+void ObjectComponent::sendGlobalObjects(PlayerObjectData& data, bool flush)
+{
+	IPlayer& player = data.getPlayer();
+	int id = data.getNextGlobalObject();
+	for (; id < OBJECT_POOL_SIZE; ++id)
 	{
-		Object* obj = static_cast<Object*>(o);
+		Object* obj = storage.get(id);
+		if (obj == nullptr)
+		{
+			continue;
+		}
+		if (!flush && joinBudget && joinBudget->takeJoinBudget(player, 1) == 0)
+		{
+			break;
+		}
 		obj->createForPlayer(player);
 	}
+	data.setNextGlobalObject(id);
+}
+
+void ObjectComponent::flushGlobalObjects(IPlayer& player)
+{
+	PlayerObjectData* data = queryExtension<PlayerObjectData>(player);
+	if (data && data->getNextGlobalObject() != OBJECT_POOL_SIZE)
+	{
+		sendGlobalObjects(*data, true);
+		joiningPlayers.erase(data);
+	}
+}
+
+bool ObjectComponent::isGlobalObjectPending(IPlayer& player, int id)
+{
+	PlayerObjectData* data = queryExtension<PlayerObjectData>(player);
+	return data && id >= data->getNextGlobalObject();
+}
+
+void ObjectComponent::stopJoiningPlayers()
+{
+	for (PlayerObjectData* data : joiningPlayers)
+	{
+		data->setNextGlobalObject(OBJECT_POOL_SIZE);
+	}
+	joiningPlayers.clear();
 }
 
 void ObjectComponent::onPlayerStreamIn(IPlayer& player, IPlayer& forPlayer)
@@ -138,6 +197,11 @@ void ObjectComponent::onPlayerStreamOut(IPlayer& player, IPlayer& forPlayer)
 
 void ObjectComponent::onPoolEntryDestroyed(IPlayer& player)
 {
+	if (PlayerObjectData* data = queryExtension<PlayerObjectData>(player))
+	{
+		joiningPlayers.erase(data);
+	}
+
 	const int pid = player.getID();
 	for (IObject* obj : attachedToPlayer)
 	{
@@ -24,6 +24,8 @@
 
 #include <pawn-natives/NativeFunc.hpp>
 #include <pawn-natives/NativesMain.hpp>
+#include "../Scripting/Database/Events.hpp"
+#include "../Scripting/Hashing/Events.hpp"
 #include "../Scripting/Player/Events.hpp"
 
 extern "C"
@@ -57,6 +59,14 @@ PawnManager::PawnManager()
 
 PawnManager::~PawnManager()
 {
+	// Everything below calls in to the scripts directly, so bring threaded ones back to this thread first.
+	for (IPawnScript* cur : scripts_)
+	{
+		PawnScript& script = *reinterpret_cast<PawnScript*>(cur);
+		delete script.thread_;
+		script.thread_ = nullptr;
+	}
+
 	if (mainScript_)
 	{
 		mainScript_->Call("OnGameModeExit", DefaultReturnValue_False);
@@ -64,6 +74,9 @@ PawnManager::~PawnManager()
 		PawnTimerImpl::Get()->killTimers(mainScript_->GetAMX());
 		pluginManager.AmxUnload(mainScript_->GetAMX());
 		eventDispatcher.dispatch(&PawnEventHandler::onAmxUnload, *mainScript_);
+		ClearFormatCache(mainScript_->GetAMX());
+		DropDatabaseQueries(mainScript_->GetAMX());
+		DropPasswordRequests(mainScript_->GetAMX());
 	}
 	for (IPawnScript* cur : scripts_)
 	{
@@ -72,6 +85,9 @@ PawnManager::~PawnManager()
 		PawnTimerImpl::Get()->killTimers(script.GetAMX());
 		pluginManager.AmxUnload(script.GetAMX());
 		eventDispatcher.dispatch(&PawnEventHandler::onAmxUnload, script);
+		ClearFormatCache(script.GetAMX());
+		DropDatabaseQueries(script.GetAMX());
+		DropPasswordRequests(script.GetAMX());
 	}
 }
 
@@ -442,6 +458,33 @@ void PawnManager::ProcessTick(Microseconds elapsed, TimePoint now)
 			core->logLn(LogLevel::Error, "%d %s", err, aux_StrError(err));
 		}
 	}
+
+	// One budget for all of them, so the more scripts are threaded the less each may hold the tick up.
+	const TimePoint deadline = Time::now() + ScriptThread::NativeBudget;
+	for (IPawnScript* cur : scripts_)
+	{
+		ScriptThread* thread = reinterpret_cast<PawnScript*>(cur)->thread_;
+		if (thread)
+		{
+			thread->processNatives(deadline);
+		}
+	}
+}
+
+bool PawnManager::IsThreadedScriptName(std::string const& name) const
+{
+	DynamicArray<StringView> threaded(config->getStringsCount("pawn.threaded_side_scripts"));
+	config->getStrings("pawn.threaded_side_scripts", Span<StringView>(threaded.data(), threaded.size()));
+	for (StringView entry : threaded)
+	{
+		std::string normal_script_name;
+		utils::NormaliseScriptName(std::string(trim(entry)), normal_script_name);
+		if (normal_script_name == name)
+		{
+			return true;
+		}
+	}
+	return false;
 }
 
 bool PawnManager::Load(DynamicArray<StringView> const& mainScripts)
@@ -515,6 +558,21 @@ void PawnManager::openAMX(PawnScript& script, bool isEntryScript, bool restartin
 
 	CheckNatives(script);
 
+	// Attach before any code runs, but only start the thread once it's initialised, so that init is synchronous.
+	if (!isEntryScript && IsThreadedScriptName(script.name_))
+	{
+		if (!pluginManager.plugins_.empty())
+		{
+			// They may amx_Exec or amx_Push on it from the main thread at any time.
+			core->logLn(LogLevel::Warning, "Not running %s on its own thread, it can't be while legacy plugins are loaded.", script.name_.c_str());
+		}
+		else
+		{
+			script.thread_ = new ScriptThread(script, core, std::max(*config->getInt("pawn.threaded_queue_limit"), 1));
+			script.thread_->attach(*config);
+		}
+	}
+
 	if (isEntryScript)
 	{
 		script.Call("OnGameModeInit", DefaultReturnValue_False);
@@ -582,6 +640,11 @@ void PawnManager::openAMX(PawnScript& script, bool isEntryScript, bool restartin
 			CallInSides("OnPlayerConnect", DefaultReturnValue_True, p->getID());
 		}
 	}
+
+	if (script.thread_)
+	{
+		script.thread_->start();
+	}
 }
 
 bool PawnManager::Load(std::string const& name, bool isEntryScript, bool restarting)
@@ -638,6 +701,10 @@ bool PawnManager::Load(std::string const& name, bool isEntryScript, bool restart
 
 void PawnManager::closeAMX(PawnScript& script, bool isEntryScript)
 {
+	// Let a threaded script finish what it was sent, then unload it synchronously like any other.
+	delete script.thread_;
+	script.thread_ = nullptr;
+
 	// Call OnPlayerDisconnect on entry script close first, then we proceed to do unload player callback
 	if (isEntryScript)
 	{
@@ -685,6 +752,9 @@ void PawnManager::closeAMX(PawnScript& script, bool isEntryScript)
 	PawnTimerImpl::Get()->killTimers(script.GetAMX());
 	pluginManager.AmxUnload(script.GetAMX());
 	eventDispatcher.dispatch(&PawnEventHandler::onAmxUnload, script);
+	ClearFormatCache(script.GetAMX());
+	DropDatabaseQueries(script.GetAMX());
+	DropPasswordRequests(script.GetAMX());
 	amxToScript_.erase(script.GetAMX());
 }
 
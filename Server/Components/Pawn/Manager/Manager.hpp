@@ -33,6 +33,10 @@
 #include <Server/Components/Vehicles/vehicles.hpp>
 #include <Server/Components/CustomModels/custommodels.hpp>
 #include <Server/Components/NPCs/npcs.hpp>
+#include <Server/Components/Unicode/unicode.hpp>
+#include <collision.hpp>
+#include <hashing.hpp>
+#include <player_codepage.hpp>
 #include <Impl/Utils/singleton.hpp>
 #include <sdk.hpp>
 
@@ -44,6 +48,7 @@
 
 #include "../PluginManager/PluginManager.hpp"
 #include "../Script/Script.hpp"
+#include "ScriptThread.hpp"
 
 using namespace Impl;
 
@@ -56,6 +61,10 @@ public:
 	FlatHashMap<AMX*, PawnScript*> amxToScript_;
 	DefaultEventDispatcher<PawnEventHandler> eventDispatcher;
 	PawnPluginManager pluginManager;
+	// Not in PawnLookup, so plugins can't see it through there.
+	ICollisionComponent* collision = nullptr;
+	IHashingComponent* hashing = nullptr;
+	IUnicodeComponent* unicode = nullptr;
 
 private:
 	int gamemodeIndex_ = 0;
@@ -132,6 +141,44 @@ public:
 		}
 	}
 
+	/// Queue a call for a side script with its own thread, false if it runs on this one.  Threaded scripts get
+	/// their calls later and can't return anything, so they're skipped when working out return values.
+	template <typename Name, typename... T>
+	bool PostToThread(IPawnScript* script, Name const& name, T... args)
+	{
+		ScriptThread* thread = static_cast<PawnScript*>(script)->thread_;
+		if (thread == nullptr)
+		{
+			return false;
+		}
+		thread->post(name, args...);
+		return true;
+	}
+
+	/// Call a public in one script, queueing it instead if the script has its own thread.
+	template <typename Name, typename... T>
+	cell CallScript(IPawnScript& script, Name const& name, DefaultReturnValue defaultRetValue, T... args)
+	{
+		if (PostToThread(&script, name, args...))
+		{
+			return static_cast<cell>(defaultRetValue);
+		}
+		return script.Call(name, defaultRetValue, args...);
+	}
+
+	/// Whether a script runs on its own thread, and so can't be called in to directly.
+	bool IsThreaded(AMX* amx) const
+	{
+		auto itr = amxToScript_.find(amx);
+		return itr != amxToScript_.end() && itr->second->thread_ != nullptr;
+	}
+
+	ScriptThread* GetScriptThread(AMX* amx) const
+	{
+		auto itr = amxToScript_.find(amx);
+		return itr == amxToScript_.end() ? nullptr : itr->second->thread_;
+	}
+
 	template <typename... T>
 	cell CallAllInSidesFirst(char const* name, DefaultReturnValue defaultRetValue, T... args)
 	{
@@ -139,6 +186,10 @@ public:
 
 		for (IPawnScript* cur : scripts_)
 		{
+			if (PostToThread(cur, name, args...))
+			{
+				continue;
+			}
 			ret = cur->Call(name, defaultRetValue, args...);
 		}
 		if (mainScript_)
@@ -160,6 +211,10 @@ public:
 		}
 		for (IPawnScript* cur : scripts_)
 		{
+			if (PostToThread(cur, name, args...))
+			{
+				continue;
+			}
 			ret = cur->Call(name, defaultRetValue, args...);
 		}
 
@@ -175,6 +230,10 @@ public:
 
 		for (IPawnScript* cur : scripts_)
 		{
+			if (PostToThread(cur, name, args...))
+			{
+				continue;
+			}
 			ret = cur->Call(name, DefaultReturnValue_False, args...);
 			if (ret)
 			{
@@ -194,6 +253,10 @@ public:
 
 		for (IPawnScript* cur : scripts_)
 		{
+			if (PostToThread(cur, name, args...))
+			{
+				continue;
+			}
 			ret = cur->Call(name, DefaultReturnValue_True, args...);
 			if (!ret)
 			{
@@ -211,6 +274,10 @@ public:
 
 		for (IPawnScript* cur : scripts_)
 		{
+			if (PostToThread(cur, name, args...))
+			{
+				continue;
+			}
 			ret = cur->Call(name, defaultRetValue, args...);
 		}
 
@@ -242,6 +309,10 @@ public:
 		}
 		for (IPawnScript* cur : scripts_)
 		{
+			if (PostToThread(cur, name, args...))
+			{
+				continue;
+			}
 			ret = cur->Call(name, DefaultReturnValue_False, args...);
 		}
 		return ret;
@@ -259,6 +330,10 @@ public:
 		}
 		for (IPawnScript* cur : scripts_)
 		{
+			if (PostToThread(cur, name, args...))
+			{
+				continue;
+			}
 			ret = cur->Call(name, DefaultReturnValue_False, args...);
 		}
 		return ret;
@@ -278,6 +353,10 @@ public:
 		}
 		for (IPawnScript* cur : scripts_)
 		{
+			if (PostToThread(cur, name, args...))
+			{
+				continue;
+			}
 			ret = cur->Call(name, DefaultReturnValue_False, args...);
 			if (ret)
 				return ret;
@@ -297,6 +376,10 @@ public:
 		}
 		for (IPawnScript* cur : scripts_)
 		{
+			if (PostToThread(cur, name, args...))
+			{
+				continue;
+			}
 			ret = cur->Call(name, DefaultReturnValue_False, args...);
 			if (ret)
 				return ret;
@@ -317,6 +400,10 @@ public:
 		}
 		for (IPawnScript* cur : scripts_)
 		{
+			if (PostToThread(cur, name, args...))
+			{
+				continue;
+			}
 			ret = cur->Call(name, DefaultReturnValue_True, args...);
 			if (!ret)
 				return ret;
@@ -337,6 +424,10 @@ public:
 		}
 		for (IPawnScript* cur : scripts_)
 		{
+			if (PostToThread(cur, name, args...))
+			{
+				continue;
+			}
 			ret = cur->Call(name, DefaultReturnValue_True, args...);
 			if (!ret)
 				return ret;
@@ -359,4 +450,7 @@ private:
 		= 0;
 
 	void CheckNatives(PawnScript& script);
+
+	/// Whether a side script is listed in `pawn.threaded_side_scripts`
+	bool IsThreadedScriptName(std::string const& name) const;
 };
@@ -0,0 +1,206 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include "ScriptThread.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+/// The thread this is running a script on, if any.
+static thread_local ScriptThread* current = nullptr;
+
+/// Attached scripts, only ever used on the main thread.
+static FlatHashMap<AMX*, ScriptThread*> attached;
+
+/// Natives that share unlocked state between scripts, never run off the main thread whatever the config says.  The
+/// format cache is one (see format.cpp).
+static const char* const MainThreadNatives[] = {
+	"format",
+	"printf",
+};
+
+ScriptThread::ScriptThread(PawnScript& script, ICore* core, size_t queueLimit)
+	: script_(script)
+	, core_(core)
+	, relay_(queueLimit)
+{
+}
+
+ScriptThread::~ScriptThread()
+{
+	stop();
+}
+
+void ScriptThread::attach(IConfig& config)
+{
+	FlatHashSet<AMX_NATIVE> safeNatives;
+	DynamicArray<StringView> names(config.getStringsCount("pawn.thread_safe_natives"));
+	config.getStrings("pawn.thread_safe_natives", Span<StringView>(names.data(), names.size()));
+	for (StringView name : names)
+	{
+		if (std::find(std::begin(MainThreadNatives), std::end(MainThreadNatives), name) != std::end(MainThreadNatives))
+		{
+			continue;
+		}
+		AMX_NATIVE native = GlobalNativeRegistry::FindNative(String(name).c_str());
+		if (native)
+		{
+			safeNatives.insert(native);
+		}
+	}
+
+	int count = 0;
+	script_.NumNatives(&count);
+	safe_.assign(count, false);
+	for (int i = 0; i != count; ++i)
+	{
+		AMX_NATIVE_INFO info;
+		if (script_.GetNativeByIndex(i, &info) == AMX_ERR_NONE && info.func)
+		{
+			safe_[i] = safeNatives.find(info.func) != safeNatives.end();
+		}
+	}
+
+	AMX* amx = script_.GetAMX();
+	// Wrap whatever plugins installed, and stop the interpreter patching native calls to skip the callback.
+	callback_ = amx->callback ? amx->callback : &amx_Callback;
+	amx->sysreq_d = 0;
+	script_.SetCallback(&ScriptThread::Callback);
+	attached[amx] = this;
+}
+
+void ScriptThread::start()
+{
+	if (!thread_.joinable())
+	{
+		relay_.start();
+		thread_ = std::thread(&ScriptThread::loop, this);
+	}
+}
+
+void ScriptThread::stop()
+{
+	if (thread_.joinable())
+	{
+		relay_.stop();
+		// It may still need the main thread for natives while it finishes what's queued.
+		relay_.serve(TimePoint::max(), [this](NativeRequest& request)
+			{
+				runNative(request);
+			});
+		thread_.join();
+	}
+
+	AMX* amx = script_.GetAMX();
+	auto itr = attached.find(amx);
+	if (itr != attached.end() && itr->second == this)
+	{
+		script_.SetCallback(callback_);
+		attached.erase(itr);
+	}
+}
+
+void ScriptThread::post(ScriptJob&& job)
+{
+	if (!relay_.post(std::move(job)))
+	{
+		if (dropped_++ == 0)
+		{
+			core_->logLn(LogLevel::Warning, "Threaded script %s has %zu calls waiting, dropping any more until it catches up.", script_.name_.c_str(), relay_.limit());
+		}
+	}
+	else if (dropped_)
+	{
+		core_->logLn(LogLevel::Warning, "Threaded script %s caught up, %zu calls were dropped.", script_.name_.c_str(), dropped_);
+		dropped_ = 0;
+	}
+}
+
+void ScriptThread::processNatives(TimePoint deadline)
+{
+	relay_.serve(deadline, [this](NativeRequest& request)
+		{
+			runNative(request);
+		});
+
+	const int error = error_.exchange(AMX_ERR_NONE);
+	if (error != AMX_ERR_NONE)
+	{
+		core_->logLn(LogLevel::Error, "Threaded script %s: %s", script_.name_.c_str(), aux_StrError(error));
+	}
+}
+
+void ScriptThread::runNative(NativeRequest& request)
+{
+	// The script is blocked until this is done, so its memory is ours meanwhile.
+	request.error = callback_(script_.GetAMX(), request.index, request.result, request.params);
+}
+
+int AMXAPI ScriptThread::Callback(AMX* amx, cell index, cell* result, const cell* params)
+{
+	ScriptThread* thread = current;
+	if (thread == nullptr)
+	{
+		// Running on the main thread, before the script's thread started or from inside a native it handed over.
+		auto itr = attached.find(amx);
+		return itr == attached.end() ? amx_Callback(amx, index, result, params) : itr->second->callback_(amx, index, result, params);
+	}
+
+	if (index >= 0 && size_t(index) < thread->safe_.size() && thread->safe_[index])
+	{
+		return thread->callback_(amx, index, result, params);
+	}
+
+	NativeRequest request { index, result, params, AMX_ERR_NONE };
+	thread->relay_.ask(request);
+	return request.error;
+}
+
+void ScriptThread::run(ScriptJob& job)
+{
+	cell heap = 0;
+	cell* phys;
+	if (!job.heap.empty())
+	{
+		int error = script_.Allot(job.heap.size(), &heap, &phys);
+		if (error != AMX_ERR_NONE)
+		{
+			error_ = error;
+			return;
+		}
+		memcpy(phys, job.heap.data(), job.heap.size() * sizeof(cell));
+	}
+
+	for (size_t i = job.args.size(); i--;)
+	{
+		script_.Push(job.args[i].second ? heap + job.args[i].first : job.args[i].first);
+	}
+
+	cell ret;
+	int error = script_.Exec(&ret, job.index);
+	if (!job.heap.empty())
+	{
+		script_.Release(heap);
+	}
+
+	if (error != AMX_ERR_NONE)
+	{
+		error_ = error;
+	}
+}
+
+void ScriptThread::loop()
+{
+	current = this;
+	ScriptJob job;
+	while (relay_.next(job))
+	{
+		run(job);
+	}
+}
@@ -0,0 +1,142 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include "../Script/Script.hpp"
+#include "ThreadRelay.hpp"
+
+#include <atomic>
+#include <climits>
+#include <thread>
+
+/// A public call queued for a threaded script.  Strings are copied in to `heap`, which is put on the script's
+/// heap in one go when the call runs, and the arguments pointing in to it hold byte offsets rather than values.
+struct ScriptJob
+{
+	int index = INT_MAX;
+	DynamicArray<cell> heap;
+	DynamicArray<Pair<cell, bool>> args; ///< The value, or an offset in to `heap` when true
+
+	template <typename T>
+	std::enable_if_t<std::is_integral<T>::value || std::is_enum<T>::value> add(T value)
+	{
+		args.emplace_back(static_cast<cell>(value), false);
+	}
+
+	void add(float value)
+	{
+		args.emplace_back(amx_ftoc(value), false);
+	}
+
+	void add(double value)
+	{
+		add(float(value));
+	}
+
+	void add(StringView str)
+	{
+		addOffset(cell(heap.size() * sizeof(cell)));
+		for (char c : str)
+		{
+			heap.push_back(cell(static_cast<unsigned char>(c)));
+		}
+		heap.push_back(0);
+	}
+
+	void add(char const* str)
+	{
+		add(StringView(str));
+	}
+
+	void add(std::string const& str)
+	{
+		add(StringView(str));
+	}
+
+	void addOffset(cell offset)
+	{
+		args.emplace_back(offset, true);
+	}
+};
+
+/// Runs a side script on its own thread.  Publics are queued and run in order without returning anything, natives
+/// listed in `pawn.thread_safe_natives` run on the script's thread and every other native is handed back to the
+/// main thread, which runs them in `processNatives` while the script waits.  Legacy plugins can call in to any AMX
+/// from the main thread, so no script is threaded while one is loaded.
+class ScriptThread
+{
+public:
+	/// How long each tick spends running natives for all the threaded scripts together, once it has run the ones
+	/// they were already waiting on.
+	static constexpr Microseconds NativeBudget = Microseconds(500);
+
+	/// At most `queueLimit` calls wait for the script, any more are dropped with a warning.
+	ScriptThread(PawnScript& script, ICore* core, size_t queueLimit);
+	~ScriptThread();
+
+	/// Route the script's native calls through the thread, done before any of its code runs.
+	void attach(IConfig& config);
+
+	/// Start running queued calls.  Until then everything runs synchronously on the main thread.
+	void start();
+
+	/// Run everything still queued, then stop and hand the script back to the main thread.
+	void stop();
+
+	/// Queue a call to a public, does nothing if the script doesn't have it.
+	template <typename... T>
+	void post(char const* name, T... args)
+	{
+		ScriptJob job;
+		if (script_.FindPublic(name, &job.index) != AMX_ERR_NONE)
+		{
+			return;
+		}
+		(job.add(args), ...);
+		post(std::move(job));
+	}
+
+	template <typename... T>
+	void post(std::string const& name, T... args)
+	{
+		post(name.c_str(), args...);
+	}
+
+	void post(ScriptJob&& job);
+
+	/// Run the natives the script asks for until it has nothing left to do or `deadline` passes.  Doesn't wait at
+	/// all when the script is idle.
+	void processNatives(TimePoint deadline);
+
+private:
+	/// A native call the script is waiting on the main thread for.
+	struct NativeRequest
+	{
+		cell index;
+		cell* result;
+		const cell* params;
+		int error;
+	};
+
+	static int AMXAPI Callback(AMX* amx, cell index, cell* result, const cell* params);
+
+	void runNative(NativeRequest& request);
+	void run(ScriptJob& job);
+	void loop();
+
+	PawnScript& script_;
+	ICore* core_;
+	AMX_CALLBACK callback_ = nullptr;
+	DynamicArray<bool> safe_;
+
+	std::thread thread_;
+	ThreadRelay<ScriptJob, NativeRequest> relay_;
+	std::atomic<int> error_ { AMX_ERR_NONE };
+	size_t dropped_ = 0; ///< Calls dropped since the queue last had room, only used on the main thread
+};
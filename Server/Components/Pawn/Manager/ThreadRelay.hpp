@@ -0,0 +1,144 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <types.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+/// Hands jobs to a worker thread in order, and lets the worker ask for requests to be run on the main thread, which
+/// runs them in `serve` while the worker waits.  What a job or a request is, and how either is run, is up to the user.
+template <typename Job, typename Request>
+class ThreadRelay
+{
+public:
+	explicit ThreadRelay(size_t limit)
+		: limit_(limit)
+	{
+	}
+
+	/// Queue a job, false if `limit` are already waiting and it was dropped.
+	bool post(Job&& job)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (jobs_.size() >= limit_)
+		{
+			return false;
+		}
+		jobs_.emplace_back(std::move(job));
+		busy_ = true;
+		workerCV_.notify_all();
+		return true;
+	}
+
+	/// Called by the worker for each job in turn, waits for one and returns false once stopped with none left.
+	bool next(Job& job)
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		if (jobs_.empty())
+		{
+			busy_ = false;
+			mainCV_.notify_all();
+		}
+		workerCV_.wait(lock, [this]()
+			{
+				return !jobs_.empty() || stopping_;
+			});
+		if (jobs_.empty())
+		{
+			return false;
+		}
+		job = std::move(jobs_.front());
+		jobs_.pop_front();
+		return true;
+	}
+
+	/// Called by the worker during a job, returns once the main thread has run the request.
+	void ask(Request& request)
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		request_ = &request;
+		mainCV_.notify_all();
+		workerCV_.wait(lock, [this]()
+			{
+				return request_ == nullptr;
+			});
+	}
+
+	/// Run what the worker asks for until it has no jobs left or `deadline` passes, whichever is first.  Returns at
+	/// once when the worker is idle, and always runs a request that was already waiting.  `TimePoint::max()` waits
+	/// for everything queued to be done.
+	template <typename F>
+	void serve(TimePoint deadline, F&& run)
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		const auto ready = [this]()
+		{
+			return request_ != nullptr || !busy_;
+		};
+		for (;;)
+		{
+			if (request_)
+			{
+				// The worker is blocked until this is done, so whatever the request points at is ours meanwhile.
+				Request& request = *request_;
+				lock.unlock();
+				run(request);
+				lock.lock();
+				request_ = nullptr;
+				workerCV_.notify_all();
+			}
+
+			if (!busy_ || (deadline != TimePoint::max() && Time::now() >= deadline))
+			{
+				return;
+			}
+			else if (deadline == TimePoint::max())
+			{
+				mainCV_.wait(lock, ready);
+			}
+			else if (!mainCV_.wait_until(lock, deadline, ready))
+			{
+				return;
+			}
+		}
+	}
+
+	/// Let `next` hand out jobs again after a `stop`.
+	void start()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stopping_ = false;
+	}
+
+	/// Have `next` return false once everything queued has been handed out.
+	void stop()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stopping_ = true;
+		workerCV_.notify_all();
+	}
+
+	size_t limit() const
+	{
+		return limit_;
+	}
+
+private:
+	const size_t limit_;
+	std::mutex mutex_;
+	std::condition_variable workerCV_;
+	std::condition_variable mainCV_;
+	std::deque<Job> jobs_;
+	Request* request_ = nullptr;
+	bool busy_ = false; ///< A job is queued or running
+	bool stopping_ = false;
+};
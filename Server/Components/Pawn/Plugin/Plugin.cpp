@@ -463,6 +463,10 @@ int PluginCallFS(char* name)
 	auto manager = PawnManager::Get();
 	for (auto cur : manager->scripts_)
 	{
+		if (manager->PostToThread(cur, name))
+		{
+			continue;
+		}
 		ret = cur->Call(name, DefaultReturnValue_False);
 		if (!ret)
 			return ret;
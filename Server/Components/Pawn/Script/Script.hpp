@@ -34,28 +34,58 @@ struct AMXCache
 	FlatHashMap<String, int> publics; ///< A cache of AMX publics
 };
 
-// Global pawn native registry for all registered pawn natives
+// Global pawn native registry for all registered pawn natives.  Natives keep the index they were first
+// registered at, re-registering a name only replaces the function, so resolved handles never go stale.
 struct GlobalNativeRegistry
 {
-	static FlatHashMap<String, AMX_NATIVE>& GetRegistry()
+	struct Registry
 	{
-		static FlatHashMap<String, AMX_NATIVE> registry;
+		FlatHashMap<String, int> indices;
+		DynamicArray<AMX_NATIVE> natives;
+	};
+
+	static Registry& GetRegistry()
+	{
+		static Registry registry;
 		return registry;
 	}
 
 	static void RegisterNative(const char* name, AMX_NATIVE func)
 	{
-		GetRegistry()[String(name)] = func;
+		auto& registry = GetRegistry();
+		auto res = registry.indices.emplace(String(name), int(registry.natives.size()));
+		if (res.second)
+		{
+			registry.natives.push_back(func);
+		}
+		else
+		{
+			registry.natives[res.first->second] = func;
+		}
 	}
 
-	static AMX_NATIVE FindNative(const char* name)
+	/// Get a handle for a native to call it without looking the name up again, -1 if there's no such native
+	static int ResolveNative(StringView name)
+	{
+		auto& registry = GetRegistry();
+		auto it = registry.indices.find(String(name));
+		return (it != registry.indices.end()) ? it->second : -1;
+	}
+
+	static AMX_NATIVE GetNative(int handle)
 	{
 		auto& registry = GetRegistry();
-		auto it = registry.find(String(name));
-		return (it != registry.end()) ? it->second : nullptr;
+		return (handle >= 0 && size_t(handle) < registry.natives.size()) ? registry.natives[handle] : nullptr;
+	}
+
+	static AMX_NATIVE FindNative(const char* name)
+	{
+		return GetNative(ResolveNative(name));
 	}
 };
 
+class ScriptThread;
+
 class PawnScript : public IPawnScript
 {
 public:
@@ -137,13 +167,47 @@ public:
 
 	cell CallNativeArray(const char* name, Span<Impl::NativeParam> params) override
 	{
-		return CallNativeArrayImpl(name, params);
+		return CallNativeArrayImpl(FindNativeInRegistry(name), params);
+	}
+
+	/// Call a native resolved with GlobalNativeRegistry::ResolveNative, skipping the name lookup
+	cell CallNativeByHandle(int handle, Span<Impl::NativeParam> params)
+	{
+		return CallNativeArrayImpl(GlobalNativeRegistry::GetNative(handle), params);
 	}
 
 private:
-	cell CallNativeArrayImpl(const char* name, Span<Impl::NativeParam> params)
+	/// Calls with up to this many parameters build their frame on the stack, longer ones go to the heap
+	static constexpr size_t MaxStackNativeParams = 32;
+
+	/// A reference parameter to copy back out of the AMX heap after the call
+	struct RefParamInfo
+	{
+		cell amx_addr;
+		void* ref_obj;
+		Impl::NativeParam::Type type;
+		size_t arraySize;
+	};
+
+	/// On failure gives back everything the call took from the heap, from `heap` up, and logs why
+	bool CheckNativeParam(int err, cell heap)
+	{
+		if (err == AMX_ERR_NONE)
+		{
+			return true;
+		}
+		Release(heap);
+		PrintError(err);
+		return false;
+	}
+
+	bool AllotNativeParam(int cells, cell* amx_addr, cell** phys_addr, cell heap)
+	{
+		return CheckNativeParam(Allot(cells, amx_addr, phys_addr), heap);
+	}
+
+	cell CallNativeArrayImpl(AMX_NATIVE native, Span<Impl::NativeParam> params)
 	{
-		AMX_NATIVE native = FindNativeInRegistry(name);
 		if (!native)
 		{
 			return 0;
@@ -156,30 +220,24 @@ private:
 			return native(const_cast<AMX*>(&amx_), paramsArray);
 		}
 
-		DynamicArray<cell> paramsArray(argCount + 1);
+		cell stackParams[MaxStackNativeParams + 1];
+		RefParamInfo stackRefParams[MaxStackNativeParams];
+		DynamicArray<cell> heapParams;
+		DynamicArray<RefParamInfo> heapRefParams;
+		cell* paramsArray = stackParams;
+		RefParamInfo* refParams = stackRefParams;
+		if (argCount > MaxStackNativeParams)
+		{
+			heapParams.resize(argCount + 1);
+			heapRefParams.resize(argCount);
+			paramsArray = heapParams.data();
+			refParams = heapRefParams.data();
+		}
+		size_t refCount = 0;
 		paramsArray[0] = argCount * sizeof(cell);
 
 		cell amx_addr_save = GetHEA();
 
-		struct RefParamInfo
-		{
-			cell amx_addr;
-			void* ref_obj;
-			enum
-			{
-				INT,
-				FLOAT,
-				BOOL,
-				STRING,
-				VECTOR_INT,
-				VECTOR_FLOAT
-			} type;
-			size_t arraySize;
-			std::function<void(cell*)> readback;
-		};
-
-		DynamicArray<RefParamInfo> refParams;
-
 		for (size_t i = 0; i < argCount; ++i)
 		{
 			const auto& param = params[i];
@@ -203,19 +261,25 @@ private:
 				break;
 
 			case ParamType::String:
-				PushString(&amx_addr, nullptr, StringView(param.stringValue), false, false);
+				if (!CheckNativeParam(PushString(&amx_addr, nullptr, StringView(param.stringValue), false, false), amx_addr_save))
+				{
+					return 0;
+				}
 				paramsArray[i + 1] = amx_addr;
 				break;
 
 			case ParamType::ArrayInt:
 			{
+				// Converted straight into the AMX heap rather than through a temporary.
 				const int* arr = static_cast<const int*>(param.arrayPtr);
-				DynamicArray<cell> cellArray(param.arraySize);
+				if (!AllotNativeParam(param.arraySize, &amx_addr, &phys_addr, amx_addr_save))
+				{
+					return 0;
+				}
 				for (size_t j = 0; j < param.arraySize; ++j)
 				{
-					cellArray[j] = static_cast<cell>(arr[j]);
+					phys_addr[j] = static_cast<cell>(arr[j]);
 				}
-				PushArray(&amx_addr, nullptr, cellArray.data(), cellArray.size());
 				paramsArray[i + 1] = amx_addr;
 				break;
 			}
@@ -223,12 +287,14 @@ private:
 			case ParamType::ArrayFloat:
 			{
 				const float* arr = static_cast<const float*>(param.arrayPtr);
-				DynamicArray<cell> cellArray(param.arraySize);
+				if (!AllotNativeParam(param.arraySize, &amx_addr, &phys_addr, amx_addr_save))
+				{
+					return 0;
+				}
 				for (size_t j = 0; j < param.arraySize; ++j)
 				{
-					cellArray[j] = amx_ftoc(arr[j]);
+					phys_addr[j] = amx_ftoc(arr[j]);
 				}
-				PushArray(&amx_addr, nullptr, cellArray.data(), cellArray.size());
 				paramsArray[i + 1] = amx_addr;
 				break;
 			}
@@ -236,9 +302,12 @@ private:
 			case ParamType::RefInt:
 			{
 				auto* ref = static_cast<PawnRef<int>*>(param.refPtr);
-				Allot(1, &amx_addr, &phys_addr);
+				if (!AllotNativeParam(1, &amx_addr, &phys_addr, amx_addr_save))
+				{
+					return 0;
+				}
 				*phys_addr = static_cast<cell>(ref->get());
-				refParams.push_back({ amx_addr, param.refPtr, RefParamInfo::INT, 0, nullptr });
+				refParams[refCount++] = { amx_addr, param.refPtr, param.type, 0 };
 				paramsArray[i + 1] = amx_addr;
 				break;
 			}
@@ -246,10 +315,13 @@ private:
 			case ParamType::RefFloat:
 			{
 				auto* ref = static_cast<PawnRef<float>*>(param.refPtr);
-				Allot(1, &amx_addr, &phys_addr);
+				if (!AllotNativeParam(1, &amx_addr, &phys_addr, amx_addr_save))
+				{
+					return 0;
+				}
 				auto val = ref->get();
 				*phys_addr = amx_ftoc(val);
-				refParams.push_back({ amx_addr, param.refPtr, RefParamInfo::FLOAT, 0, nullptr });
+				refParams[refCount++] = { amx_addr, param.refPtr, param.type, 0 };
 				paramsArray[i + 1] = amx_addr;
 				break;
 			}
@@ -257,9 +329,12 @@ private:
 			case ParamType::RefBool:
 			{
 				auto* ref = static_cast<PawnRef<bool>*>(param.refPtr);
-				Allot(1, &amx_addr, &phys_addr);
+				if (!AllotNativeParam(1, &amx_addr, &phys_addr, amx_addr_save))
+				{
+					return 0;
+				}
 				*phys_addr = ref->get() ? 1 : 0;
-				refParams.push_back({ amx_addr, param.refPtr, RefParamInfo::BOOL, 0, nullptr });
+				refParams[refCount++] = { amx_addr, param.refPtr, param.type, 0 };
 				paramsArray[i + 1] = amx_addr;
 				break;
 			}
@@ -268,7 +343,10 @@ private:
 			{
 				auto* ref = static_cast<PawnRef<String>*>(param.refPtr);
 				size_t bufferSize = param.arraySize;
-				Allot(bufferSize, &amx_addr, &phys_addr);
+				if (!AllotNativeParam(bufferSize, &amx_addr, &phys_addr, amx_addr_save))
+				{
+					return 0;
+				}
 
 				const String& currentStr = ref->get();
 				if (!currentStr.empty())
@@ -280,7 +358,7 @@ private:
 					*phys_addr = 0;
 				}
 
-				refParams.push_back({ amx_addr, param.refPtr, RefParamInfo::STRING, bufferSize, nullptr });
+				refParams[refCount++] = { amx_addr, param.refPtr, param.type, bufferSize };
 				paramsArray[i + 1] = amx_addr;
 				break;
 			}
@@ -289,7 +367,10 @@ private:
 			{
 				auto* ref = static_cast<PawnRef<DynamicArray<int>>*>(param.refPtr);
 				size_t bufferSize = param.arraySize;
-				Allot(bufferSize, &amx_addr, &phys_addr);
+				if (!AllotNativeParam(bufferSize, &amx_addr, &phys_addr, amx_addr_save))
+				{
+					return 0;
+				}
 
 				const auto& currentVec = ref->get();
 				size_t initSize = std::min(currentVec.size(), bufferSize);
@@ -298,17 +379,7 @@ private:
 					phys_addr[j] = static_cast<cell>(currentVec[j]);
 				}
 
-				auto readback = [ref, bufferSize](cell* data)
-				{
-					auto& vec = ref->ref();
-					vec.resize(bufferSize, 0);
-					for (size_t j = 0; j < bufferSize; ++j)
-					{
-						vec[j] = static_cast<int>(data[j]);
-					}
-				};
-
-				refParams.push_back({ amx_addr, param.refPtr, RefParamInfo::VECTOR_INT, bufferSize, readback });
+				refParams[refCount++] = { amx_addr, param.refPtr, param.type, bufferSize };
 				paramsArray[i + 1] = amx_addr;
 				break;
 			}
@@ -317,7 +388,10 @@ private:
 			{
 				auto* ref = static_cast<PawnRef<DynamicArray<float>>*>(param.refPtr);
 				size_t bufferSize = param.arraySize;
-				Allot(bufferSize, &amx_addr, &phys_addr);
+				if (!AllotNativeParam(bufferSize, &amx_addr, &phys_addr, amx_addr_save))
+				{
+					return 0;
+				}
 
 				const auto& currentVec = ref->get();
 				size_t initSize = std::min(currentVec.size(), bufferSize);
@@ -326,70 +400,77 @@ private:
 					phys_addr[j] = amx_ftoc(currentVec[j]);
 				}
 
-				auto readback = [ref, bufferSize](cell* data)
-				{
-					auto& vec = ref->ref();
-					vec.resize(bufferSize, 0.0f);
-					for (size_t j = 0; j < bufferSize; ++j)
-					{
-						vec[j] = amx_ctof(data[j]);
-					}
-				};
-
-				refParams.push_back({ amx_addr, param.refPtr, RefParamInfo::VECTOR_FLOAT, bufferSize, readback });
+				refParams[refCount++] = { amx_addr, param.refPtr, param.type, bufferSize };
 				paramsArray[i + 1] = amx_addr;
 				break;
 			}
 			}
 		}
 
-		cell result = native(const_cast<AMX*>(&amx_), paramsArray.data());
+		cell result = native(const_cast<AMX*>(&amx_), paramsArray);
 
 		// Read back reference parameters
-		for (auto& refInfo : refParams)
+		for (size_t i = 0; i != refCount; ++i)
 		{
+			const RefParamInfo& refInfo = refParams[i];
 			cell* phys_addr;
 			GetAddr(refInfo.amx_addr, &phys_addr);
 
 			if (phys_addr)
 			{
+				using ParamType = Impl::NativeParam::Type;
+
 				switch (refInfo.type)
 				{
-				case RefParamInfo::FLOAT:
+				case ParamType::RefFloat:
 				{
 					auto* ref = static_cast<PawnRef<float>*>(refInfo.ref_obj);
 					ref->ref() = amx_ctof(*phys_addr);
 					break;
 				}
-				case RefParamInfo::BOOL:
+				case ParamType::RefBool:
 				{
 					auto* ref = static_cast<PawnRef<bool>*>(refInfo.ref_obj);
 					ref->ref() = (*phys_addr != 0);
 					break;
 				}
-				case RefParamInfo::INT:
+				case ParamType::RefInt:
 				{
 					auto* ref = static_cast<PawnRef<int>*>(refInfo.ref_obj);
 					ref->ref() = static_cast<int>(*phys_addr);
 					break;
 				}
-				case RefParamInfo::STRING:
+				case ParamType::RefString:
 				{
 					auto* ref = static_cast<PawnRef<String>*>(refInfo.ref_obj);
-					DynamicArray<char> buffer(refInfo.arraySize + 1);
-					GetString(buffer.data(), phys_addr, false, refInfo.arraySize);
-					ref->ref() = String(buffer.data());
+					String& str = ref->ref();
+					str.resize(refInfo.arraySize + 1);
+					GetString(&str[0], phys_addr, false, refInfo.arraySize);
+					str.resize(strlen(str.c_str()));
+					break;
+				}
+				case ParamType::RefArrayInt:
+				{
+					auto& vec = static_cast<PawnRef<DynamicArray<int>>*>(refInfo.ref_obj)->ref();
+					vec.resize(refInfo.arraySize, 0);
+					for (size_t j = 0; j < refInfo.arraySize; ++j)
+					{
+						vec[j] = static_cast<int>(phys_addr[j]);
+					}
 					break;
 				}
-				case RefParamInfo::VECTOR_INT:
-				case RefParamInfo::VECTOR_FLOAT:
+				case ParamType::RefArrayFloat:
 				{
-					if (refInfo.readback)
+					auto& vec = static_cast<PawnRef<DynamicArray<float>>*>(refInfo.ref_obj)->ref();
+					vec.resize(refInfo.arraySize, 0.0f);
+					for (size_t j = 0; j < refInfo.arraySize; ++j)
 					{
-						refInfo.readback(phys_addr);
+						vec[j] = amx_ctof(phys_addr[j]);
 					}
 					break;
 				}
+				default:
+					break;
 				}
 			}
 		}
@@ -408,5 +489,9 @@ private:
 
 	int id_;
 
+	/// Set when the script runs on its own thread, see `pawn.threaded_side_scripts`
+	ScriptThread* thread_ = nullptr;
+
 	friend class PawnManager;
+	friend class ScriptThread;
 };
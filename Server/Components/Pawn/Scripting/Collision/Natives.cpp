@@ -0,0 +1,90 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include "../Types.hpp"
+#include "sdk.hpp"
+
+SCRIPT_API(Collision_IsLoaded, bool())
+{
+	auto component = PawnManager::Get()->collision;
+	return component && component->isLoaded();
+}
+
+SCRIPT_API(Collision_RayCast, bool(Vector3 from, Vector3 to, Vector3& hitPosition, Vector3& hitNormal, int& modelid))
+{
+	auto component = PawnManager::Get()->collision;
+	if (component)
+	{
+		CollisionHit hit;
+		if (component->rayCast(from, to, hit))
+		{
+			hitPosition = hit.position;
+			hitNormal = hit.normal;
+			modelid = hit.modelId;
+			return true;
+		}
+	}
+	return false;
+}
+
+SCRIPT_API(Collision_LineOfSight, bool(Vector3 from, Vector3 to))
+{
+	auto component = PawnManager::Get()->collision;
+	// Without collision nothing is ever in the way.
+	return !component || component->hasLineOfSight(from, to);
+}
+
+SCRIPT_API(Collision_FindZ, bool(Vector3 position, float& z))
+{
+	auto component = PawnManager::Get()->collision;
+	if (component)
+	{
+		return component->getGroundZ(position, z);
+	}
+	return false;
+}
+
+SCRIPT_API(Collision_RemoveBuilding, int(int modelid, Vector3 position, float radius))
+{
+	auto component = PawnManager::Get()->collision;
+	if (component)
+	{
+		return component->removeBuilding(modelid, position, radius);
+	}
+	return 0;
+}
+
+SCRIPT_API(Collision_CreateObject, int(int modelid, Vector3 position, Vector3 rotation))
+{
+	auto component = PawnManager::Get()->collision;
+	if (component)
+	{
+		return component->createObject(modelid, position, GTAQuat(rotation));
+	}
+	return INVALID_COLLISION_OBJECT_ID;
+}
+
+SCRIPT_API(Collision_SetObjectPos, bool(int objectid, Vector3 position, Vector3 rotation))
+{
+	auto component = PawnManager::Get()->collision;
+	if (component)
+	{
+		return component->setObjectTransform(objectid, position, GTAQuat(rotation));
+	}
+	return false;
+}
+
+SCRIPT_API(Collision_DestroyObject, bool(int objectid))
+{
+	auto component = PawnManager::Get()->collision;
+	if (component)
+	{
+		return component->destroyObject(objectid);
+	}
+	return false;
+}
@@ -17,6 +17,8 @@
 #include <math.h>
 #include <sstream>
 #include <anim.hpp>
+#include <packet_accounting.hpp>
+#include <player_name_index.hpp>
 
 SCRIPT_API(GetTickCount, int())
 {
@@ -138,6 +140,39 @@ SCRIPT_API(GetPlayers, int(DynamicArray<int>& outputPlayers))
 	return index + 1;
 }
 
+SCRIPT_API(GetPlayerIdFromName, int(std::string const& name))
+{
+	IPlayerPool* players = PawnManager::Get()->players;
+	if (auto index = queryExtension<IPlayerNameIndexExtension>(players))
+	{
+		if (IPlayer* player = index->getPlayerByName(name))
+		{
+			return player->getID();
+		}
+	}
+	return INVALID_PLAYER_ID;
+}
+
+SCRIPT_API(FindPlayersByName, int(std::string const& prefix, DynamicArray<int>& outputPlayers))
+{
+	IPlayerPool* players = PawnManager::Get()->players;
+	auto index = queryExtension<IPlayerNameIndexExtension>(players);
+	if (!index)
+	{
+		return 0;
+	}
+
+	// Returns every match, so scripts can tell an ambiguous partial name from a unique one.
+	IPlayer* found[PLAYER_POOL_SIZE];
+	const size_t capacity = std::min<size_t>(outputPlayers.size(), PLAYER_POOL_SIZE);
+	const size_t total = index->findPlayersByNamePrefix(prefix, found, capacity);
+	for (size_t i = 0, written = std::min(total, capacity); i != written; ++i)
+	{
+		outputPlayers[i] = found[i]->getID();
+	}
+	return total;
+}
+
 SCRIPT_API(GetActors, int(DynamicArray<int>& outputActors))
 {
 	int index = -1;
@@ -551,6 +586,90 @@ SCRIPT_API(NetStats_PacketLossPercent, float(IPlayer& player))
 	return stats.packetloss;
 }
 
+static IPacketAccountingExtension* getPacketAccounting()
+{
+	for (INetwork* network : PawnManager::Get()->core->getNetworks())
+	{
+		IPacketAccountingExtension* accounting = queryExtension<IPacketAccountingExtension>(network);
+		if (accounting)
+		{
+			return accounting;
+		}
+	}
+	return nullptr;
+}
+
+static bool getPacketStats(const PacketAccountingEntry* entry, int& count, int& bytes, int& handlerMicroseconds)
+{
+	if (!entry)
+	{
+		count = bytes = handlerMicroseconds = 0;
+		return false;
+	}
+	count = int(entry->count);
+	bytes = int(entry->bytes);
+	handlerMicroseconds = int(entry->handlerMicroseconds);
+	return true;
+}
+
+SCRIPT_API(TogglePacketAccounting, bool(bool enable))
+{
+	IPacketAccountingExtension* accounting = getPacketAccounting();
+	if (!accounting)
+	{
+		return false;
+	}
+	accounting->setAccountingEnabled(enable);
+	return true;
+}
+
+SCRIPT_API(IsPacketAccountingEnabled, bool())
+{
+	IPacketAccountingExtension* accounting = getPacketAccounting();
+	return accounting && accounting->isAccountingEnabled();
+}
+
+SCRIPT_API(ResetPacketAccounting, bool())
+{
+	IPacketAccountingExtension* accounting = getPacketAccounting();
+	if (!accounting)
+	{
+		return false;
+	}
+	accounting->resetAccounting();
+	return true;
+}
+
+SCRIPT_API(GetPacketStats, bool(int kind, int direction, int id, int& count, int& bytes, int& handlerMicroseconds))
+{
+	IPacketAccountingExtension* accounting = getPacketAccounting();
+	if (!accounting || kind < 0 || kind >= PacketAccountingKind_End || direction < 0 || direction >= PacketAccountingDirection_End || id < 0 || id > 255)
+	{
+		return getPacketStats(nullptr, count, bytes, handlerMicroseconds);
+	}
+	return getPacketStats(&accounting->getAccounting(PacketAccountingKind(kind), PacketAccountingDirection(direction), uint8_t(id)), count, bytes, handlerMicroseconds);
+}
+
+SCRIPT_API(NetStats_GetPacketStats, bool(IPlayer& player, int kind, int direction, int id, int& count, int& bytes, int& handlerMicroseconds))
+{
+	IPacketAccountingExtension* accounting = getPacketAccounting();
+	if (!accounting || kind < 0 || kind >= PacketAccountingKind_End || direction < 0 || direction >= PacketAccountingDirection_End || id < 0 || id > 255)
+	{
+		return getPacketStats(nullptr, count, bytes, handlerMicroseconds);
+	}
+	return getPacketStats(accounting->getPlayerAccounting(player, PacketAccountingKind(kind), PacketAccountingDirection(direction), uint8_t(id)), count, bytes, handlerMicroseconds);
+}
+
+SCRIPT_API(GetPacketHandlerHistogram, int(int kind, int id, int bucket))
+{
+	IPacketAccountingExtension* accounting = getPacketAccounting();
+	if (!accounting || kind < 0 || kind >= PacketAccountingKind_End || id < 0 || id > 255 || bucket < 0 || bucket >= int(PacketHandlerTimeBuckets))
+	{
+		return 0;
+	}
+	return int(accounting->getAccounting(PacketAccountingKind(kind), PacketAccountingDirection_In, uint8_t(id)).handlerHistogram[bucket]);
+}
+
 SCRIPT_API(SendPlayerMessageToAll, bool(IPlayer& sender, cell const* format))
 {
 	AmxStringFormatter message(format, GetAMX(), GetParams(), 2);
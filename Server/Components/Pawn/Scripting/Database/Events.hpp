@@ -7,3 +7,12 @@
  */
 
 #pragma once
+
+#include <amx/amx.h>
+
+/// Stop calling back a script for the async queries it queued, call when it's unloaded.  Their result sets are
+/// freed when they come back.
+void DropDatabaseQueries(AMX* amx);
+
+/// Stop calling back any script for async queries, call when the databases component goes away
+void DropAllDatabaseQueries();
@@ -10,6 +10,8 @@
 #include "sdk.hpp"
 #include <ghc/filesystem.hpp>
 #include "../../format.hpp"
+#include "Events.hpp"
+#include <database_async.hpp>
 
 static int getFlags(cell* params)
 {
@@ -26,6 +28,92 @@ static int getFlags(cell* params)
 	}
 }
 
+struct PawnDatabaseQueryHandler;
+
+/// Handlers of the queries scripts have queued that haven't come back yet
+static FlatHashSet<PawnDatabaseQueryHandler*> queuedQueries;
+
+struct PawnDatabaseQueryHandler final : DatabaseQueryHandler
+{
+	int extra;
+	String callback;
+	/// The script that queued the query, null once it's been unloaded
+	AMX* amx;
+	IDatabasesComponent* databases;
+
+	PawnDatabaseQueryHandler(int extra, StringView callback, AMX* amx, IDatabasesComponent* databases)
+		: extra(extra)
+		, callback(callback)
+		, amx(amx)
+		, databases(databases)
+	{
+	}
+
+	void onQueryExecuted(IDatabaseResultSet* resultSet) override
+	{
+		queuedQueries.erase(this);
+		// Dropped handlers leave the pawn manager alone, it may already be gone.
+		PawnScript* script = nullptr;
+		if (amx)
+		{
+			auto& amx_map = PawnManager::Get()->amxToScript_;
+			auto script_itr = amx_map.find(amx);
+			if (script_itr != amx_map.end())
+			{
+				script = script_itr->second;
+			}
+		}
+		if (script)
+		{
+			PawnManager::Get()->CallScript(*script, callback, DefaultReturnValue_True, resultSet ? resultSet->getID() : 0, extra);
+		}
+		else if (resultSet)
+		{
+			// Nobody is left to free it.
+			databases->freeResultSet(*resultSet);
+		}
+		delete this;
+	}
+};
+
+void DropDatabaseQueries(AMX* amx)
+{
+	for (PawnDatabaseQueryHandler* handler : queuedQueries)
+	{
+		if (handler->amx == amx)
+		{
+			handler->amx = nullptr;
+		}
+	}
+}
+
+void DropAllDatabaseQueries()
+{
+	for (PawnDatabaseQueryHandler* handler : queuedQueries)
+	{
+		handler->amx = nullptr;
+	}
+}
+
+static bool doDBQueryAsync(IDatabaseConnection& db, const std::string& query, const std::string& callback, cell* params, AMX* amx)
+{
+	IDatabaseAsyncExtension* async = queryExtension<IDatabaseAsyncExtension>(PawnManager::Get()->databases);
+	if (!async)
+	{
+		return false;
+	}
+	// Optional parameter passed back to the callback.
+	int extra = params[0] >= 4 * sizeof(cell) ? params[4] : 0;
+	auto handler = new PawnDatabaseQueryHandler(extra, callback, amx, PawnManager::Get()->databases);
+	if (async->executeQueryAsync(db, query, handler))
+	{
+		queuedQueries.insert(handler);
+		return true;
+	}
+	delete handler;
+	return false;
+}
+
 static IDatabaseConnection* doDBOpen(const std::string& name, int flags)
 {
 	size_t start;
@@ -115,6 +203,11 @@ SCRIPT_API(db_query, int(IDatabaseConnection& db, cell const* format))
 	return database_result_set ? database_result_set->getID() : 0;
 }
 
+SCRIPT_API(db_query_async, bool(IDatabaseConnection& db, const std::string& query, const std::string& callback))
+{
+	return doDBQueryAsync(db, query, callback, GetParams(), GetAMX());
+}
+
 SCRIPT_API(db_free_result, bool(IDatabaseResultSet& result))
 {
 	return PawnManager::Get()->databases->freeResultSet(result);
@@ -229,6 +322,11 @@ SCRIPT_API(DB_ExecuteQuery, int(IDatabaseConnection& db, cell const* format))
 	return database_result_set ? database_result_set->getID() : 0;
 }
 
+SCRIPT_API(DB_ExecuteQueryAsync, bool(IDatabaseConnection& db, const std::string& query, const std::string& callback))
+{
+	return doDBQueryAsync(db, query, callback, GetParams(), GetAMX());
+}
+
 SCRIPT_API(DB_FreeResultSet, bool(IDatabaseResultSet& result))
 {
 	return PawnManager::Get()->databases->freeResultSet(result);
@@ -321,3 +419,9 @@ SCRIPT_API(DB_GetDatabaseResultSetCount, int())
 {
 	return static_cast<int>(PawnManager::Get()->databases->getDatabaseResultSetCount());
 }
+
+SCRIPT_API(DB_GetPendingQueryCount, int())
+{
+	IDatabaseAsyncExtension* async = queryExtension<IDatabaseAsyncExtension>(PawnManager::Get()->databases);
+	return async ? static_cast<int>(async->getPendingQueryCount()) : 0;
+}
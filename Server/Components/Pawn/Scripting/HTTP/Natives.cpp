@@ -29,7 +29,7 @@ struct PawnHTTPResponseHandler final : HTTPResponseHandler
 		auto script_itr = amx_map.find(amx);
 		if (script_itr != amx_map.end())
 		{
-			script_itr->second->Call(callback, DefaultReturnValue_True, index, status, body);
+			PawnManager::Get()->CallScript(*script_itr->second, callback, DefaultReturnValue_True, index, status, body);
 		}
 		delete this;
 	}
@@ -0,0 +1,17 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <amx/amx.h>
+
+/// Stop calling back a script for the password requests it queued, call when it's unloaded
+void DropPasswordRequests(AMX* amx);
+
+/// Stop calling back any script for password requests, call when the hashing component goes away
+void DropAllPasswordRequests();
@@ -0,0 +1,127 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include "../Types.hpp"
+#include "sdk.hpp"
+#include "Events.hpp"
+
+struct PawnPasswordHandler;
+
+/// Handlers of the requests scripts have queued that haven't come back yet
+static FlatHashSet<PawnPasswordHandler*> queuedPasswords;
+
+struct PawnPasswordHandler final : PasswordHashHandler, PasswordCheckHandler
+{
+	int index;
+	String callback;
+	/// The script that queued the request, null once it's been unloaded
+	AMX* amx;
+
+	PawnPasswordHandler(int index, StringView callback, AMX* amx)
+		: index(index)
+		, callback(callback)
+		, amx(amx)
+	{
+	}
+
+	/// The script to call back, if it's still loaded.  Dropped handlers leave the pawn manager alone, it may already be gone.
+	PawnScript* getScript() const
+	{
+		if (amx)
+		{
+			auto& amx_map = PawnManager::Get()->amxToScript_;
+			auto script_itr = amx_map.find(amx);
+			if (script_itr != amx_map.end())
+			{
+				return script_itr->second;
+			}
+		}
+		return nullptr;
+	}
+
+	void onPasswordHashed(StringView hash) override
+	{
+		queuedPasswords.erase(this);
+		if (PawnScript* script = getScript())
+		{
+			PawnManager::Get()->CallScript(*script, callback, DefaultReturnValue_True, index, hash);
+		}
+		delete this;
+	}
+
+	void onPasswordChecked(bool match) override
+	{
+		queuedPasswords.erase(this);
+		if (PawnScript* script = getScript())
+		{
+			PawnManager::Get()->CallScript(*script, callback, DefaultReturnValue_True, index, int(match));
+		}
+		delete this;
+	}
+};
+
+void DropPasswordRequests(AMX* amx)
+{
+	for (PawnPasswordHandler* handler : queuedPasswords)
+	{
+		if (handler->amx == amx)
+		{
+			handler->amx = nullptr;
+		}
+	}
+}
+
+void DropAllPasswordRequests()
+{
+	for (PawnPasswordHandler* handler : queuedPasswords)
+	{
+		handler->amx = nullptr;
+	}
+}
+
+SCRIPT_API(Password_Hash, bool(std::string const& password, int type, int cost, std::string const& callback, int index))
+{
+	auto component = PawnManager::Get()->hashing;
+	if (component)
+	{
+		auto handler = new PawnPasswordHandler(index, callback, GetAMX());
+		if (component->hashPassword(handler, PasswordHashType(type), password, cost))
+		{
+			queuedPasswords.insert(handler);
+			return true;
+		}
+		delete handler;
+	}
+	return false;
+}
+
+SCRIPT_API(Password_Verify, bool(std::string const& password, std::string const& hash, std::string const& callback, int index))
+{
+	auto component = PawnManager::Get()->hashing;
+	if (component)
+	{
+		auto handler = new PawnPasswordHandler(index, callback, GetAMX());
+		if (component->checkPassword(handler, password, hash))
+		{
+			queuedPasswords.insert(handler);
+			return true;
+		}
+		delete handler;
+	}
+	return false;
+}
+
+SCRIPT_API(Password_GetPendingCount, int())
+{
+	auto component = PawnManager::Get()->hashing;
+	if (component)
+	{
+		return component->getPendingCount();
+	}
+	return 0;
+}
@@ -12,6 +12,7 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 #include "../../format.hpp"
+#include <npcs_nodes.hpp>
 
 inline float getAngleOfLine(float x, float y)
 {
@@ -909,6 +910,16 @@ SCRIPT_API(NPC_GetNodePointPosition, bool(int nodeId, float& x, float& y, float&
 	return false;
 }
 
+SCRIPT_API(NPC_FindNearestNodePoint, bool(Vector3 position, int& nodeId, int& pointId, float& distance))
+{
+	auto lookup = queryExtension<INPCNodeLookupExtension>(PawnManager::Get()->npcs);
+	if (lookup)
+	{
+		return lookup->findNearestNodePoint(position, nodeId, pointId, distance);
+	}
+	return false;
+}
+
 SCRIPT_API(NPC_GetNodePointCount, int(int nodeId))
 {
 	auto component = PawnManager::Get()->npcs;
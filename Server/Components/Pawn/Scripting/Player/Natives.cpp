@@ -10,6 +10,7 @@
 #include "../../format.hpp"
 #include "sdk.hpp"
 #include <iostream>
+#include <player_rewind.hpp>
 
 SCRIPT_API(SendClientMessage, bool(IPlayer& player, uint32_t colour, cell const* format))
 {
@@ -273,6 +274,27 @@ SCRIPT_API_FAILRET(GetPlayerPing, -1, int(IPlayer& player))
 	return player.getPing();
 }
 
+SCRIPT_API(GetPlayerRewindPos, bool(IPlayer& player, int milliseconds, Vector3& position))
+{
+	auto rewind = queryExtension<IPlayerRewindExtension>(PawnManager::Get()->players);
+	if (rewind)
+	{
+		return rewind->getPlayerPositionAt(player, Time::now() - Milliseconds(milliseconds), position);
+	}
+	return false;
+}
+
+SCRIPT_API(WasPlayerNearShotLine, bool(IPlayer& player, Vector3 from, Vector3 to, float radius, int milliseconds))
+{
+	auto rewind = queryExtension<IPlayerRewindExtension>(PawnManager::Get()->players);
+	if (rewind)
+	{
+		return rewind->wasPlayerNearLine(player, from, to, radius, Time::now() - Milliseconds(milliseconds));
+	}
+	// Can't tell, so don't reject anything.
+	return true;
+}
+
 SCRIPT_API_FAILRET(GetPlayerWeapon, -1, int(IPlayer& player))
 {
 	return player.getArmedWeapon();
@@ -0,0 +1,50 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include "../Types.hpp"
+#include "sdk.hpp"
+
+// Text from players reaches scripts in the codepage they typed it in, which is also what they can display.  These
+// convert it for storage or other services that want UTF-8, without changing what the callbacks are given.
+
+SCRIPT_API(ConvertPlayerTextToUTF8, int(IPlayer& player, std::string const& input, OutputOnlyString& output))
+{
+	IPlayerCodepageExtension* codepages = queryExtension<IPlayerCodepageExtension>(PawnManager::Get()->unicode);
+	if (!codepages)
+	{
+		output = String(input);
+		return input.length();
+	}
+	String converted(StringView(codepages->playerToUTF8(player, input)));
+	const int length = converted.length();
+	output = std::move(converted);
+	return length;
+}
+
+SCRIPT_API(GetPlayerCodepage, int(IPlayer& player, OutputOnlyString& output))
+{
+	IPlayerCodepageExtension* codepages = queryExtension<IPlayerCodepageExtension>(PawnManager::Get()->unicode);
+	if (!codepages)
+	{
+		output = StringView();
+		return 0;
+	}
+	output = codepages->getPlayerCodepage(player);
+	return std::get<StringView>(output).length();
+}
+
+SCRIPT_API(SetPlayerCodepage, bool(IPlayer& player, std::string const& codepage))
+{
+	IPlayerCodepageExtension* codepages = queryExtension<IPlayerCodepageExtension>(PawnManager::Get()->unicode);
+	if (!codepages)
+	{
+		return false;
+	}
+	codepages->setPlayerCodepage(player, codepage);
+	return true;
+}
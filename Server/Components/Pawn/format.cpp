@@ -9,6 +9,8 @@
 
 #include "format.hpp"
 #include "Manager/Manager.hpp"
+#include <algorithm>
+#include <cstring>
 
 #ifndef WIN32
 #include <math.h>
@@ -594,52 +596,89 @@ static inline unsigned char atcadvance(unsigned char const** fmt, bool ispacked)
 	return ret;
 }
 
-template <typename D, typename S>
-size_t atcprintf(D* buffer, size_t maxlen, const S* format, AMX* amx, const cell* params, int* param)
+/// One step of a compiled format string
+struct FormatToken
 {
-	cell* cptr;
-	int arg;
-	int args = params[0] / sizeof(cell);
-	D* buf_p;
-	D ch;
+	enum class Type : uint8_t
+	{
+		Literal, ///< Copy `length` characters of the literal text, starting at `value`
+		Width, ///< Set the width to `value`
+		Precision, ///< Set the precision to `value`
+		ArgWidth, ///< Take the width from the next argument
+		ArgPrecision, ///< Take the precision from the next argument
+		Convert, ///< Print the next argument with `conversion` and `flags`
+	};
+
+	Type type;
+	char conversion;
 	int flags;
-	int width;
-	int prec;
-	int n;
-	// char sign;
-	const unsigned char* fmt;
-	size_t llen = maxlen;
-	bool ispacked = sizeof(S) == sizeof(ucell) && (ucell)*format > UNPACKEDMAX;
+	int value;
+	int length;
+};
+
+/// A format string parsed once into the steps needed to print it, so printing only has to
+/// convert the arguments.
+struct CompiledFormat
+{
+	DynamicArray<FormatToken> tokens;
+	String literals;
+	DynamicArray<cell> source; ///< The cells it was compiled from, to notice the script changing them
+};
+
+/// Formats compiled from scripts' data segments, by script and address.  Neither this nor the scratch format below
+/// is locked, so nothing that formats may run on a script thread; ScriptThread::attach keeps `format` and `printf`
+/// on the main thread even when they're listed in `pawn.thread_safe_natives`.
+static FlatHashMap<AMX*, FlatHashMap<ucell, CompiledFormat>> CompiledFormats;
+/// Stop caching new formats for a script after this many, they are usually a few hundred at most.
+static constexpr size_t MaxCompiledFormats = 4096;
+
+template <typename S>
+static void CompileFormat(const S* format, CompiledFormat& compiled)
+{
+	compiled.tokens.clear();
+	compiled.literals.clear();
 
-	buf_p = buffer;
-	arg = *param;
+	const bool ispacked = sizeof(S) == sizeof(ucell) && (ucell)*format > UNPACKEDMAX;
 	// Invert the byte order.
-	fmt = ispacked ? (unsigned char*)((intptr_t)format + sizeof(S) - 1) : (unsigned char*)format;
+	const unsigned char* const start = ispacked ? (unsigned char*)((intptr_t)format + sizeof(S) - 1) : (unsigned char*)format;
+	const unsigned char* fmt = start;
+	unsigned char ch;
+	int flags;
+	int n;
+
+	const auto addLiteral = [&compiled](unsigned char ch)
+	{
+		if (compiled.tokens.empty() || compiled.tokens.back().type != FormatToken::Type::Literal)
+		{
+			compiled.tokens.push_back({ FormatToken::Type::Literal, '\0', 0, int(compiled.literals.size()), 0 });
+		}
+		compiled.literals.push_back(static_cast<char>(ch));
+		++compiled.tokens.back().length;
+	};
+
+	const auto addToken = [&compiled](FormatToken::Type type, int value)
+	{
+		compiled.tokens.push_back({ type, '\0', 0, value, 0 });
+	};
 
 	while (true)
 	{
 		// run through the format string until we hit a '%' or '\0'
-		for (ch = static_cast<D>(*fmt);
-			 llen && ((ch = static_cast<D>(*fmt)) != '\0' && ch != '%');
-			 atcadvance<S>(&fmt, ispacked))
+		while ((ch = *fmt) != '\0' && ch != '%')
 		{
-			*buf_p++ = static_cast<D>(ch);
-			llen--;
+			addLiteral(ch);
+			atcadvance<S>(&fmt, ispacked);
 		}
-		if (ch == '\0' || llen <= 0)
-			goto done;
+		if (ch == '\0')
+			break;
 
 		// skip over the '%'
 		atcadvance<S>(&fmt, ispacked);
 
-		// reset formatting state
 		flags = 0;
-		width = 0;
-		prec = -1;
-		// sign = '\0';
 
 rflag:
-		ch = static_cast<D>(atcadvance<S>(&fmt, ispacked));
+		ch = atcadvance<S>(&fmt, ispacked);
 reswitch:
 		switch (ch)
 		{
@@ -647,21 +686,18 @@ reswitch:
 			flags |= LADJUST;
 			goto rflag;
 		case '.':
-			ch = static_cast<D>(*fmt);
-			if (ch == '*')
+			if (*fmt == '*')
 			{
-				amx_GetAddr(amx, params[arg], &cptr);
-				prec = cptr ? *cptr : 0;
-				arg++;
+				addToken(FormatToken::Type::ArgPrecision, 0);
 				atcadvance<S>(&fmt, ispacked);
 				goto rflag;
 			}
 			else
 			{
 				n = 0;
-				while (is_digit((ch = static_cast<D>(atcadvance<S>(&fmt, ispacked)))))
+				while (is_digit((ch = atcadvance<S>(&fmt, ispacked))))
 					n = 10 * n + (ch - '0');
-				prec = n < 0 ? -1 : n;
+				addToken(FormatToken::Type::Precision, n < 0 ? -1 : n);
 				goto reswitch;
 			}
 		case '0':
@@ -680,72 +716,213 @@ reswitch:
 			do
 			{
 				n = 10 * n + (ch - '0');
-				ch = static_cast<D>(atcadvance<S>(&fmt, ispacked));
+				ch = atcadvance<S>(&fmt, ispacked);
 			} while (is_digit(ch));
-			width = n;
+			addToken(FormatToken::Type::Width, n);
 			goto reswitch;
 		case '*':
+			addToken(FormatToken::Type::ArgWidth, 0);
+			goto rflag;
+		case 'H':
+		case 'x':
+			flags |= UPPERDIGITS;
+			// fallthrough
+		case 'c':
+		case 'b':
+		case 'o':
+		case 'd':
+		case 'i':
+		case 'u':
+		case 'f':
+		case 'h':
+		case 'a':
+		case 's':
+		case 'q':
+			compiled.tokens.push_back({ FormatToken::Type::Convert, static_cast<char>(ch), flags, 0, 0 });
+			break;
+		case '\0':
+			addLiteral('%');
+			goto done;
+		default:
+			// Includes "%%"
+			addLiteral(ch);
+			break;
+		}
+	}
+
+done:
+	// Remember every cell the parser looked at, it stops at the first '\0'.
+	for (fmt = start; *fmt; atcadvance<S>(&fmt, ispacked))
+		;
+	const size_t cells = (fmt - reinterpret_cast<const unsigned char*>(format)) / sizeof(cell) + 1;
+	compiled.source.assign(reinterpret_cast<const cell*>(format), reinterpret_cast<const cell*>(format) + cells);
+}
+
+template <typename S>
+static const CompiledFormat& GetCompiledFormat(const S* format, AMX* amx)
+{
+	static CompiledFormat scratch;
+
+	// Only strings in the data segment stay where they are, so only those are worth keeping.  Global
+	// arrays live there too and can be rewritten, so every hit is checked against the source.
+	if (amx && amx->base)
+	{
+		const AMX_HEADER* hdr = reinterpret_cast<const AMX_HEADER*>(amx->base);
+		const unsigned char* data = amx->data ? amx->data : amx->base + hdr->dat;
+		const unsigned char* address = reinterpret_cast<const unsigned char*>(format);
+		if (address >= data && address < data + amx->hlw)
+		{
+			FlatHashMap<ucell, CompiledFormat>& formats = CompiledFormats[amx];
+			const ucell offset = ucell(address - data);
+			auto it = formats.find(offset);
+			if (it != formats.end())
+			{
+				const DynamicArray<cell>& source = it->second.source;
+				if (std::memcmp(source.data(), format, source.size() * sizeof(cell)) != 0)
+				{
+					CompileFormat(format, it->second);
+				}
+				return it->second;
+			}
+			if (formats.size() < MaxCompiledFormats)
+			{
+				CompiledFormat& compiled = formats[offset];
+				CompileFormat(format, compiled);
+				return compiled;
+			}
+		}
+	}
+
+	CompileFormat(format, scratch);
+	return scratch;
+}
+
+void ClearFormatCache(AMX* amx)
+{
+	CompiledFormats.erase(amx);
+}
+
+template <typename U>
+void AddPlainString(U** buf_p, size_t& maxlen, const cell* string)
+{
+	U* buf = *buf_p;
+	if (*string > UNPACKEDMAX)
+	{
+		for (size_t i = 0; maxlen; ++i, --maxlen)
+		{
+			const char ch = ((const char*)string)[i ^ (sizeof(cell) - 1)];
+			if (ch == '\0')
+				break;
+			*buf++ = static_cast<U>(ch);
+		}
+	}
+	else
+	{
+		while (*string && maxlen)
+		{
+			*buf++ = static_cast<U>(*string++);
+			maxlen--;
+		}
+	}
+	*buf_p = buf;
+}
+
+template <typename D, typename S>
+size_t atcprintf(D* buffer, size_t maxlen, const S* format, AMX* amx, const cell* params, int* param)
+{
+	const CompiledFormat& compiled = GetCompiledFormat(format, amx);
+	cell* cptr;
+	int arg = *param;
+	int args = params[0] / sizeof(cell);
+	D* buf_p = buffer;
+	int width = 0;
+	int prec = -1;
+	size_t llen = maxlen;
+
+	for (const FormatToken& token : compiled.tokens)
+	{
+		if (token.type == FormatToken::Type::Literal)
+		{
+			const size_t count = std::min<size_t>(token.length, llen);
+			const unsigned char* text = reinterpret_cast<const unsigned char*>(compiled.literals.data()) + token.value;
+			for (size_t i = 0; i != count; ++i)
+			{
+				*buf_p++ = static_cast<D>(text[i]);
+			}
+			llen -= count;
+			// A specifier that printed a literal ("%5%") doesn't pass its width on
+			width = 0;
+			prec = -1;
+			continue;
+		}
+
+		if (llen == 0)
+			break;
+
+		switch (token.type)
+		{
+		case FormatToken::Type::Width:
+			width = token.value;
+			continue;
+		case FormatToken::Type::Precision:
+			prec = token.value;
+			continue;
+		case FormatToken::Type::ArgWidth:
 			amx_GetAddr(amx, params[arg], &cptr);
 			width = cptr ? *cptr : 0;
 			arg++;
-			goto rflag;
-		case 'c':
-			CHECK_ARGS(0);
+			continue;
+		case FormatToken::Type::ArgPrecision:
 			amx_GetAddr(amx, params[arg], &cptr);
+			prec = cptr ? *cptr : 0;
+			arg++;
+			continue;
+		default:
+			break;
+		}
+
+		const int flags = token.flags;
+		CHECK_ARGS(0);
+		amx_GetAddr(amx, params[arg], &cptr);
+
+		// Fast path for a bare %s, bare %d already goes straight to AddInt.
+		if (token.conversion == 's' && flags == 0 && width == 0 && prec < 0 && cptr)
+		{
+			AddPlainString(&buf_p, llen, cptr);
+			arg++;
+			continue;
+		}
+
+		switch (token.conversion)
+		{
+		case 'c':
 			*buf_p++ = static_cast<D>(cptr ? *cptr : 0);
 			llen--;
-			arg++;
 			break;
 		case 'b':
-			CHECK_ARGS(0);
-			amx_GetAddr(amx, params[arg], &cptr);
 			AddBinary(&buf_p, llen, cptr ? *cptr : 0, width, flags);
-			arg++;
 			break;
 		case 'o':
-			CHECK_ARGS(0);
-			amx_GetAddr(amx, params[arg], &cptr);
 			AddOctal(&buf_p, llen, cptr ? *cptr : 0, width, flags);
-			arg++;
 			break;
 		case 'd':
 		case 'i':
-			CHECK_ARGS(0);
-			amx_GetAddr(amx, params[arg], &cptr);
 			AddInt(&buf_p, llen, cptr ? *cptr : 0, width, flags);
-			arg++;
 			break;
 		case 'u':
-			CHECK_ARGS(0);
-			amx_GetAddr(amx, params[arg], &cptr);
 			AddUInt(&buf_p, llen, static_cast<unsigned int>(cptr ? *cptr : 0), width, flags);
-			arg++;
 			break;
 		case 'f':
-			CHECK_ARGS(0);
-			amx_GetAddr(amx, params[arg], &cptr);
 			AddFloat(&buf_p, llen, cptr ? amx_ctof(*cptr) : 0.0f, width, prec, flags);
-			arg++;
 			break;
 		case 'H':
 		case 'x':
-			CHECK_ARGS(0);
-			flags |= UPPERDIGITS;
-			amx_GetAddr(amx, params[arg], &cptr);
-			AddHex(&buf_p, llen, static_cast<unsigned int>(cptr ? *cptr : 0), width, flags);
-			arg++;
-			break;
 		case 'h':
-			CHECK_ARGS(0);
-			amx_GetAddr(amx, params[arg], &cptr);
 			AddHex(&buf_p, llen, static_cast<unsigned int>(cptr ? *cptr : 0), width, flags);
-			arg++;
 			break;
 		case 'a':
 		{
-			CHECK_ARGS(0);
 			// %a is passed a pointer directly to a cell string.
-			amx_GetAddr(amx, params[arg], &cptr);
 			if (!cptr)
 			{
 				PawnManager::Get()->core->logLn(LogLevel::Error, "Invalid vector string handle provided");
@@ -759,24 +936,17 @@ reswitch:
 			}
 
 			AddString(&buf_p, llen, ptr, width, prec, flags);
-			arg++;
 			break;
 		}
 		case 's':
-			CHECK_ARGS(0);
-			amx_GetAddr(amx, params[arg], &cptr);
 			if (cptr)
 			{
 				AddString(&buf_p, llen, cptr, width, prec, flags);
 			}
-			arg++;
 			break;
 		case 'q':
 		{
-			CHECK_ARGS(0);
-
 			int argLen = 0;
-			amx_GetAddr(amx, params[arg], &cptr);
 			if (cptr)
 			{
 				amx_StrLen(cptr, &argLen);
@@ -801,33 +971,15 @@ reswitch:
 
 				AddString(&buf_p, llen, escaped.data(), width, prec, flags);
 			}
-
-			arg++;
 			break;
 		}
-		case '%':
-			*buf_p++ = static_cast<D>(ch);
-			if (!llen)
-				goto done;
-			llen--;
-			break;
-		case '\0':
-			*buf_p++ = static_cast<D>('%');
-			if (!llen)
-				goto done;
-			llen--;
-			goto done;
-			break;
-		default:
-			*buf_p++ = static_cast<D>(ch);
-			if (!llen)
-				goto done;
-			llen--;
-			break;
 		}
+
+		arg++;
+		width = 0;
+		prec = -1;
 	}
 
-done:
 	*buf_p = static_cast<D>(0);
 	*param = arg;
 
@@ -25,6 +25,9 @@
 template <typename D, typename S>
 size_t atcprintf(D* buffer, size_t maxlen, const S* format, AMX* amx, cell const* params, int* param);
 
+/// Forget the format strings compiled for a script, call when it's unloaded
+void ClearFormatCache(AMX* amx);
+
 /// Amx string format which can be cast to StringView
 class AmxStringFormatter
 {
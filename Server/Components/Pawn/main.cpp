@@ -9,8 +9,11 @@
 #include "Manager/Manager.hpp"
 #include "PluginManager/PluginManager.hpp"
 #include "Scripting/Impl.hpp"
+#include "Scripting/Database/Events.hpp"
+#include "Scripting/Hashing/Events.hpp"
 #include "Server/Components/Pawn/pawn.hpp"
 #include <ghc/filesystem.hpp>
+#include <pawn_natives.hpp>
 #include <stdlib.h>
 
 static StaticArray<void*, NUM_AMX_FUNCS> AMX_FUNCTIONS = {
@@ -84,13 +87,58 @@ static StaticArray<void*, NUM_AMX_FUNCS> AMX_FUNCTIONS = {
 	reinterpret_cast<void*>(&amx_StrSize),
 };
 
+/// Natives that only touch the calling script, so scripts in `pawn.threaded_side_scripts` can call them on their
+/// own threads.  Anything else is run on the main thread for them.
+static StringView ThreadSafeNatives[] = {
+	"heapspace", "numargs", "getarg", "setarg", "min", "max", "clamp", "tolower", "toupper", "swapchars",
+	"float", "floatstr", "floatmul", "floatdiv", "floatadd", "floatsub", "floatfract", "floatround", "floatcmp",
+	"floatsqroot", "floatpower", "floatlog", "floatsin", "floatcos", "floattan", "floatabs",
+	"asin", "acos", "atan", "atan2", "VectorSize",
+	"strlen", "strpack", "strunpack", "strcat", "strmid", "strins", "strdel", "strcmp", "strfind", "strval",
+	"valstr", "ispacked", "uudecode", "uuencode", "memcpy"
+};
+
 class PawnComponent final : public IPawnComponent, public CoreEventHandler, public ConsoleEventHandler
 {
 private:
+	/// Native calls by handle for other components, see IPawnNativeCallExtension.
+	struct NativeCallExtension final : public IPawnNativeCallExtension
+	{
+		int resolveNative(StringView name) const override
+		{
+			return GlobalNativeRegistry::ResolveNative(name);
+		}
+
+		cell callNative(IPawnScript& script, int handle, Span<Impl::NativeParam> params) override
+		{
+			// Every script handed out by this component is a `PawnScript`.
+			return static_cast<PawnScript&>(script).CallNativeByHandle(handle, params);
+		}
+
+		void freeExtension() override
+		{
+			// Owned by the component.
+		}
+
+		void reset() override
+		{
+		}
+	};
+
 	ICore* core = nullptr;
 	Scripting scriptingInstance;
+	NativeCallExtension nativeCalls;
 
 public:
+	IExtension* getExtension(UID id) override
+	{
+		if (id == IPawnNativeCallExtension::ExtensionIID)
+		{
+			return &nativeCalls;
+		}
+		return IPawnComponent::getExtension(id);
+	}
+
 	StringView componentName() const override
 	{
 		return "Pawn";
@@ -168,6 +216,9 @@ public:
 		mgr->vehicles = components->queryComponent<IVehiclesComponent>();
 		mgr->models = components->queryComponent<ICustomModelsComponent>();
 		mgr->npcs = components->queryComponent<INPCComponent>();
+		mgr->collision = components->queryComponent<ICollisionComponent>();
+		mgr->hashing = components->queryComponent<IHashingComponent>();
+		mgr->unicode = components->queryComponent<IUnicodeComponent>();
 
 		scriptingInstance.addEvents();
 
@@ -267,6 +318,17 @@ public:
 
 		PawnManager* mgr = PawnManager::Get();
 
+		if (component == mgr->databases)
+		{
+			// It calls the handlers of the queries still out as it goes, don't run scripts from there.
+			DropAllDatabaseQueries();
+		}
+		if (component == mgr->hashing)
+		{
+			// The same goes for password requests.
+			DropAllPasswordRequests();
+		}
+
 		COMPONENT_UNLOADED(mgr->actors)
 		COMPONENT_UNLOADED(mgr->console)
 		COMPONENT_UNLOADED(mgr->checkpoints)
@@ -286,6 +348,9 @@ public:
 		COMPONENT_UNLOADED(mgr->vehicles)
 		COMPONENT_UNLOADED(mgr->models)
 		COMPONENT_UNLOADED(mgr->npcs)
+		COMPONENT_UNLOADED(mgr->collision)
+		COMPONENT_UNLOADED(mgr->hashing)
+		COMPONENT_UNLOADED(mgr->unicode)
 	}
 
 	void provideConfiguration(ILogger& logger, IEarlyConfig& config, bool defaults) override
@@ -296,6 +361,25 @@ public:
 			config.setStrings("pawn.main_scripts", Span<StringView>(scripts, 1));
 			config.setStrings("pawn.side_scripts", Span<StringView>());
 			config.setStrings("pawn.legacy_plugins", Span<StringView>());
+			config.setStrings("pawn.threaded_side_scripts", Span<StringView>());
+			config.setStrings("pawn.thread_safe_natives", Span<StringView>(ThreadSafeNatives, GLM_COUNTOF(ThreadSafeNatives)));
+			config.setInt("pawn.threaded_queue_limit", 4096);
+		}
+		else
+		{
+			// Set default values if options are not set.
+			if (config.getType("pawn.threaded_side_scripts") == ConfigOptionType_None)
+			{
+				config.setStrings("pawn.threaded_side_scripts", Span<StringView>());
+			}
+			if (config.getType("pawn.thread_safe_natives") == ConfigOptionType_None)
+			{
+				config.setStrings("pawn.thread_safe_natives", Span<StringView>(ThreadSafeNatives, GLM_COUNTOF(ThreadSafeNatives)));
+			}
+			if (config.getType("pawn.threaded_queue_limit") == ConfigOptionType_None)
+			{
+				config.setInt("pawn.threaded_queue_limit", 4096);
+			}
 		}
 	}
 
@@ -101,6 +101,36 @@ struct PawnTimerHandler final : TimerTimeOutHandler, PoolIDProvider
 
 		const bool hasParams = !fmt.empty();
 
+		if (ScriptThread* thread = PawnManager::Get()->GetScriptThread(amx))
+		{
+			// The script runs on its own thread, so queue the call with a copy of the data instead.  Reference
+			// parameters can't be copied back from there.
+			ScriptJob job;
+			int err = amx_FindPublic(amx, callback.data(), &job.index);
+			if (err != AMX_ERR_NONE)
+			{
+				PawnManager::Get()->core->logLn(LogLevel::Error, "SetTimer(Ex): There was a problem in calling %.*s: %s", PRINT_VIEW(callback), aux_StrError(err));
+				return;
+			}
+			job.heap = data;
+			for (size_t i = 0, len = params.size(); i != len; ++i)
+			{
+				switch (fmt[i])
+				{
+				case 'a':
+				case 's':
+				case 'v':
+					job.addOffset(params[i]);
+					break;
+				default:
+					job.add(params[i]);
+					break;
+				}
+			}
+			thread->post(std::move(job));
+			return;
+		}
+
 		// Call it.
 		// First copy all the data in to the heap.
 		cell ret;
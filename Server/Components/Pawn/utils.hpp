@@ -408,6 +408,11 @@ inline cell AMX_NATIVE_CALL pawn_Script_CallOne(AMX* amx, cell const* params)
 		num
 		= amx_NumParams(params);
 	AMX_MIN_PARAMETERS("Script_CallOne", params, 3);
+	if (AMX* target = PawnManager::Get()->AMXFromID(params[1]); target != amx && PawnManager::Get()->IsThreaded(target))
+	{
+		PawnManager::Get()->core->logLn(LogLevel::Error, "Target script (%u) runs on its own thread and can't be called in `Script_CallOne`", uint32_t(params[1]));
+		return 0;
+	}
 	char*
 		name;
 	amx = PawnManager::Get()->AMXFromID(params[1]);
@@ -487,6 +492,11 @@ inline cell AMX_NATIVE_CALL pawn_Script_CallOneByIndex(AMX* amx, cell const* par
 		num
 		= amx_NumParams(params);
 	AMX_MIN_PARAMETERS("Script_CallOneByIndex", params, 3);
+	if (AMX* target = PawnManager::Get()->AMXFromID(params[1]); target != amx && PawnManager::Get()->IsThreaded(target))
+	{
+		PawnManager::Get()->core->logLn(LogLevel::Error, "Target script (%u) runs on its own thread and can't be called in `Script_CallOneByIndex`", uint32_t(params[1]));
+		return 0;
+	}
 	amx = PawnManager::Get()->AMXFromID(params[1]);
 	if (amx == nullptr)
 	{
@@ -562,6 +572,7 @@ inline cell AMX_NATIVE_CALL pawn_Script_CallAll(AMX* amx, cell const* params)
 		num
 		= amx_NumParams(params);
 	AMX_MIN_PARAMETERS("Script_CallAll", params, 2);
+	AMX* const caller = amx;
 	char*
 		name;
 	amx_StrParamChar(amx, params[1], name);
@@ -710,6 +721,11 @@ pawn_CallRemoteFunction_gmnext:
 	{
 		// Get the next script to call in to, always starting with the GM.
 		amx = cur->GetAMX();
+		// Scripts on their own threads only get events, they can't be called in to while they're running.
+		if (amx != caller && manager->IsThreaded(amx))
+		{
+			continue;
+		}
 		// Step 2: Get the function.
 		int
 			index;
@@ -0,0 +1,380 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#include <sdk.hpp>
+#include <Server/Components/Console/console.hpp>
+#include <traffic_capture.hpp>
+// The same in-process network the load test uses, replayed players are just as fake as simulated ones.
+#include <simulated_network.hpp>
+
+using namespace Impl;
+
+/// Plays a capture written with network.capture_file back into the server through a fake network, at the
+/// recorded pace scaled by replay.speed or one recorded tick per server tick when the speed is 0, then reports
+/// the tick times and outgoing traffic the way the load test does.  Run it with the legacy network excluded.
+class ReplayComponent final : public INetworkComponent, public CoreEventHandler, public PlayerConnectEventHandler
+{
+private:
+	/// Runs after everything else in the tick so the whole tick can be timed.
+	struct TickEndHandler : public CoreEventHandler
+	{
+		ReplayComponent& self;
+
+		TickEndHandler(ReplayComponent& self)
+			: self(self)
+		{
+		}
+
+		void onTick(Microseconds elapsed, TimePoint now) override
+		{
+			self.onTickEnd();
+		}
+	};
+
+	ICore* core = nullptr;
+	IConsoleComponent* console = nullptr;
+	SimulatedNetwork network;
+	TickEndHandler tickEndHandler;
+
+	String file;
+	float speed = 1.0f;
+	bool exitWhenDone = true;
+
+	TrafficCaptureReader reader;
+	TrafficRecord pending;
+	bool hasPending = false;
+	/// Replayed players by the pool ID they had when captured
+	StaticArray<IPlayer*, PLAYER_POOL_SIZE> players;
+
+	DynamicArray<Microseconds> tickTimes;
+	TimePoint tickStart;
+	TimePoint replayStart;
+	TimePoint replayEnd;
+	Microseconds capturedTime = Microseconds(0);
+	uint64_t recordsReplayed = 0;
+	bool running = false;
+
+	IPlayer* getPlayer(const TrafficRecord& record) const
+	{
+		return record.player < players.size() ? players[record.player] : nullptr;
+	}
+
+	void connect(const TrafficRecord& record)
+	{
+		const DynamicArray<uint8_t>& payload = record.payload;
+		if (record.player >= players.size() || payload.size() < 3)
+		{
+			return;
+		}
+
+		size_t offset = 2;
+		StringView strings[2];
+		for (StringView& str : strings)
+		{
+			const size_t length = offset < payload.size() ? payload[offset++] : 0;
+			if (offset + length > payload.size())
+			{
+				return;
+			}
+			str = StringView(reinterpret_cast<const char*>(payload.data() + offset), length);
+			offset += length;
+		}
+
+		PeerNetworkData data;
+		data.network = &network;
+		data.networkID.address.v4 = 16777343; // 127.0.0.1
+		data.networkID.address.ipv6 = false;
+		data.networkID.port = uint16_t(10000 + record.player);
+
+		PeerRequestParams request;
+		request.bot = payload[0] != 0;
+		request.version = ClientVersion(payload[1]);
+		request.name = strings[0];
+		request.versionName = strings[1];
+
+		Pair<NewConnectionResult, IPlayer*> result = core->getPlayers().requestPlayer(data, request);
+		if (result.first != NewConnectionResult_Success)
+		{
+			core->logLn(LogLevel::Warning, "[replay] Couldn't connect captured player %d (%.*s), check max_players.", record.player, PRINT_VIEW(strings[0]));
+			return;
+		}
+
+		IPlayer& player = *result.second;
+		players[record.player] = &player;
+		network.addPeer(player);
+		network.networkEventDispatcher.dispatch(&NetworkEventHandler::onPeerConnect, player);
+	}
+
+	void dispatch(TrafficRecord& record)
+	{
+		++recordsReplayed;
+		if (record.type == TrafficRecordType_Connect)
+		{
+			connect(record);
+			return;
+		}
+
+		IPlayer* player = getPlayer(record);
+		if (!player)
+		{
+			return;
+		}
+
+		switch (record.type)
+		{
+		case TrafficRecordType_Disconnect:
+		{
+			network.removePeer(*player);
+			network.networkEventDispatcher.dispatch(&NetworkEventHandler::onPeerDisconnect, *player, PeerDisconnectReason(record.id));
+			break;
+		}
+		case TrafficRecordType_Packet:
+		{
+			// We want exact bits - set the write offset with bit granularity
+			NetworkBitStream bs(record.payload.data(), record.payload.size(), false /* copyData */);
+			bs.SetWriteOffset(record.bits);
+			network.receivePacket(*player, record.id, bs);
+			break;
+		}
+		case TrafficRecordType_RPC:
+		{
+			NetworkBitStream bs(record.payload.data(), record.payload.size(), false /* copyData */);
+			bs.SetWriteOffset(record.bits);
+			network.receiveRPC(*player, record.id, bs);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	/// Feed everything captured up to a point in capture time, or just the next captured tick when going flat out
+	void replay(TimePoint now)
+	{
+		Microseconds until;
+		if (speed > 0.0f)
+		{
+			until = Microseconds(Microseconds::rep(duration_cast<Microseconds>(now - replayStart).count() * double(speed)));
+		}
+		else
+		{
+			until = pending.type == TrafficRecordType_Tick ? TrafficCaptureReader::getTickTime(pending) : capturedTime;
+		}
+
+		while (hasPending)
+		{
+			if (pending.type == TrafficRecordType_Tick)
+			{
+				const Microseconds time = TrafficCaptureReader::getTickTime(pending);
+				if (time > until)
+				{
+					break;
+				}
+				capturedTime = time;
+			}
+			else
+			{
+				dispatch(pending);
+			}
+			hasPending = reader.read(pending);
+		}
+		if (!hasPending && reader.failed())
+		{
+			core->logLn(LogLevel::Error, "[replay] The capture is truncated or corrupt after %llu records, stopping the replay.", (unsigned long long)recordsReplayed);
+		}
+	}
+
+	void report()
+	{
+		const float seconds = duration_cast<Milliseconds>(replayEnd - replayStart).count() / 1000.0f;
+		if (tickTimes.empty() || seconds <= 0.0f)
+		{
+			core->printLn("[replay] No ticks were measured.");
+			return;
+		}
+
+		DynamicArray<Microseconds> sorted = tickTimes;
+		std::sort(sorted.begin(), sorted.end());
+		const auto percentile = [&sorted](float p)
+		{
+			return sorted[std::min(sorted.size() - 1, size_t(p * sorted.size()))].count() / 1000.0f;
+		};
+
+		core->printLn("[replay] %llu records, %.1fs of capture replayed in %.1fs (%zu ticks)", (unsigned long long)recordsReplayed, capturedTime.count() / 1000000.0f, seconds, tickTimes.size());
+		core->printLn("[replay] Tick time: p50 %.3fms, p90 %.3fms, p99 %.3fms, max %.3fms", percentile(0.5f), percentile(0.9f), percentile(0.99f), sorted.back().count() / 1000.0f);
+		core->printLn("[replay] Outgoing: %.1f KB, %llu messages, %.1f KB per captured second", network.getBytesSent() / 1024.0f, (unsigned long long)network.getPacketsSent(),
+			capturedTime.count() > 0 ? network.getBytesSent() / 1024.0f / (capturedTime.count() / 1000000.0f) : 0.0f);
+	}
+
+public:
+	ReplayComponent()
+		: tickEndHandler(*this)
+	{
+		players.fill(nullptr);
+	}
+
+	StringView componentName() const override
+	{
+		return "Replay";
+	}
+
+	SemanticVersion componentVersion() const override
+	{
+		return SemanticVersion(OMP_VERSION_MAJOR, OMP_VERSION_MINOR, OMP_VERSION_PATCH, BUILD_NUMBER);
+	}
+
+	UID getUID() override
+	{
+		return 0x3f7d2a91c6e85b40;
+	}
+
+	void provideConfiguration(ILogger& logger, IEarlyConfig& config, bool defaults) override
+	{
+		if (defaults)
+		{
+			config.setString("replay.file", file);
+			config.setFloat("replay.speed", speed);
+			config.setBool("replay.exit_when_done", exitWhenDone);
+		}
+		else
+		{
+			// Set default values if options are not set.
+			if (config.getType("replay.file") == ConfigOptionType_None)
+			{
+				config.setString("replay.file", file);
+			}
+			if (config.getType("replay.speed") == ConfigOptionType_None)
+			{
+				config.setFloat("replay.speed", speed);
+			}
+			if (config.getType("replay.exit_when_done") == ConfigOptionType_None)
+			{
+				config.setBool("replay.exit_when_done", exitWhenDone);
+			}
+		}
+	}
+
+	void onLoad(ICore* c) override
+	{
+		core = c;
+	}
+
+	void onInit(IComponentList* components) override
+	{
+		console = components->queryComponent<IConsoleComponent>();
+
+		IConfig& config = core->getConfig();
+		file = String(config.getString("replay.file"));
+		speed = std::max(*config.getFloat("replay.speed"), 0.0f);
+		exitWhenDone = *config.getBool("replay.exit_when_done");
+
+		core->getEventDispatcher().addEventHandler(this, EventPriority_Highest);
+		core->getEventDispatcher().addEventHandler(&tickEndHandler, EventPriority_Lowest);
+		core->getPlayers().getPlayerConnectDispatcher().addEventHandler(this);
+	}
+
+	void onReady() override
+	{
+		if (file.empty())
+		{
+			core->logLn(LogLevel::Error, "[replay] Set replay.file to the capture to play back.");
+			return;
+		}
+		if (!reader.open(file))
+		{
+			core->logLn(LogLevel::Error, "[replay] %s is not a network capture.", file.c_str());
+			return;
+		}
+
+		hasPending = reader.read(pending);
+		if (!hasPending && reader.failed())
+		{
+			core->logLn(LogLevel::Error, "[replay] %s is truncated or corrupt.", file.c_str());
+			return;
+		}
+		replayStart = Time::now();
+		tickTimes.reserve(1 << 16);
+		running = hasPending;
+		core->printLn("[replay] Replaying %s at %s.", file.c_str(), speed > 0.0f ? (std::to_string(speed) + "x").c_str() : "full speed");
+	}
+
+	void onFree(IComponent* component) override
+	{
+		if (component == console)
+		{
+			console = nullptr;
+		}
+	}
+
+	void onPlayerDisconnect(IPlayer& player, PeerDisconnectReason reason) override
+	{
+		// Kicked by the server rather than leaving in the capture, whatever else they sent has nowhere to go.
+		for (IPlayer*& replayed : players)
+		{
+			if (replayed == &player)
+			{
+				network.removePeer(player);
+				replayed = nullptr;
+			}
+		}
+	}
+
+	void onTick(Microseconds elapsed, TimePoint now) override
+	{
+		tickStart = Time::now();
+		if (running)
+		{
+			replay(now);
+		}
+	}
+
+	void onTickEnd()
+	{
+		if (!running)
+		{
+			return;
+		}
+
+		const TimePoint now = Time::now();
+		tickTimes.push_back(duration_cast<Microseconds>(now - tickStart));
+
+		if (!hasPending)
+		{
+			replayEnd = now;
+			running = false;
+			report();
+
+			if (exitWhenDone && console)
+			{
+				console->send("exit");
+			}
+		}
+	}
+
+	INetwork* getNetwork() override
+	{
+		return &network;
+	}
+
+	void free() override
+	{
+		core->getEventDispatcher().removeEventHandler(this);
+		core->getEventDispatcher().removeEventHandler(&tickEndHandler);
+		core->getPlayers().getPlayerConnectDispatcher().removeEventHandler(this);
+		delete this;
+	}
+
+	void reset() override
+	{
+	}
+};
+
+COMPONENT_ENTRY_POINT()
+{
+	return new ReplayComponent();
+}
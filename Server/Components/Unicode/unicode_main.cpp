@@ -8,38 +8,311 @@
 
 #include <Server/Components/Unicode/unicode.hpp>
 #include <sdk.hpp>
+#include <player_codepage.hpp>
+#include <cstring>
+#include <mutex>
 #include <unicode/ucsdet.h>
 #include <unicode/unistr.h>
 
 using namespace Impl;
 
-class UnicodeComponent final : public IUnicodeComponent
+/// Detection confidence, out of 100, needed before a player's codepage is remembered
+static constexpr int32_t StickyCodepageConfidence = 50;
+
+/// Check whether text can be passed through untouched, which is most of it: plain ASCII or already UTF-8
+static bool isASCIIOrUTF8(StringView input)
 {
+	const uint8_t* it = reinterpret_cast<const uint8_t*>(input.data());
+	const uint8_t* const end = it + input.length();
+
+	while (it != end)
+	{
+		// Skip ASCII eight bytes at a time.
+		while (end - it >= 8)
+		{
+			uint64_t word;
+			std::memcpy(&word, it, sizeof(word));
+			if (word & 0x8080808080808080ull)
+			{
+				break;
+			}
+			it += 8;
+		}
+		if (it == end)
+		{
+			break;
+		}
+
+		const uint8_t lead = *it;
+		if (lead < 0x80)
+		{
+			++it;
+			continue;
+		}
+
+		// Reject overlong forms, surrogates and anything past U+10FFFF along with malformed sequences.
+		size_t length;
+		uint8_t min = 0x80, max = 0xBF;
+		if (lead >= 0xC2 && lead <= 0xDF)
+		{
+			length = 2;
+		}
+		else if (lead >= 0xE0 && lead <= 0xEF)
+		{
+			length = 3;
+			if (lead == 0xE0)
+			{
+				min = 0xA0;
+			}
+			else if (lead == 0xED)
+			{
+				max = 0x9F;
+			}
+		}
+		else if (lead >= 0xF0 && lead <= 0xF4)
+		{
+			length = 4;
+			if (lead == 0xF0)
+			{
+				min = 0x90;
+			}
+			else if (lead == 0xF4)
+			{
+				max = 0x8F;
+			}
+		}
+		else
+		{
+			return false;
+		}
+
+		if (size_t(end - it) < length || it[1] < min || it[1] > max)
+		{
+			return false;
+		}
+		for (size_t i = 2; i < length; ++i)
+		{
+			if (it[i] < 0x80 || it[i] > 0xBF)
+			{
+				return false;
+			}
+		}
+		it += length;
+	}
+	return true;
+}
+
+/// ICU detectors aren't safe to share, so each caller borrows one of its own and gives it back after
+class DetectorPool
+{
+private:
+	std::mutex mutex_;
+	DynamicArray<UCharsetDetector*> idle_;
+
 public:
-	void onLoad(ICore* core) override
+	~DetectorPool()
 	{
+		for (UCharsetDetector* detector : idle_)
+		{
+			ucsdet_close(detector);
+		}
 	}
 
-	OptimisedString toUTF8(StringView input) override
+	UCharsetDetector* acquire()
 	{
-		static UErrorCode detstatus = U_ZERO_ERROR;
-		static UCharsetDetector* detector = ucsdet_open(&detstatus);
-		if (U_FAILURE(detstatus))
 		{
-			return OptimisedString(input);
+			std::scoped_lock<std::mutex> lock(mutex_);
+			if (!idle_.empty())
+			{
+				UCharsetDetector* detector = idle_.back();
+				idle_.pop_back();
+				return detector;
+			}
 		}
+
 		UErrorCode status = U_ZERO_ERROR;
-		ucsdet_setText(detector, input.data(), input.length(), &status);
-		const char* cp = ucsdet_getName(ucsdet_detect(detector, &status), &status);
+		UCharsetDetector* detector = ucsdet_open(&status);
 		if (U_FAILURE(status))
 		{
-			return OptimisedString(input);
+			if (detector)
+			{
+				ucsdet_close(detector);
+			}
+			return nullptr;
+		}
+		return detector;
+	}
+
+	void release(UCharsetDetector* detector)
+	{
+		std::scoped_lock<std::mutex> lock(mutex_);
+		idle_.push_back(detector);
+	}
+};
+
+class PlayerCodepageData final : public IExtension
+{
+public:
+	PROVIDE_EXT_UID(0x3e92b5d04c71a8f6)
+
+	String codepage;
+
+	void freeExtension() override
+	{
+		delete this;
+	}
+
+	void reset() override
+	{
+		codepage.clear();
+	}
+};
+
+class UnicodeComponent final : public IUnicodeComponent, public PlayerConnectEventHandler
+{
+private:
+	ICore* core = nullptr;
+	DetectorPool detectors;
+
+	struct PlayerCodepageExtension final : public IPlayerCodepageExtension
+	{
+		UnicodeComponent& self;
+
+		PlayerCodepageExtension(UnicodeComponent& component)
+			: self(component)
+		{
 		}
+
+		OptimisedString playerToUTF8(IPlayer& player, StringView input) override
+		{
+			if (isASCIIOrUTF8(input))
+			{
+				return OptimisedString(input);
+			}
+
+			PlayerCodepageData* data = queryExtension<PlayerCodepageData>(player);
+			if (data && !data->codepage.empty())
+			{
+				return convert(input, data->codepage.c_str());
+			}
+
+			int32_t confidence = 0;
+			const char* cp = self.detect(input, confidence);
+			if (!cp)
+			{
+				return OptimisedString(input);
+			}
+
+			// Short lines are easy to get wrong, only stick to a guess we're fairly sure about.
+			if (data && confidence >= StickyCodepageConfidence)
+			{
+				data->codepage = cp;
+			}
+			return convert(input, cp);
+		}
+
+		StringView getPlayerCodepage(IPlayer& player) const override
+		{
+			PlayerCodepageData* data = queryExtension<PlayerCodepageData>(player);
+			return data ? StringView(data->codepage) : StringView();
+		}
+
+		void setPlayerCodepage(IPlayer& player, StringView codepage) override
+		{
+			PlayerCodepageData* data = queryExtension<PlayerCodepageData>(player);
+			if (data)
+			{
+				data->codepage = String(codepage);
+			}
+		}
+
+		void freeExtension() override
+		{
+			// Owned by the component.
+		}
+
+		void reset() override
+		{
+		}
+	} playerCodepages;
+
+	/// Guess the codepage of some text, safe to call from any thread
+	const char* detect(StringView input, int32_t& confidence)
+	{
+		UCharsetDetector* detector = detectors.acquire();
+		if (!detector)
+		{
+			return nullptr;
+		}
+
+		UErrorCode status = U_ZERO_ERROR;
+		ucsdet_setText(detector, input.data(), input.length(), &status);
+		const UCharsetMatch* match = ucsdet_detect(detector, &status);
+		// Names are static in ICU, they outlive the match once the detector goes back in the pool.
+		const char* cp = ucsdet_getName(match, &status);
+		confidence = ucsdet_getConfidence(match, &status);
+		detectors.release(detector);
+
+		return U_FAILURE(status) ? nullptr : cp;
+	}
+
+	static OptimisedString convert(StringView input, const char* cp)
+	{
 		String output;
 		icu::UnicodeString(input.data(), input.length(), cp).toUTF8String(output);
 		return OptimisedString(output);
 	}
 
+public:
+	UnicodeComponent()
+		: playerCodepages(*this)
+	{
+	}
+
+	~UnicodeComponent()
+	{
+		if (core)
+		{
+			core->getPlayers().getPlayerConnectDispatcher().removeEventHandler(this);
+		}
+	}
+
+	void onLoad(ICore* c) override
+	{
+		core = c;
+		core->getPlayers().getPlayerConnectDispatcher().addEventHandler(this);
+	}
+
+	void onPlayerConnect(IPlayer& player) override
+	{
+		player.addExtension(new PlayerCodepageData(), true);
+	}
+
+	OptimisedString toUTF8(StringView input) override
+	{
+		if (isASCIIOrUTF8(input))
+		{
+			return OptimisedString(input);
+		}
+
+		int32_t confidence = 0;
+		const char* cp = detect(input, confidence);
+		if (!cp)
+		{
+			return OptimisedString(input);
+		}
+		return convert(input, cp);
+	}
+
+	IExtension* getExtension(UID id) override
+	{
+		if (id == IPlayerCodepageExtension::ExtensionIID)
+		{
+			return &playerCodepages;
+		}
+		return IUnicodeComponent::getExtension(id);
+	}
+
 	StringView componentName() const override
 	{
 		return "Unicode";
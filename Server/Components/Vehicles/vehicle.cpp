@@ -172,6 +172,7 @@ bool Vehicle::updateFromDriverSync(const VehicleDriverSyncPacket& vehicleSync, I
 	}
 
 	pos = vehicleSync.Position;
+	pool->getHotState().setPosition(poolID, pos);
 	rot = vehicleSync.Rotation;
 	velocity = vehicleSync.Velocity;
 	landingGear = vehicleSync.LandingGear;
@@ -298,6 +299,7 @@ bool Vehicle::updateFromUnoccupied(const VehicleUnoccupiedSyncPacket& unoccupied
 	if (allowed)
 	{
 		pos = unoccupiedSync.Position;
+		pool->getHotState().setPosition(poolID, pos);
 		rot.q = glm::quat_cast(glm::transpose(glm::mat3(unoccupiedSync.Roll, unoccupiedSync.Rotation, glm::cross(unoccupiedSync.Roll, unoccupiedSync.Rotation))));
 		velocity = unoccupiedSync.Velocity;
 		angularVelocity = unoccupiedSync.AngularVelocity;
@@ -327,6 +329,7 @@ bool Vehicle::updateFromTrailerSync(const VehicleTrailerSyncPacket& trailerSync,
 	}
 
 	pos = trailerSync.Position;
+	pool->getHotState().setPosition(poolID, pos);
 	velocity = trailerSync.Velocity;
 	angularVelocity = trailerSync.TurnVelocity;
 	rot.q = glm::quat(trailerSync.Quat[0], trailerSync.Quat[1], trailerSync.Quat[2], trailerSync.Quat[3]);
@@ -600,6 +603,7 @@ void Vehicle::setHealth(float Health)
 void Vehicle::setInterior(int InteriorID)
 {
 	interior = InteriorID;
+	updateHotState();
 	NetCode::RPC::LinkVehicleToInterior linkVehicleToInteriorRPC;
 	linkVehicleToInteriorRPC.VehicleID = poolID;
 	linkVehicleToInteriorRPC.InteriorID = InteriorID;
@@ -658,6 +662,7 @@ float Vehicle::getHealth()
 void Vehicle::setPosition(Vector3 position)
 {
 	pos = position;
+	updateHotState();
 	NetCode::RPC::SetVehiclePosition setVehiclePosition;
 	setVehiclePosition.VehicleID = poolID;
 	setVehiclePosition.position = position;
@@ -669,6 +674,14 @@ Vector3 Vehicle::getPosition() const
 	return pos;
 }
 
+void Vehicle::updateHotState()
+{
+	if (hotStateTracked_)
+	{
+		pool->getHotState().set(poolID, pos, virtualWorld_, interior, 0);
+	}
+}
+
 void Vehicle::setDead(IPlayer& killer)
 {
 	deathData.dead = true;
@@ -700,6 +713,7 @@ void Vehicle::_respawn()
 	deathData.killerID = INVALID_PLAYER_ID;
 	pos = spawnData.position;
 	interior = spawnData.interior;
+	updateHotState();
 	bodyColour1 = -1;
 	bodyColour2 = -1;
 	rot = GTAQuat(0.0f, 0.0f, spawnData.zRotation);
@@ -12,12 +12,15 @@
 #include <Impl/pool_impl.hpp>
 #include <Server/Components/Vehicles/vehicles.hpp>
 #include <chrono>
+#include <hot_state.hpp>
 #include <netcode.hpp>
 
 using namespace Impl;
 
 class VehiclesComponent;
 
+using VehicleHotState = HotStateTable<VEHICLE_POOL_SIZE>;
+
 struct VehicleDeathData
 {
 	bool dead = false;
@@ -67,6 +70,8 @@ private:
 	uint32_t hydraThrustAngle = 0;
 	float trainSpeed = 0.0f;
 	int lastDriverPoolID = INVALID_PLAYER_ID;
+	/// Set once the vehicle has its pool ID, there's no hot state slot to write to before then
+	bool hotStateTracked_ = false;
 
 	/// Update the vehicle occupied status - set beenOccupied to true and update the lastOccupied time.
 	void updateOccupied()
@@ -84,6 +89,16 @@ private:
 	void _respawn();
 
 public:
+	/// Copy the fields streaming reads into the pool's hot state table, call after changing any of them
+	void updateHotState();
+
+	/// Start writing to the hot state table, once the vehicle is in the pool
+	void trackHotState()
+	{
+		hotStateTracked_ = true;
+		updateHotState();
+	}
+
 	int getLastDriverPoolID() const override
 	{
 		return lastDriverPoolID;
@@ -162,6 +177,7 @@ public:
 	void setVirtualWorld(int vw) override
 	{
 		virtualWorld_ = vw;
+		updateHotState();
 	}
 
 	void setSiren(bool status) override
@@ -384,6 +400,7 @@ public:
 	{
 		this->pos = pos;
 		velocity = veloc;
+		updateHotState();
 	}
 
 	const StaticArray<IVehicle*, MAX_VEHICLE_CARRIAGES>& getCarriages() override
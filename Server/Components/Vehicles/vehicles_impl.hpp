@@ -25,6 +25,9 @@ private:
 	StaticArray<uint8_t, MAX_VEHICLE_MODELS> preloadModels;
 	StreamConfigHelper streamConfigHelper;
 	int* deathRespawnDelay = nullptr;
+	VehicleHotState hotState;
+	/// Scratch for the streaming scan, which vehicles are in range of the player being updated
+	StaticArray<uint8_t, VEHICLE_POOL_SIZE> streamInRange;
 
 	struct PlayerEnterVehicleHandler : public SingleNetworkInEventHandler
 	{
@@ -299,6 +302,11 @@ public:
 		return core->getPlayers();
 	}
 
+	VehicleHotState& getHotState()
+	{
+		return hotState;
+	}
+
 	IEventDispatcher<VehicleEventHandler>& getEventDispatcher() override
 	{
 		return eventDispatcher;
@@ -456,6 +464,7 @@ public:
 
 		if (vehicle)
 		{
+			static_cast<Vehicle*>(vehicle)->trackHotState();
 			++preloadModels[data.modelID - 400];
 
 			static bool delay_warn = false;
@@ -481,6 +490,7 @@ public:
 		IVehicle* vehicle = storage.get(vehicleId);
 		if (vehicle)
 		{
+			static_cast<Vehicle*>(vehicle)->trackHotState();
 			++preloadModels[data.modelID - 400];
 
 			static bool delay_warn = false;
@@ -528,6 +538,7 @@ public:
 					Vehicle* carriage = static_cast<Vehicle*>(c);
 					--preloadModels[carriage->getModel() - 400];
 					carriage->destream();
+					hotState.remove(carriage->poolID);
 					storage.release(carriage->poolID, false);
 				}
 			}
@@ -558,6 +569,7 @@ public:
 
 			--preloadModels[veh_model - 400];
 			vehiclePtr->destream();
+			hotState.remove(index);
 			storage.release(index, false);
 		}
 	}
@@ -634,6 +646,10 @@ public:
 	void reset() override
 	{
 		// Destroy all stored entity instances.
+		for (IVehicle* vehicle : storage)
+		{
+			hotState.remove(vehicle->getID());
+		}
 		storage.clear();
 	}
 
@@ -694,6 +710,10 @@ public:
 		const float maxDist = streamConfigHelper.getDistanceSqr();
 		if (streamConfigHelper.shouldStream(player.getID(), now))
 		{
+			// Distances and worlds come from the hot state table, the vehicles are only touched to stream them.
+			const int world = player.getVirtualWorld();
+			hotState.findInRange(Vector2(player.getPosition()), maxDist, world, streamInRange);
+
 			for (IVehicle* v : storage)
 			{
 				Vehicle* vehicle = static_cast<Vehicle*>(v);
@@ -705,8 +725,9 @@ public:
 					continue;
 				}
 
-				const Vector2 dist2D = vehicle->getPosition() - player.getPosition();
-				const bool shouldBeStreamedIn = state != PlayerState_None && player.getVirtualWorld() == vehicle->getVirtualWorld() && (playerVehicle == vehicle || glm::dot(dist2D, dist2D) < maxDist);
+				const int id = vehicle->poolID;
+				const bool inRange = streamInRange[id] || (playerVehicle == vehicle && hotState.getWorld(id) == world);
+				const bool shouldBeStreamedIn = state != PlayerState_None && inRange;
 
 				const bool isStreamedIn = vehicle->isStreamedInForPlayer(player);
 				if (!isStreamedIn && shouldBeStreamedIn)
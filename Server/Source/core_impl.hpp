@@ -60,6 +60,7 @@ static const std::map<String, ConfigStorage> Defaults {
 	{ "password", String("") },
 	{ "sleep", 5.0f },
 	{ "use_dyn_ticks", true },
+	{ "use_parallel_component_loading", true },
 	{ "website", String("open.mp") },
 	// game
 	{ "game.allow_interior_weapons", true },
@@ -88,6 +89,7 @@ static const std::map<String, ConfigStorage> Defaults {
 	{ "game.validate_animations", true },
 	{ "game.use_all_animations", true },
 	{ "game.lag_compensation_mode", LagCompMode_Enabled },
+	{ "game.bullet_hit_tolerance", 0.0f },
 	{ "game.group_player_objects", false },
 	// logging
 	{ "logging.enable", true },
@@ -119,6 +121,7 @@ static const std::map<String, ConfigStorage> Defaults {
 	{ "network.on_foot_sync_rate", 30 },
 	{ "network.player_marker_sync_rate", 2500 },
 	{ "network.player_timeout", 10000 },
+	{ "network.scores_and_pings_rate", 1000 },
 	{ "network.stream_radius", 200.f },
 	{ "network.stream_rate", 1000 },
 	{ "network.time_sync_rate", 30000 },
@@ -126,7 +129,25 @@ static const std::map<String, ConfigStorage> Defaults {
 	{ "network.allow_037_clients", true },
 	{ "network.grace_period", 5000 },
 	{ "network.use_omp_encryption", false },
+	{ "network.use_receive_thread", false },
 	{ "network.minimum_send_bits_per_second", 96000.0f }, // 96 kbps  (~12 KB/s)
+	{ "network.join_sync_budget", 100 }, // Join-time RPCs (other players, global objects, model requests) sent to a newcomer per tick, 0 sends them all at once
+	{ "network.capture_file", String("") }, // Record everything received to this file for the Replay component, empty disables
+	{ "network.capture_mask_input", true }, // Mask command, dialog response and RCON text in captures, they can hold passwords
+	{ "network.packet_accounting", false }, // Count bytes and handler time per packet and RPC ID, see the packetstats command
+	// Peers closer than each distance get a sender's sync at full, half or quarter rate, anyone further gets 1/8.  The
+	// defaults keep the old rates, full within 250 units and half beyond, lower the other distances to thin far sync further
+	{ "network.sync_lod.on_foot_full_rate_distance", 250.0f },
+	{ "network.sync_lod.on_foot_half_rate_distance", 100000.0f },
+	{ "network.sync_lod.on_foot_quarter_rate_distance", 100000.0f },
+	{ "network.sync_lod.vehicle_full_rate_distance", 250.0f },
+	{ "network.sync_lod.vehicle_half_rate_distance", 100000.0f },
+	{ "network.sync_lod.vehicle_quarter_rate_distance", 100000.0f },
+	{ "network.sync_lod.aim_full_rate_distance", 250.0f },
+	{ "network.sync_lod.aim_half_rate_distance", 100000.0f },
+	{ "network.sync_lod.aim_quarter_rate_distance", 100000.0f },
+	{ "network.sync_lod.congestion_send_queue", 0 }, // Messages waiting to go out before a receiver's rates drop a step, 0 disables
+	{ "network.sync_lod.congestion_bits_per_second", 0 }, // 0 disables
 	// rcon
 	{ "rcon.allow_teleport", false },
 	{ "rcon.enable", false },
@@ -223,11 +244,56 @@ struct VarlistEnumCallback : OptionEnumeratorCallback
 	}
 };
 
+enum ComponentStartupPhase
+{
+	ComponentStartupPhase_Open,
+	ComponentStartupPhase_Configure,
+	ComponentStartupPhase_Load,
+	ComponentStartupPhase_Init,
+	ComponentStartupPhase_Ready,
+	ComponentStartupPhase_Count
+};
+
+static const StringView ComponentStartupPhaseNames[ComponentStartupPhase_Count] = {
+	"open",
+	"configure",
+	"load",
+	"init",
+	"ready",
+};
+
+/// How long a single component spent in every startup phase
+struct ComponentStartupTimes
+{
+	String name;
+	StaticArray<Microseconds, ComponentStartupPhase_Count> phases;
+
+	ComponentStartupTimes()
+	{
+		phases.fill(Microseconds(0));
+	}
+
+	Microseconds total() const
+	{
+		Microseconds sum(0);
+		for (const Microseconds& phase : phases)
+		{
+			sum += phase;
+		}
+		return sum;
+	}
+};
+
 class ComponentList : public IComponentList
 {
 public:
 	using IComponentList::queryComponent;
 
+	ComponentList()
+	{
+		phaseTotals.fill(Microseconds(0));
+	}
+
 	IComponent* queryComponent(UID id) override
 	{
 		auto it = components.find(id);
@@ -236,28 +302,28 @@ public:
 
 	void configure(ICore& core, IEarlyConfig& config, bool defaults)
 	{
-		std::for_each(components.begin(), components.end(),
-			[&core, &config, defaults](const robin_hood::pair<UID, IComponent*>& pair)
+		forEachTimed(ComponentStartupPhase_Configure,
+			[&core, &config, defaults](IComponent* component)
 			{
-				pair.second->provideConfiguration(core, config, defaults);
+				component->provideConfiguration(core, config, defaults);
 			});
 	}
 
 	void load(ICore* core)
 	{
-		std::for_each(components.begin(), components.end(),
-			[core](const robin_hood::pair<UID, IComponent*>& pair)
+		forEachTimed(ComponentStartupPhase_Load,
+			[core](IComponent* component)
 			{
-				pair.second->onLoad(core);
+				component->onLoad(core);
 			});
 	}
 
 	void init()
 	{
-		std::for_each(components.begin(), components.end(),
-			[this](const robin_hood::pair<UID, IComponent*>& pair)
+		forEachTimed(ComponentStartupPhase_Init,
+			[this](IComponent* component)
 			{
-				pair.second->onInit(this);
+				component->onInit(this);
 			});
 	}
 
@@ -272,10 +338,10 @@ public:
 
 	void ready()
 	{
-		std::for_each(components.begin(), components.end(),
-			[](const robin_hood::pair<UID, IComponent*>& pair)
+		forEachTimed(ComponentStartupPhase_Ready,
+			[](IComponent* component)
 			{
-				pair.second->onReady();
+				component->onReady();
 			});
 	}
 
@@ -303,8 +369,49 @@ public:
 		return components.size();
 	}
 
+	/// Record time spent outside of the component list, e.g. opening the library
+	void addStartupTime(IComponent* component, ComponentStartupPhase phase, Microseconds time)
+	{
+		ComponentStartupTimes& times = startupTimes[component->getUID()];
+		if (times.name.empty())
+		{
+			times.name = String(component->componentName());
+		}
+		times.phases[phase] += time;
+	}
+
+	void addStartupPhaseTime(ComponentStartupPhase phase, Microseconds time)
+	{
+		phaseTotals[phase] += time;
+	}
+
+	const FlatHashMap<UID, ComponentStartupTimes>& getStartupTimes() const
+	{
+		return startupTimes;
+	}
+
+	const StaticArray<Microseconds, ComponentStartupPhase_Count>& getStartupPhaseTimes() const
+	{
+		return phaseTotals;
+	}
+
 private:
+	template <typename F>
+	void forEachTimed(ComponentStartupPhase phase, F&& func)
+	{
+		const TimePoint phaseStart = Time::now();
+		for (const robin_hood::pair<UID, IComponent*>& pair : components)
+		{
+			const TimePoint start = Time::now();
+			func(pair.second);
+			addStartupTime(pair.second, phase, duration_cast<Microseconds>(Time::now() - start));
+		}
+		phaseTotals[phase] += duration_cast<Microseconds>(Time::now() - phaseStart);
+	}
+
 	FlatHashMap<UID, IComponent*> components;
+	FlatHashMap<UID, ComponentStartupTimes> startupTimes;
+	StaticArray<Microseconds, ComponentStartupPhase_Count> phaseTotals;
 };
 
 static constexpr const char* TimeFormat = "%Y-%m-%dT%H:%M:%S%z";
@@ -1100,7 +1207,8 @@ private:
 class Core final : public ICore, public PlayerConnectEventHandler, public ConsoleEventHandler
 {
 private:
-	DefaultEventDispatcher<CoreEventHandler> eventDispatcher;
+	EventProfiler eventProfiler;
+	SortedEventDispatcher<CoreEventHandler> eventDispatcher;
 	PlayerPool players;
 	Microseconds sleepTimer;
 	Microseconds sleepDuration;
@@ -1161,39 +1269,82 @@ private:
 		}
 	}
 
-	IComponent* loadComponent(const ghc::filesystem::path& path, bool highPriority = false)
+	/// The result of opening a component library, filled in from a loader thread
+	struct ComponentLibrary
 	{
-		printLn("Loading component %s", path.filename().u8string().c_str());
-		auto componentLib = highPriority ? LIBRARY_OPEN_GLOBAL(path.u8string().c_str()) : LIBRARY_OPEN(path.u8string().c_str());
-		if (componentLib == nullptr)
+		ghc::filesystem::path path;
+		LIBRARY_HANDLE handle = nullptr;
+		ComponentEntryPoint_t entryPoint = nullptr;
+		bool found = true;
+		bool isSAMPPlugin = false;
+		std::string error;
+		Microseconds openTime = Microseconds(0);
+	};
+
+	/// Open the library and resolve its entry point.  Doesn't log or touch any core state, so it's
+	/// safe to call for several libraries at once.
+	static void openComponentLibrary(ComponentLibrary& library, bool highPriority)
+	{
+		const TimePoint start = Time::now();
+		if (!ghc::filesystem::exists(library.path))
+		{
+			library.found = false;
+			return;
+		}
+
+		library.handle = highPriority ? LIBRARY_OPEN_GLOBAL(library.path.u8string().c_str()) : LIBRARY_OPEN(library.path.u8string().c_str());
+		if (library.handle == nullptr)
+		{
+			library.error = utils::GetLastErrorAsString();
+		}
+		else
+		{
+			library.entryPoint = reinterpret_cast<ComponentEntryPoint_t>(LIBRARY_GET_ADDR(library.handle, "ComponentEntryPoint"));
+			if (library.entryPoint == nullptr)
+			{
+				library.isSAMPPlugin = LIBRARY_GET_ADDR(library.handle, "Supports") != nullptr;
+			}
+		}
+		library.openTime = duration_cast<Microseconds>(Time::now() - start);
+	}
+
+	/// Create the component from an opened library, on the main thread and in load order.
+	IComponent* finishLoadComponent(ComponentLibrary& library)
+	{
+		printLn("Loading component %s", library.path.filename().u8string().c_str());
+		if (!library.found)
 		{
-			printLn("\tFailed to load component: %s.", utils::GetLastErrorAsString().c_str());
+			printLn("\tCould not find component");
 			return nullptr;
 		}
-		ComponentEntryPoint_t OnComponentLoad = reinterpret_cast<ComponentEntryPoint_t>(LIBRARY_GET_ADDR(componentLib, "ComponentEntryPoint"));
-		if (OnComponentLoad == nullptr)
+		if (library.handle == nullptr)
+		{
+			printLn("\tFailed to load component: %s.", library.error.c_str());
+			return nullptr;
+		}
+		if (library.entryPoint == nullptr)
 		{
-			void* isSAMPPlugin = reinterpret_cast<void*>(LIBRARY_GET_ADDR(componentLib, "Supports"));
 			printLn(
 				"\tFailed to load component: %s.",
-				isSAMPPlugin
+				library.isSAMPPlugin
 					? "it is a SA-MP plugin, put it in plugins/ folder"
 					: "it is neither an open.mp component nor a SA-MP plugin");
-			LIBRARY_FREE(componentLib);
+			LIBRARY_FREE(library.handle);
 			return nullptr;
 		}
-		IComponent* component = OnComponentLoad();
+		const TimePoint start = Time::now();
+		IComponent* component = library.entryPoint();
 		if (component == nullptr)
 		{
 			printLn("\tFailed to load component.");
-			LIBRARY_FREE(componentLib);
+			LIBRARY_FREE(library.handle);
 			return nullptr;
 		}
 		int supports = component->supportedVersion();
 		if (supports != OMP_VERSION_MAJOR)
 		{
 			printLn("\tFailed to load component: Built for open.mp version %d, now on %d.", supports, OMP_VERSION_MAJOR);
-			LIBRARY_FREE(componentLib);
+			LIBRARY_FREE(library.handle);
 			return nullptr;
 		}
 		SemanticVersion ver = component->componentVersion();
@@ -1205,9 +1356,62 @@ private:
 			ver.patch,
 			ver.prerel,
 			component->getUID());
+		components.addStartupTime(component, ComponentStartupPhase_Open, library.openTime + duration_cast<Microseconds>(Time::now() - start));
 		return component;
 	}
 
+	/// Load a set of component libraries.  High priority libraries are opened one at a time since
+	/// the ones after them may depend on their globally exported symbols, the rest are opened and
+	/// have their symbols resolved in parallel.  Components are always created and added in order.
+	void loadComponentLibraries(const DynamicArray<ghc::filesystem::path>& paths, bool highPriority)
+	{
+		const TimePoint start = Time::now();
+		DynamicArray<ComponentLibrary> libraries(paths.size());
+		for (size_t i = 0; i != paths.size(); ++i)
+		{
+			libraries[i].path = paths[i];
+		}
+
+		const size_t threadCount = (highPriority || !*config.getBool("use_parallel_component_loading")) ? 0 : std::min<size_t>(std::thread::hardware_concurrency(), libraries.size());
+		if (threadCount > 1)
+		{
+			std::atomic_size_t next(0);
+			DynamicArray<std::thread> loaders;
+			loaders.reserve(threadCount);
+			for (size_t i = 0; i != threadCount; ++i)
+			{
+				loaders.emplace_back([&libraries, &next]()
+					{
+						for (size_t idx = next++; idx < libraries.size(); idx = next++)
+						{
+							openComponentLibrary(libraries[idx], false);
+						}
+					});
+			}
+			for (std::thread& loader : loaders)
+			{
+				loader.join();
+			}
+		}
+		else
+		{
+			for (ComponentLibrary& library : libraries)
+			{
+				openComponentLibrary(library, highPriority);
+			}
+		}
+
+		for (ComponentLibrary& library : libraries)
+		{
+			IComponent* component = finishLoadComponent(library);
+			if (component)
+			{
+				addComponent(component);
+			}
+		}
+		components.addStartupPhaseTime(ComponentStartupPhase_Open, duration_cast<Microseconds>(Time::now() - start));
+	}
+
 	void loadComponents(const ghc::filesystem::path& path)
 	{
 		ghc::filesystem::create_directory(path);
@@ -1243,6 +1447,11 @@ private:
 			for (auto& de : ghc::filesystem::recursive_directory_iterator(path))
 			{
 				ghc::filesystem::path p = de.path();
+				if (p.extension() != LIBRARY_EXT || !shouldLoad(p))
+				{
+					continue;
+				}
+
 				if (p.filename().string().at(0) == '$')
 				{
 					highPriorityComponents.push_back(p);
@@ -1252,40 +1461,6 @@ private:
 					normalComponents.push_back(p);
 				}
 			}
-
-			for (auto& p : highPriorityComponents)
-			{
-				if (p.extension() == LIBRARY_EXT)
-				{
-					if (!shouldLoad(p))
-					{
-						continue;
-					}
-
-					IComponent* component = loadComponent(p, true);
-					if (component)
-					{
-						addComponent(component);
-					}
-				}
-			}
-
-			for (auto& p : normalComponents)
-			{
-				if (p.extension() == LIBRARY_EXT)
-				{
-					if (!shouldLoad(p))
-					{
-						continue;
-					}
-
-					IComponent* component = loadComponent(p);
-					if (component)
-					{
-						addComponent(component);
-					}
-				}
-			}
 		}
 		else
 		{
@@ -1297,69 +1472,79 @@ private:
 					file.replace_extension("");
 				}
 
-				if (file.filename().string().at(0) == '$')
-				{
-					highPriorityComponents.push_back(file);
-				}
-				else
-				{
-					normalComponents.push_back(file);
-				}
-			}
-
-			for (auto& p : highPriorityComponents)
-			{
-				if (!shouldLoad(p))
-				{
-					continue;
-				}
-
-				// Now load it.
-				p.replace_extension(LIBRARY_EXT);
-				if (ghc::filesystem::exists(p))
-				{
-					IComponent* component = loadComponent(p, true);
-					if (component)
-					{
-						addComponent(component);
-					}
-				}
-				else
-				{
-					printLn("Loading component %s", p.filename().u8string().c_str());
-					printLn("\tCould not find component");
-				}
-			}
-
-			for (auto& p : normalComponents)
-			{
-				if (!shouldLoad(p))
+				if (!shouldLoad(file))
 				{
 					continue;
 				}
 
 				// Now load it.
-				p.replace_extension(LIBRARY_EXT);
-				if (ghc::filesystem::exists(p))
+				file.replace_extension(LIBRARY_EXT);
+				if (file.filename().string().at(0) == '$')
 				{
-					IComponent* component = loadComponent(p);
-					if (component)
-					{
-						addComponent(component);
-					}
+					highPriorityComponents.push_back(file);
 				}
 				else
 				{
-					printLn("Loading component %s", p.filename().u8string().c_str());
-					printLn("\tCould not find component");
+					normalComponents.push_back(file);
 				}
 			}
 		}
 
+		loadComponentLibraries(highPriorityComponents, true);
+		loadComponentLibraries(normalComponents, false);
+
 		std::string absPath = ghc::filesystem::canonical(path).string();
 		printLnU8("Loaded %i component(s) from %.*s", components.size(), PRINT_VIEW(StringView(absPath)));
 	}
 
+	/// Output the per component and per phase startup times, slowest components first
+	template <typename Output>
+	void reportStartupTimes(Output&& output) const
+	{
+		char line[256];
+		const auto& phaseTotals = components.getStartupPhaseTimes();
+		Microseconds total(0);
+		for (const Microseconds& phase : phaseTotals)
+		{
+			total += phase;
+		}
+
+		snprintf(line, sizeof(line), "Component startup took %.2fms:", total.count() / 1000.0);
+		output(line);
+		for (int i = 0; i != ComponentStartupPhase_Count; ++i)
+		{
+			snprintf(line, sizeof(line), "\t%-10.*s %10.2fms", PRINT_VIEW(ComponentStartupPhaseNames[i]), phaseTotals[i].count() / 1000.0);
+			output(line);
+		}
+
+		DynamicArray<const ComponentStartupTimes*> sorted;
+		sorted.reserve(components.getStartupTimes().size());
+		for (const auto& kv : components.getStartupTimes())
+		{
+			sorted.push_back(&kv.second);
+		}
+		std::sort(sorted.begin(), sorted.end(),
+			[](const ComponentStartupTimes* a, const ComponentStartupTimes* b)
+			{
+				return a->total() > b->total();
+			});
+
+		snprintf(line, sizeof(line), "\t%-24s %10s %10s %10s %10s %10s %10s", "component", "total", "open", "configure", "load", "init", "ready");
+		output(line);
+		for (const ComponentStartupTimes* times : sorted)
+		{
+			snprintf(line, sizeof(line), "\t%-24.*s %8.2fms %8.2fms %8.2fms %8.2fms %8.2fms %8.2fms",
+				PRINT_VIEW(StringView(times->name)),
+				times->total().count() / 1000.0,
+				times->phases[ComponentStartupPhase_Open].count() / 1000.0,
+				times->phases[ComponentStartupPhase_Configure].count() / 1000.0,
+				times->phases[ComponentStartupPhase_Load].count() / 1000.0,
+				times->phases[ComponentStartupPhase_Init].count() / 1000.0,
+				times->phases[ComponentStartupPhase_Ready].count() / 1000.0);
+			output(line);
+		}
+	}
+
 	void playerInit(IPlayer& player)
 	{
 		players.playerConnectDispatcher.dispatch(&PlayerConnectEventHandler::onPlayerClientInit, player);
@@ -1710,6 +1895,9 @@ public:
 		// Initialize start time
 		getTickCount();
 
+		eventDispatcher.setProfiler(eventProfiler, "CoreEventHandler");
+		players.setEventProfiler(eventProfiler);
+
 		players.getPlayerConnectDispatcher().addEventHandler(this, EventPriority_FairlyLow);
 
 		// Read config params before loading config file
@@ -1862,6 +2050,11 @@ public:
 
 		models = components.queryComponent<ICustomModelsComponent>();
 		components.ready();
+
+		reportStartupTimes([this](StringView line)
+			{
+				printLn("%.*s", PRINT_VIEW(line));
+			});
 	}
 
 	~Core()
@@ -2106,6 +2299,15 @@ public:
 		return eventDispatcher;
 	}
 
+	IExtension* getExtension(UID id) override
+	{
+		if (id == IEventProfilerExtension::ExtensionIID)
+		{
+			return &eventProfiler;
+		}
+		return ICore::getExtension(id);
+	}
+
 	void setGravity(float gravity) override
 	{
 		*SetGravity = gravity;
@@ -2263,6 +2465,7 @@ public:
 		commands.emplace("reloadlog");
 		commands.emplace("config");
 		commands.emplace("varlist");
+		commands.emplace("startuptimes");
 	}
 
 	bool onConsoleText(StringView command, StringView parameters, const ConsoleCommandSenderData& sender) override
@@ -2294,6 +2497,14 @@ public:
 			updateNetworks();
 			return true;
 		}
+		else if (command == "startuptimes")
+		{
+			reportStartupTimes([this, &sender](StringView line)
+				{
+					console->sendMessage(sender, line);
+				});
+			return true;
+		}
 		else if (command == "varlist")
 		{
 			console->sendMessage(sender, "Console variables:");
@@ -0,0 +1,429 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <event_profile.hpp>
+#include <events.hpp>
+#include <types.hpp>
+#include <algorithm>
+#include <chrono>
+#include <typeinfo>
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+using namespace Impl;
+
+/// A dispatcher the profiler can read handler timings from
+struct IProfiledEventDispatcher
+{
+	/// Append the timings of every live handler, with their class names alongside
+	virtual void collectProfile(StringView event, DynamicArray<EventHandlerProfile>& profiles, DynamicArray<String>& names) const = 0;
+
+	virtual void resetProfile() = 0;
+};
+
+/// Times the handlers of the dispatchers registered with it, for the eventstats console command.
+class EventProfiler final : public IEventProfilerExtension
+{
+public:
+	void add(IProfiledEventDispatcher& dispatcher, StringView event)
+	{
+		dispatchers_.emplace_back(&dispatcher, event);
+	}
+
+	bool enabled() const
+	{
+		return enabled_;
+	}
+
+	bool isEventProfiling() const override
+	{
+		return enabled_;
+	}
+
+	void setEventProfiling(bool enabled) override
+	{
+		enabled_ = enabled;
+	}
+
+	void resetEventProfile() override
+	{
+		for (auto& dispatcher : dispatchers_)
+		{
+			dispatcher.first->resetProfile();
+		}
+	}
+
+	Span<const EventHandlerProfile> getEventProfile() override
+	{
+		profiles_.clear();
+		names_.clear();
+		for (auto& dispatcher : dispatchers_)
+		{
+			dispatcher.first->collectProfile(dispatcher.second, profiles_, names_);
+		}
+		// Only point at the names once they've all been added and won't move again.
+		for (size_t i = 0; i != profiles_.size(); ++i)
+		{
+			profiles_[i].handler = names_[i];
+		}
+		return Span<const EventHandlerProfile>(profiles_.data(), profiles_.size());
+	}
+
+	void freeExtension() override
+	{
+		// Owned by the core.
+	}
+
+	void reset() override
+	{
+	}
+
+	/// Get a readable name for a handler's class
+	static String getHandlerName(const std::type_info& type)
+	{
+#if defined(__GNUC__)
+		int status = 0;
+		char* demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+		if (demangled)
+		{
+			String name = status == 0 ? String(demangled) : String(type.name());
+			free(demangled);
+			return name;
+		}
+#endif
+		return type.name();
+	}
+
+private:
+	bool enabled_ = false;
+	DynamicArray<Pair<IProfiledEventDispatcher*, StringView>> dispatchers_;
+	DynamicArray<EventHandlerProfile> profiles_;
+	DynamicArray<String> names_;
+};
+
+/// An event dispatcher that keeps its handlers in contiguous arrays sorted by priority, and ties by the order
+/// they were added in.  Handlers added or removed while an event is being dispatched are only queued, so
+/// dispatching never has to guard against the arrays changing under it; removed handlers are skipped at once,
+/// added ones take part from the next event.  Handler calls are timed while the profiler it's attached to is on.
+template <class EventHandlerType>
+class SortedEventDispatcher final : public IEventDispatcher<EventHandlerType>, public IProfiledEventDispatcher, public NoCopy
+{
+public:
+	void setProfiler(EventProfiler& profiler, StringView event)
+	{
+		profiler_ = &profiler;
+		profiler.add(*this, event);
+	}
+
+	bool addEventHandler(EventHandlerType* handler, event_order_t priority = EventPriority_Default) override
+	{
+		if (handler == nullptr || find(handler) != -1)
+		{
+			return false;
+		}
+
+		if (depth_)
+		{
+			auto itr = std::find_if(pending_.begin(), pending_.end(), [handler](const Pending& pending)
+				{
+					return pending.handler == handler;
+				});
+			if (itr != pending_.end())
+			{
+				return false;
+			}
+			pending_.push_back({ handler, priority });
+			return true;
+		}
+
+		insert(handler, priority);
+		return true;
+	}
+
+	bool removeEventHandler(EventHandlerType* handler) override
+	{
+		const int index = find(handler);
+		if (index != -1)
+		{
+			if (depth_)
+			{
+				// Leave a hole to skip over until the dispatch finishes.
+				handlers_[index] = nullptr;
+				dirty_ = true;
+			}
+			else
+			{
+				erase(index);
+			}
+			return true;
+		}
+
+		auto itr = std::find_if(pending_.begin(), pending_.end(), [handler](const Pending& pending)
+			{
+				return pending.handler == handler;
+			});
+		if (itr != pending_.end())
+		{
+			pending_.erase(itr);
+			return true;
+		}
+		return false;
+	}
+
+	bool hasEventHandler(EventHandlerType* handler, event_order_t& priority) override
+	{
+		const int index = find(handler);
+		if (index != -1)
+		{
+			priority = priorities_[index];
+			return true;
+		}
+		for (const Pending& pending : pending_)
+		{
+			if (pending.handler == handler)
+			{
+				priority = pending.priority;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	size_t count() const override
+	{
+		return size_t(std::count_if(handlers_.begin(), handlers_.end(), [](EventHandlerType* handler)
+				   {
+					   return handler != nullptr;
+				   }))
+			+ pending_.size();
+	}
+
+	template <typename Return, typename... Params, typename... Args>
+	void dispatch(Return (EventHandlerType::*mf)(Params...), Args&&... args)
+	{
+		all([&](EventHandlerType* handler)
+			{
+				(handler->*mf)(args...);
+			});
+	}
+
+	template <typename Fn>
+	void all(Fn fn)
+	{
+		DispatchScope scope(*this);
+		const bool profile = profiling();
+		for (size_t i = 0, size = handlers_.size(); i != size; ++i)
+		{
+			if (handlers_[i])
+			{
+				call(i, fn, profile);
+			}
+		}
+	}
+
+	/// Call handlers until one returns false, true if none did
+	template <typename Fn>
+	bool stopAtFalse(Fn fn)
+	{
+		DispatchScope scope(*this);
+		const bool profile = profiling();
+		for (size_t i = 0, size = handlers_.size(); i != size; ++i)
+		{
+			if (handlers_[i] && !call(i, fn, profile))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// Call handlers until one returns true, false if none did
+	template <typename Fn>
+	bool stopAtTrue(Fn fn)
+	{
+		DispatchScope scope(*this);
+		const bool profile = profiling();
+		for (size_t i = 0, size = handlers_.size(); i != size; ++i)
+		{
+			if (handlers_[i] && call(i, fn, profile))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/// Call every handler, true if any of them returned true
+	template <typename Fn>
+	bool anyTrue(Fn fn)
+	{
+		DispatchScope scope(*this);
+		const bool profile = profiling();
+		bool ret = false;
+		for (size_t i = 0, size = handlers_.size(); i != size; ++i)
+		{
+			if (handlers_[i])
+			{
+				ret |= static_cast<bool>(call(i, fn, profile));
+			}
+		}
+		return ret;
+	}
+
+	void collectProfile(StringView event, DynamicArray<EventHandlerProfile>& profiles, DynamicArray<String>& names) const override
+	{
+		for (size_t i = 0; i != handlers_.size(); ++i)
+		{
+			if (handlers_[i])
+			{
+				const Cost& cost = costs_[i];
+				profiles.push_back({ event, StringView(), priorities_[i], cost.calls, cost.nanoseconds, cost.maxNanoseconds });
+				names.push_back(EventProfiler::getHandlerName(typeid(*handlers_[i])));
+			}
+		}
+	}
+
+	void resetProfile() override
+	{
+		std::fill(costs_.begin(), costs_.end(), Cost());
+	}
+
+private:
+	struct Pending
+	{
+		EventHandlerType* handler;
+		event_order_t priority;
+	};
+
+	struct Cost
+	{
+		uint64_t calls = 0;
+		uint64_t nanoseconds = 0;
+		uint64_t maxNanoseconds = 0;
+	};
+
+	/// Times a handler call when the profiler is on
+	struct CostScope
+	{
+		Cost* cost;
+		std::chrono::steady_clock::time_point start;
+
+		CostScope(Cost* cost)
+			: cost(cost)
+		{
+			if (cost)
+			{
+				start = std::chrono::steady_clock::now();
+			}
+		}
+
+		~CostScope()
+		{
+			if (cost)
+			{
+				const uint64_t time = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+				++cost->calls;
+				cost->nanoseconds += time;
+				cost->maxNanoseconds = std::max(cost->maxNanoseconds, time);
+			}
+		}
+	};
+
+	/// Tracks nested dispatches, and applies the queued changes once the outermost one finishes
+	struct DispatchScope
+	{
+		SortedEventDispatcher& dispatcher;
+
+		DispatchScope(SortedEventDispatcher& dispatcher)
+			: dispatcher(dispatcher)
+		{
+			++dispatcher.depth_;
+		}
+
+		~DispatchScope()
+		{
+			if (--dispatcher.depth_ == 0 && (dispatcher.dirty_ || !dispatcher.pending_.empty()))
+			{
+				dispatcher.flush();
+			}
+		}
+	};
+
+	bool profiling() const
+	{
+		return profiler_ && profiler_->enabled();
+	}
+
+	template <typename Fn>
+	decltype(auto) call(size_t index, Fn& fn, bool profile)
+	{
+		// The arrays can't be reallocated during a dispatch, so the cost entry stays put.
+		CostScope scope(profile ? &costs_[index] : nullptr);
+		return fn(handlers_[index]);
+	}
+
+	int find(EventHandlerType* handler) const
+	{
+		if (handler == nullptr)
+		{
+			return -1;
+		}
+		auto itr = std::find(handlers_.begin(), handlers_.end(), handler);
+		return itr == handlers_.end() ? -1 : int(itr - handlers_.begin());
+	}
+
+	void insert(EventHandlerType* handler, event_order_t priority)
+	{
+		const size_t index = size_t(std::upper_bound(priorities_.begin(), priorities_.end(), priority) - priorities_.begin());
+		handlers_.insert(handlers_.begin() + index, handler);
+		priorities_.insert(priorities_.begin() + index, priority);
+		costs_.insert(costs_.begin() + index, Cost());
+	}
+
+	void erase(size_t index)
+	{
+		handlers_.erase(handlers_.begin() + index);
+		priorities_.erase(priorities_.begin() + index);
+		costs_.erase(costs_.begin() + index);
+	}
+
+	void flush()
+	{
+		if (dirty_)
+		{
+			dirty_ = false;
+			for (size_t i = handlers_.size(); i--;)
+			{
+				if (handlers_[i] == nullptr)
+				{
+					erase(i);
+				}
+			}
+		}
+
+		// Moved out first, in case a handler somehow manages to add more in the meantime.
+		DynamicArray<Pending> pending;
+		pending.swap(pending_);
+		for (const Pending& add : pending)
+		{
+			insert(add.handler, add.priority);
+		}
+	}
+
+	DynamicArray<EventHandlerType*> handlers_;
+	DynamicArray<event_order_t> priorities_;
+	DynamicArray<Cost> costs_;
+	DynamicArray<Pending> pending_;
+	EventProfiler* profiler_ = nullptr;
+	unsigned depth_ = 0;
+	bool dirty_ = false;
+};
@@ -0,0 +1,211 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <player.hpp>
+#include <types.hpp>
+#include <algorithm>
+#include <cctype>
+
+using namespace Impl;
+
+/// Case-folded names, hashed for exact lookups and in a trie for prefixes
+template <typename Entry>
+class NameIndex
+{
+public:
+	using FoldedName = HybridString<MAX_PLAYER_NAME + 1>;
+
+	static FoldedName fold(StringView name)
+	{
+		FoldedName folded;
+		char buffer[MAX_PLAYER_NAME + 1];
+		// Valid names are never longer than this, anything longer can't match one anyway.
+		const size_t length = std::min(name.length(), sizeof(buffer));
+		for (size_t i = 0; i != length; ++i)
+		{
+			buffer[i] = char(std::tolower(static_cast<unsigned char>(name[i])));
+		}
+		folded = StringView(buffer, length);
+		return folded;
+	}
+
+	NameIndex()
+	{
+		nodes_.emplace_back();
+	}
+
+	void add(StringView name, Entry& entry)
+	{
+		const FoldedName folded = fold(name);
+		const StringView key = folded;
+		entries_[String(key)] = &entry;
+
+		uint32_t node = 0;
+		++nodes_[node].count;
+		for (char c : key)
+		{
+			uint32_t child = findChild(node, c);
+			if (child == InvalidNode)
+			{
+				child = allocateNode();
+				// Children stay in character order, so prefix searches come out sorted.
+				auto& children = nodes_[node].children;
+				children.emplace(std::find_if(children.begin(), children.end(),
+									 [c](const Pair<char, uint32_t>& other)
+									 {
+										 return static_cast<unsigned char>(other.first) > static_cast<unsigned char>(c);
+									 }),
+					c, child);
+			}
+			node = child;
+			++nodes_[node].count;
+		}
+		nodes_[node].entry = &entry;
+	}
+
+	void remove(StringView name, Entry& entry)
+	{
+		const FoldedName folded = fold(name);
+		const StringView key = folded;
+		auto it = entries_.find(String(key));
+		if (it == entries_.end() || it->second != &entry)
+		{
+			return;
+		}
+		entries_.erase(it);
+
+		// Walk down once to find the path, then prune the branches nobody uses any more on the way back up.
+		StaticArray<uint32_t, MAX_PLAYER_NAME + 2> path;
+		size_t depth = 0;
+		uint32_t node = 0;
+		path[depth++] = node;
+		for (char c : key)
+		{
+			node = findChild(node, c);
+			if (node == InvalidNode)
+			{
+				return;
+			}
+			path[depth++] = node;
+		}
+		nodes_[node].entry = nullptr;
+
+		for (size_t i = 0; i != depth; ++i)
+		{
+			--nodes_[path[i]].count;
+		}
+
+		for (size_t i = depth - 1; i != 0; --i)
+		{
+			const uint32_t current = path[i];
+			if (nodes_[current].count != 0)
+			{
+				break;
+			}
+
+			auto& siblings = nodes_[path[i - 1]].children;
+			siblings.erase(std::find_if(siblings.begin(), siblings.end(),
+				[current](const Pair<char, uint32_t>& child)
+				{
+					return child.second == current;
+				}));
+			nodes_[current].children.clear();
+			freeNodes_.push_back(current);
+		}
+	}
+
+	Entry* get(StringView name) const
+	{
+		const FoldedName folded = fold(name);
+		auto it = entries_.find(String(StringView(folded)));
+		return it == entries_.end() ? nullptr : it->second;
+	}
+
+	size_t findByPrefix(StringView prefix, Entry** output, size_t capacity) const
+	{
+		const FoldedName folded = fold(prefix);
+		uint32_t node = 0;
+		for (char c : StringView(folded))
+		{
+			node = findChild(node, c);
+			if (node == InvalidNode)
+			{
+				return 0;
+			}
+		}
+
+		const size_t total = nodes_[node].count;
+		size_t written = 0;
+		if (capacity == 0)
+		{
+			return total;
+		}
+
+		DynamicArray<uint32_t> stack;
+		stack.push_back(node);
+		while (!stack.empty() && written < capacity)
+		{
+			const Node& current = nodes_[stack.back()];
+			stack.pop_back();
+			if (current.entry)
+			{
+				output[written++] = current.entry;
+			}
+
+			// Pushed backwards so the first child is visited first.
+			for (auto it = current.children.rbegin(); it != current.children.rend(); ++it)
+			{
+				stack.push_back(it->second);
+			}
+		}
+		return total;
+	}
+
+private:
+	static constexpr uint32_t InvalidNode = UINT32_MAX;
+
+	struct Node
+	{
+		DynamicArray<Pair<char, uint32_t>> children;
+		Entry* entry = nullptr; ///< The entry whose whole name ends here
+		uint32_t count = 0; ///< Names at or below this node
+	};
+
+	uint32_t findChild(uint32_t node, char c) const
+	{
+		for (const auto& child : nodes_[node].children)
+		{
+			if (child.first == c)
+			{
+				return child.second;
+			}
+		}
+		return InvalidNode;
+	}
+
+	uint32_t allocateNode()
+	{
+		if (!freeNodes_.empty())
+		{
+			const uint32_t node = freeNodes_.back();
+			freeNodes_.pop_back();
+			return node;
+		}
+		nodes_.emplace_back();
+		return uint32_t(nodes_.size() - 1);
+	}
+
+	FlatHashMap<String, Entry*> entries_;
+	DynamicArray<Node> nodes_;
+	DynamicArray<uint32_t> freeNodes_;
+};
+
+/// Connected players by name
+using PlayerNameIndex = NameIndex<IPlayer>;
@@ -42,6 +42,7 @@ EPlayerNameStatus Player::setName(StringView name)
 
 	const auto oldName = name_;
 	name_ = name;
+	pool_.onNameChanged(*this, oldName);
 	pool_.playerChangeDispatcher.dispatch(&PlayerChangeEventHandler::onPlayerNameChange, *this, oldName);
 
 	NetCode::RPC::SetPlayerName setPlayerNameRPC;
@@ -127,7 +128,7 @@ IObject* Player::getCameraTargetObject()
 
 	if (!object)
 	{
-		IPlayerObjectData* data = queryExtension<IPlayerObjectData>(this);
+		IPlayerObjectData* data = querySlotExtension<IPlayerObjectData>();
 
 		if (data)
 		{
@@ -210,6 +211,7 @@ void Player::setState(PlayerState state, bool dispatchEvents)
 	{
 		PlayerState oldstate = state_;
 		state_ = state;
+		updateHotState();
 		if (dispatchEvents)
 		{
 			pool_.playerChangeDispatcher.dispatch(&PlayerChangeEventHandler::onPlayerStateChange, *this, state, oldstate);
@@ -222,6 +224,7 @@ void Player::setScore(int score)
 	if (score_ != score)
 	{
 		score_ = score;
+		pool_.scoresAndPingsDirty = true;
 		pool_.playerChangeDispatcher.dispatch(&PlayerChangeEventHandler::onPlayerScoreChange, *this, score);
 	}
 }
@@ -240,7 +243,7 @@ void Player::streamInForPlayer(IPlayer& other)
 			playerStreamInRPC.PlayerID = poolID;
 
 			playerStreamInRPC.Skin = skin_;
-			if (auto models_data = queryExtension<IPlayerCustomModelsData>(this); models_data != nullptr)
+			if (auto models_data = querySlotExtension<IPlayerCustomModelsData>(); models_data != nullptr)
 			{
 				playerStreamInRPC.CustomSkin = models_data->getCustomSkin();
 			}
@@ -287,7 +290,7 @@ void Player::setSkin(int skin, bool send = true)
 		pool_.modelsComponent->getBaseModel(skin_, customSkin);
 	}
 
-	if (auto models_data = queryExtension<IPlayerCustomModelsData>(*this); models_data != nullptr)
+	if (auto models_data = querySlotExtension<IPlayerCustomModelsData>(); models_data != nullptr)
 	{
 		models_data->setCustomSkin(customSkin);
 	}
@@ -302,7 +305,7 @@ void Player::setSkin(int skin, bool send = true)
 	setPlayerSkinRPC.Skin = skin_;
 	setPlayerSkinRPC.CustomSkin = customSkin;
 
-	IPlayerVehicleData* data = queryExtension<IPlayerVehicleData>(*this);
+	IPlayerVehicleData* data = querySlotExtension<IPlayerVehicleData>();
 	if (data)
 	{
 		IVehicle* vehicle = data->getVehicle();
@@ -361,6 +364,25 @@ void Player::streamOutForPlayer(IPlayer& other)
 	}
 }
 
+void Player::broadcastSyncPacket(Span<uint8_t> data, int channel, SyncLODKind kind) const
+{
+	const uint32_t sequence = syncLODSequence_[kind]++;
+	for (IPlayer* p : streamedFor_.entries())
+	{
+		Player* player = static_cast<Player*>(p);
+		if (player == this)
+		{
+			continue;
+		}
+
+		const Vector3 distVec = pos_ - player->pos_;
+		if (pool_.syncLOD.shouldSend(kind, glm::dot(distVec, distVec), player->syncCongested_, sequence, player->poolID))
+		{
+			player->sendPacket(data, channel);
+		}
+	}
+}
+
 void Player::kick()
 {
 	if (pool_.npcsComponent_ && pool_.npcsComponent_->get(poolID))
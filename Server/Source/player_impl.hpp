@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "position_history.hpp"
+#include "sync_lod.hpp"
 #include <Impl/pool_impl.hpp>
 #include <Server/Components/Actors/actors.hpp>
 #include <Server/Components/Classes/classes.hpp>
@@ -18,6 +20,7 @@
 #include <Server/Components/Fixes/fixes.hpp>
 #include <events.hpp>
 #include <glm/glm.hpp>
+#include <hot_state.hpp>
 #include <netcode.hpp>
 #include <network.hpp>
 #include <player.hpp>
@@ -53,6 +56,59 @@ enum SecondarySyncUpdateType
 	SecondarySyncUpdateType_Trailer = (1 << 2),
 };
 
+/// Extensions the server looks up while handling sync, each gets a fixed index in the player
+enum PlayerExtensionSlot
+{
+	PlayerExtensionSlot_VehicleData,
+	PlayerExtensionSlot_ObjectData,
+	PlayerExtensionSlot_ClassData,
+	PlayerExtensionSlot_FixesData,
+	PlayerExtensionSlot_CustomModelsData,
+	PlayerExtensionSlot_Count,
+	PlayerExtensionSlot_None = -1
+};
+
+template <class ExtensionT>
+struct PlayerExtensionSlotOf;
+
+#define PLAYER_EXTENSION_SLOT(Type, Index) \
+	template <>                           \
+	struct PlayerExtensionSlotOf<Type>    \
+	{                                     \
+		static constexpr int Slot = Index; \
+	};
+
+PLAYER_EXTENSION_SLOT(IPlayerVehicleData, PlayerExtensionSlot_VehicleData)
+PLAYER_EXTENSION_SLOT(IPlayerObjectData, PlayerExtensionSlot_ObjectData)
+PLAYER_EXTENSION_SLOT(IPlayerClassData, PlayerExtensionSlot_ClassData)
+PLAYER_EXTENSION_SLOT(IPlayerFixesData, PlayerExtensionSlot_FixesData)
+PLAYER_EXTENSION_SLOT(IPlayerCustomModelsData, PlayerExtensionSlot_CustomModelsData)
+
+#undef PLAYER_EXTENSION_SLOT
+
+/// Map an extension ID to its slot, only done when extensions are added or removed
+inline int getPlayerExtensionSlot(UID id)
+{
+	static const UID SlotIDs[PlayerExtensionSlot_Count] = {
+		IPlayerVehicleData::ExtensionIID,
+		IPlayerObjectData::ExtensionIID,
+		IPlayerClassData::ExtensionIID,
+		IPlayerFixesData::ExtensionIID,
+		IPlayerCustomModelsData::ExtensionIID,
+	};
+
+	for (int i = 0; i != PlayerExtensionSlot_Count; ++i)
+	{
+		if (SlotIDs[i] == id)
+		{
+			return i;
+		}
+	}
+	return PlayerExtensionSlot_None;
+}
+
+using PlayerHotState = HotStateTable<PLAYER_POOL_SIZE>;
+
 struct Player final : public IPlayer, public PoolIDProvider, public NoCopy
 {
 	PlayerPool& pool_;
@@ -136,16 +192,87 @@ struct Player final : public IPlayer, public PoolIDProvider, public NoCopy
 
 	TimePoint lastScoresAndPings_;
 	bool kicked_;
+	/// Tells apart players who got the same ID, a later one is announced by its own connect instead
+	uint32_t connectSequence_;
+	/// IDs and connect sequences of the players who were here when this one joined and haven't been announced to them yet
+	DynamicArray<Pair<int, uint32_t>> pendingJoins_;
+	size_t pendingJoinsSent_;
+	/// What's left of this tick's join budget, shared with components, and the pool tick it was refilled on
+	size_t joinBudgetLeft_;
+	uint32_t joinBudgetTick_;
+	/// Ticks the join announcements were spread over, for the join report
+	uint32_t joinSyncTicks_;
+	TimePoint connectedAt_;
+	bool awaitingFirstSpawn_;
 	bool* allAnimationLibraries_;
 	bool* validateAnimations_;
 	bool* allowInteriorWeapons_;
 
 	IFixesComponent* fixesComponent_;
+	PositionHistory positionHistory_;
+	PlayerHotState& hotState_;
+	/// Sync packets broadcast so far of each kind, the sync LOD policy staggers peers against it
+	mutable StaticArray<uint32_t, SyncLODKind_End> syncLODSequence_;
+	/// Set while this player's own connection is over the sync LOD congestion budget
+	bool syncCongested_;
+	TimePoint lastSyncCongestionCheck_;
+
+	/// Mirrors the hashed extensions for the slotted types, the map stays the source of truth for everyone else
+	StaticArray<IExtension*, PlayerExtensionSlot_Count> extensionSlots_;
 
 	void clearExtensions()
 	{
 		freeExtensions();
 		miscExtensions.clear();
+		extensionSlots_.fill(nullptr);
+	}
+
+	bool addExtension(IExtension* extension, bool autoDeleteExt) override
+	{
+		if (!IExtensible::addExtension(extension, autoDeleteExt))
+		{
+			return false;
+		}
+
+		const int slot = getPlayerExtensionSlot(extension->getExtensionID());
+		if (slot != PlayerExtensionSlot_None)
+		{
+			extensionSlots_[slot] = extension;
+		}
+		return true;
+	}
+
+	bool removeExtension(IExtension* extension) override
+	{
+		const int slot = getPlayerExtensionSlot(extension->getExtensionID());
+		if (slot != PlayerExtensionSlot_None && extensionSlots_[slot] == extension)
+		{
+			extensionSlots_[slot] = nullptr;
+		}
+		return IExtensible::removeExtension(extension);
+	}
+
+	bool removeExtension(UID id) override
+	{
+		const int slot = getPlayerExtensionSlot(id);
+		if (slot != PlayerExtensionSlot_None)
+		{
+			extensionSlots_[slot] = nullptr;
+		}
+		return IExtensible::removeExtension(id);
+	}
+
+	/// The same as queryExtension for the slotted types, without hashing the ID
+	template <class ExtensionT>
+	ExtensionT* querySlotExtension() const
+	{
+		return static_cast<ExtensionT*>(extensionSlots_[PlayerExtensionSlotOf<ExtensionT>::Slot]);
+	}
+
+	/// Copy the fields streaming reads into the pool's hot state table, call after changing any of them
+	void updateHotState()
+	{
+		hotState_.set(poolID, pos_, virtualWorld_, interior_, uint8_t(state_));
 	}
 
 	void reset()
@@ -205,10 +332,12 @@ struct Player final : public IPlayer, public PoolIDProvider, public NoCopy
 		secondarySyncUpdateType_ = 0;
 		leavingSpec_ = false;
 		lastScoresAndPings_ = Time::now();
+		positionHistory_.clear();
+		updateHotState();
 		IExtensible::resetExtensions();
 	}
 
-	Player(PlayerPool& pool, const PeerNetworkData& netData, const PeerRequestParams& params, bool* allAnimationLibraries, bool* validateAnimations, bool* allowInteriorWeapons, IFixesComponent* fixesComponent)
+	Player(PlayerPool& pool, const PeerNetworkData& netData, const PeerRequestParams& params, bool* allAnimationLibraries, bool* validateAnimations, bool* allowInteriorWeapons, IFixesComponent* fixesComponent, PlayerHotState& hotState)
 		: pool_(pool)
 		, netData_(netData)
 		, version_(params.version)
@@ -268,13 +397,25 @@ struct Player final : public IPlayer, public PoolIDProvider, public NoCopy
 		, secondarySyncUpdateType_(0)
 		, lastScoresAndPings_(Time::now())
 		, kicked_(false)
+		, connectSequence_(0)
+		, pendingJoinsSent_(0)
+		, joinBudgetLeft_(0)
+		, joinBudgetTick_(UINT32_MAX)
+		, joinSyncTicks_(0)
+		, connectedAt_(Time::now())
+		, awaitingFirstSpawn_(true)
 		, allAnimationLibraries_(allAnimationLibraries)
 		, validateAnimations_(validateAnimations)
 		, allowInteriorWeapons_(allowInteriorWeapons)
 		, fixesComponent_(fixesComponent)
+		, hotState_(hotState)
+		, syncCongested_(false)
+		, lastSyncCongestionCheck_(Time::now())
 	{
+		syncLODSequence_.fill(0);
 		weapons_.fill({ 0, 0 });
 		skillLevels_.fill(MAX_SKILL_LEVEL);
+		extensionSlots_.fill(nullptr);
 	}
 
 	void ban(StringView reason) override;
@@ -290,7 +431,7 @@ struct Player final : public IPlayer, public PoolIDProvider, public NoCopy
 		}
 
 		// Reset player's vehicle related data
-		IPlayerVehicleData* vehicleData = queryExtension<IPlayerVehicleData>(*this);
+		IPlayerVehicleData* vehicleData = querySlotExtension<IPlayerVehicleData>();
 		if (vehicleData && vehicleData->getVehicle())
 		{
 			vehicleData->resetVehicle();
@@ -301,7 +442,7 @@ struct Player final : public IPlayer, public PoolIDProvider, public NoCopy
 		spectateData_.spectateID = INVALID_PLAYER_ID;
 
 		toSpawn_ = true;
-		IPlayerClassData* classData = queryExtension<IPlayerClassData>(*this);
+		IPlayerClassData* classData = querySlotExtension<IPlayerClassData>();
 		if (classData)
 		{
 			classData->spawnPlayer();
@@ -434,39 +575,16 @@ struct Player final : public IPlayer, public PoolIDProvider, public NoCopy
 		}
 	}
 
-	inline bool shouldSendSyncPacket(Player* other) const
-	{
-		const Vector3 distVec = pos_ - other->pos_;
-		const float distSqr = glm::dot(distVec, distVec);
-		if (distSqr < 250.f * 250.f)
-		{
-			return true;
-		}
-		else
-		{
-			// 50% probability
-			return rand() % 2 == 0;
-		}
-	}
-
 	/// Attempt to broadcast a packet derived from NetworkPacketBase to the player's streamed peers
 	/// @param packet The packet to send
 	void broadcastSyncPacket(Span<uint8_t> data, int channel) const override
 	{
-		for (IPlayer* p : streamedFor_.entries())
-		{
-			Player* player = static_cast<Player*>(p);
-			if (player == this)
-			{
-				continue;
-			}
-			if (shouldSendSyncPacket(player))
-			{
-				player->sendPacket(data, channel);
-			}
-		}
+		broadcastSyncPacket(data, channel, SyncLODKind_OnFoot);
 	}
 
+	/// Broadcast sync to the streamed peers at the rates the pool's sync LOD policy gives for this kind
+	void broadcastSyncPacket(Span<uint8_t> data, int channel, SyncLODKind kind) const;
+
 	void createExplosion(Vector3 vec, int type, float radius) override
 	{
 		NetCode::RPC::CreateExplosion createExplosionRPC;
@@ -685,7 +803,7 @@ struct Player final : public IPlayer, public PoolIDProvider, public NoCopy
 	{
 		PlayerState suspectState = suspect.getState();
 		IVehicle* vehicle = nullptr;
-		IPlayerVehicleData* data = queryExtension<IPlayerVehicleData>(suspect);
+		IPlayerVehicleData* data = static_cast<Player&>(suspect).querySlotExtension<IPlayerVehicleData>();
 		if (data)
 		{
 			vehicle = data->getVehicle();
@@ -743,7 +861,7 @@ private:
 		if (syncType == PlayerAnimationSyncType_NoSync)
 		{
 			PacketHelper::send(applyPlayerAnimationRPC, *this);
-			if (IPlayerFixesData* data = queryExtension<IPlayerFixesData>(*this))
+			if (IPlayerFixesData* data = querySlotExtension<IPlayerFixesData>())
 			{
 				data->applyAnimation(this, nullptr, &animation);
 			}
@@ -759,7 +877,7 @@ private:
 					continue;
 				}
 				PacketHelper::send(applyPlayerAnimationRPC, *player);
-				if (IPlayerFixesData* data = queryExtension<IPlayerFixesData>(*player))
+				if (IPlayerFixesData* data = static_cast<Player*>(player)->querySlotExtension<IPlayerFixesData>())
 				{
 					data->applyAnimation(this, nullptr, &animation);
 				}
@@ -802,7 +920,7 @@ public:
 
 	void clearAnimations(PlayerAnimationSyncType syncType) override
 	{
-		IPlayerVehicleData* data = queryExtension<IPlayerVehicleData>(*this);
+		IPlayerVehicleData* data = querySlotExtension<IPlayerVehicleData>();
 		AnimationData animationData(4.0f, false, false, false, false, 1, "", "");
 
 		if (data && data->getVehicle())
@@ -1115,12 +1233,15 @@ public:
 		removeParachute();
 
 		// Reset player's vehicle related data
-		IPlayerVehicleData* vehicleData = queryExtension<IPlayerVehicleData>(*this);
+		IPlayerVehicleData* vehicleData = querySlotExtension<IPlayerVehicleData>();
 		if (vehicleData && vehicleData->getVehicle())
 		{
 			vehicleData->resetVehicle();
 		}
 
+		// Don't interpolate shots across the teleport.
+		positionHistory_.clear();
+
 		// Set from sync
 		NetCode::RPC::SetPlayerPosition setPlayerPosRPC;
 		setPlayerPosRPC.Pos = position;
@@ -1202,12 +1323,15 @@ public:
 		removeParachute();
 
 		// Reset player's vehicle related data
-		IPlayerVehicleData* vehicleData = queryExtension<IPlayerVehicleData>(*this);
+		IPlayerVehicleData* vehicleData = querySlotExtension<IPlayerVehicleData>();
 		if (vehicleData && vehicleData->getVehicle())
 		{
 			vehicleData->resetVehicle();
 		}
 
+		// Don't interpolate shots across the teleport.
+		positionHistory_.clear();
+
 		// Set from sync
 		NetCode::RPC::SetPlayerPositionFindZ setPlayerPosRPC;
 		setPlayerPosRPC.Pos = position;
@@ -1474,7 +1598,7 @@ removeWeapon_has_weapon:
 
 	void sendGameText(StringView message, Milliseconds time, int style) override
 	{
-		if (IPlayerFixesData* data = queryExtension<IPlayerFixesData>(*this))
+		if (IPlayerFixesData* data = querySlotExtension<IPlayerFixesData>())
 		{
 			data->sendGameText(message, time, style);
 		}
@@ -1490,7 +1614,7 @@ removeWeapon_has_weapon:
 
 	void hideGameText(int style) override
 	{
-		if (IPlayerFixesData* data = queryExtension<IPlayerFixesData>(*this))
+		if (IPlayerFixesData* data = querySlotExtension<IPlayerFixesData>())
 		{
 			data->hideGameText(style);
 		}
@@ -1506,7 +1630,7 @@ removeWeapon_has_weapon:
 
 	bool hasGameText(int style) override
 	{
-		if (IPlayerFixesData* data = queryExtension<IPlayerFixesData>(*this))
+		if (IPlayerFixesData* data = querySlotExtension<IPlayerFixesData>())
 		{
 			return data->hasGameText(style);
 		}
@@ -1515,7 +1639,7 @@ removeWeapon_has_weapon:
 
 	bool getGameText(int style, StringView& message, Milliseconds& time, Milliseconds& remaining) override
 	{
-		if (IPlayerFixesData* data = queryExtension<IPlayerFixesData>(*this))
+		if (IPlayerFixesData* data = querySlotExtension<IPlayerFixesData>())
 		{
 			data->getGameText(style, message, time, remaining);
 			return true;
@@ -1536,6 +1660,7 @@ removeWeapon_has_weapon:
 		}
 
 		virtualWorld_ = vw;
+		updateHotState();
 
 		if (version_ == ClientVersion::ClientVersion_SAMP_037)
 			return;
@@ -1632,6 +1757,7 @@ removeWeapon_has_weapon:
 
 		setState(PlayerState_Spectating);
 		pos_ = target.getPosition();
+		updateHotState();
 		target.streamInForPlayer(*this);
 
 		spectateData_.type = PlayerSpectateData::ESpectateType::Player;
@@ -1659,6 +1785,7 @@ removeWeapon_has_weapon:
 
 		setState(PlayerState_Spectating);
 		pos_ = target.getPosition();
+		updateHotState();
 		target.streamInForPlayer(*this);
 
 		spectateData_.type = PlayerSpectateData::ESpectateType::Vehicle;
@@ -8,28 +8,128 @@
 
 #pragma once
 
+#include "event_dispatcher.hpp"
+#include "name_index.hpp"
 #include "player_impl.hpp"
+#include "sync_validation.hpp"
+#include <join_budget.hpp>
+#include <player_name_index.hpp>
+#include <player_rewind.hpp>
+#include <sync_injection.hpp>
 #include <Server/Components/Console/console.hpp>
 #include <Server/Components/NPCs/npcs.hpp>
 #include <utils.hpp>
 
-struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public PlayerUpdateEventHandler, public CoreEventHandler
+/// Exposes the pool's name index to components through queryExtension
+struct PlayerNameIndexExtension final : public IPlayerNameIndexExtension
+{
+	PlayerNameIndex index;
+
+	IPlayer* getPlayerByName(StringView name) const override
+	{
+		return index.get(name);
+	}
+
+	size_t findPlayersByNamePrefix(StringView prefix, IPlayer** output, size_t capacity) const override
+	{
+		return index.findByPrefix(prefix, output, capacity);
+	}
+
+	void freeExtension() override
+	{
+		// Owned by the pool.
+	}
+
+	void reset() override
+	{
+	}
+};
+
+/// Exposes the players' position histories to components through queryExtension
+struct PlayerRewindExtension final : public IPlayerRewindExtension
+{
+	bool getPlayerPositionAt(IPlayer& player, TimePoint time, Vector3& position) const override
+	{
+		return static_cast<Player&>(player).positionHistory_.getPositionAt(time, position);
+	}
+
+	bool wasPlayerNearLine(IPlayer& player, Vector3 from, Vector3 to, float radius, TimePoint time) const override
+	{
+		Vector3 position;
+		if (!getPlayerPositionAt(player, time, position))
+		{
+			// The history doesn't go back that far, where they are now is the best guess.
+			position = player.getPosition();
+		}
+
+		const Vector3 line = to - from;
+		const float lengthSquared = glm::dot(line, line);
+		const float along = lengthSquared > 0.0f ? glm::clamp(glm::dot(position - from, line) / lengthSquared, 0.0f, 1.0f) : 0.0f;
+		return glm::distance(from + line * along, position) <= radius;
+	}
+
+	void freeExtension() override
+	{
+		// Owned by the pool.
+	}
+
+	void reset() override
+	{
+	}
+};
+
+/// Hands out the players' join budgets to the pool and to components through queryExtension
+struct PlayerJoinBudgetExtension final : public IPlayerJoinBudgetExtension
+{
+	int* budget = nullptr;
+	/// Counts the pool's ticks, a player's budget is refilled the first time it's asked for in each
+	uint32_t tick = 0;
+
+	size_t takeJoinBudget(IPlayer& peer, size_t wanted) override
+	{
+		if (budget == nullptr || *budget <= 0)
+		{
+			return wanted;
+		}
+
+		Player& player = static_cast<Player&>(peer);
+		if (player.joinBudgetTick_ != tick)
+		{
+			player.joinBudgetTick_ = tick;
+			player.joinBudgetLeft_ = size_t(*budget);
+		}
+		const size_t taken = std::min(wanted, player.joinBudgetLeft_);
+		player.joinBudgetLeft_ -= taken;
+		return taken;
+	}
+
+	void freeExtension() override
+	{
+		// Owned by the pool.
+	}
+
+	void reset() override
+	{
+	}
+};
+
+struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public PlayerUpdateEventHandler, public CoreEventHandler, public NetCode::ISyncInjector
 {
 	ICore& core;
 	const FlatPtrHashSet<INetwork>& networks;
 	PoolStorage<Player, IPlayer, 0, PLAYER_POOL_SIZE> storage;
 	FlatPtrHashSet<IPlayer> playerList;
 	FlatPtrHashSet<IPlayer> botList;
-	DefaultEventDispatcher<PlayerSpawnEventHandler> playerSpawnDispatcher;
-	DefaultEventDispatcher<PlayerConnectEventHandler> playerConnectDispatcher;
-	DefaultEventDispatcher<PlayerStreamEventHandler> playerStreamDispatcher;
-	DefaultEventDispatcher<PlayerTextEventHandler> playerTextDispatcher;
-	DefaultEventDispatcher<PlayerShotEventHandler> playerShotDispatcher;
-	DefaultEventDispatcher<PlayerChangeEventHandler> playerChangeDispatcher;
-	DefaultEventDispatcher<PlayerDamageEventHandler> playerDamageDispatcher;
-	DefaultEventDispatcher<PlayerClickEventHandler> playerClickDispatcher;
-	DefaultEventDispatcher<PlayerCheckEventHandler> playerCheckDispatcher;
-	DefaultEventDispatcher<PlayerUpdateEventHandler> playerUpdateDispatcher;
+	SortedEventDispatcher<PlayerSpawnEventHandler> playerSpawnDispatcher;
+	SortedEventDispatcher<PlayerConnectEventHandler> playerConnectDispatcher;
+	SortedEventDispatcher<PlayerStreamEventHandler> playerStreamDispatcher;
+	SortedEventDispatcher<PlayerTextEventHandler> playerTextDispatcher;
+	SortedEventDispatcher<PlayerShotEventHandler> playerShotDispatcher;
+	SortedEventDispatcher<PlayerChangeEventHandler> playerChangeDispatcher;
+	SortedEventDispatcher<PlayerDamageEventHandler> playerDamageDispatcher;
+	SortedEventDispatcher<PlayerClickEventHandler> playerClickDispatcher;
+	SortedEventDispatcher<PlayerCheckEventHandler> playerCheckDispatcher;
+	SortedEventDispatcher<PlayerUpdateEventHandler> playerUpdateDispatcher;
 	IVehiclesComponent* vehiclesComponent = nullptr;
 	IObjectsComponent* objectsComponent = nullptr;
 	IActorsComponent* actorsComponent = nullptr;
@@ -38,6 +138,13 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 	IFixesComponent* fixesComponent_ = nullptr;
 	INPCComponent* npcsComponent_ = nullptr;
 	StreamConfigHelper streamConfigHelper;
+	PlayerNameIndexExtension nameIndex;
+	PlayerRewindExtension rewind;
+	PlayerJoinBudgetExtension joinBudget;
+	PlayerHotState hotState;
+	/// Scratch for the streaming scan, which of the other players are in range
+	StaticArray<uint8_t, PLAYER_POOL_SIZE> streamInRange;
+	SyncLODPolicy syncLOD;
 	int* markersShow;
 	int* markersUpdateRate;
 	bool* markersLimit;
@@ -49,7 +156,19 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 	bool* logConnectionMessages_;
 	int* maxBots;
 	StaticArray<bool, 256> allowNickCharacter;
+	int* scoresAndPingsRate;
+	/// Handed out to players as they connect, see Player::connectSequence_
+	uint32_t connectSequence = 0;
+	/// The scoreboard RPC payload, encoded once and sent as is to everyone who asks for it
+	NetworkBitStream scoresAndPingsCache;
 	TimePoint lastScoresAndPingsCached;
+	bool scoresAndPingsDirty = true;
+
+	/// Pings change without telling anyone, so the cache can't get older than this even when nothing is dirty
+	static constexpr Seconds ScoresAndPingsMaxAge = Seconds(3);
+
+	/// How often a receiver's send queue and bandwidth are checked against the sync LOD budgets
+	static constexpr Seconds SyncCongestionCheckRate = Seconds(1);
 
 	struct PlayerRequestSpawnRPCHandler : public SingleNetworkInEventHandler
 	{
@@ -102,11 +221,8 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 			// But not every client is the official one... so I guess we need a hard limit for player here as well
 			if (now - player.lastScoresAndPings_ >= Seconds(3))
 			{
-				// There is also a cache tick diff we are sending to SendPlayerScoresAndPings constructor to use in SendPlayerScoresAndPings::write
-				// This is added to make sure we have a global cache and we don't recalculate and regenerate for every player and every request of theirs
-				// So instead it keeps a cache of our bitstream to use, which won't loop through player pool and gathering data
-				NetCode::RPC::SendPlayerScoresAndPings sendPlayerScoresAndPingsRPC(self.storage.entries(), now - self.lastScoresAndPingsCached);
-				PacketHelper::send(sendPlayerScoresAndPingsRPC, peer);
+				NetworkBitStream& cache = self.getScoresAndPings(now);
+				peer.sendRPC(NetCode::RPC::SendPlayerScoresAndPings::PacketID, Span<uint8_t>(cache.GetData(), cache.GetNumberOfBitsUsed()), NetCode::RPC::SendPlayerScoresAndPings::PacketChannel);
 				player.lastScoresAndPings_ = now;
 			}
 			return true;
@@ -311,6 +427,7 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 
 			uint32_t oldInterior = player.interior_;
 			player.interior_ = onPlayerInteriorChangeRPC.Interior;
+			player.updateHotState();
 
 			if (oldInterior == player.interior_)
 			{
@@ -458,15 +575,17 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 			Player& player = static_cast<Player&>(peer);
 			if (player.toSpawn_ || player.isBot_)
 			{
+				self.flushPendingJoins(player);
 				player.setState(PlayerState_Spawned);
 				player.controllable_ = true;
 				player.leavingSpec_ = false;
 
-				IPlayerClassData* classData = queryExtension<IPlayerClassData>(peer);
+				IPlayerClassData* classData = player.querySlotExtension<IPlayerClassData>();
 				if (classData)
 				{
 					const PlayerClass& cls = classData->getClass();
 					player.pos_ = cls.spawn;
+					player.updateHotState();
 					player.rot_ = GTAQuat(0.f, 0.f, cls.angle) * player.rotTransform_;
 					player.setSkin(cls.skin, false);
 
@@ -497,6 +616,7 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 				}
 
 				self.playerSpawnDispatcher.dispatch(&PlayerSpawnEventHandler::onPlayerSpawn, peer);
+				self.reportFirstSpawn(player);
 			}
 
 			return true;
@@ -678,6 +798,15 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 			{
 				return false;
 			}
+			return apply(peer, footSync);
+		}
+
+		bool apply(IPlayer& peer, NetCode::Packet::PlayerFootSync& footSync)
+		{
+			if (!SyncValidation::isValid(footSync))
+			{
+				return false;
+			}
 
 			Player& player = static_cast<Player&>(peer);
 
@@ -691,11 +820,13 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 			footSync.Rotation *= player.rotTransform_;
 
 			player.pos_ = footSync.Position;
+			self.hotState.setPosition(player.poolID, player.pos_);
 			player.rot_ = footSync.Rotation;
 			player.health_ = footSync.HealthArmour.x;
 			player.armour_ = footSync.HealthArmour.y;
 			player.armedWeapon_ = player.areWeaponsAllowed() ? footSync.Weapon : 0;
 			player.velocity_ = footSync.Velocity;
+			player.positionHistory_.push(Time::now(), footSync.Position, footSync.Velocity);
 			player.animation_.ID = footSync.AnimationID;
 			player.animation_.flags = footSync.AnimationFlags;
 
@@ -704,7 +835,7 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 				&& self.objectsComponent->get(footSync.SurfingData.ID) == nullptr)
 			{
 
-				IPlayerObjectData* player_data = queryExtension<IPlayerObjectData>(player);
+				IPlayerObjectData* player_data = player.querySlotExtension<IPlayerObjectData>();
 
 				if (player_data != nullptr && player_data->get(footSync.SurfingData.ID) != nullptr)
 				{
@@ -818,6 +949,7 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 			uint32_t newKeys = spectatorSync.Keys;
 
 			player.pos_ = spectatorSync.Position;
+			self.hotState.setPosition(player.poolID, player.pos_);
 
 			player.keys_.leftRight = spectatorSync.LeftRight;
 			player.keys_.upDown = spectatorSync.UpDown;
@@ -859,6 +991,15 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 			{
 				return false;
 			}
+			return apply(peer, aimSync);
+		}
+
+		bool apply(IPlayer& peer, NetCode::Packet::PlayerAimSync& aimSync)
+		{
+			if (!SyncValidation::isValid(aimSync))
+			{
+				return false;
+			}
 
 			const float frontvec = glm::dot(aimSync.CamFrontVector, aimSync.CamFrontVector);
 			if (frontvec > 0.0 && frontvec < 1.5)
@@ -923,11 +1064,18 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 	struct PlayerBulletSyncHandler : public SingleNetworkInEventHandler
 	{
 		PlayerPool& self;
+		float* hitTolerance;
+
 		PlayerBulletSyncHandler(PlayerPool& self)
 			: self(self)
 		{
 		}
 
+		void init(IConfig& config)
+		{
+			hitTolerance = config.getFloat("game.bullet_hit_tolerance");
+		}
+
 		bool onReceive(IPlayer& peer, NetworkBitStream& bs) override
 		{
 			NetCode::Packet::PlayerBulletSync bulletSync;
@@ -965,8 +1113,8 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 					return false;
 				}
 
-				IPlayerVehicleData* data = queryExtension<IPlayerVehicleData>(player);
-				IPlayerVehicleData* otherData = queryExtension<IPlayerVehicleData>(*targetedplayer);
+				IPlayerVehicleData* data = player.querySlotExtension<IPlayerVehicleData>();
+				IPlayerVehicleData* otherData = targetedplayer->querySlotExtension<IPlayerVehicleData>();
 				if (data && otherData)
 				{
 					IVehicle* playerVehicle = data->getVehicle();
@@ -976,6 +1124,16 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 						return false;
 					}
 				}
+
+				// The shooter saw the target roughly a ping ago, they should have been somewhere near the shot then.
+				if (hitTolerance && *hitTolerance > 0.0f && !targetedplayer->positionHistory_.empty())
+				{
+					const TimePoint shotTime = Time::now() - Milliseconds(player.getPing());
+					if (!self.rewind.wasPlayerNearLine(*targetedplayer, bulletSync.Origin, bulletSync.HitPos, *hitTolerance, shotTime))
+					{
+						return false;
+					}
+				}
 			}
 			else if (bulletSync.HitType == PlayerBulletHitType_Vehicle)
 			{
@@ -991,7 +1149,7 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 						return false;
 					}
 
-					IPlayerVehicleData* data = queryExtension<IPlayerVehicleData>(player);
+					IPlayerVehicleData* data = player.querySlotExtension<IPlayerVehicleData>();
 					if (data)
 					{
 						if (data->getVehicle() == targetedVehicle)
@@ -1082,7 +1240,7 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 					else
 					{
 						player.bulletData_.hitType = PlayerBulletHitType_PlayerObject;
-						IPlayerObjectData* data = queryExtension<IPlayerObjectData>(peer);
+						IPlayerObjectData* data = player.querySlotExtension<IPlayerObjectData>();
 						if (data)
 						{
 							ScopedPoolReleaseLock lock(*data, player.bulletData_.hitID);
@@ -1125,6 +1283,15 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 			{
 				return false;
 			}
+			return apply(peer, vehicleSync);
+		}
+
+		bool apply(IPlayer& peer, NetCode::Packet::PlayerVehicleSync& vehicleSync)
+		{
+			if (!self.vehiclesComponent || !SyncValidation::isValid(vehicleSync))
+			{
+				return false;
+			}
 
 			IVehicle* vehiclePtr = self.vehiclesComponent->get(vehicleSync.VehicleID);
 			if (!vehiclePtr)
@@ -1150,6 +1317,8 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 			}
 
 			player.pos_ = vehicleSync.Position;
+			self.hotState.setPosition(player.poolID, player.pos_);
+			player.positionHistory_.push(Time::now(), vehicleSync.Position, vehicleSync.Velocity);
 			player.health_ = vehicleSync.PlayerHealthArmour.x;
 			player.armour_ = vehicleSync.PlayerHealthArmour.y;
 			player.armedWeapon_ = player.areWeaponsAllowed() ? vehicleSync.WeaponID : 0;
@@ -1374,6 +1543,15 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 			{
 				return false;
 			}
+			return apply(peer, passengerSync);
+		}
+
+		bool apply(IPlayer& peer, NetCode::Packet::PlayerPassengerSync& passengerSync)
+		{
+			if (!self.vehiclesComponent || !SyncValidation::isValid(passengerSync))
+			{
+				return false;
+			}
 
 			// Avoid processing if received seat id is for driver's
 			if (passengerSync.SeatID == 0)
@@ -1412,6 +1590,8 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 			}
 
 			player.pos_ = vehicle.getPosition();
+			self.hotState.setPosition(player.poolID, player.pos_);
+			player.positionHistory_.push(Time::now(), player.pos_, vehicle.getVelocity());
 			player.health_ = passengerSync.HealthArmour.x;
 			player.armour_ = passengerSync.HealthArmour.y;
 			player.armedWeapon_ = player.areWeaponsAllowed() ? passengerSync.WeaponID : 0;
@@ -1506,7 +1686,7 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 				return false;
 			}
 
-			IPlayerVehicleData* playerVehicleData = queryExtension<IPlayerVehicleData>(peer);
+			IPlayerVehicleData* playerVehicleData = player.querySlotExtension<IPlayerVehicleData>();
 
 			if (vehicle.getDriver() || !vehicle.isStreamedInForPlayer(peer))
 			{
@@ -1575,7 +1755,7 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 
 			Player& player = static_cast<Player&>(peer);
 			PlayerState state = player.getState();
-			IPlayerVehicleData* vehData = queryExtension<IPlayerVehicleData>(peer);
+			IPlayerVehicleData* vehData = player.querySlotExtension<IPlayerVehicleData>();
 			if (state != PlayerState_Driver || vehData == nullptr || vehData->getVehicle() == nullptr)
 			{
 				return false;
@@ -1739,7 +1919,7 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 			{
 				if (storage.get(index) == nullptr)
 				{
-					storage.claimHint(index, *this, netData, params, useAllAnimations_, validateAnimations_, allowInteriorWeapons_, fixesComponent_);
+					storage.claimHint(index, *this, netData, params, useAllAnimations_, validateAnimations_, allowInteriorWeapons_, fixesComponent_, hotState);
 					result = storage.get(index);
 					break;
 				}
@@ -1747,7 +1927,7 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 		}
 		else
 		{
-			result = storage.emplace(*this, netData, params, useAllAnimations_, validateAnimations_, allowInteriorWeapons_, fixesComponent_);
+			result = storage.emplace(*this, netData, params, useAllAnimations_, validateAnimations_, allowInteriorWeapons_, fixesComponent_, hotState);
 		}
 
 		if (!result)
@@ -1757,11 +1937,95 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 
 		auto& secondaryPool = result->isBot_ ? botList : playerList;
 		secondaryPool.emplace(result);
+		nameIndex.index.add(result->name_, *result);
+		result->updateHotState();
+		scoresAndPingsDirty = true;
 
 		initPlayer(*result);
 		return { NewConnectionResult_Success, result };
 	}
 
+	/// Rebuild the scoreboard payload if something changed, but never more often than the configured rate
+	NetworkBitStream& getScoresAndPings(TimePoint now)
+	{
+		const Milliseconds age = duration_cast<Milliseconds>(now - lastScoresAndPingsCached);
+		if ((scoresAndPingsDirty || age >= ScoresAndPingsMaxAge) && age >= Milliseconds(*scoresAndPingsRate))
+		{
+			scoresAndPingsCache.reset();
+			NetCode::RPC::SendPlayerScoresAndPings sendPlayerScoresAndPingsRPC(storage.entries());
+			sendPlayerScoresAndPingsRPC.write(scoresAndPingsCache);
+			lastScoresAndPingsCached = now;
+			scoresAndPingsDirty = false;
+		}
+		return scoresAndPingsCache;
+	}
+
+	/// Announce up to `budget` of the players who were here when this one joined
+	void sendPendingJoins(Player& player, size_t budget)
+	{
+		const size_t end = player.pendingJoinsSent_ + std::min(budget, player.pendingJoins_.size() - player.pendingJoinsSent_);
+		for (; player.pendingJoinsSent_ != end; ++player.pendingJoinsSent_)
+		{
+			// Anyone who left in the meantime was never announced, and anyone who took their ID has already been.
+			const Pair<int, uint32_t>& pending = player.pendingJoins_[player.pendingJoinsSent_];
+			Player* other = static_cast<Player*>(storage.get(pending.first));
+			if (other == nullptr || other == &player || other->connectSequence_ != pending.second)
+			{
+				continue;
+			}
+
+			NetCode::RPC::PlayerJoin otherJoinPacket;
+			otherJoinPacket.PlayerID = other->poolID;
+			otherJoinPacket.Col = other->colour_;
+			otherJoinPacket.IsNPC = other->isBot_;
+			otherJoinPacket.Name = StringView(other->name_);
+			PacketHelper::send(otherJoinPacket, player);
+		}
+		++player.joinSyncTicks_;
+
+		if (player.pendingJoinsSent_ == player.pendingJoins_.size())
+		{
+			player.pendingJoins_.clear();
+			player.pendingJoins_.shrink_to_fit();
+			player.pendingJoinsSent_ = 0;
+		}
+	}
+
+	/// Announce as many of them as this tick's join budget allows, components get whatever is left
+	void sendPendingJoins(Player& player)
+	{
+		sendPendingJoins(player, joinBudget.takeJoinBudget(player, player.pendingJoins_.size() - player.pendingJoinsSent_));
+	}
+
+	/// Everyone must be announced before the player can see them, stream in or spawn
+	void flushPendingJoins(Player& player)
+	{
+		if (!player.pendingJoins_.empty())
+		{
+			sendPendingJoins(player, SIZE_MAX);
+		}
+	}
+
+	/// Log how long it took from connecting to spawning the first time
+	void reportFirstSpawn(Player& player)
+	{
+		if (!player.awaitingFirstSpawn_)
+		{
+			return;
+		}
+		player.awaitingFirstSpawn_ = false;
+
+		if (logConnectionMessages_ && *logConnectionMessages_)
+		{
+			core.logLn(
+				LogLevel::Message,
+				"[join] %.*s reached spawn %lldms after connecting, other players announced over %u ticks",
+				PRINT_VIEW(player.name_),
+				(long long)duration_cast<Milliseconds>(Time::now() - player.connectedAt_).count(),
+				player.joinSyncTicks_);
+		}
+	}
+
 	void onPeerConnect(IPlayer& peer) override
 	{
 		Player& player = static_cast<Player&>(peer);
@@ -1783,6 +2047,8 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 			return;
 		}
 
+		player.connectSequence_ = ++connectSequence;
+
 		NetCode::RPC::PlayerJoin playerJoinPacket;
 		playerJoinPacket.PlayerID = player.poolID;
 		playerJoinPacket.Col = player.colour_;
@@ -1790,21 +2056,21 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 		playerJoinPacket.Name = StringView(player.name_);
 		PacketHelper::broadcastToSome(playerJoinPacket, storage.entries(), &peer);
 
+		// Everyone already here is announced to the newcomer a budget at a time over the next ticks, rather than
+		// thousands of reliable RPCs at once, and whatever is left is flushed before they can see anyone.
+		player.connectedAt_ = Time::now();
+		player.pendingJoins_.clear();
+		player.pendingJoins_.reserve(storage.entries().size());
 		for (IPlayer* other : storage.entries())
 		{
-			if (&peer == other)
+			if (&peer != other)
 			{
-				continue;
+				Player* otherPlayer = static_cast<Player*>(other);
+				player.pendingJoins_.emplace_back(otherPlayer->poolID, otherPlayer->connectSequence_);
 			}
-
-			Player* otherPlayer = static_cast<Player*>(other);
-			NetCode::RPC::PlayerJoin otherJoinPacket;
-			otherJoinPacket.PlayerID = otherPlayer->poolID;
-			otherJoinPacket.Col = otherPlayer->colour_;
-			otherJoinPacket.IsNPC = otherPlayer->isBot_;
-			otherJoinPacket.Name = StringView(otherPlayer->name_);
-			PacketHelper::send(otherJoinPacket, peer);
 		}
+		player.pendingJoinsSent_ = 0;
+		sendPendingJoins(player);
 
 		// Set player's time & weather to global ones.
 		IConfig& config = core.getConfig();
@@ -1888,6 +2154,9 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 
 		auto& secondaryPool = player.isBot_ ? botList : playerList;
 		secondaryPool.erase(&player);
+		nameIndex.index.remove(player.name_, player);
+		hotState.remove(player.poolID);
+		scoresAndPingsDirty = true;
 	}
 
 	void onPeerDisconnect(IPlayer& peer, PeerDisconnectReason reason) override
@@ -1897,10 +2166,25 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 		storage.remove(player.poolID);
 	}
 
+	/// Time the pool's event handlers with the core's profiler
+	void setEventProfiler(EventProfiler& profiler)
+	{
+		playerSpawnDispatcher.setProfiler(profiler, "PlayerSpawnEventHandler");
+		playerConnectDispatcher.setProfiler(profiler, "PlayerConnectEventHandler");
+		playerStreamDispatcher.setProfiler(profiler, "PlayerStreamEventHandler");
+		playerTextDispatcher.setProfiler(profiler, "PlayerTextEventHandler");
+		playerShotDispatcher.setProfiler(profiler, "PlayerShotEventHandler");
+		playerChangeDispatcher.setProfiler(profiler, "PlayerChangeEventHandler");
+		playerDamageDispatcher.setProfiler(profiler, "PlayerDamageEventHandler");
+		playerClickDispatcher.setProfiler(profiler, "PlayerClickEventHandler");
+		playerCheckDispatcher.setProfiler(profiler, "PlayerCheckEventHandler");
+		playerUpdateDispatcher.setProfiler(profiler, "PlayerUpdateEventHandler");
+	}
+
 	PlayerPool(ICore& core)
 		: core(core)
 		, networks(core.getNetworks())
-		, lastScoresAndPingsCached(Time::now())
+		, lastScoresAndPingsCached()
 		, playerRequestSpawnRPCHandler(*this)
 		, playerRequestScoresAndPingsRPCHandler(*this)
 		, onPlayerClickMapRPCHandler(*this)
@@ -1982,22 +2266,33 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 
 	bool isNameTaken(StringView name, const IPlayer* skip) override
 	{
-		const FlatPtrHashSet<IPlayer>& players = storage.entries();
-		return std::any_of(players.begin(), players.end(),
-			[&name, &skip](IPlayer* player)
-			{
-				// Don't check name for player to skip
-				if (player == skip)
-				{
-					return false;
-				}
-				StringView otherName = player->getName();
-				return std::equal(name.begin(), name.end(), otherName.begin(), otherName.end(),
-					[](const char& c1, const char& c2)
-					{
-						return std::tolower(c1) == std::tolower(c2);
-					});
-			});
+		// Don't check name for player to skip
+		IPlayer* player = nameIndex.index.get(name);
+		return player != nullptr && player != skip;
+	}
+
+	/// Rename a player in the name index, called after their name changes
+	void onNameChanged(Player& player, StringView oldName)
+	{
+		nameIndex.index.remove(oldName, player);
+		nameIndex.index.add(player.name_, player);
+	}
+
+	IExtension* getExtension(UID id) override
+	{
+		if (id == IPlayerNameIndexExtension::ExtensionIID)
+		{
+			return &nameIndex;
+		}
+		if (id == IPlayerRewindExtension::ExtensionIID)
+		{
+			return &rewind;
+		}
+		if (id == IPlayerJoinBudgetExtension::ExtensionIID)
+		{
+			return &joinBudget;
+		}
+		return IPlayerPool::getExtension(id);
 	}
 
 	void sendClientMessageToAll(const Colour& colour, StringView message) override
@@ -2083,14 +2378,18 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 	{
 		IConfig& config = core.getConfig();
 		streamConfigHelper = StreamConfigHelper(config);
+		syncLOD.init(config);
 		playerTextRPCHandler.init(config);
 		playerCommandRPCHandler.init(config);
 		playerDeathRPCHandler.init(config);
+		playerBulletSyncHandler.init(config);
 		markersShow = config.getInt("game.player_marker_mode");
 		markersLimit = config.getBool("game.use_player_marker_draw_radius");
 		markersLimitRadius = config.getFloat("game.player_marker_draw_radius");
 		markersUpdateRate = config.getInt("network.player_marker_sync_rate");
 		gameTimeUpdateRate = config.getInt("network.time_sync_rate");
+		scoresAndPingsRate = config.getInt("network.scores_and_pings_rate");
+		joinBudget.budget = config.getInt("network.join_sync_budget");
 		useAllAnimations_ = config.getBool("game.use_all_animations");
 		validateAnimations_ = config.getBool("game.validate_animations");
 		allowInteriorWeapons_ = config.getBool("game.allow_interior_weapons");
@@ -2124,6 +2423,33 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 		npcsComponent_ = components.queryComponent<INPCComponent>();
 	}
 
+	/// Encode a sync packet once and hand it to the sender to forward at the sync LOD rates for its kind
+	template <class Packet>
+	static void broadcastSync(const Packet& packet, Player& from, SyncLODKind kind)
+	{
+		NetworkBitStream bs;
+		bs.writeUINT8(Packet::PacketID);
+		packet.write(bs);
+		from.broadcastSyncPacket(Span<uint8_t>(bs.GetData(), bs.GetNumberOfBitsUsed()), Packet::PacketChannel, kind);
+	}
+
+	/// Sample a receiver's connection about once a second and flag it while it's over a sync LOD budget
+	void updateSyncCongestion(Player& player, TimePoint now)
+	{
+		if (!syncLOD.tracksCongestion())
+		{
+			player.syncCongested_ = false;
+			return;
+		}
+
+		if (now - player.lastSyncCongestionCheck_ < SyncCongestionCheckRate || !player.netData_.network)
+		{
+			return;
+		}
+		player.lastSyncCongestionCheck_ = now;
+		player.syncCongested_ = syncLOD.isCongested(player.netData_.network->getStatistics(&player));
+	}
+
 	bool onPlayerUpdate(IPlayer& p, TimePoint now) override
 	{
 		Player& player = static_cast<Player&>(p);
@@ -2133,6 +2459,7 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 		const bool shouldStream = streamConfigHelper.shouldStream(player.poolID, now);
 
 		player.updateGameTime(gameTimeUpdateRateMS, now);
+		updateSyncCongestion(player, now);
 
 		if (*markersShow == PlayerMarkerMode_Global)
 		{
@@ -2141,6 +2468,11 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 
 		if (shouldStream)
 		{
+			flushPendingJoins(player);
+
+			// Distances, worlds and states all come from the hot state table, the other players are only touched to stream them.
+			hotState.findInRange(Vector2(player.pos_), maxDist, player.virtualWorld_, streamInRange);
+
 			for (IPlayer* other : storage.entries())
 			{
 				if (&player == other)
@@ -2148,13 +2480,14 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 					continue;
 				}
 
-				Vector3 otherPos = other->getPosition();
-				const PlayerState state = other->getState();
+				const int otherID = static_cast<Player*>(other)->poolID;
+				const PlayerState state = PlayerState(hotState.getState(otherID));
+				bool inRange = streamInRange[otherID];
 
 				// Use vehicle pos if player is passenger to keep paused players synced.
 				if (state == PlayerState_Passenger)
 				{
-					auto vehicleData = queryExtension<IPlayerVehicleData>(other);
+					auto vehicleData = static_cast<Player*>(other)->querySlotExtension<IPlayerVehicleData>();
 
 					if (vehicleData)
 					{
@@ -2162,13 +2495,13 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 
 						if (vehicle)
 						{
-							otherPos = vehicle->getPosition();
+							const Vector2 dist2D = player.pos_ - vehicle->getPosition();
+							inRange = hotState.getWorld(otherID) == player.virtualWorld_ && glm::dot(dist2D, dist2D) < maxDist;
 						}
 					}
 				}
 
-				const Vector2 dist2D = player.pos_ - otherPos;
-				const bool shouldBeStreamedIn = state != PlayerState_Spectating && state != PlayerState_None && other->getVirtualWorld() == player.virtualWorld_ && glm::dot(dist2D, dist2D) < maxDist;
+				const bool shouldBeStreamedIn = state != PlayerState_Spectating && state != PlayerState_None && inRange;
 
 				const bool isStreamedIn = other->isStreamedInForPlayer(player);
 				if (!isStreamedIn && shouldBeStreamedIn)
@@ -2187,6 +2520,8 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 
 	void onTick(Microseconds elapsed, TimePoint now) override
 	{
+		// Everyone's join budget starts again, this runs after the components so they spend what the pool leaves.
+		++joinBudget.tick;
 		for (auto it = storage.entries().begin(); it != storage.entries().end();)
 		{
 			Player* player = static_cast<Player*>(*it);
@@ -2199,6 +2534,11 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 				continue;
 			}
 
+			if (!player->pendingJoins_.empty())
+			{
+				sendPendingJoins(*player);
+			}
+
 			if (!player->spectateData_.spectating)
 			{
 				switch (player->primarySyncUpdateType_)
@@ -2218,7 +2558,7 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 						player->footSync_.SpecialAction = SpecialAction_EnterVehicle;
 					}
 
-					PacketHelper::broadcastSyncPacket(player->footSync_, *player);
+					broadcastSync(player->footSync_, *player, SyncLODKind_OnFoot);
 					break;
 				}
 				case PrimarySyncUpdateType::Driver:
@@ -2230,7 +2570,7 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 						player->vehicleSync_.LeftRight = 0;
 					}
 
-					PacketHelper::broadcastSyncPacket(player->vehicleSync_, *player);
+					broadcastSync(player->vehicleSync_, *player, SyncLODKind_Vehicle);
 					break;
 				}
 				case PrimarySyncUpdateType::Passenger:
@@ -2247,7 +2587,7 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 					{
 						player->passengerSync_.Keys &= 0xFB;
 					}
-					PacketHelper::broadcastSyncPacket(player->passengerSync_, *player);
+					broadcastSync(player->passengerSync_, *player, SyncLODKind_Vehicle);
 					player->passengerSync_.Keys = keys;
 
 					break;
@@ -2259,11 +2599,11 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 
 				if (player->secondarySyncUpdateType_ & SecondarySyncUpdateType_Aim)
 				{
-					PacketHelper::broadcastSyncPacket(player->aimSync_, *player);
+					broadcastSync(player->aimSync_, *player, SyncLODKind_Aim);
 				}
 				if (player->secondarySyncUpdateType_ & SecondarySyncUpdateType_Trailer)
 				{
-					PacketHelper::broadcastSyncPacket(player->trailerSync_, *player);
+					broadcastSync(player->trailerSync_, *player, SyncLODKind_Vehicle);
 				}
 				if (player->secondarySyncUpdateType_ & SecondarySyncUpdateType_Unoccupied)
 				{
@@ -2298,6 +2638,7 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 		NetCode::Packet::PlayerUnoccupiedSync::addEventHandler(core, &playerUnoccupiedSyncHandler);
 		NetCode::Packet::PlayerTrailerSync::addEventHandler(core, &playerTrailerSyncHandler);
 		NetCode::Packet::PlayerWeaponsUpdate::addEventHandler(core, &playerWeaponsUpdateHandler);
+		setSyncInjector(this);
 	}
 
 	void removeSyncPacketsHandlers()
@@ -2312,6 +2653,39 @@ struct PlayerPool final : public IPlayerPool, public NetworkEventHandler, public
 		NetCode::Packet::PlayerUnoccupiedSync::removeEventHandler(core, &playerUnoccupiedSyncHandler);
 		NetCode::Packet::PlayerWeaponsUpdate::removeEventHandler(core, &playerWeaponsUpdateHandler);
 		NetCode::Packet::PlayerTrailerSync::removeEventHandler(core, &playerTrailerSyncHandler);
+		setSyncInjector(nullptr);
+	}
+
+	/// Let networks that support it skip the bitstream round trip, see ISyncInjectionExtension
+	void setSyncInjector(NetCode::ISyncInjector* injector)
+	{
+		for (INetwork* network : networks)
+		{
+			if (auto extension = queryExtension<NetCode::ISyncInjectionExtension>(network))
+			{
+				extension->setSyncInjector(injector);
+			}
+		}
+	}
+
+	bool injectFootSync(IPlayer& peer, NetCode::Packet::PlayerFootSync& footSync) override
+	{
+		return playerFootSyncHandler.apply(peer, footSync);
+	}
+
+	bool injectDriverSync(IPlayer& peer, NetCode::Packet::PlayerVehicleSync& vehicleSync) override
+	{
+		return playerVehicleSyncHandler.apply(peer, vehicleSync);
+	}
+
+	bool injectPassengerSync(IPlayer& peer, NetCode::Packet::PlayerPassengerSync& passengerSync) override
+	{
+		return playerPassengerSyncHandler.apply(peer, passengerSync);
+	}
+
+	bool injectAimSync(IPlayer& peer, NetCode::Packet::PlayerAimSync& aimSync) override
+	{
+		return playerAimSyncHandler.apply(peer, aimSync);
 	}
 
 	~PlayerPool()
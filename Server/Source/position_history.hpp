@@ -0,0 +1,97 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <types.hpp>
+#include <glm/glm.hpp>
+
+using namespace Impl;
+
+/// The last few seconds of a player's synced positions, so shots can be checked against where the target was
+/// when the shooter saw them rather than where they are now
+class PositionHistory
+{
+public:
+	/// About four seconds of on foot sync at the default rates
+	static constexpr size_t Capacity = 128;
+
+	/// Furthest a position is extrapolated past the newest sample
+	static constexpr Milliseconds MaxExtrapolation = Milliseconds(250);
+
+	struct Sample
+	{
+		TimePoint time;
+		Vector3 position;
+		Vector3 velocity; ///< In game units, which are metres per 1/50 of a second
+	};
+
+	void push(TimePoint time, Vector3 position, Vector3 velocity)
+	{
+		samples_[head_] = { time, position, velocity };
+		head_ = (head_ + 1) % Capacity;
+		if (size_ < Capacity)
+		{
+			++size_;
+		}
+	}
+
+	/// Forget everything, for teleports where interpolating across the jump would be nonsense
+	void clear()
+	{
+		size_ = 0;
+	}
+
+	bool empty() const
+	{
+		return size_ == 0;
+	}
+
+	/// Interpolate the position at a point in time, fails if that's older than anything we have
+	bool getPositionAt(TimePoint time, Vector3& position) const
+	{
+		if (size_ == 0)
+		{
+			return false;
+		}
+
+		const Sample& newest = at(0);
+		if (time >= newest.time)
+		{
+			const Microseconds ahead = std::min<Microseconds>(duration_cast<Microseconds>(time - newest.time), MaxExtrapolation);
+			position = newest.position + newest.velocity * (ahead.count() / 1000000.0f * 50.0f);
+			return true;
+		}
+
+		// Samples arrive in time order, walk back until we straddle the time we want.
+		for (size_t i = 1; i < size_; ++i)
+		{
+			const Sample& older = at(i);
+			if (older.time <= time)
+			{
+				const Sample& newer = at(i - 1);
+				const float span = float(duration_cast<Microseconds>(newer.time - older.time).count());
+				const float t = span > 0.0f ? float(duration_cast<Microseconds>(time - older.time).count()) / span : 1.0f;
+				position = glm::mix(older.position, newer.position, t);
+				return true;
+			}
+		}
+		return false;
+	}
+
+private:
+	/// The sample `age` pushes ago, 0 being the newest
+	const Sample& at(size_t age) const
+	{
+		return samples_[(head_ + Capacity - 1 - age) % Capacity];
+	}
+
+	StaticArray<Sample, Capacity> samples_;
+	size_t head_ = 0;
+	size_t size_ = 0;
+};
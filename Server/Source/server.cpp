@@ -17,6 +17,48 @@
 Core* core = nullptr;
 std::atomic_bool done = false;
 
+#ifdef OMP_COUNT_ALLOCATIONS
+// Count the heap allocations made through the server executable's operator new so the load test component can
+// report allocations per tick.  Only the executable is counted: components are built with hidden visibility and
+// may link the C++ runtime statically, so their allocations don't reach this replacement.
+static std::atomic<uint64_t> allocationCount(0);
+
+void* operator new(size_t size)
+{
+	++allocationCount;
+	void* ptr = std::malloc(size ? size : 1);
+	if (ptr == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+#ifdef BUILD_WINDOWS
+extern "C" __declspec(dllexport) uint64_t OMPGetAllocationCount()
+#else
+extern "C" __attribute__((visibility("default"))) uint64_t OMPGetAllocationCount()
+#endif
+{
+	return allocationCount.load(std::memory_order_relaxed);
+}
+#endif
+
 void handler(int s)
 {
 	signal(s, &handler);
@@ -0,0 +1,96 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <core.hpp>
+#include <network.hpp>
+#include <types.hpp>
+
+using namespace Impl;
+
+/// Which band set a sync packet is judged by
+enum SyncLODKind
+{
+	SyncLODKind_OnFoot, ///< On foot sync, and anything sent through the generic broadcast
+	SyncLODKind_Vehicle, ///< Driver, passenger and trailer sync
+	SyncLODKind_Aim,
+	SyncLODKind_End
+};
+
+/// Decides how often a player's sync is forwarded to each peer, from full rate close by down to one packet
+/// in eight far away.  Peers are staggered by ID so the packets a sender skips are spread evenly over ticks
+/// instead of everyone dropping the same ones, and the choice is deterministic so rates are exact.
+class SyncLODPolicy
+{
+public:
+	/// Slowest rate a band can drop to before congestion is taken into account
+	static constexpr uint32_t MaxInterval = 8;
+
+	void init(IConfig& config)
+	{
+		static const StringView prefixes[SyncLODKind_End] = { "on_foot", "vehicle", "aim" };
+		static const StringView bandNames[BandCount] = { "full_rate_distance", "half_rate_distance", "quarter_rate_distance" };
+
+		for (int kind = 0; kind != SyncLODKind_End; ++kind)
+		{
+			for (size_t band = 0; band != BandCount; ++band)
+			{
+				const String key = "network.sync_lod." + String(prefixes[kind]) + "_" + String(bandNames[band]);
+				distances_[kind][band] = config.getFloat(key);
+			}
+		}
+		congestionSendQueue_ = config.getInt("network.sync_lod.congestion_send_queue");
+		congestionBitsPerSecond_ = config.getInt("network.sync_lod.congestion_bits_per_second");
+	}
+
+	/// Whether any congestion budget is set, otherwise receivers don't need sampling at all
+	bool tracksCongestion() const
+	{
+		return (congestionSendQueue_ && *congestionSendQueue_ > 0) || (congestionBitsPerSecond_ && *congestionBitsPerSecond_ > 0);
+	}
+
+	/// Whether a receiver's statistics put them over either budget
+	bool isCongested(const NetworkStats& stats) const
+	{
+		return (*congestionSendQueue_ > 0 && stats.messageSendBuffer > unsigned(*congestionSendQueue_))
+			|| (*congestionBitsPerSecond_ > 0 && stats.bitsPerSecond > uint64_t(*congestionBitsPerSecond_));
+	}
+
+	/// Forward every this many packets to a peer at this distance, always a power of two
+	uint32_t getInterval(SyncLODKind kind, float distSqr, bool congested) const
+	{
+		uint32_t interval = MaxInterval;
+		for (size_t band = 0; band != BandCount; ++band)
+		{
+			const float distance = *distances_[kind][band];
+			if (distSqr < distance * distance)
+			{
+				interval = 1u << band;
+				break;
+			}
+		}
+
+		// Everyone a congested receiver sees drops a step, their queue is the thing that's full.
+		return congested ? interval << 1 : interval;
+	}
+
+	/// The packet a sender is on for this kind, counted per sender, decides which peers get it
+	bool shouldSend(SyncLODKind kind, float distSqr, bool congested, uint32_t sequence, int receiverID) const
+	{
+		const uint32_t interval = getInterval(kind, distSqr, congested);
+		return ((sequence + uint32_t(receiverID)) & (interval - 1)) == 0;
+	}
+
+private:
+	static constexpr size_t BandCount = 3;
+
+	float* distances_[SyncLODKind_End][BandCount];
+	int* congestionSendQueue_ = nullptr;
+	int* congestionBitsPerSecond_ = nullptr;
+};
@@ -0,0 +1,82 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <netcode.hpp>
+#include <cmath>
+
+/// Checks on decoded sync, made by the sync handlers before they apply it.  Packets read from a bitstream have had
+/// most of these made while reading, sync injected by a network without a bitstream hasn't had any of them.
+namespace SyncValidation
+{
+/// Furthest a synced position can be from the origin on any axis
+constexpr float MaxPosition = 20000.0f;
+
+/// Largest synced velocity on any axis
+constexpr float MaxVelocity = 100.0f;
+
+/// Health and armour are sent as one byte each
+constexpr float MaxHealthArmour = 255.0f;
+
+inline bool isFinite(Vector2 value)
+{
+	return std::isfinite(value.x) && std::isfinite(value.y);
+}
+
+inline bool isFinite(Vector3 value)
+{
+	return std::isfinite(value.x) && std::isfinite(value.y) && std::isfinite(value.z);
+}
+
+inline bool isWithin(Vector3 value, float limit)
+{
+	return isFinite(value) && std::abs(value.x) <= limit && std::abs(value.y) <= limit && std::abs(value.z) <= limit;
+}
+
+inline bool isValidRotation(const GTAQuat& rotation)
+{
+	return std::isfinite(rotation.q.w) && std::isfinite(rotation.q.x) && std::isfinite(rotation.q.y) && std::isfinite(rotation.q.z);
+}
+
+inline bool isValidHealthArmour(Vector2 healthArmour)
+{
+	return isFinite(healthArmour) && healthArmour.x >= 0.0f && healthArmour.x <= MaxHealthArmour && healthArmour.y >= 0.0f && healthArmour.y <= MaxHealthArmour;
+}
+
+inline bool isValid(const NetCode::Packet::PlayerFootSync& footSync)
+{
+	return isWithin(footSync.Position, MaxPosition)
+		&& isWithin(footSync.Velocity, MaxVelocity)
+		&& isValidRotation(footSync.Rotation)
+		&& isValidHealthArmour(footSync.HealthArmour)
+		&& isFinite(footSync.SurfingData.offset);
+}
+
+inline bool isValid(const NetCode::Packet::PlayerVehicleSync& vehicleSync)
+{
+	return isWithin(vehicleSync.Position, MaxPosition)
+		&& isWithin(vehicleSync.Velocity, MaxVelocity)
+		&& isValidRotation(vehicleSync.Rotation)
+		&& isValidHealthArmour(vehicleSync.PlayerHealthArmour)
+		&& std::isfinite(vehicleSync.Health);
+}
+
+inline bool isValid(const NetCode::Packet::PlayerPassengerSync& passengerSync)
+{
+	return isWithin(passengerSync.Position, MaxPosition)
+		&& isValidHealthArmour(passengerSync.HealthArmour);
+}
+
+inline bool isValid(const NetCode::Packet::PlayerAimSync& aimSync)
+{
+	return isWithin(aimSync.CamPos, MaxPosition)
+		&& isFinite(aimSync.CamFrontVector)
+		&& std::isfinite(aimSync.AimZ);
+}
+}
@@ -19,6 +19,7 @@ struct IUnknown;
 #include <shellapi.h>
 #include <timeapi.h>
 #define SET_TICKER_RESOLUTION(ms) timeBeginPeriod(ms)
+#define LIBRARY_HANDLE HMODULE
 #define LIBRARY_OPEN(path) LoadLibrary(path)
 #define LIBRARY_OPEN_GLOBAL(path) LIBRARY_OPEN(path)
 #define LIBRARY_GET_ADDR GetProcAddress
@@ -35,6 +36,7 @@ static LARGE_INTEGER yo;
 #include <mach-o/dyld.h>
 #endif
 #define SET_TICKER_RESOLUTION(ms)
+#define LIBRARY_HANDLE void*
 #define LIBRARY_OPEN(path) dlopen(path, RTLD_LAZY | RTLD_LOCAL)
 #define LIBRARY_OPEN_GLOBAL(path) dlopen(path, RTLD_LAZY | RTLD_GLOBAL)
 #define LIBRARY_GET_ADDR dlsym
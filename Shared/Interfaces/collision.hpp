@@ -0,0 +1,54 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <sdk.hpp>
+
+/// Returned by createObject when the model has no collision
+static const int INVALID_COLLISION_OBJECT_ID = -1;
+
+/// Where a ray first touched the world
+struct CollisionHit
+{
+	Vector3 position; ///< The point of impact
+	Vector3 normal; ///< The surface normal at the point of impact, facing the ray
+	float distance; ///< Distance from the ray origin to the point of impact
+	int modelId; ///< The model that was hit
+};
+
+static const UID CollisionComponent_UID = UID(0x3d6a1f0c8e42b795);
+/// Static world collision loaded from a preprocessed or ColAndreas file, plus global objects and any objects added at runtime
+struct ICollisionComponent : public IComponent
+{
+	PROVIDE_UID(CollisionComponent_UID);
+
+	/// Get whether a collision file was loaded, all queries miss when it wasn't
+	virtual bool isLoaded() const = 0;
+
+	/// Find the first surface on the segment between two points
+	virtual bool rayCast(Vector3 from, Vector3 to, CollisionHit& hit) const = 0;
+
+	/// Check that nothing is in the way between two points
+	virtual bool hasLineOfSight(Vector3 from, Vector3 to) const = 0;
+
+	/// Find the height of the first surface below a point
+	virtual bool getGroundZ(Vector3 position, float& z) const = 0;
+
+	/// Remove the map buildings of a model within a radius, -1 matches every model.  Returns how many were removed
+	virtual int removeBuilding(int modelId, Vector3 position, float radius) = 0;
+
+	/// Add an object to the collision world, returns its ID or INVALID_COLLISION_OBJECT_ID
+	virtual int createObject(int modelId, Vector3 position, GTAQuat rotation) = 0;
+
+	/// Move an object added with createObject
+	virtual bool setObjectTransform(int objectId, Vector3 position, GTAQuat rotation) = 0;
+
+	/// Remove an object added with createObject
+	virtual bool destroyObject(int objectId) = 0;
+};
@@ -0,0 +1,34 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <component.hpp>
+#include <Server/Components/Databases/databases.hpp>
+
+/// Gets the result of executeQueryAsync on the main thread
+struct DatabaseQueryHandler
+{
+	/// The result set belongs to the handler, which frees it with IDatabasesComponent::freeResultSet; null if the query failed
+	virtual void onQueryExecuted(IDatabaseResultSet* resultSet) = 0;
+};
+
+/// Runs queries on a worker thread per connection, the results are delivered from the tick.  Queries queued on one
+/// connection run in order, and synchronous queries on it wait for the queued ones first.  Query it on the databases
+/// component with queryExtension<IDatabaseAsyncExtension>(databasesComponent).
+struct IDatabaseAsyncExtension : public IExtension
+{
+	PROVIDE_EXT_UID(0x3d95c0e7b1a4f826)
+
+	/// Queue a query, the handler must stay alive until it's called.  Closing the connection runs what's still
+	/// queued before it closes, and the handlers are called as usual.
+	virtual bool executeQueryAsync(IDatabaseConnection& connection, StringView query, DatabaseQueryHandler* handler) = 0;
+
+	/// Get the number of queries whose handlers haven't been called yet
+	virtual size_t getPendingQueryCount() const = 0;
+};
@@ -0,0 +1,42 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <component.hpp>
+#include <events.hpp>
+
+/// The time one event handler has spent handling one kind of event
+struct EventHandlerProfile
+{
+	StringView event; ///< The handler interface, such as PlayerUpdateEventHandler
+	StringView handler; ///< The class that registered the handler
+	event_order_t priority;
+	uint64_t calls;
+	uint64_t nanoseconds;
+	uint64_t maxNanoseconds;
+};
+
+/// Per handler timing for the core's event dispatchers, the player pool's and the tick.  Query it on the core
+/// with queryExtension<IEventProfilerExtension>(core).
+struct IEventProfilerExtension : public IExtension
+{
+	PROVIDE_EXT_UID(0x6a1f93c0e47d52b8)
+
+	/// Whether handler calls are being timed
+	virtual bool isEventProfiling() const = 0;
+
+	/// Start or stop timing handler calls, what was timed so far is kept
+	virtual void setEventProfiling(bool enabled) = 0;
+
+	/// Forget everything timed so far
+	virtual void resetEventProfile() = 0;
+
+	/// Get every registered handler's timings, valid until the next call
+	virtual Span<const EventHandlerProfile> getEventProfile() = 0;
+};
@@ -0,0 +1,53 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <sdk.hpp>
+
+enum PasswordHashType
+{
+	PasswordHashType_Bcrypt,
+	PasswordHashType_Argon2id,
+};
+
+/// Use the cost from the config
+static const int PASSWORD_HASH_DEFAULT_COST = -1;
+
+/// Gets the result of hashPassword on the main thread
+struct PasswordHashHandler
+{
+	/// The encoded hash with its salt and parameters, or empty if hashing failed
+	virtual void onPasswordHashed(StringView hash) = 0;
+};
+
+/// Gets the result of checkPassword on the main thread
+struct PasswordCheckHandler
+{
+	virtual void onPasswordChecked(bool match) = 0;
+};
+
+static const UID HashingComponent_UID = UID(0x7c0e95b3a14f2d68);
+/// Password hashing off the main thread, the results are delivered from the tick.  Requests still out when the
+/// component goes away are answered then, with an empty hash or no match for those that never ran.
+struct IHashingComponent : public IComponent
+{
+	PROVIDE_UID(HashingComponent_UID);
+
+	/// Queue a password to be hashed with a fresh salt, the handler must stay alive until it's called
+	/// The cost is the log2 of the rounds for bcrypt and the number of passes for Argon2id, capped at what
+	/// checkPassword accepts: the configured cost plus 2 for bcrypt, 4 times the configured passes for Argon2id
+	virtual bool hashPassword(PasswordHashHandler* handler, PasswordHashType type, StringView password, int cost = PASSWORD_HASH_DEFAULT_COST) = 0;
+
+	/// Queue a password to be checked against a hash from either algorithm, the handler must stay alive until it's called
+	/// Hashes costing more than the limits above, or more than 4 times the configured Argon2id memory and lanes, never match
+	virtual bool checkPassword(PasswordCheckHandler* handler, StringView password, StringView hash) = 0;
+
+	/// Get the number of requests whose handlers haven't been called yet
+	virtual size_t getPendingCount() const = 0;
+};
@@ -0,0 +1,137 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <types.hpp>
+
+using namespace Impl;
+
+/// A structure-of-arrays copy of the spatial state streaming loops read for every entity in a pool, indexed
+/// by pool ID.  The entities write through to it whenever those fields change, so the loops scan a few flat
+/// arrays instead of pulling whole entities, strings and sync data and all, through the cache.
+template <size_t Capacity>
+class HotStateTable
+{
+public:
+	HotStateTable()
+	{
+		x_.fill(0.0f);
+		y_.fill(0.0f);
+		z_.fill(0.0f);
+		world_.fill(0);
+		interior_.fill(0);
+		state_.fill(0);
+		active_.fill(0);
+	}
+
+	/// Store everything about an entity at once and mark its slot live
+	void set(int id, Vector3 position, int world, int interior, uint8_t state)
+	{
+		if (size_t(id) >= Capacity)
+		{
+			return;
+		}
+
+		x_[id] = position.x;
+		y_[id] = position.y;
+		z_[id] = position.z;
+		world_[id] = world;
+		interior_[id] = interior;
+		state_[id] = state;
+		active_[id] = 1;
+		if (size_t(id) >= upper_)
+		{
+			upper_ = id + 1;
+		}
+	}
+
+	/// Just the position, for sync where nothing else changes
+	void setPosition(int id, Vector3 position)
+	{
+		if (size_t(id) < Capacity)
+		{
+			x_[id] = position.x;
+			y_[id] = position.y;
+			z_[id] = position.z;
+		}
+	}
+
+	void remove(int id)
+	{
+		if (size_t(id) >= Capacity)
+		{
+			return;
+		}
+
+		active_[id] = 0;
+		while (upper_ != 0 && active_[upper_ - 1] == 0)
+		{
+			--upper_;
+		}
+	}
+
+	bool isActive(int id) const
+	{
+		return size_t(id) < Capacity && active_[id];
+	}
+
+	Vector3 getPosition(int id) const
+	{
+		return Vector3(x_[id], y_[id], z_[id]);
+	}
+
+	int getWorld(int id) const
+	{
+		return world_[id];
+	}
+
+	int getInterior(int id) const
+	{
+		return interior_[id];
+	}
+
+	uint8_t getState(int id) const
+	{
+		return state_[id];
+	}
+
+	/// One past the highest live ID, nothing at or above it needs scanning
+	size_t upper() const
+	{
+		return upper_;
+	}
+
+	/// Mark the live entities in a world within range of a point on the XY plane, writing 1 or 0 for every
+	/// slot below upper() and returning how many were in range.  The body is branch-free over flat arrays so
+	/// compilers can vectorise it.
+	size_t findInRange(Vector2 centre, float rangeSqr, int world, StaticArray<uint8_t, Capacity>& out) const
+	{
+		const size_t count = upper_;
+		size_t found = 0;
+		for (size_t i = 0; i != count; ++i)
+		{
+			const float dx = x_[i] - centre.x;
+			const float dy = y_[i] - centre.y;
+			const uint8_t hit = active_[i] & uint8_t(world_[i] == world) & uint8_t(dx * dx + dy * dy < rangeSqr);
+			out[i] = hit;
+			found += hit;
+		}
+		return found;
+	}
+
+private:
+	StaticArray<float, Capacity> x_;
+	StaticArray<float, Capacity> y_;
+	StaticArray<float, Capacity> z_;
+	StaticArray<int32_t, Capacity> world_;
+	StaticArray<int32_t, Capacity> interior_;
+	StaticArray<uint8_t, Capacity> state_;
+	StaticArray<uint8_t, Capacity> active_; ///< 1 for slots holding a live entity, kept as a byte so the scan can mask with it
+	size_t upper_ = 0;
+};
@@ -0,0 +1,23 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <player.hpp>
+
+/// How many join-time RPCs a newcomer is sent per tick (network.join_sync_budget), shared between the player pool
+/// announcing the other players and components sending one RPC per entity that already exists.  Query it on the
+/// player pool with queryExtension<IPlayerJoinBudgetExtension>(players).  Each player's budget is refilled every
+/// tick, and whoever asks first that tick gets it first.
+struct IPlayerJoinBudgetExtension : public IExtension
+{
+	PROVIDE_EXT_UID(0x7c2e9a514fd0b386)
+
+	/// Take up to `wanted` sends from the player's budget for this tick, returns how many may go out now
+	virtual size_t takeJoinBudget(IPlayer& player, size_t wanted) = 0;
+};
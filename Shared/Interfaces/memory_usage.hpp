@@ -0,0 +1,24 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <component.hpp>
+
+/// Lets a component report how much memory its entities use, for the memusage console command.  Query it
+/// on the component with queryExtension<IMemoryUsageExtension>(component).
+struct IMemoryUsageExtension : public IExtension
+{
+	PROVIDE_EXT_UID(0x0d4b7e92c3a6f158)
+
+	/// Get the number of live entities
+	virtual size_t getEntityCount() const = 0;
+
+	/// Get the approximate bytes held by the entities and their per-player state
+	virtual size_t getMemoryUsage() const = 0;
+};
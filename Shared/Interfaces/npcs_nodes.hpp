@@ -0,0 +1,21 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <sdk.hpp>
+
+/// Spatial lookups over the node files the NPC component has loaded.  Query it on the NPC component with
+/// queryExtension<INPCNodeLookupExtension>(npcComponent).
+struct INPCNodeLookupExtension : public IExtension
+{
+	PROVIDE_EXT_UID(0x5b8e0d4f72a9c13e)
+
+	/// Find the path point closest to a position over every loaded node file, false if none has any path points
+	virtual bool findNearestNodePoint(Vector3 position, int& nodeId, int& pointId, float& distance) const = 0;
+};
@@ -0,0 +1,87 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <component.hpp>
+#include <player.hpp>
+
+enum PacketAccountingKind
+{
+	PacketAccountingKind_Packet,
+	PacketAccountingKind_RPC,
+	PacketAccountingKind_End
+};
+
+enum PacketAccountingDirection
+{
+	PacketAccountingDirection_Out,
+	PacketAccountingDirection_In,
+	PacketAccountingDirection_End
+};
+
+/// Handler times are bucketed by powers of four microseconds: under 4, 16, 64, 256, 1024, 4096, 16384, and slower
+static constexpr size_t PacketHandlerTimeBuckets = 8;
+
+/// Get the histogram bucket a handler time falls in
+inline size_t getPacketHandlerTimeBucket(uint64_t microseconds)
+{
+	size_t bucket = 0;
+	while (microseconds >= 4 && bucket != PacketHandlerTimeBuckets - 1)
+	{
+		microseconds >>= 2;
+		++bucket;
+	}
+	return bucket;
+}
+
+/// What went through the network for one packet or RPC ID
+struct PacketAccountingEntry
+{
+	uint64_t count = 0;
+	uint64_t bytes = 0;
+	uint64_t handlerMicroseconds = 0; ///< Inbound only, total time spent in the receive handlers
+	uint32_t handlerMaxMicroseconds = 0;
+	StaticArray<uint32_t, PacketHandlerTimeBuckets> handlerHistogram {};
+
+	void add(size_t size, uint32_t recipients = 1)
+	{
+		count += recipients;
+		bytes += uint64_t(size) * recipients;
+	}
+
+	void addHandlerTime(uint64_t microseconds)
+	{
+		handlerMicroseconds += microseconds;
+		handlerMaxMicroseconds = std::max(handlerMaxMicroseconds, uint32_t(std::min<uint64_t>(microseconds, UINT32_MAX)));
+		++handlerHistogram[getPacketHandlerTimeBucket(microseconds)];
+	}
+};
+
+/// Per packet and RPC ID bandwidth and handler cost, in total and per player.  Query it on a network with
+/// queryExtension<IPacketAccountingExtension>(network).
+struct IPacketAccountingExtension : public IExtension
+{
+	PROVIDE_EXT_UID(0x5c83e1a7f20b4d96)
+
+	/// Whether sends and receives are being counted, see network.packet_accounting
+	virtual bool isAccountingEnabled() const = 0;
+
+	/// Start or stop counting, what was counted so far is kept
+	virtual void setAccountingEnabled(bool enabled) = 0;
+
+	/// Forget everything counted so far, for every player
+	virtual void resetAccounting() = 0;
+
+	/// Get the totals for an ID over all players, broadcasts count once for each player they reach
+	virtual const PacketAccountingEntry& getAccounting(PacketAccountingKind kind, PacketAccountingDirection direction, uint8_t id) const = 0;
+
+	/// Get a player's totals for an ID since they connected, null if nothing was counted
+	virtual const PacketAccountingEntry* getPlayerAccounting(const IPlayer& player, PacketAccountingKind kind, PacketAccountingDirection direction, uint8_t id) const = 0;
+};
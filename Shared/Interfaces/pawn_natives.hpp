@@ -0,0 +1,27 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <component.hpp>
+#include <Server/Components/Pawn/pawn.hpp>
+
+/// Calls pawn natives through handles resolved once, rather than by name on every call the way
+/// IPawnScript::CallNativeArray does.  Query it on the pawn component with
+/// queryExtension<IPawnNativeCallExtension>(pawnComponent).
+struct IPawnNativeCallExtension : public IExtension
+{
+	PROVIDE_EXT_UID(0x8e2b47d1c95a3f06)
+
+	/// Get a handle for a native registered by any script or plugin, -1 if there's no such native yet.  Handles stay
+	/// valid for the rest of the run, even if the native is registered again.
+	virtual int resolveNative(StringView name) const = 0;
+
+	/// Call a native by handle in the context of a script, the same as CallNativeArray otherwise; 0 for a bad handle
+	virtual cell callNative(IPawnScript& script, int handle, Span<Impl::NativeParam> params) = 0;
+};
@@ -0,0 +1,27 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <sdk.hpp>
+
+/// Conversions that remember the codepage each player types in, so detection only runs until one has been
+/// seen with enough confidence.  Query it on the Unicode component with queryExtension<IPlayerCodepageExtension>(unicode).
+struct IPlayerCodepageExtension : public IExtension
+{
+	PROVIDE_EXT_UID(0x6a1f3c8e52d7b094)
+
+	/// Convert text a player sent to UTF-8, must be called from the main thread
+	virtual OptimisedString playerToUTF8(IPlayer& player, StringView input) = 0;
+
+	/// Get the codepage learned for a player, empty until one has been detected or set
+	virtual StringView getPlayerCodepage(IPlayer& player) const = 0;
+
+	/// Set a player's codepage, e.g. from a saved preference, or clear it with an empty string to detect it again
+	virtual void setPlayerCodepage(IPlayer& player, StringView codepage) = 0;
+};
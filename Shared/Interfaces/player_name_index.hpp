@@ -0,0 +1,25 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <player.hpp>
+
+/// Name lookups on the player pool, query it with queryExtension<IPlayerNameIndexExtension>(players).
+/// Names compare without case, the same way isNameTaken does.
+struct IPlayerNameIndexExtension : public IExtension
+{
+	PROVIDE_EXT_UID(0x2f8c4e1d7a93b650)
+
+	/// Get the connected player with exactly this name
+	virtual IPlayer* getPlayerByName(StringView name) const = 0;
+
+	/// Fill the output with up to `capacity` players whose names start with the prefix, in name order.
+	/// Returns the total number of matches, which can be more than were written.
+	virtual size_t findPlayersByNamePrefix(StringView prefix, IPlayer** output, size_t capacity) const = 0;
+};
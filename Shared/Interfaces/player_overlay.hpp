@@ -0,0 +1,135 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <types.hpp>
+#include <algorithm>
+
+using namespace Impl;
+
+/// Per-player state for an entity that only stores the players whose state isn't the default, as a small
+/// vector sorted by player ID.  Most entities only ever differ for a handful of players, so this replaces
+/// arrays sized to PLAYER_POOL_SIZE that were nearly all default values.
+template <typename T>
+class PlayerOverlay
+{
+public:
+	using Entry = Pair<int, T>;
+
+	explicit PlayerOverlay(const T& fallback = T())
+		: fallback_(fallback)
+	{
+	}
+
+	/// Get a player's value, or the default if they have none
+	const T& get(int pid) const
+	{
+		auto it = lowerBound(pid);
+		return (it != entries_.end() && it->first == pid) ? it->second : fallback_;
+	}
+
+	/// Get a player's value only if they have one
+	const T* find(int pid) const
+	{
+		auto it = lowerBound(pid);
+		return (it != entries_.end() && it->first == pid) ? &it->second : nullptr;
+	}
+
+	bool has(int pid) const
+	{
+		return find(pid) != nullptr;
+	}
+
+	void set(int pid, const T& value)
+	{
+		auto it = lowerBound(pid);
+		if (it != entries_.end() && it->first == pid)
+		{
+			it->second = value;
+		}
+		else
+		{
+			entries_.emplace(it, pid, value);
+		}
+	}
+
+	/// Drop a player's value so they see the default again
+	bool erase(int pid)
+	{
+		auto it = lowerBound(pid);
+		if (it == entries_.end() || it->first != pid)
+		{
+			return false;
+		}
+		entries_.erase(it);
+		return true;
+	}
+
+	/// Drop the entry at an index, for removing entries while walking them
+	void eraseAt(size_t index)
+	{
+		entries_.erase(entries_.begin() + index);
+	}
+
+	void clear()
+	{
+		entries_.clear();
+	}
+
+	bool empty() const
+	{
+		return entries_.empty();
+	}
+
+	size_t size() const
+	{
+		return entries_.size();
+	}
+
+	const Entry& operator[](size_t index) const
+	{
+		return entries_[index];
+	}
+
+	typename DynamicArray<Entry>::const_iterator begin() const
+	{
+		return entries_.begin();
+	}
+
+	typename DynamicArray<Entry>::const_iterator end() const
+	{
+		return entries_.end();
+	}
+
+	/// Bytes allocated outside the object itself
+	size_t heapUsage() const
+	{
+		return entries_.capacity() * sizeof(Entry);
+	}
+
+private:
+	typename DynamicArray<Entry>::iterator lowerBound(int pid)
+	{
+		return std::lower_bound(entries_.begin(), entries_.end(), pid, [](const Entry& entry, int id)
+			{
+				return entry.first < id;
+			});
+	}
+
+	typename DynamicArray<Entry>::const_iterator lowerBound(int pid) const
+	{
+		return std::lower_bound(entries_.begin(), entries_.end(), pid, [](const Entry& entry, int id)
+			{
+				return entry.first < id;
+			});
+	}
+
+	DynamicArray<Entry> entries_;
+	T fallback_;
+};
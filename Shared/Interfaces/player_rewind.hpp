@@ -0,0 +1,25 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <player.hpp>
+
+/// Where players were in the last few seconds, recorded from their sync.  Query it on the player pool
+/// with queryExtension<IPlayerRewindExtension>(players).
+struct IPlayerRewindExtension : public IExtension
+{
+	PROVIDE_EXT_UID(0x51d7e0a3c96b2f84)
+
+	/// Get where a player was at some point in the recent past, interpolated between syncs
+	virtual bool getPlayerPositionAt(IPlayer& player, TimePoint time, Vector3& position) const = 0;
+
+	/// Check whether a player was within a radius of the segment between two points at some point in the
+	/// recent past, usually a shot line rewound by the shooter's ping
+	virtual bool wasPlayerNearLine(IPlayer& player, Vector3 from, Vector3 to, float radius, TimePoint time) const = 0;
+};
@@ -0,0 +1,171 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+#include <sdk.hpp>
+#include <Impl/network_impl.hpp>
+
+using namespace Impl;
+
+/// In-process network for simulated clients, used by the LoadTest and Replay components.  Nothing leaves the
+/// process, outgoing traffic is only counted so they can report what a real network would have had to send.
+class SimulatedNetwork : public Impl::Network
+{
+private:
+	FlatPtrHashSet<IPlayer> peers;
+	uint64_t bytesSent = 0;
+	uint64_t packetsSent = 0;
+
+	/// Outgoing spans are sized in bits
+	void count(size_t bits, size_t receivers)
+	{
+		bytesSent += bitsToBytes(bits) * receivers;
+		packetsSent += receivers;
+	}
+
+	size_t broadcastReceivers(const IPlayer* exceptPeer) const
+	{
+		size_t receivers = peers.size();
+		if (exceptPeer && peers.find(const_cast<IPlayer*>(exceptPeer)) != peers.end())
+		{
+			--receivers;
+		}
+		return receivers;
+	}
+
+public:
+	void addPeer(IPlayer& peer)
+	{
+		peers.insert(&peer);
+	}
+
+	void removePeer(IPlayer& peer)
+	{
+		peers.erase(&peer);
+	}
+
+	const FlatPtrHashSet<IPlayer>& getPeers() const
+	{
+		return peers;
+	}
+
+	uint64_t getBytesSent() const
+	{
+		return bytesSent;
+	}
+
+	uint64_t getPacketsSent() const
+	{
+		return packetsSent;
+	}
+
+	/// Feed a packet to the in-handlers as if the peer had sent it.  The first byte must be the packet ID.
+	void receivePacket(IPlayer& peer, int type, NetworkBitStream& bs)
+	{
+		const bool res = inEventDispatcher.stopAtFalse([&peer, type, &bs](NetworkInEventHandler* handler)
+			{
+				bs.SetReadOffset(8); // Ignore packet ID
+				return handler->onReceivePacket(peer, type, bs);
+			});
+
+		if (res)
+		{
+			packetInEventDispatcher.stopAtFalse(type, [&peer, &bs](SingleNetworkInEventHandler* handler)
+				{
+					bs.SetReadOffset(8); // Ignore packet ID
+					return handler->onReceive(peer, bs);
+				});
+		}
+	}
+
+	/// Feed an RPC to the in-handlers as if the peer had sent it.
+	void receiveRPC(IPlayer& peer, int id, NetworkBitStream& bs)
+	{
+		const bool res = inEventDispatcher.stopAtFalse([&peer, id, &bs](NetworkInEventHandler* handler)
+			{
+				return handler->onReceiveRPC(peer, id, bs);
+			});
+
+		if (res)
+		{
+			rpcInEventDispatcher.stopAtFalse(id, [&peer, &bs](SingleNetworkInEventHandler* handler)
+				{
+					bs.resetReadPointer();
+					return handler->onReceive(peer, bs);
+				});
+		}
+	}
+
+	ENetworkType getNetworkType() const override
+	{
+		return ENetworkType(4);
+	}
+
+	bool sendPacket(IPlayer& peer, Span<uint8_t> data, int channel, bool dispatchEvents = true) override
+	{
+		count(data.size(), 1);
+		return true;
+	}
+
+	bool broadcastPacket(Span<uint8_t> data, int channel, const IPlayer* exceptPeer = nullptr, bool dispatchEvents = true) override
+	{
+		count(data.size(), broadcastReceivers(exceptPeer));
+		return true;
+	}
+
+	bool sendRPC(IPlayer& peer, int id, Span<uint8_t> data, int channel, bool dispatchEvents = true) override
+	{
+		count(data.size(), 1);
+		return true;
+	}
+
+	bool broadcastRPC(int id, Span<uint8_t> data, int channel, const IPlayer* exceptPeer = nullptr, bool dispatchEvents = true) override
+	{
+		count(data.size(), broadcastReceivers(exceptPeer));
+		return true;
+	}
+
+	NetworkStats getStatistics(IPlayer* player = nullptr) override
+	{
+		NetworkStats stats = { 0 };
+		stats.totalBytesSent = bytesSent;
+		stats.messagesSent = packetsSent;
+		return stats;
+	}
+
+	unsigned getPing(const IPlayer& peer) override
+	{
+		return 0;
+	}
+
+	void disconnect(const IPlayer& peer) override
+	{
+		IPlayer& player = const_cast<IPlayer&>(peer);
+		if (peers.erase(&player))
+		{
+			networkEventDispatcher.dispatch(&NetworkEventHandler::onPeerDisconnect, player, PeerDisconnectReason_Kicked);
+		}
+	}
+
+	void ban(const BanEntry& entry, Milliseconds expire = Milliseconds(0)) override
+	{
+	}
+
+	void unban(const BanEntry& entry) override
+	{
+	}
+
+	void update() override
+	{
+	}
+
+	SimulatedNetwork()
+		: Network(256, 256)
+	{
+	}
+};
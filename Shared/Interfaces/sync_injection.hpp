@@ -0,0 +1,33 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2022, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <netcode.hpp>
+
+namespace NetCode
+{
+/// Applies inbound sync packets that are already decoded, running the same validation and events as
+/// the packet handlers.  The packets are adjusted in place the way the handlers adjust what they read.
+struct ISyncInjector
+{
+	virtual bool injectFootSync(IPlayer& peer, Packet::PlayerFootSync& footSync) = 0;
+	virtual bool injectDriverSync(IPlayer& peer, Packet::PlayerVehicleSync& vehicleSync) = 0;
+	virtual bool injectPassengerSync(IPlayer& peer, Packet::PlayerPassengerSync& passengerSync) = 0;
+	virtual bool injectAimSync(IPlayer& peer, Packet::PlayerAimSync& aimSync) = 0;
+};
+
+/// Implemented by networks whose peers produce sync state in memory rather than as packets, the
+/// player pool hands them its injector while its sync handlers are registered.
+struct ISyncInjectionExtension : public IExtension
+{
+	PROVIDE_EXT_UID(0x6b4b7a8e21c0f35d)
+
+	virtual void setSyncInjector(ISyncInjector* injector) = 0;
+};
+}
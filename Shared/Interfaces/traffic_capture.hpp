@@ -0,0 +1,310 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+#pragma once
+
+#include <netcode.hpp>
+#include <network.hpp>
+#include <player.hpp>
+#include <types.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+using namespace Impl;
+
+/// Inbound traffic capture files, written by the legacy network with network.capture_file and played back by the
+/// Replay component.  After an eight byte magic every record is an eight byte little-endian header followed by
+/// its payload:
+///
+///     uint8  type      TrafficRecordType
+///     uint8  id        Packet or RPC ID, disconnect reason
+///     uint16 player    Pool ID of the player when it was captured
+///     uint32 bits      Payload length in bits, the payload itself is padded to whole bytes
+///
+/// Tick records carry the microseconds since the capture started and precede everything received in that tick.
+///
+/// Captures hold whatever players typed.  Unless masking is turned off, the text of commands, dialog responses and
+/// RCON commands is overwritten with '*' before it's written, so passwords typed there never reach the file.  Their
+/// lengths are kept and they still replay, with the masked text.
+enum TrafficRecordType : uint8_t
+{
+	TrafficRecordType_Tick,
+	TrafficRecordType_Connect, ///< uint8 bot, uint8 ClientVersion, uint8 length + name, uint8 length + version name
+	TrafficRecordType_Disconnect,
+	TrafficRecordType_Packet, ///< Includes the packet ID byte, as received
+	TrafficRecordType_RPC, ///< Just the RPC's data
+};
+
+static constexpr char TrafficCaptureMagic[8] = { 'O', 'M', 'P', 'T', 'R', 'A', 'F', '1' };
+
+struct TrafficRecord
+{
+	TrafficRecordType type;
+	uint8_t id;
+	uint16_t player;
+	uint32_t bits;
+	DynamicArray<uint8_t> payload;
+};
+
+/// Appends records to a capture file through a buffer, so capturing costs a copy per message rather than a write
+class TrafficCaptureWriter
+{
+public:
+	~TrafficCaptureWriter()
+	{
+		close();
+	}
+
+	bool open(StringView path, TimePoint now)
+	{
+		close();
+		file_ = fopen(String(path).c_str(), "wb");
+		if (!file_)
+		{
+			return false;
+		}
+		start_ = now;
+		tickPending_ = false;
+		buffer_.reserve(FlushSize + 1024);
+		buffer_.insert(buffer_.end(), std::begin(TrafficCaptureMagic), std::end(TrafficCaptureMagic));
+		return true;
+	}
+
+	void close()
+	{
+		if (file_)
+		{
+			flush();
+			fclose(file_);
+			file_ = nullptr;
+		}
+	}
+
+	bool isOpen() const
+	{
+		return file_ != nullptr;
+	}
+
+	/// Whether to mask typed text that may hold passwords, on by default
+	void setMaskInput(bool mask)
+	{
+		maskInput_ = mask;
+	}
+
+	/// Start a new tick, its record is only written if something is received during it
+	void beginTick(TimePoint now)
+	{
+		tickTime_ = now;
+		tickPending_ = true;
+	}
+
+	void writeConnect(int player, bool bot, ClientVersion version, StringView name, StringView versionName)
+	{
+		uint8_t payload[2 + 2 * 256];
+		size_t length = 0;
+		payload[length++] = bot;
+		payload[length++] = uint8_t(version);
+		for (StringView str : { name, versionName })
+		{
+			const size_t strLength = std::min<size_t>(str.length(), 255);
+			payload[length++] = uint8_t(strLength);
+			memcpy(payload + length, str.data(), strLength);
+			length += strLength;
+		}
+		write(TrafficRecordType_Connect, 0, player, payload, length * 8);
+	}
+
+	void writeDisconnect(int player, uint8_t reason)
+	{
+		write(TrafficRecordType_Disconnect, reason, player, nullptr, 0);
+	}
+
+	void writePacket(int player, uint8_t id, const uint8_t* data, uint32_t bits)
+	{
+		// The packet ID byte and the length come before an RCON command's text.
+		const size_t textOffset = id == NetCode::Packet::PlayerRconCommand::PacketID ? 5 : 0;
+		write(TrafficRecordType_Packet, id, player, mask(data, bits, textOffset), bits);
+	}
+
+	void writeRPC(int player, uint8_t id, const uint8_t* data, uint32_t bits)
+	{
+		// Commands start with their length, dialog responses with the dialog, button, list item and length.
+		size_t textOffset = 0;
+		if (id == NetCode::RPC::PlayerRequestCommandMessage::PacketID)
+		{
+			textOffset = 4;
+		}
+		else if (id == NetCode::RPC::OnPlayerDialogResponse::PacketID)
+		{
+			textOffset = 6;
+		}
+		write(TrafficRecordType_RPC, id, player, mask(data, bits, textOffset), bits);
+	}
+
+	void flush()
+	{
+		if (file_ && !buffer_.empty())
+		{
+			fwrite(buffer_.data(), 1, buffer_.size(), file_);
+			buffer_.clear();
+		}
+	}
+
+private:
+	static constexpr size_t FlushSize = 256 * 1024;
+
+	/// A copy of the payload with everything from the text offset on masked, or the payload itself if there's
+	/// nothing to mask
+	const uint8_t* mask(const uint8_t* data, uint32_t bits, size_t textOffset)
+	{
+		const size_t length = bitsToBytes(bits);
+		if (!maskInput_ || !data || textOffset == 0 || length <= textOffset)
+		{
+			return data;
+		}
+		masked_.assign(data, data + length);
+		std::fill(masked_.begin() + textOffset, masked_.end(), uint8_t('*'));
+		return masked_.data();
+	}
+
+	void writeHeader(TrafficRecordType type, uint8_t id, int player, uint32_t bits)
+	{
+		const uint8_t header[8] = {
+			type, id, uint8_t(player), uint8_t(player >> 8),
+			uint8_t(bits), uint8_t(bits >> 8), uint8_t(bits >> 16), uint8_t(bits >> 24)
+		};
+		buffer_.insert(buffer_.end(), header, header + sizeof(header));
+	}
+
+	void write(TrafficRecordType type, uint8_t id, int player, const uint8_t* data, uint32_t bits)
+	{
+		if (!file_)
+		{
+			return;
+		}
+
+		if (tickPending_)
+		{
+			tickPending_ = false;
+			const uint64_t micros = uint64_t(duration_cast<Microseconds>(tickTime_ - start_).count());
+			writeHeader(TrafficRecordType_Tick, 0, 0, 64);
+			for (int i = 0; i != 8; ++i)
+			{
+				buffer_.push_back(uint8_t(micros >> (i * 8)));
+			}
+		}
+
+		writeHeader(type, id, player, bits);
+		if (data)
+		{
+			buffer_.insert(buffer_.end(), data, data + bitsToBytes(bits));
+		}
+
+		if (buffer_.size() >= FlushSize)
+		{
+			flush();
+		}
+	}
+
+	FILE* file_ = nullptr;
+	DynamicArray<uint8_t> buffer_;
+	DynamicArray<uint8_t> masked_;
+	bool maskInput_ = true;
+	TimePoint start_;
+	TimePoint tickTime_;
+	bool tickPending_ = false;
+};
+
+/// Reads a capture back one record at a time
+class TrafficCaptureReader
+{
+public:
+	~TrafficCaptureReader()
+	{
+		if (file_)
+		{
+			fclose(file_);
+		}
+	}
+
+	bool open(StringView path)
+	{
+		file_ = fopen(String(path).c_str(), "rb");
+		if (!file_)
+		{
+			return false;
+		}
+
+		char magic[sizeof(TrafficCaptureMagic)];
+		return fread(magic, 1, sizeof(magic), file_) == sizeof(magic) && memcmp(magic, TrafficCaptureMagic, sizeof(magic)) == 0;
+	}
+
+	/// Read the next record, false at the end of the capture or if it's truncated or corrupt
+	bool read(TrafficRecord& record)
+	{
+		uint8_t header[8];
+		if (!file_)
+		{
+			return false;
+		}
+		const size_t headerRead = fread(header, 1, sizeof(header), file_);
+		if (headerRead != sizeof(header))
+		{
+			failed_ = headerRead != 0;
+			return false;
+		}
+
+		record.type = TrafficRecordType(header[0]);
+		record.id = header[1];
+		record.player = uint16_t(header[2] | (header[3] << 8));
+		record.bits = uint32_t(header[4]) | (uint32_t(header[5]) << 8) | (uint32_t(header[6]) << 16) | (uint32_t(header[7]) << 24);
+
+		// The length isn't trusted: the payload only grows as far as the file has data for it, so a corrupt one can't
+		// ask for hundreds of megabytes.
+		const size_t length = bitsToBytes(record.bits);
+		record.payload.clear();
+		while (record.payload.size() != length)
+		{
+			const size_t offset = record.payload.size();
+			const size_t chunk = std::min(length - offset, ReadChunkSize);
+			record.payload.resize(offset + chunk);
+			if (fread(record.payload.data() + offset, 1, chunk, file_) != chunk)
+			{
+				failed_ = true;
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// Whether reading stopped part way through a record rather than at the end of the capture
+	bool failed() const
+	{
+		return failed_;
+	}
+
+	/// The time stored in a tick record
+	static Microseconds getTickTime(const TrafficRecord& record)
+	{
+		uint64_t micros = 0;
+		for (size_t i = 0; i != std::min<size_t>(record.payload.size(), 8); ++i)
+		{
+			micros |= uint64_t(record.payload[i]) << (i * 8);
+		}
+		return Microseconds(micros);
+	}
+
+private:
+	/// Payloads are read this much at a time
+	static constexpr size_t ReadChunkSize = 64 * 1024;
+
+	FILE* file_ = nullptr;
+	bool failed_ = false;
+};
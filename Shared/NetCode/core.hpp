@@ -1127,11 +1127,9 @@ namespace RPC
 	struct SendPlayerScoresAndPings : NetworkPacketBase<155, NetworkPacketType::RPC, OrderingChannel_SyncRPC>
 	{
 		const FlatPtrHashSet<IPlayer>& Players;
-		const Nanoseconds LastCachedTickDiff;
 
-		SendPlayerScoresAndPings(const FlatPtrHashSet<IPlayer>& players, Nanoseconds lastCachedTickDiff)
+		SendPlayerScoresAndPings(const FlatPtrHashSet<IPlayer>& players)
 			: Players(players)
-			, LastCachedTickDiff(lastCachedTickDiff)
 		{
 		}
 
@@ -1142,21 +1140,12 @@ namespace RPC
 
 		void write(NetworkBitStream& bs) const
 		{
-			// This is added to make sure we have a global cache and we don't recalculate and regenerate for every player and every request of theirs
-			// So instead it keeps a cache of our bitstream to use, which won't loop through player pool and gathering data
-			static NetworkBitStream cache;
-			if (LastCachedTickDiff >= Seconds(2))
+			for (IPlayer* player : Players)
 			{
-				cache.reset();
-				for (IPlayer* player : Players)
-				{
-					cache.writeUINT16(player->getID());
-					cache.writeINT32(player->getScore());
-					cache.writeUINT32(player->getPing());
-				}
+				bs.writeUINT16(player->getID());
+				bs.writeINT32(player->getScore());
+				bs.writeUINT32(player->getPing());
 			}
-
-			bs.WriteBits(cache.GetData(), cache.GetNumberOfBitsUsed());
 		}
 	};
 
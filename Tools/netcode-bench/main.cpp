@@ -0,0 +1,453 @@
+/*
+ *  This Source Code Form is subject to the terms of the Mozilla Public License,
+ *  v. 2.0. If a copy of the MPL was not distributed with this file, You can
+ *  obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *  The original code is copyright (c) 2025, open.mp team and contributors.
+ */
+
+/// Micro-benchmarks for the hand-written NetCode (de)serialisers.  Every sync packet is decoded
+/// from the client format with `read` and encoded in the server format with `write`, which is the
+/// round trip a synced packet makes through the server.  Results can be compared against a stored
+/// baseline to fail runs that regress, and the encoded client packets can be dumped as a fuzzing
+/// corpus for the decoders.
+
+#include <sdk.hpp>
+#include <netcode.hpp>
+#include <cxxopts.hpp>
+#include <ghc/filesystem.hpp>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+using namespace Impl;
+
+static volatile size_t sink = 0;
+
+struct BenchmarkResult
+{
+	String name;
+	double nsPerOp;
+	size_t bytes;
+};
+
+/// Run `op` in batches until at least `minTime` has passed and return the mean time per call.
+template <typename Op>
+double measure(Milliseconds minTime, Op&& op)
+{
+	constexpr size_t BatchSize = 1024;
+
+	// Warm up caches and branch predictors
+	for (size_t i = 0; i != BatchSize; ++i)
+	{
+		op();
+	}
+
+	size_t iterations = 0;
+	const TimePoint start = Time::now();
+	TimePoint now = start;
+	do
+	{
+		for (size_t i = 0; i != BatchSize; ++i)
+		{
+			op();
+		}
+		iterations += BatchSize;
+		now = Time::now();
+	} while (now - start < minTime);
+
+	return double(duration_cast<std::chrono::nanoseconds>(now - start).count()) / iterations;
+}
+
+class NetCodeBenchmark
+{
+private:
+	Milliseconds minTime;
+	DynamicArray<BenchmarkResult> results;
+	DynamicArray<Pair<String, DynamicArray<uint8_t>>> corpus;
+
+public:
+	NetCodeBenchmark(Milliseconds minTime)
+		: minTime(minTime)
+	{
+	}
+
+	/// Benchmark decoding a packet as the server receives it.  `encode` writes the client format,
+	/// starting with the packet ID.
+	template <typename Packet, typename Encode>
+	void read(const String& name, Encode&& encode)
+	{
+		NetworkBitStream encoded;
+		encode(encoded);
+		const size_t bytes = bitsToBytes(encoded.GetNumberOfBitsUsed());
+		DynamicArray<uint8_t> data(encoded.GetData(), encoded.GetData() + bytes);
+
+		{
+			// Make sure the encoder and decoder agree before timing anything
+			NetworkBitStream bs(data.data(), bytes, false);
+			bs.SetReadOffset(8);
+			Packet packet;
+			if (!packet.read(bs))
+			{
+				std::cerr << name << ": encoded packet is rejected by the decoder" << std::endl;
+				std::exit(2);
+			}
+		}
+
+		const double ns = measure(minTime, [&data, bytes]()
+			{
+				NetworkBitStream bs(data.data(), bytes, false);
+				bs.SetReadOffset(8);
+				Packet packet;
+				sink += packet.read(bs);
+			});
+
+		results.push_back({ name + ".read", ns, bytes });
+		corpus.emplace_back(name, std::move(data));
+	}
+
+	/// Benchmark encoding a packet as the server sends it.
+	template <typename Packet>
+	void write(const String& name, const Packet& packet)
+	{
+		size_t bytes = 0;
+		const double ns = measure(minTime, [&packet, &bytes]()
+			{
+				NetworkBitStream bs;
+				packet.write(bs);
+				bytes = bitsToBytes(bs.GetNumberOfBitsUsed());
+				sink += bytes;
+			});
+
+		results.push_back({ name + ".write", ns, bytes });
+	}
+
+	const DynamicArray<BenchmarkResult>& getResults() const
+	{
+		return results;
+	}
+
+	void writeCorpus(const ghc::filesystem::path& dir) const
+	{
+		ghc::filesystem::create_directories(dir);
+		for (const auto& entry : corpus)
+		{
+			std::ofstream file(dir / (entry.first + ".bin"), std::ios::binary);
+			file.write(reinterpret_cast<const char*>(entry.second.data()), entry.second.size());
+		}
+	}
+};
+
+static void writeQuat(NetworkBitStream& bs, const GTAQuat& quat)
+{
+	bs.writeVEC4(Vector4(quat.q.w, quat.q.x, quat.q.y, quat.q.z));
+}
+
+/// Realistic values for a player running through Los Santos
+static const Vector3 SamplePosition(2495.1f, -1687.3f, 13.5f);
+static const Vector3 SampleVelocity(0.21f, -0.13f, 0.0f);
+static const GTAQuat SampleRotation(Vector3(0.0f, 0.0f, 135.0f));
+
+static void runBenchmarks(NetCodeBenchmark& bench)
+{
+	using namespace NetCode::Packet;
+
+	bench.read<PlayerFootSync>("PlayerFootSync", [](NetworkBitStream& bs)
+		{
+			bs.writeUINT8(PlayerFootSync::PacketID);
+			bs.writeUINT16(0);
+			bs.writeUINT16(uint16_t(-128));
+			bs.writeUINT16(Key::SPRINT);
+			bs.writeVEC3(SamplePosition);
+			writeQuat(bs, SampleRotation);
+			bs.writeUINT8(87);
+			bs.writeUINT8(50);
+			bs.writeUINT8(31);
+			bs.writeUINT8(SpecialAction_None);
+			bs.writeVEC3(SampleVelocity);
+			bs.writeVEC3(Vector3(0.0f));
+			bs.writeUINT16(0);
+			bs.writeUINT16(1231);
+			bs.writeUINT16(32772);
+		});
+
+	PlayerFootSync footSync;
+	footSync.PlayerID = 123;
+	footSync.LeftRight = 0;
+	footSync.UpDown = uint16_t(-128);
+	footSync.Keys = Key::SPRINT;
+	footSync.WeaponAdditionalKey = 31;
+	footSync.SpecialAction = SpecialAction_None;
+	footSync.Position = SamplePosition;
+	footSync.Rotation = SampleRotation;
+	footSync.HealthArmour = Vector2(87.0f, 50.0f);
+	footSync.Velocity = SampleVelocity;
+	footSync.AnimationID = 1231;
+	footSync.AnimationFlags = 32772;
+	footSync.SurfingData.type = PlayerSurfingData::Type::None;
+	footSync.SurfingData.ID = 0;
+	footSync.SurfingData.offset = Vector3(0.0f);
+	bench.write("PlayerFootSync", footSync);
+
+	bench.read<PlayerVehicleSync>("PlayerVehicleSync", [](NetworkBitStream& bs)
+		{
+			bs.writeUINT8(PlayerVehicleSync::PacketID);
+			bs.writeUINT16(42);
+			bs.writeUINT16(uint16_t(-128));
+			bs.writeUINT16(0);
+			bs.writeUINT16(Key::SPRINT);
+			writeQuat(bs, SampleRotation);
+			bs.writeVEC3(SamplePosition);
+			bs.writeVEC3(SampleVelocity * 4.0f);
+			bs.writeFLOAT(874.5f);
+			bs.writeUINT8(100);
+			bs.writeUINT8(0);
+			bs.writeUINT8(0);
+			bs.writeUINT8(0);
+			bs.writeUINT8(0);
+			bs.writeUINT16(0);
+			bs.writeUINT32(0);
+		});
+
+	PlayerVehicleSync vehicleSync;
+	vehicleSync.PlayerID = 123;
+	vehicleSync.VehicleID = 42;
+	vehicleSync.LeftRight = uint16_t(-128);
+	vehicleSync.UpDown = 0;
+	vehicleSync.Keys = Key::SPRINT;
+	vehicleSync.Rotation = SampleRotation;
+	vehicleSync.Position = SamplePosition;
+	vehicleSync.Velocity = SampleVelocity * 4.0f;
+	vehicleSync.Health = 874.5f;
+	vehicleSync.PlayerHealthArmour = Vector2(100.0f, 0.0f);
+	vehicleSync.AdditionalKeyWeapon = 0;
+	vehicleSync.Siren = 0;
+	vehicleSync.LandingGear = 0;
+	vehicleSync.TrailerID = 0;
+	vehicleSync.HasTrailer = false;
+	vehicleSync.HydraThrustAngle = 0;
+	bench.write("PlayerVehicleSync", vehicleSync);
+
+	bench.read<PlayerPassengerSync>("PlayerPassengerSync", [](NetworkBitStream& bs)
+		{
+			bs.writeUINT8(PlayerPassengerSync::PacketID);
+			bs.writeUINT16(42);
+			bs.writeUINT16(2);
+			bs.writeUINT8(100);
+			bs.writeUINT8(25);
+			bs.writeUINT16(0);
+			bs.writeUINT16(0);
+			bs.writeUINT16(0);
+			bs.writeVEC3(SamplePosition);
+		});
+
+	PlayerPassengerSync passengerSync;
+	passengerSync.PlayerID = 123;
+	passengerSync.VehicleID = 42;
+	passengerSync.DriveBySeatAdditionalKeyWeapon = 2;
+	passengerSync.HealthArmour = Vector2(100.0f, 25.0f);
+	passengerSync.LeftRight = 0;
+	passengerSync.UpDown = 0;
+	passengerSync.Keys = 0;
+	passengerSync.Position = SamplePosition;
+	bench.write("PlayerPassengerSync", passengerSync);
+
+	bench.read<PlayerUnoccupiedSync>("PlayerUnoccupiedSync", [](NetworkBitStream& bs)
+		{
+			bs.writeUINT8(PlayerUnoccupiedSync::PacketID);
+			bs.writeUINT16(42);
+			bs.writeUINT8(0);
+			bs.writeVEC3(Vector3(1.0f, 0.0f, 0.0f));
+			bs.writeVEC3(Vector3(0.0f, 1.0f, 0.0f));
+			bs.writeVEC3(SamplePosition);
+			bs.writeVEC3(SampleVelocity);
+			bs.writeVEC3(Vector3(0.0f, 0.0f, 0.01f));
+			bs.writeFLOAT(1000.0f);
+		});
+
+	PlayerUnoccupiedSync unoccupiedSync;
+	unoccupiedSync.PlayerID = 123;
+	unoccupiedSync.VehicleID = 42;
+	unoccupiedSync.SeatID = 0;
+	unoccupiedSync.Roll = Vector3(1.0f, 0.0f, 0.0f);
+	unoccupiedSync.Rotation = Vector3(0.0f, 1.0f, 0.0f);
+	unoccupiedSync.Position = SamplePosition;
+	unoccupiedSync.Velocity = SampleVelocity;
+	unoccupiedSync.AngularVelocity = Vector3(0.0f, 0.0f, 0.01f);
+	unoccupiedSync.Health = 1000.0f;
+	bench.write("PlayerUnoccupiedSync", unoccupiedSync);
+
+	bench.read<PlayerTrailerSync>("PlayerTrailerSync", [](NetworkBitStream& bs)
+		{
+			bs.writeUINT8(PlayerTrailerSync::PacketID);
+			bs.writeUINT16(43);
+			bs.writeVEC3(SamplePosition);
+			writeQuat(bs, SampleRotation);
+			bs.writeVEC3(SampleVelocity);
+			bs.writeVEC3(Vector3(0.0f));
+		});
+
+	PlayerTrailerSync trailerSync;
+	trailerSync.PlayerID = 123;
+	trailerSync.VehicleID = 43;
+	trailerSync.Position = SamplePosition;
+	trailerSync.Quat = Vector4(SampleRotation.q.w, SampleRotation.q.x, SampleRotation.q.y, SampleRotation.q.z);
+	trailerSync.Velocity = SampleVelocity;
+	trailerSync.TurnVelocity = Vector3(0.0f);
+	bench.write("PlayerTrailerSync", trailerSync);
+
+	bench.read<PlayerAimSync>("PlayerAimSync", [](NetworkBitStream& bs)
+		{
+			bs.writeUINT8(PlayerAimSync::PacketID);
+			bs.writeUINT8(53);
+			bs.writeVEC3(Vector3(0.7f, -0.7f, 0.1f));
+			bs.writeVEC3(SamplePosition + Vector3(0.0f, 0.0f, 0.7f));
+			bs.writeFLOAT(0.1f);
+			bs.writeUINT8(0x82);
+			bs.writeUINT8(85);
+		});
+
+	PlayerAimSync aimSync;
+	aimSync.PlayerID = 123;
+	aimSync.CamMode = 53;
+	aimSync.CamFrontVector = Vector3(0.7f, -0.7f, 0.1f);
+	aimSync.CamPos = SamplePosition + Vector3(0.0f, 0.0f, 0.7f);
+	aimSync.AimZ = 0.1f;
+	aimSync.ZoomWepState = 0x82;
+	aimSync.AspectRatio = 85;
+	bench.write("PlayerAimSync", aimSync);
+
+	bench.read<PlayerBulletSync>("PlayerBulletSync", [](NetworkBitStream& bs)
+		{
+			bs.writeUINT8(PlayerBulletSync::PacketID);
+			bs.writeUINT8(1);
+			bs.writeUINT16(7);
+			bs.writeVEC3(SamplePosition);
+			bs.writeVEC3(SamplePosition + Vector3(12.0f, -9.0f, 0.2f));
+			bs.writeVEC3(Vector3(0.1f, 0.05f, 0.3f));
+			bs.writeUINT8(31);
+		});
+
+	PlayerBulletSync bulletSync;
+	bulletSync.PlayerID = 123;
+	bulletSync.HitType = 1;
+	bulletSync.HitID = 7;
+	bulletSync.Origin = SamplePosition;
+	bulletSync.HitPos = SamplePosition + Vector3(12.0f, -9.0f, 0.2f);
+	bulletSync.Offset = Vector3(0.1f, 0.05f, 0.3f);
+	bulletSync.WeaponID = 31;
+	bench.write("PlayerBulletSync", bulletSync);
+
+	bench.read<PlayerSpectatorSync>("PlayerSpectatorSync", [](NetworkBitStream& bs)
+		{
+			bs.writeUINT8(PlayerSpectatorSync::PacketID);
+			bs.writeUINT16(0);
+			bs.writeUINT16(0);
+			bs.writeUINT16(0);
+			bs.writeVEC3(SamplePosition);
+		});
+
+	PlayerSpectatorSync spectatorSync;
+	spectatorSync.LeftRight = 0;
+	spectatorSync.UpDown = 0;
+	spectatorSync.Keys = 0;
+	spectatorSync.Position = SamplePosition;
+	bench.write("PlayerSpectatorSync", spectatorSync);
+
+	bench.read<PlayerStatsSync>("PlayerStatsSync", [](NetworkBitStream& bs)
+		{
+			bs.writeUINT8(PlayerStatsSync::PacketID);
+			bs.writeINT32(15230);
+			bs.writeINT32(0);
+		});
+
+	bench.read<PlayerWeaponsUpdate>("PlayerWeaponsUpdate", [](NetworkBitStream& bs)
+		{
+			bs.writeUINT8(PlayerWeaponsUpdate::PacketID);
+			bs.writeUINT16(0xFFFF); // No target player
+			bs.writeUINT16(0xFFFF); // No target actor
+			const uint8_t weapons[][2] = { { 0, 1 }, { 2, 24 }, { 3, 25 }, { 4, 29 }, { 5, 31 }, { 6, 34 } };
+			for (const auto& weapon : weapons)
+			{
+				bs.writeUINT8(weapon[0]);
+				bs.writeUINT8(weapon[1]);
+				bs.writeUINT16(500);
+			}
+		});
+}
+
+static std::map<String, BenchmarkResult> loadBaseline(const String& path)
+{
+	std::map<String, BenchmarkResult> baseline;
+	std::ifstream file(path);
+	BenchmarkResult result;
+	while (file >> result.name >> result.nsPerOp >> result.bytes)
+	{
+		baseline.emplace(result.name, result);
+	}
+	return baseline;
+}
+
+int main(int argc, char** argv)
+{
+	cxxopts::Options options(argv[0], "open.mp NetCode serialisation benchmark");
+
+	options.add_options()("h,help", "Print usage information");
+	options.add_options()("min-time", "Minimum time to run each benchmark for, in milliseconds", cxxopts::value<int>()->default_value("200"));
+	options.add_options()("output", "Write the results to this file, for use as a future baseline", cxxopts::value<std::string>());
+	options.add_options()("baseline", "Compare the results against this file", cxxopts::value<std::string>());
+	options.add_options()("threshold", "Allowed slowdown against the baseline, in percent", cxxopts::value<double>()->default_value("10"));
+	options.add_options()("corpus", "Write the encoded client packets to this directory as a fuzzing corpus", cxxopts::value<std::string>());
+
+	cxxopts::ParseResult args = options.parse(argc, argv);
+	if (args.count("help"))
+	{
+		std::cout << options.help() << std::endl;
+		return 0;
+	}
+
+	NetCodeBenchmark bench(Milliseconds(args["min-time"].as<int>()));
+	runBenchmarks(bench);
+
+	const std::map<String, BenchmarkResult> baseline = args.count("baseline") ? loadBaseline(args["baseline"].as<std::string>()) : std::map<String, BenchmarkResult>();
+	const double threshold = args["threshold"].as<double>();
+	int regressions = 0;
+
+	printf("%-28s %12s %8s %12s\n", "benchmark", "ns/packet", "bytes", "vs baseline");
+	for (const BenchmarkResult& result : bench.getResults())
+	{
+		auto it = baseline.find(result.name);
+		if (it == baseline.end())
+		{
+			printf("%-28s %12.1f %8zu %12s\n", result.name.c_str(), result.nsPerOp, result.bytes, "-");
+			continue;
+		}
+
+		const double change = (result.nsPerOp / it->second.nsPerOp - 1.0) * 100.0;
+		const bool slower = change > threshold;
+		const bool resized = result.bytes != it->second.bytes;
+		printf("%-28s %12.1f %8zu %+11.1f%%%s%s\n", result.name.c_str(), result.nsPerOp, result.bytes, change, slower ? " SLOWER" : "", resized ? " RESIZED" : "");
+		regressions += slower || resized;
+	}
+
+	if (args.count("output"))
+	{
+		std::ofstream file(args["output"].as<std::string>());
+		for (const BenchmarkResult& result : bench.getResults())
+		{
+			file << result.name << ' ' << result.nsPerOp << ' ' << result.bytes << '\n';
+		}
+	}
+
+	if (args.count("corpus"))
+	{
+		bench.writeCorpus(args["corpus"].as<std::string>());
+	}
+
+	if (regressions)
+	{
+		printf("%d benchmark(s) regressed past the %.1f%% threshold\n", regressions, threshold);
+		return 1;
+	}
+	return 0;
+}